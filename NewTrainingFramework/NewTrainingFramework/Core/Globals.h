@@ -6,4 +6,9 @@ public:
 	static const int screenWidth = 1280;
 	static const int screenHeight = 720;
     static const bool fullscreenScale = true;
+
+    // Frame pacing; idle rate applies on the pause screen and static menus
+    static const int targetFrameRate = 144;
+    static const int idleFrameRate = 15;
+    static const int swapInterval = 1;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 //
 
 #include "stdafx.h"
-#include <windows.h>
 #include "../GameObject/Vertex.h"
 #include "../GameObject/Shaders.h"
 #include "Globals.h"
@@ -10,11 +9,26 @@
 #include "../GameManager/ResourceManager.h"
 #include "../GameManager/SceneManager.h"
 #include "../GameManager/GameStateMachine.h"
+#include "../GameManager/SimulationClock.h"
+#include "../GameManager/HeadlessRunner.h"
+#include "../GameManager/AtlasPacker.h"
+#include "../GameManager/SheetTrimmer.h"
+#include "../GameManager/JobSystem.h"
+#include "../GameManager/RenderThread.h"
+#include "../GameManager/FrameTimeStats.h"
+#include "../GameManager/GSPlay.h"
 #include "../GameObject/Object.h"
 #include "../GameObject/Camera.h"
+#include "../GameObject/GlyphAtlas.h"
+#include "../GameObject/BulletSystem.h"
+#include "../GameObject/AnimationBatch.h"
+#include "../GameObject/AnimationGraph.h"
+#ifdef _WIN32
 #include <conio.h>
+#endif
 #include "../../Utilities/utilities.h"
 #include "../GameManager/SoundManager.h"
+#include <cstring>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -24,13 +38,52 @@ ResourceManager* g_resourceManager = nullptr;
 SceneManager* g_sceneManager = nullptr;
 GameStateMachine* g_gameStateMachine = nullptr;
 
+// Letterboxed viewport for the logical resolution, recomputed only on resize
+struct Viewport {
+    int x, y, width, height;
+    float scale;
+};
+static Viewport g_viewport = { 0, 0, Globals::screenWidth, Globals::screenHeight, 1.0f };
+static const GLfloat g_clearColor[4] = { 0.380f, 0.643f, 0.871f, 1.0f };
+// Frame recorded and submitted on this thread under --no-render-thread
+static RenderPacket g_directPacket;
+
+// Main-thread frame interval, Update+Draw cost and packet waits; printed at exit
+static FrameTimeStats g_frameMs;
+static FrameTimeStats g_mainThreadMs;
+static FrameTimeStats g_packetWaitMs;
+static double g_lastFrameTime = 0.0;
+static double g_updateStartTime = 0.0;
+
+void Resize(ESContext* esContext, int clientW, int clientH)
+{
+    const float logicalW = static_cast<float>(Globals::screenWidth);
+    const float logicalH = static_cast<float>(Globals::screenHeight);
+    Viewport vp = { 0, 0, clientW, clientH, 1.0f };
+    if (clientW > 0 && clientH > 0) {
+        const float scaleX = static_cast<float>(clientW) / logicalW;
+        const float scaleY = static_cast<float>(clientH) / logicalH;
+        vp.scale = (scaleX < scaleY) ? scaleX : scaleY;
+        vp.width = static_cast<int>(logicalW * vp.scale + 0.5f);
+        vp.height = static_cast<int>(logicalH * vp.scale + 0.5f);
+        vp.x = (clientW - vp.width) / 2;
+        vp.y = (clientH - vp.height) / 2;
+    }
+    g_viewport = vp;
+}
+
 int Init(ESContext* esContext)
 {
-    glClearColor(0.380f, 0.643f, 0.871f, 1.0f);
+    glClearColor(g_clearColor[0], g_clearColor[1], g_clearColor[2], g_clearColor[3]);
 	g_resourceManager = ResourceManager::GetInstance();
+	g_resourceManager->LoadAtlas("../Resources/Atlas/Atlas.txt");
 	if (!g_resourceManager->LoadFromFile("../Resources/RM.txt")) {
 		return -1;
 	}
+	g_resourceManager->LoadSpriteTrims("../Resources/SpriteTrim.txt");
+	if (!AnimationGraph::Instance().Load("../Resources/AnimGraph.txt")) {
+		return -1;
+	}
 	
 	SoundManager::Instance().LoadMusicFromFile("../Resources/RM.txt");
 	
@@ -45,41 +98,59 @@ int Init(ESContext* esContext)
 
 void Draw(ESContext* esContext)
 {
-    RECT clientRect;
-    GetClientRect((HWND)esContext->hWnd, &clientRect);
-    int clientW = clientRect.right - clientRect.left;
-    int clientH = clientRect.bottom - clientRect.top;
-    const float logicalW = static_cast<float>(Globals::screenWidth);
-    const float logicalH = static_cast<float>(Globals::screenHeight);
-    float scale = 1.0f;
-    int vpX = 0, vpY = 0, vpW = clientW, vpH = clientH;
-    if (clientW > 0 && clientH > 0) {
-        const float scaleX = static_cast<float>(clientW) / logicalW;
-        const float scaleY = static_cast<float>(clientH) / logicalH;
-        scale = (scaleX < scaleY) ? scaleX : scaleY;
-        vpW = static_cast<int>(logicalW * scale + 0.5f);
-        vpH = static_cast<int>(logicalH * scale + 0.5f);
-        vpX = (clientW - vpW) / 2;
-        vpY = (clientH - vpH) / 2;
-    }
-
-    glViewport(vpX, vpY, vpW, vpH);
-    glClear(GL_COLOR_BUFFER_BIT);
+	RenderThread& renderThread = RenderThread::Instance();
+	double waitSec = 0.0;
+	if (renderThread.IsRunning()) {
+		// Recorded here, submitted and presented by the render thread
+		const double waitStart = esGetTime();
+		RenderPacket& packet = renderThread.BeginFrame();
+		waitSec = esGetTime() - waitStart;
+		g_packetWaitMs.Add(waitSec * 1000.0);
+		packet.SetViewport(g_viewport.x, g_viewport.y, g_viewport.width, g_viewport.height);
+		packet.SetClearColor(g_clearColor[0], g_clearColor[1], g_clearColor[2], g_clearColor[3]);
+		if (g_gameStateMachine) {
+			g_gameStateMachine->Draw();
+		}
+		renderThread.EndFrame();
+	} else {
+		// Still recorded first so the opaque and translucent passes can be split
+		g_directPacket.Clear();
+		g_directPacket.SetViewport(g_viewport.x, g_viewport.y, g_viewport.width, g_viewport.height);
+		g_directPacket.SetClearColor(g_clearColor[0], g_clearColor[1], g_clearColor[2], g_clearColor[3]);
+		RenderPacket::SetRecording(&g_directPacket);
+		if (g_gameStateMachine) {
+			g_gameStateMachine->Draw();
+		}
+		RenderPacket::SetRecording(nullptr);
+		g_directPacket.Submit();
 
-	if (g_gameStateMachine) {
-		g_gameStateMachine->Draw();
+		eglSwapBuffers(esContext->eglDisplay, esContext->eglSurface);
 	}
 
-	eglSwapBuffers(esContext->eglDisplay, esContext->eglSurface);	
+	const double now = esGetTime();
+	g_mainThreadMs.Add((now - g_updateStartTime - waitSec) * 1000.0);
+	if (g_lastFrameTime > 0.0) {
+		g_frameMs.Add((now - g_lastFrameTime) * 1000.0);
+	}
+	g_lastFrameTime = now;
 }
 
 void Update(ESContext *esContext, float deltaTime)
 {
-	if (g_gameStateMachine) {
-		g_gameStateMachine->Update(deltaTime);
+	g_updateStartTime = esGetTime();
+	SimulationClock& clock = SimulationClock::Instance();
+	int steps = clock.Advance(deltaTime);
+	for (int i = 0; i < steps && g_gameStateMachine; ++i) {
+		clock.Step();
+		g_gameStateMachine->Update(SimulationClock::TICK_DT);
 	}
 }
 
+bool IsIdle(ESContext *esContext)
+{
+	return g_gameStateMachine && g_gameStateMachine->IsIdle();
+}
+
 void Key(ESContext *esContext, unsigned char key, bool bIsPressed)
 {
 	if (g_gameStateMachine) {
@@ -87,73 +158,61 @@ void Key(ESContext *esContext, unsigned char key, bool bIsPressed)
 	}
 }
 
+// Maps window pixels to logical coordinates (1280x720); false when outside the letterbox
+static bool WindowToLogical(int x, int y, int& lx, int& ly)
+{
+    const Viewport& vp = g_viewport;
+    if (x < vp.x || y < vp.y || x >= vp.x + vp.width || y >= vp.y + vp.height) {
+        return false;
+    }
+    lx = static_cast<int>((x - vp.x) / vp.scale);
+    ly = static_cast<int>((y - vp.y) / vp.scale);
+    return true;
+}
+
 void MouseClick(ESContext *esContext, int x, int y, bool bIsPressed)
 {
-    if (g_gameStateMachine) {
-        // Map from window pixels to logical coordinates (1280x720)
-        RECT clientRect;
-        GetClientRect((HWND)esContext->hWnd, &clientRect);
-        int clientW = clientRect.right - clientRect.left;
-        int clientH = clientRect.bottom - clientRect.top;
-        const float logicalW = static_cast<float>(Globals::screenWidth);
-        const float logicalH = static_cast<float>(Globals::screenHeight);
-        int vpX = 0, vpY = 0, vpW = clientW, vpH = clientH;
-        float scale = 1.0f;
-        if (clientW > 0 && clientH > 0) {
-            const float scaleX = static_cast<float>(clientW) / logicalW;
-            const float scaleY = static_cast<float>(clientH) / logicalH;
-            scale = (scaleX < scaleY) ? scaleX : scaleY;
-            vpW = static_cast<int>(logicalW * scale + 0.5f);
-            vpH = static_cast<int>(logicalH * scale + 0.5f);
-            vpX = (clientW - vpW) / 2;
-            vpY = (clientH - vpH) / 2;
-        }
-        if (x < vpX || y < vpY || x >= vpX + vpW || y >= vpY + vpH) {
-            return;
-        }
-        int lx = static_cast<int>((x - vpX) / scale);
-        int ly = static_cast<int>((y - vpY) / scale);
+    int lx, ly;
+    if (g_gameStateMachine && WindowToLogical(x, y, lx, ly)) {
         g_gameStateMachine->HandleMouseEvent(lx, ly, bIsPressed);
     }
 }
 
 void OnMouseMove(ESContext *esContext, int x, int y)
 {
-    if (g_gameStateMachine) {
-        RECT clientRect;
-        GetClientRect((HWND)esContext->hWnd, &clientRect);
-        int clientW = clientRect.right - clientRect.left;
-        int clientH = clientRect.bottom - clientRect.top;
-        const float logicalW = static_cast<float>(Globals::screenWidth);
-        const float logicalH = static_cast<float>(Globals::screenHeight);
-        int vpX = 0, vpY = 0, vpW = clientW, vpH = clientH;
-        float scale = 1.0f;
-        if (clientW > 0 && clientH > 0) {
-            const float scaleX = static_cast<float>(clientW) / logicalW;
-            const float scaleY = static_cast<float>(clientH) / logicalH;
-            scale = (scaleX < scaleY) ? scaleX : scaleY;
-            vpW = static_cast<int>(logicalW * scale + 0.5f);
-            vpH = static_cast<int>(logicalH * scale + 0.5f);
-            vpX = (clientW - vpW) / 2;
-            vpY = (clientH - vpH) / 2;
-        }
-        if (x < vpX || y < vpY || x >= vpX + vpW || y >= vpY + vpH) {
-            return;
-        }
-        int lx = static_cast<int>((x - vpX) / scale);
-        int ly = static_cast<int>((y - vpY) / scale);
+    int lx, ly;
+    if (g_gameStateMachine && WindowToLogical(x, y, lx, ly)) {
         g_gameStateMachine->HandleMouseMove(lx, ly);
     }
 }
 
+// Runs while the window context still exists: the render thread hands it back
+void Shutdown(ESContext* esContext)
+{
+	RenderThread& renderThread = RenderThread::Instance();
+	const bool threaded = renderThread.IsRunning();
+	renderThread.Stop();
+
+	std::cout << "[Frame] " << (threaded ? "render thread" : "single thread") << std::endl;
+	g_frameMs.Print(std::cout, "frame interval");
+	g_mainThreadMs.Print(std::cout, "main thread update+draw");
+	if (threaded) {
+		g_packetWaitMs.Print(std::cout, "main thread wait for packet");
+		renderThread.GetSubmitStats().Print(std::cout, "render thread submit+swap");
+	}
+}
+
 void CleanUp()
 {
+	JobSystem::Instance().Stop();
 	SoundManager::Instance().Shutdown();
 	if (g_gameStateMachine) {
 		GameStateMachine::DestroyInstance();
 		g_gameStateMachine = nullptr;
 	}
 	
+	GlyphAtlas::ReleaseAll();
+
 	if (g_sceneManager) {
 		SceneManager::DestroyInstance();
 		g_sceneManager = nullptr;
@@ -167,13 +226,119 @@ void CleanUp()
 
 int _tmain(int argc, _TCHAR* argv[])
 {
+	int targetFps = Globals::targetFrameRate;
+	bool headless = false;
+	int headlessTicks = 120 * 60;
+	unsigned int headlessSeed = 1u;
+	int matchCount = 0;
+	int threadCount = 0;
+	int jobWorkers = -1;
+	bool useRenderThread = true;
+	std::vector<std::string> replays;
+	bool benchReplays = false;
+	bool benchSnapshot = false;
+	int replayRepeats = 1;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--bench-bullets") == 0) {
+			BulletSystem::RunBenchmark(10000, 600);
+			return 0;
+		}
+		if (strcmp(argv[i], "--bench-anim") == 0) {
+			AnimationBatch::RunBenchmark(100000, 600);
+			return 0;
+		}
+		if (strcmp(argv[i], "--bench-animgraph") == 0) {
+			AnimationGraph::RunBenchmark("../Resources/AnimGraph.txt", 10000, 600);
+			return 0;
+		}
+		if (strcmp(argv[i], "--pack-atlas") == 0) {
+			return AtlasPacker::Run("../Resources/RM.txt", "../Resources/Atlas/");
+		}
+		if (strcmp(argv[i], "--trim-sheets") == 0) {
+			return SheetTrimmer::Run("../Resources/RM.txt", "../Resources/SpriteTrim.txt");
+		}
+		if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+			targetFps = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--headless") == 0) {
+			headless = true;
+		}
+		if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+			headlessTicks = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			headlessSeed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+		}
+		if (strcmp(argv[i], "--matches") == 0 && i + 1 < argc) {
+			matchCount = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+			threadCount = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+			jobWorkers = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--no-render-thread") == 0) {
+			useRenderThread = false;
+		}
+		if (strcmp(argv[i], "--overdraw") == 0) {
+			RenderPacket::SetOverdrawView(true);
+		}
+		if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+			GSPlay::SetRecordDirectory(argv[++i]);
+		}
+		if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+			replays.push_back(argv[++i]);
+		}
+		if (strcmp(argv[i], "--bench-replays") == 0) {
+			benchReplays = true;
+			while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+				replays.push_back(argv[++i]);
+			}
+		}
+		if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+			replayRepeats = atoi(argv[++i]);
+		}
+		if (strcmp(argv[i], "--bench-snapshot") == 0) {
+			benchSnapshot = true;
+		}
+	}
+
+	JobSystem::Instance().Start(jobWorkers);
+
+	if (!replays.empty()) {
+		int result = benchReplays
+			? HeadlessRunner::RunReplayBenchmark(replays, replayRepeats)
+			: HeadlessRunner::Replay(replays[0]);
+		JobSystem::Instance().Stop();
+		MemoryManager::GetInstance()->SanityCheck();
+		return result;
+	}
+
+	if (benchSnapshot) {
+		int result = HeadlessRunner::RunSnapshotBenchmark(headlessTicks, headlessSeed);
+		JobSystem::Instance().Stop();
+		MemoryManager::GetInstance()->SanityCheck();
+		return result;
+	}
+
+	if (headless) {
+		int result = matchCount > 0
+			? HeadlessRunner::RunMatches(matchCount, threadCount, headlessTicks, headlessSeed)
+			: HeadlessRunner::Run(headlessTicks, headlessSeed);
+		JobSystem::Instance().Stop();
+		MemoryManager::GetInstance()->SanityCheck();
+		return result;
+	}
+
 	ESContext esContext;
 
 	esInitContext ( &esContext );
 
     const char* baseTitle = "New Training Framework - 2D Engine";
     const char* title = Globals::fullscreenScale ? "New Training Framework - 2D Engine [FS]" : baseTitle;
-    esCreateWindow ( &esContext, title, Globals::screenWidth, Globals::screenHeight, ES_WINDOW_RGB);
+    if ( !esCreateWindow ( &esContext, title, Globals::screenWidth, Globals::screenHeight, ES_WINDOW_RGB | ES_WINDOW_DEPTH) )
+		return 0;
 
 	if ( Init ( &esContext ) != 0 )
 		return 0;
@@ -183,13 +348,25 @@ int _tmain(int argc, _TCHAR* argv[])
 	esRegisterKeyFunc ( &esContext, Key);
 	esRegisterMouseFunc ( &esContext, MouseClick );
 	esRegisterMouseMoveFunc ( &esContext, OnMouseMove );
+	esRegisterIdleFunc ( &esContext, IsIdle );
+	esRegisterResizeFunc ( &esContext, Resize );
+	esRegisterShutdownFunc ( &esContext, Shutdown );
+	Resize ( &esContext, esContext.width, esContext.height );
+
+	esSetSwapInterval ( &esContext, Globals::swapInterval );
+	esSetFrameRate ( &esContext, (float)targetFps, (float)Globals::idleFrameRate );
+
+	if ( useRenderThread )
+		RenderThread::Instance().Start ( &esContext );
 
 	esMainLoop ( &esContext );
 
 	CleanUp();
 
 	MemoryManager::GetInstance()->SanityCheck();
+#ifdef _WIN32
 	_getch();
+#endif
 
 	return 0;
 }
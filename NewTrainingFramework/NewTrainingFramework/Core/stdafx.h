@@ -8,7 +8,13 @@
 #include "targetver.h"
 
 #include <stdio.h>
+#ifdef _WIN32
 #include <tchar.h>
+#else
+typedef char _TCHAR;
+#define _tmain main
+#define sscanf_s sscanf
+#endif
 #include <iostream>
 #include <string>
 #include <vector>
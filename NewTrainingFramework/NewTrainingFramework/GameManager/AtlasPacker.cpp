@@ -0,0 +1,232 @@
+#include "stdafx.h"
+#include "AtlasPacker.h"
+#include "ResourceManager.h"
+#include "../GameObject/Texture2D.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+namespace {
+    struct Source {
+        std::string filepath;
+        std::vector<int> ids;       // every RM.txt entry that loads this file
+        int width;
+        int height;
+        int page;
+        int x;
+        int y;
+        Texture2D::AlphaClass alphaClass;
+        uint64_t hash;              // of the source pixels, so LoadAtlas notices an edit
+    };
+
+    // Bottom-left skyline: the top edge of everything placed so far, as
+    // horizontal segments from left to right
+    class Skyline {
+    public:
+        Skyline(int width, int height) : m_width(width), m_height(height), m_usedWidth(0), m_usedHeight(0) {
+            m_nodes.push_back({ 0, 0, width });
+        }
+
+        bool Insert(int width, int height, int& outX, int& outY) {
+            int bestIndex = -1, bestX = 0, bestY = 0, bestTop = m_height + 1;
+            for (size_t i = 0; i < m_nodes.size(); ++i) {
+                int y;
+                if (!Fits((int)i, width, height, y)) continue;
+                if (y + height < bestTop || (y + height == bestTop && m_nodes[i].x < bestX)) {
+                    bestIndex = (int)i;
+                    bestX = m_nodes[i].x;
+                    bestY = y;
+                    bestTop = y + height;
+                }
+            }
+            if (bestIndex < 0) {
+                return false;
+            }
+
+            Node node = { bestX, bestY + height, width };
+            m_nodes.insert(m_nodes.begin() + bestIndex, node);
+            for (size_t i = bestIndex + 1; i < m_nodes.size();) {
+                const int covered = node.x + node.width - m_nodes[i].x;
+                if (covered <= 0) break;
+                if (covered >= m_nodes[i].width) {
+                    m_nodes.erase(m_nodes.begin() + i);
+                } else {
+                    m_nodes[i].x += covered;
+                    m_nodes[i].width -= covered;
+                    break;
+                }
+            }
+            for (size_t i = 0; i + 1 < m_nodes.size();) {
+                if (m_nodes[i].y == m_nodes[i + 1].y) {
+                    m_nodes[i].width += m_nodes[i + 1].width;
+                    m_nodes.erase(m_nodes.begin() + i + 1);
+                } else {
+                    ++i;
+                }
+            }
+
+            m_usedWidth = std::max(m_usedWidth, bestX + width);
+            m_usedHeight = std::max(m_usedHeight, bestY + height);
+            outX = bestX;
+            outY = bestY;
+            return true;
+        }
+
+        int UsedWidth() const { return m_usedWidth; }
+        int UsedHeight() const { return m_usedHeight; }
+
+    private:
+        struct Node {
+            int x;
+            int y;
+            int width;
+        };
+
+        // Lowest y a rectangle can sit at with its left edge on node index
+        bool Fits(int index, int width, int height, int& outY) const {
+            if (m_nodes[index].x + width > m_width) return false;
+            int y = 0, remaining = width;
+            for (size_t i = index; remaining > 0 && i < m_nodes.size(); ++i) {
+                y = std::max(y, m_nodes[i].y);
+                if (y + height > m_height) return false;
+                remaining -= m_nodes[i].width;
+            }
+            outY = y;
+            return true;
+        }
+
+        std::vector<Node> m_nodes;
+        int m_width;
+        int m_height;
+        int m_usedWidth;
+        int m_usedHeight;
+    };
+
+    int RoundUpPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+int AtlasPacker::Run(const std::string& rmPath, const std::string& outputDir) {
+    esSetHeadless(GL_TRUE);
+    ResourceManager* resources = ResourceManager::GetInstance();
+    if (!resources->LoadFromFile(rmPath)) {
+        std::cout << "[AtlasPacker] failed to load " << rmPath << std::endl;
+        ResourceManager::DestroyInstance();
+        return 1;
+    }
+
+    std::vector<Source> sources;
+    std::map<std::string, int> byPath;
+    for (const TextureData& data : resources->GetTextures()) {
+        const Texture2D* texture = data.texture.get();
+        const bool small = texture->GetWidth() <= MAX_SIDE && texture->GetHeight() <= MAX_SIDE;
+        const bool rgb = texture->GetChannels() == 24 || texture->GetChannels() == 32;
+        if (!small || !rgb || data.tiling != "GL_CLAMP_TO_EDGE" || data.spriteWidth > 0 || !data.arrayName.empty()) {
+            continue;
+        }
+        auto found = byPath.find(data.filepath);
+        if (found != byPath.end()) {
+            sources[found->second].ids.push_back(data.id);
+            continue;
+        }
+        byPath[data.filepath] = (int)sources.size();
+        sources.push_back({ data.filepath, { data.id }, texture->GetWidth(), texture->GetHeight(), -1, 0, 0,
+                           Texture2D::ALPHA_TRANSLUCENT, 0 });
+    }
+    ResourceManager::DestroyInstance();
+
+    std::vector<int> order(sources.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+    std::stable_sort(order.begin(), order.end(), [&sources](int a, int b) {
+        if (sources[a].height != sources[b].height) return sources[a].height > sources[b].height;
+        return sources[a].width > sources[b].width;
+    });
+
+    std::vector<Skyline> pages;
+    for (int index : order) {
+        Source& source = sources[index];
+        const int width = source.width + 2 * PADDING;
+        const int height = source.height + 2 * PADDING;
+        for (size_t p = 0; p <= pages.size() && source.page < 0; ++p) {
+            if (p == pages.size()) pages.push_back(Skyline(PAGE_SIZE, PAGE_SIZE));
+            int x, y;
+            if (pages[p].Insert(width, height, x, y)) {
+                source.page = (int)p;
+                source.x = x + PADDING;
+                source.y = y + PADDING;
+            }
+        }
+    }
+
+    // Each page is trimmed to the power of two around what it holds
+    std::vector<std::vector<uint32_t>> pixels(pages.size());
+    std::vector<int> pageWidth(pages.size()), pageHeight(pages.size());
+    for (size_t p = 0; p < pages.size(); ++p) {
+        pageWidth[p] = RoundUpPowerOfTwo(pages[p].UsedWidth());
+        pageHeight[p] = RoundUpPowerOfTwo(pages[p].UsedHeight());
+        pixels[p].assign((size_t)pageWidth[p] * pageHeight[p], 0u);
+    }
+
+    for (Source& source : sources) {
+        int width, height, bpp;
+        char* data = LoadTGA(source.filepath.c_str(), &width, &height, &bpp);
+        if (!data) {
+            std::cout << "[AtlasPacker] cannot read " << source.filepath << std::endl;
+            return 1;
+        }
+        source.alphaClass = Texture2D::ClassifyAlpha((const unsigned char*)data, width, height, bpp);
+        source.hash = Texture2D::HashPixels((const unsigned char*)data, width, height, bpp);
+        const int stride = bpp / 8;
+        uint32_t* page = pixels[source.page].data();
+        const int pw = pageWidth[source.page];
+        // The padding repeats the edge texels, so filtering at the border
+        // never reaches a neighbour
+        for (int y = -PADDING; y < height + PADDING; ++y) {
+            const int sy = std::min(std::max(y, 0), height - 1);
+            for (int x = -PADDING; x < width + PADDING; ++x) {
+                const int sx = std::min(std::max(x, 0), width - 1);
+                const unsigned char* src = (const unsigned char*)data + ((size_t)sy * width + sx) * stride;
+                unsigned char* dst = (unsigned char*)&page[(size_t)(source.y + y) * pw + source.x + x];
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = stride == 4 ? src[3] : 255;
+            }
+        }
+        delete[] data;
+    }
+
+    std::ofstream manifest(outputDir + "Atlas.txt");
+    if (!manifest.is_open()) {
+        std::cout << "[AtlasPacker] cannot write " << outputDir << "Atlas.txt" << std::endl;
+        return 1;
+    }
+    manifest << "# Written by --pack-atlas from " << rmPath << "; rerun it after changing a packed texture\n";
+    manifest << "# PAGE <index> \"<file>\"\n";
+    manifest << "# TEXTURE <id> <page> <x> <y> <width> <height> <opaque|cutout|translucent> <pixel hash> \"<source file>\"\n";
+    for (size_t p = 0; p < pages.size(); ++p) {
+        const std::string path = outputDir + "Atlas_" + std::to_string(p) + ".tga";
+        if (!SaveTGA(path.c_str(), pageWidth[p], pageHeight[p], (const char*)pixels[p].data())) {
+            std::cout << "[AtlasPacker] cannot write " << path << std::endl;
+            return 1;
+        }
+        manifest << "PAGE " << p << " \"" << path << "\"\n";
+        std::cout << "[AtlasPacker] " << path << ": " << pageWidth[p] << "x" << pageHeight[p] << std::endl;
+    }
+    for (const Source& source : sources) {
+        for (int id : source.ids) {
+            manifest << "TEXTURE " << id << " " << source.page << " " << source.x << " " << source.y << " "
+                     << source.width << " " << source.height << " " << Texture2D::GetAlphaClassName(source.alphaClass)
+                     << " " << std::hex << std::setw(16) << std::setfill('0') << source.hash << std::dec
+                     << " \"" << source.filepath << "\"\n";
+        }
+    }
+    std::cout << "[AtlasPacker] " << sources.size() << " textures in " << pages.size() << " pages" << std::endl;
+    return 0;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+
+// Offline step behind --pack-atlas. Copies the small clamped textures listed in
+// RM.txt into a few atlas pages and writes the manifest that
+// ResourceManager::LoadAtlas reads at startup. Sprite sheets, tiled textures
+// and ARRAY members keep their own storage. Rerun after changing a packed image.
+class AtlasPacker {
+public:
+    static const int PAGE_SIZE = 1024;
+    static const int MAX_SIDE = 256;    // larger textures are not worth a slot
+    static const int PADDING = 2;       // border around each texture, filled with its edge texels
+
+    // 0 on success; the pages and Atlas.txt go into outputDir
+    static int Run(const std::string& rmPath, const std::string& outputDir);
+};
@@ -0,0 +1,156 @@
+#include "stdafx.h"
+#include "FrameGraph.h"
+#include "JobSystem.h"
+#include "MatchContext.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+
+FrameGraph::FrameGraph()
+    : m_pendingCapacity(0), m_remaining(0), m_context(nullptr), m_originMs(0.0), m_wallMs(0.0) {
+}
+
+void FrameGraph::Reset() {
+    m_jobs.clear();
+    m_wallMs = 0.0;
+}
+
+int FrameGraph::Add(const char* name, std::function<void()> func, ResourceMask reads, ResourceMask writes) {
+    const int index = (int)m_jobs.size();
+    Job job;
+    job.name = name;
+    job.func = std::move(func);
+    job.reads = reads;
+    job.writes = writes;
+    job.dependencyCount = 0;
+    job.thread = -1;
+    job.startMs = job.endMs = 0.0;
+    for (int i = 0; i < index; ++i) {
+        Job& earlier = m_jobs[i];
+        if ((earlier.writes & (reads | writes)) || (earlier.reads & writes)) {
+            earlier.successors.push_back(index);
+            ++job.dependencyCount;
+        }
+    }
+    m_jobs.push_back(std::move(job));
+    return index;
+}
+
+double FrameGraph::NowMs() const {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameGraph::RunTask(void* owner, int index) {
+    static_cast<FrameGraph*>(owner)->Execute(index);
+}
+
+void FrameGraph::Execute(int index) {
+    Job& job = m_jobs[index];
+    {
+        MatchContext::Scope bind(*m_context);
+        job.thread = JobSystem::CurrentThreadIndex();
+        job.startMs = NowMs() - m_originMs;
+        job.func();
+        job.endMs = NowMs() - m_originMs;
+    }
+
+    JobSystem& jobs = JobSystem::Instance();
+    for (int next : job.successors) {
+        if (--m_pending[next] == 0) {
+            jobs.Push({ &FrameGraph::RunTask, this, next });
+        }
+    }
+    --m_remaining;
+}
+
+void FrameGraph::Run() {
+    const int count = Size();
+    if (count == 0) return;
+    m_context = &MatchContext::Current();
+    m_originMs = NowMs();
+
+    JobSystem& jobs = JobSystem::Instance();
+    if (jobs.GetWorkerCount() == 0) {
+        // No pool: declaration order already satisfies every dependency
+        for (int i = 0; i < count; ++i) {
+            Job& job = m_jobs[i];
+            job.thread = 0;
+            job.startMs = NowMs() - m_originMs;
+            job.func();
+            job.endMs = NowMs() - m_originMs;
+        }
+        m_wallMs = NowMs() - m_originMs;
+        return;
+    }
+
+    if (m_pendingCapacity < count) {
+        m_pending.reset(new std::atomic<int>[count]);
+        m_pendingCapacity = count;
+    }
+    for (int i = 0; i < count; ++i) {
+        m_pending[i] = m_jobs[i].dependencyCount;
+    }
+    m_remaining = count;
+    for (int i = 0; i < count; ++i) {
+        if (m_jobs[i].dependencyCount == 0) {
+            jobs.Push({ &FrameGraph::RunTask, this, i });
+        }
+    }
+    while (m_remaining.load() > 0) {
+        if (!jobs.RunOne()) {
+            std::this_thread::yield();
+        }
+    }
+    m_wallMs = NowMs() - m_originMs;
+}
+
+void FrameGraph::Dump(std::ostream& out) const {
+    const int count = Size();
+    std::vector<double> finish(count, 0.0);
+    std::vector<std::vector<int>> predecessors(count);
+    double workMs = 0.0, criticalMs = 0.0;
+    int maxThread = 0;
+    for (int i = 0; i < count; ++i) {
+        const Job& job = m_jobs[i];
+        const double duration = job.endMs - job.startMs;
+        workMs += duration;
+        finish[i] += duration;
+        criticalMs = std::max(criticalMs, finish[i]);
+        maxThread = std::max(maxThread, job.thread);
+        for (int next : job.successors) {
+            finish[next] = std::max(finish[next], finish[i]);
+            predecessors[next].push_back(i);
+        }
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "[FrameGraph] " << count << " jobs on " << maxThread + 1 << " thread(s), wall " << m_wallMs
+        << " ms, work " << workMs << " ms, parallelism " << (m_wallMs > 0.0 ? workMs / m_wallMs : 0.0)
+        << "x, critical path " << criticalMs << " ms" << std::endl;
+    for (int i = 0; i < count; ++i) {
+        const Job& job = m_jobs[i];
+        out << "  " << std::left << std::setw(16) << job.name << std::right
+            << " t" << job.thread << "  " << std::setw(8) << job.startMs << " .. " << std::setw(8) << job.endMs << "  after:";
+        if (predecessors[i].empty()) out << " -";
+        for (int p : predecessors[i]) out << " " << m_jobs[p].name;
+        out << std::endl;
+    }
+
+    // One lane per thread, each job drawn with the first letter of its name
+    const int columns = 60;
+    for (int t = 0; t <= maxThread; ++t) {
+        std::string lane(columns, '.');
+        for (const Job& job : m_jobs) {
+            if (job.thread != t || m_wallMs <= 0.0) continue;
+            int from = (int)(job.startMs / m_wallMs * columns);
+            int to = std::max(from + 1, (int)(job.endMs / m_wallMs * columns));
+            for (int c = std::max(from, 0); c < std::min(to, columns); ++c) lane[c] = job.name[0];
+        }
+        out << "  t" << t << " |" << lane << "|" << std::endl;
+    }
+    out << std::defaultfloat;
+}
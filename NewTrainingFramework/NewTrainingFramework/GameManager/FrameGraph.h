@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <atomic>
+#include <vector>
+
+class MatchContext;
+
+// Per-tick dependency graph of jobs. Each job declares the resources it reads
+// and writes as bit masks; Add() orders it after every earlier job it conflicts
+// with (read-after-write, write-after-read, write-after-write), so the result is
+// the same as running the jobs one by one in the order they were added. Jobs
+// run on the JobSystem with the adding thread's MatchContext bound.
+class FrameGraph {
+public:
+    typedef uint32_t ResourceMask;
+
+    FrameGraph();
+
+    void Reset();
+    int Add(const char* name, std::function<void()> func, ResourceMask reads, ResourceMask writes);
+    // Blocks until every job has finished; the calling thread runs jobs too
+    void Run();
+
+    int Size() const { return (int)m_jobs.size(); }
+    // Per-job thread and timing of the last Run() plus work, span and critical path
+    void Dump(std::ostream& out) const;
+
+private:
+    struct Job {
+        const char* name;
+        std::function<void()> func;
+        ResourceMask reads;
+        ResourceMask writes;
+        std::vector<int> successors;
+        int dependencyCount;
+        int thread;
+        double startMs;
+        double endMs;
+    };
+
+    static void RunTask(void* owner, int index);
+    void Execute(int index);
+    double NowMs() const;
+
+    std::vector<Job> m_jobs;
+    std::unique_ptr<std::atomic<int>[]> m_pending;
+    int m_pendingCapacity;
+    std::atomic<int> m_remaining;
+    MatchContext* m_context;
+    double m_originMs;
+    double m_wallMs;
+};
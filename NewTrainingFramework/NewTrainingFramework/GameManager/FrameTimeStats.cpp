@@ -0,0 +1,41 @@
+#include "stdafx.h"
+#include "FrameTimeStats.h"
+#include <algorithm>
+#include <ostream>
+
+namespace {
+
+double SortedPercentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+}
+
+double FrameTimeStats::Total() const {
+    double total = 0.0;
+    for (double ms : m_samples) total += ms;
+    return total;
+}
+
+double FrameTimeStats::Percentile(double p) const {
+    std::vector<double> sorted(m_samples);
+    std::sort(sorted.begin(), sorted.end());
+    return SortedPercentile(sorted, p);
+}
+
+void FrameTimeStats::Print(std::ostream& out, const char* label) const {
+    out << "  " << label << ": ";
+    if (m_samples.empty()) {
+        out << "no samples" << std::endl;
+        return;
+    }
+    std::vector<double> sorted(m_samples);
+    std::sort(sorted.begin(), sorted.end());
+    out << sorted.size() << " samples, mean " << Total() / sorted.size()
+        << " ms, p50 " << SortedPercentile(sorted, 0.50)
+        << ", p95 " << SortedPercentile(sorted, 0.95)
+        << ", p99 " << SortedPercentile(sorted, 0.99)
+        << ", max " << sorted.back() << " ms" << std::endl;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <iosfwd>
+#include <vector>
+
+// Duration samples in milliseconds (frames, ticks, submissions) and their
+// distribution. Not synchronized: each thread records into its own instance.
+class FrameTimeStats {
+public:
+    void Reserve(int count) { m_samples.reserve(count > 0 ? count : 0); }
+    void Clear() { m_samples.clear(); }
+    void Add(double ms) { m_samples.push_back(ms); }
+
+    int Count() const { return (int)m_samples.size(); }
+    double Total() const;
+    // Nearest-rank percentile, p in [0, 1]; 0 when empty
+    double Percentile(double p) const;
+
+    // One line: count, mean, p50, p95, p99 and max
+    void Print(std::ostream& out, const char* label) const;
+
+private:
+    std::vector<double> m_samples;
+};
@@ -12,7 +12,6 @@
 #include <SDL_mixer.h>
 #include "SoundManager.h"
 #include <algorithm>
-#include <windows.h>
 
 #ifndef MIX_MAX_VOLUME
 #define MIX_MAX_VOLUME 128
@@ -68,6 +67,10 @@ void GSMenu::Update(float deltaTime) {
     
 }
 
+bool GSMenu::IsIdle() const {
+    return SceneManager::GetInstance()->GetBehaviors().GetCount() == 0;
+}
+
 void GSMenu::Draw() {
     SceneManager::GetInstance()->Draw();
 }
@@ -280,12 +283,7 @@ void GSMenu::HandleMouseEvent(int x, int y, bool bIsPressed) {
                 } else if (id == BUTTON_ID_EXIT) {
                     SoundManager::Instance().PlaySFXByID(33, 0);
                     Cleanup();
-                    HWND hwnd = GetActiveWindow();
-                    if (hwnd) {
-                        PostMessage(hwnd, WM_CLOSE, 0, 0);
-                    } else {
-                        exit(0);
-                    }
+                    esQuit();
                 }
                 break;
             }
@@ -62,6 +62,7 @@ public:
     void Init() override;
     void Update(float deltaTime) override;
     void Draw() override;
+    bool IsIdle() const override;
     void HandleKeyEvent(unsigned char key, bool bIsPressed) override;
     void HandleMouseEvent(int x, int y, bool bIsPressed) override;
     void HandleMouseMove(int x, int y) override;
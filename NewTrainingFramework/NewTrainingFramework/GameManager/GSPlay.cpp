@@ -10,7 +10,9 @@
 #include <random>
 #include "../GameObject/Object.h"
 #include "../GameObject/Texture2D.h"
+#include "../GameObject/GlyphAtlas.h"
 #include "../GameObject/Camera.h"
+#include "../GameObject/RenderPacket.h"
 #include <memory>
 #include "../GameObject/AnimationManager.h"
 #include "../GameObject/Character.h"
@@ -22,6 +24,9 @@
 #include <sstream>
 #include <SDL_ttf.h>
 #include "SoundManager.h"
+#include "SimulationClock.h"
+#include "MatchContext.h"
+#include "Snapshot.h"
 
 
 
@@ -40,15 +45,26 @@ namespace {
     HurtboxPreset P2_HURTBOX_CROUCH    { 0.07f, 0.09f,  -0.0f, -0.053f };
 }
 
-static Character m_player;
-static Character m_player2;
-static InputManager* m_inputManager = nullptr;
-
 bool GSPlay::s_showHitboxHurtbox = false;
 bool GSPlay::s_showPlatformBoxes = false;
 bool GSPlay::s_showWallBoxes = false;
 bool GSPlay::s_showLadderBoxes = false;
 bool GSPlay::s_showTeleportBoxes = false;
+std::string GSPlay::s_recordDirectory;
+
+// End and pause screen strings are rendered whole, once when those screens open;
+// the in-match HUD draws from the glyph atlas instead. Headless gets no font.
+static TTF_Font* OpenHudFont(int pointSize) {
+    if (esIsHeadless()) return nullptr;
+    if (TTF_WasInit() == 0) {
+        TTF_Init();
+    }
+    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", pointSize);
+    if (!font) {
+        std::cout << "Failed to load HUD font: " << TTF_GetError() << std::endl;
+    }
+    return font;
+}
 
 static void ToggleSpecialForm_Internal(Character& character, int specialTexId) {
     if (specialTexId < 0) return;
@@ -197,7 +213,7 @@ int GSPlay::ChooseRandomAvailableItemId() {
     if (pool.empty()) return -1;
     int total = 0;
     for (const auto& c : pool) total += c.weight;
-    static std::mt19937 rng{ std::random_device{}() };
+    std::mt19937& rng = MatchContext::Current().GetRng(MatchContext::RNG_ITEMS);
     std::uniform_int_distribution<int> dist(0, total - 1);
     int r = dist(rng);
     for (const auto& c : pool) {
@@ -219,16 +235,7 @@ bool GSPlay::SpawnItemIntoSlot(int slotIndex, int itemId) {
             scene->RemoveObject(otherId);
         }
     }
-    Object* obj = scene->CreateObject(objectId);
-    if (!obj) return false;
-
-    const ItemTemplate& t = it->second;
-    obj->SetModel(t.modelId);
-    for (int i = 0; i < (int)t.textureIds.size(); ++i) obj->SetTexture(t.textureIds[i], i);
-    obj->SetShader(1);
-    obj->SetScale(t.scale);
-    obj->SetPosition(m_spawnSlots[slotIndex].pos);
-    obj->SetVisible(true);
+    if (!CreateItemObject(slotIndex, itemId)) return false;
 
     m_spawnSlots[slotIndex].currentId = objectId;
     m_spawnSlots[slotIndex].typeId = itemId;
@@ -240,6 +247,22 @@ bool GSPlay::SpawnItemIntoSlot(int slotIndex, int itemId) {
     return true;
 }
 
+Object* GSPlay::CreateItemObject(int slotIndex, int itemId) {
+    auto it = m_itemTemplates.find(itemId);
+    if (it == m_itemTemplates.end()) return nullptr;
+    Object* obj = SceneManager::GetInstance()->CreateObject(itemId * 100 + slotIndex);
+    if (!obj) return nullptr;
+
+    const ItemTemplate& t = it->second;
+    obj->SetModel(t.modelId);
+    for (int i = 0; i < (int)t.textureIds.size(); ++i) obj->SetTexture(t.textureIds[i], i);
+    obj->SetShader(1);
+    obj->SetScale(t.scale);
+    obj->SetPosition(m_spawnSlots[slotIndex].pos);
+    obj->SetVisible(true);
+    return obj;
+}
+
 void GSPlay::MarkSlotPickedByObjectId(int itemId) {
     auto it = m_objectIdToSlot.find(itemId);
     if (it == m_objectIdToSlot.end()) return;
@@ -365,15 +388,17 @@ bool GSPlay_IsShowPlatformBoxes() {
 }
 
 GSPlay::GSPlay() 
-    : GameStateBase(StateType::PLAY), m_gameTime(0.0f), m_player1Health(100.0f), m_player2Health(100.0f), m_cloudSpeed(0.5f), m_p1Respawned(false), m_p2Respawned(false), m_isPaused(false) {
+    : GameStateBase(StateType::PLAY), m_gameTime(0.0f), m_inputManager(nullptr), m_player1Health(100.0f), m_player2Health(100.0f), m_p1Respawned(false), m_p2Respawned(false), m_isPaused(false) {
 }
 
 GSPlay::~GSPlay() {
 }
 
 void GSPlay::Init() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (!esIsHeadless()) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
     SoundManager::Instance().PlayMusicByID(22, -1);
     
     ResourceManager* resourceManager = ResourceManager::GetInstance();
@@ -424,22 +449,20 @@ void GSPlay::Init() {
     m_gameEnded = false;
 
     m_inputManager = InputManager::GetInstance();
+    m_matchTick = 0;
+    {
+        const uint32_t seed = MatchContext::Current().BeginMatch();
+        m_recordingActive = !s_recordDirectory.empty();
+        if (m_recordingActive) {
+            m_recording.Begin(seed, SimulationClock::Instance().GetTick(), m_inputManager->GetQueuedTotal());
+        }
+    }
+    m_bullets.Reserve(MAX_BULLETS);
     m_prevJumpingP1 = false;
     m_prevJumpingP2 = false;
 
-    m_animManager = std::make_shared<AnimationManager>();
-    
-    const TextureData* textureData = ResourceManager::GetInstance()->GetTextureData(10);
-    if (textureData && textureData->spriteWidth > 0 && textureData->spriteHeight > 0) {
-        std::vector<AnimationData> animations;
-        for (const auto& anim : textureData->animations) {
-            animations.push_back({anim.startFrame, anim.numFrames, anim.duration, 0.0f});
-        }
-        m_animManager->Initialize(textureData->spriteWidth, textureData->spriteHeight, animations);
-    } else {
-    }
-    
-    m_player.Initialize(m_animManager, 1000);
+
+    m_player.Initialize(10, 1000);
     m_player.SetInputConfig(CharacterMovement::PLAYER1_INPUT);
     m_player.ResetHealth();
     // Apply Player 1 hurtbox presets
@@ -447,20 +470,8 @@ void GSPlay::Init() {
     m_player.SetHurtboxFacingLeft(P1_HURTBOX_FACE_LEFT.w,  P1_HURTBOX_FACE_LEFT.h,  P1_HURTBOX_FACE_LEFT.ox,  P1_HURTBOX_FACE_LEFT.oy);
     m_player.SetHurtboxFacingRight(P1_HURTBOX_FACE_RIGHT.w, P1_HURTBOX_FACE_RIGHT.h, P1_HURTBOX_FACE_RIGHT.ox, P1_HURTBOX_FACE_RIGHT.oy);
     m_player.SetHurtboxCrouchRoll(P1_HURTBOX_CROUCH.w,     P1_HURTBOX_CROUCH.h,     P1_HURTBOX_CROUCH.ox,     P1_HURTBOX_CROUCH.oy);
-    
-    auto animManager2 = std::make_shared<AnimationManager>();
-    
-    const TextureData* textureData2 = ResourceManager::GetInstance()->GetTextureData(11);
-    if (textureData2 && textureData2->spriteWidth > 0 && textureData2->spriteHeight > 0) {
-        std::vector<AnimationData> animations2;
-        for (const auto& anim : textureData2->animations) {
-            animations2.push_back({anim.startFrame, anim.numFrames, anim.duration, 0.0f});
-        }
-        animManager2->Initialize(textureData2->spriteWidth, textureData2->spriteHeight, animations2);
-    } else {
-    }
-    
-    m_player2.Initialize(animManager2, 1001);
+
+    m_player2.Initialize(11, 1001);
     m_player2.SetInputConfig(CharacterMovement::PLAYER2_INPUT);
     m_player2.ResetHealth();
     // Apply Player 2 hurtbox presets
@@ -561,17 +572,10 @@ void GSPlay::Init() {
     m_player.GetMovement()->SetCharacterSize(0.16f, 0.24f);
     m_player2.GetMovement()->SetCharacterSize(0.16f, 0.24f);
     
-    // Setup lift platform (Object ID 30)
-    Object* liftPlatform = sceneManager->GetObject(30);
-    if (liftPlatform) {
-        liftPlatform->SetLiftPlatform(true, 
-            1.375005f, -1.301985f, 0.0f,  // Start position
-            1.375005f, 0.217009f, 0.0f,   // End position
-            0.2f, 1.0f);          // Speed: 0.2 units/sec, Pause time: 1.0 second
-
+    SetupSceneBehaviors();
+    if (sceneManager->GetObject(30)) {
         m_player.GetMovement()->AddMovingPlatformById(30);
         m_player2.GetMovement()->AddMovingPlatformById(30);
-    } else {
     }
     
     m_isAxeAvailable   = (sceneManager->GetObject(AXE_OBJECT_ID)   != nullptr);
@@ -648,71 +652,43 @@ void GSPlay::Init() {
     if (Object* explProto = SceneManager::GetInstance()->GetObject(m_explosionObjectId)) {
         explProto->SetVisible(false);
     }
+    InitObjectPools();
     UpdateHudWeapons();
 
-    {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
+    // HUD text is presentation only; headless matches get no atlas and skip it
+    m_hudGlyphs = GlyphAtlas::Get(HUD_FONT_SIZE);
+    if (m_hudGlyphs) {
+        SceneManager* scene = SceneManager::GetInstance();
+        // Ammo and bomb counters pick their digit through per-object UVs
+        for (int id = 924; id <= 931; ++id) {
+            if (Object* digit = scene->GetObject(id)) digit->MakeModelInstanceCopy();
         }
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-        if (!font) {
-            std::cout << "Failed to load font for HUD digits: " << TTF_GetError() << std::endl;
-        } else {
-            TTF_SetFontHinting(font, TTF_HINTING_NONE);
-            TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
-            auto makeTextTexture = [&](const char* text) -> std::shared_ptr<Texture2D> {
-                SDL_Color color = {255, 255, 255, 255};
-                SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, color);
-                if (!surf) { return nullptr; }
-                std::shared_ptr<Texture2D> tex = std::make_shared<Texture2D>();
-                if (!tex->LoadFromSDLSurface(surf)) {
-                    SDL_FreeSurface(surf);
-                    return nullptr;
-                }
-                SDL_FreeSurface(surf);
-                tex->SetSharpFiltering();
-                return tex;
-            };
-
-            SceneManager* scene = SceneManager::GetInstance();
-            auto setTwoDigits = [&](int value, int leftId, int rightId){
-                if (value < 0) value = 0;
-                if (value > 99) value = 99;
-                int left = (value / 10) % 10;
-                int right = value % 10;
-                char lbuf[2] = {(char)('0' + left), '\0'};
-                char rbuf[2] = {(char)('0' + right), '\0'};
-                if (Object* L = scene->GetObject(leftId))  { if (auto t = makeTextTexture(lbuf)) L->SetDynamicTexture(t); }
-                if (Object* R = scene->GetObject(rightId)) { if (auto t = makeTextTexture(rbuf)) R->SetDynamicTexture(t); }
-            };
-
-            auto setDigitsVisible = [&](bool isP1, bool visible){
-                int leftId  = isP1 ? 924 : 926;
-                int rightId = isP1 ? 925 : 927;
-                if (Object* L = scene->GetObject(leftId))  { if (!visible) L->SetScale(0.0f, 0.0f, 1.0f); }
-                if (Object* R = scene->GetObject(rightId)) { if (!visible) R->SetScale(0.0f, 0.0f, 1.0f); }
-            };
-            setDigitsVisible(true,  m_player1GunTexId >= 0);
-            setDigitsVisible(false, m_player2GunTexId >= 0);
-            UpdateHudAmmoDigits();
-
-            auto setBombDigitsVisible = [&](bool isP1, bool visible){
-                int leftId  = isP1 ? 928 : 930;
-                int rightId = isP1 ? 929 : 931;
-                if (Object* L = scene->GetObject(leftId))  { if (!visible) L->SetScale(0.0f, 0.0f, 1.0f); }
-                if (Object* R = scene->GetObject(rightId)) { if (!visible) R->SetScale(0.0f, 0.0f, 1.0f); }
-            };
-            setBombDigitsVisible(true,  m_p1Bombs > 0);
-            setBombDigitsVisible(false, m_p2Bombs > 0);
-            if (Object* bombIcon1 = scene->GetObject(922)) m_hudBombIcon1BaseScale = bombIcon1->GetScale();
-            if (Object* bombIcon2 = scene->GetObject(923)) m_hudBombIcon2BaseScale = bombIcon2->GetScale();
-            UpdateHudBombDigits();
 
-            TTF_CloseFont(font);
-        }
+        auto setDigitsVisible = [&](bool isP1, bool visible){
+            int leftId  = isP1 ? 924 : 926;
+            int rightId = isP1 ? 925 : 927;
+            if (Object* L = scene->GetObject(leftId))  { if (!visible) L->SetScale(0.0f, 0.0f, 1.0f); }
+            if (Object* R = scene->GetObject(rightId)) { if (!visible) R->SetScale(0.0f, 0.0f, 1.0f); }
+        };
+        setDigitsVisible(true,  m_player1GunTexId >= 0);
+        setDigitsVisible(false, m_player2GunTexId >= 0);
+        UpdateHudAmmoDigits();
+
+        auto setBombDigitsVisible = [&](bool isP1, bool visible){
+            int leftId  = isP1 ? 928 : 930;
+            int rightId = isP1 ? 929 : 931;
+            if (Object* L = scene->GetObject(leftId))  { if (!visible) L->SetScale(0.0f, 0.0f, 1.0f); }
+            if (Object* R = scene->GetObject(rightId)) { if (!visible) R->SetScale(0.0f, 0.0f, 1.0f); }
+        };
+        setBombDigitsVisible(true,  m_p1Bombs > 0);
+        setBombDigitsVisible(false, m_p2Bombs > 0);
+        if (Object* bombIcon1 = scene->GetObject(922)) m_hudBombIcon1BaseScale = bombIcon1->GetScale();
+        if (Object* bombIcon2 = scene->GetObject(923)) m_hudBombIcon2BaseScale = bombIcon2->GetScale();
+        UpdateHudBombDigits();
     }
     
-    CreateAllScoreTextures();
+    CreateHudText();
+    SetupHudLayer();
     CreatePauseTextTexture();
     UpdateScoreDisplay();
     UpdateTimeDisplay();
@@ -728,35 +704,13 @@ void GSPlay::Init() {
         Vector3 player2Pos = m_player2.GetPosition();
         camera->UpdateCameraForCharacters(player1Pos, player2Pos, 0.0f);
     }
+
+    SaveSnapshot(m_matchStartSnapshot);
 }
 
 void GSPlay::UpdateHudAmmoDigits() {
-    if (TTF_WasInit() == 0) return;
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-    if (!font) { return; }
-    TTF_SetFontHinting(font, TTF_HINTING_NONE);
-    TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
-    auto makeTextTexture = [&](const char* text) -> std::shared_ptr<Texture2D> {
-        SDL_Color color = {255, 255, 255, 255};
-        SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, color);
-        if (!surf) { return nullptr; }
-        std::shared_ptr<Texture2D> tex = std::make_shared<Texture2D>();
-        if (!tex->LoadFromSDLSurface(surf)) { SDL_FreeSurface(surf); return nullptr; }
-        SDL_FreeSurface(surf);
-        tex->SetSharpFiltering();
-        return tex;
-    };
+    if (!m_hudGlyphs) { return; }
     SceneManager* scene = SceneManager::GetInstance();
-    auto setTwoDigits = [&](int value, int leftId, int rightId){
-        if (value < 0) value = 0;
-        if (value > 99) value = 99;
-        int left = (value / 10) % 10;
-        int right = value % 10;
-        char lbuf[2] = {(char)('0' + left), '\0'};
-        char rbuf[2] = {(char)('0' + right), '\0'};
-        if (Object* L = scene->GetObject(leftId))  { if (auto t = makeTextTexture(lbuf)) L->SetDynamicTexture(t); }
-        if (Object* R = scene->GetObject(rightId)) { if (auto t = makeTextTexture(rbuf)) R->SetDynamicTexture(t); }
-    };
     auto currentAmmo = [&](bool isP1)->int{
         int tex = isP1 ? m_player1GunTexId : m_player2GunTexId;
         switch (tex) {
@@ -786,9 +740,25 @@ void GSPlay::UpdateHudAmmoDigits() {
     if (m_p2HudAmmoShown <= 0) m_p2HudAmmoShown = m_p2HudAmmoTarget;
     showDigits(true,  a1 > 0 && m_player1GunTexId >= 0);
     showDigits(false, a2 > 0 && m_player2GunTexId >= 0);
-    if (m_p1HudAmmoShown > 0 && m_player1GunTexId >= 0) setTwoDigits(m_p1HudAmmoShown, 924, 925);
-    if (m_p2HudAmmoShown > 0 && m_player2GunTexId >= 0) setTwoDigits(m_p2HudAmmoShown, 926, 927);
-    TTF_CloseFont(font);
+    if (m_p1HudAmmoShown > 0 && m_player1GunTexId >= 0) SetHudTwoDigits(m_p1HudAmmoShown, 924, 925);
+    if (m_p2HudAmmoShown > 0 && m_player2GunTexId >= 0) SetHudTwoDigits(m_p2HudAmmoShown, 926, 927);
+}
+
+void GSPlay::SetHudTwoDigits(int value, int leftId, int rightId) {
+    if (value < 0) value = 0;
+    if (value > 99) value = 99;
+    const GlyphAtlas::Glyph* left = m_hudGlyphs->Find((char)('0' + (value / 10) % 10));
+    const GlyphAtlas::Glyph* right = m_hudGlyphs->Find((char)('0' + value % 10));
+    SceneManager* scene = SceneManager::GetInstance();
+    // Sprite2D UVs run bottom-left first, so v1 (glyph bottom) comes before v0
+    if (Object* L = scene->GetObject(leftId)) {
+        L->SetDynamicTexture(m_hudGlyphs->GetTexture());
+        L->SetCustomUV(left->u0, left->v1, left->u1, left->v0);
+    }
+    if (Object* R = scene->GetObject(rightId)) {
+        R->SetDynamicTexture(m_hudGlyphs->GetTexture());
+        R->SetCustomUV(right->u0, right->v1, right->u1, right->v0);
+    }
 }
 
 // Return reference to ammo counter for given gun texture and player
@@ -866,30 +836,8 @@ void GSPlay::UpdateHudAmmoAnim(float deltaTime) {
 }
 
 void GSPlay::UpdateHudBombDigits() {
-    if (TTF_WasInit() == 0) return;
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-    if (!font) return;
-    TTF_SetFontHinting(font, TTF_HINTING_NONE);
-    TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
-    auto makeTextTexture = [&](const char* text) -> std::shared_ptr<Texture2D> {
-        SDL_Color color = {255, 255, 255, 255};
-        SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, color);
-        if (!surf) return nullptr;
-        std::shared_ptr<Texture2D> tex = std::make_shared<Texture2D>();
-        if (!tex->LoadFromSDLSurface(surf)) { SDL_FreeSurface(surf); return nullptr; }
-        SDL_FreeSurface(surf);
-        tex->SetSharpFiltering();
-        return tex;
-    };
+    if (!m_hudGlyphs) return;
     SceneManager* scene = SceneManager::GetInstance();
-    auto setTwoDigits = [&](int value, int leftId, int rightId){
-        if (value < 0) value = 0; if (value > 99) value = 99;
-        int left = (value / 10) % 10; int right = value % 10;
-        char lbuf[2] = {(char)('0' + left), '\0'};
-        char rbuf[2] = {(char)('0' + right), '\0'};
-        if (Object* L = scene->GetObject(leftId))  { if (auto t = makeTextTexture(lbuf)) L->SetDynamicTexture(t); }
-        if (Object* R = scene->GetObject(rightId)) { if (auto t = makeTextTexture(rbuf)) R->SetDynamicTexture(t); }
-    };
     auto showDigits = [&](bool isP1, bool show){
         int leftId  = isP1 ? 928 : 930;
         int rightId = isP1 ? 929 : 931;
@@ -917,209 +865,93 @@ void GSPlay::UpdateHudBombDigits() {
         }
         bombIcon2->SetScale(m_p2Bombs > 0 ? base : Vector3(0.0f, 0.0f, base.z));
     }
-    if (m_p1Bombs > 0) setTwoDigits(m_p1Bombs, 928, 929);
-    if (m_p2Bombs > 0) setTwoDigits(m_p2Bombs, 930, 931);
-    TTF_CloseFont(font);
+    if (m_p1Bombs > 0) SetHudTwoDigits(m_p1Bombs, 928, 929);
+    if (m_p2Bombs > 0) SetHudTwoDigits(m_p2Bombs, 930, 931);
 }
 
-void GSPlay::CreateAllScoreTextures() {
-    if (TTF_WasInit() == 0) {
-        TTF_Init();
-    }
-    
-    TTF_Font* font32 = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 32);
-    TTF_Font* font64 = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-    
-    if (!font32 || !font64) {
-        std::cout << "Failed to load fonts for score textures: " << TTF_GetError() << std::endl;
-        if (font32) TTF_CloseFont(font32);
-        if (font64) TTF_CloseFont(font64);
-        return;
-    }
-    
-    TTF_SetFontHinting(font32, TTF_HINTING_NONE);
-    TTF_SetFontStyle(font32, TTF_STYLE_NORMAL);
-    TTF_SetFontHinting(font64, TTF_HINTING_NONE);
-    TTF_SetFontStyle(font64, TTF_STYLE_NORMAL);
-    
-    SDL_Color color = {255, 255, 255, 255};
-    
-    SDL_Surface* surf = TTF_RenderUTF8_Blended(font32, "SCORE", color);
-    if (surf) {
-        m_scoreTextTexture = std::make_shared<Texture2D>();
-        if (m_scoreTextTexture->LoadFromSDLSurface(surf)) {
-            m_scoreTextTexture->SetSharpFiltering();
-        }
-        SDL_FreeSurface(surf);
-    }
-    
-    m_scoreTextP1 = std::make_shared<Object>();
-    m_scoreTextP1->SetId(940);
-    m_scoreTextP1->SetModel(0);
-    m_scoreTextP1->SetShader(0);
-    m_scoreTextP1->SetDynamicTexture(m_scoreTextTexture);
-    m_scoreTextP1->SetPosition(Vector3(-0.846f, 0.925f, 0.0f));
-    m_scoreTextP1->SetRotation(Vector3(0.0f, 0.0f, 0.0f));
-    m_scoreTextP1->SetScale(Vector3(0.27f, 0.1f, 1.0f));
-    
-    m_scoreTextP2 = std::make_shared<Object>();
-    m_scoreTextP2->SetId(946);
-    m_scoreTextP2->SetModel(0);
-    m_scoreTextP2->SetShader(0);
-    m_scoreTextP2->SetDynamicTexture(m_scoreTextTexture);
-    m_scoreTextP2->SetPosition(Vector3(0.849f, 0.925f, 0.0f));
-    m_scoreTextP2->SetRotation(Vector3(0.0f, 0.0f, 0.0f));
-    m_scoreTextP2->SetScale(Vector3(0.27f, 0.1f, 1.0f));
-    
-    m_digitTextures.clear();
-    m_digitTextures.resize(10);
-    
-    for (int i = 0; i < 10; ++i) {
-        std::string digitStr = std::to_string(i);
-        SDL_Surface* digitSurf = TTF_RenderUTF8_Blended(font64, digitStr.c_str(), color);
-        if (digitSurf) {
-            auto texture = std::make_shared<Texture2D>();
-            if (texture->LoadFromSDLSurface(digitSurf)) {
-                texture->SetSharpFiltering();
-                m_digitTextures[i] = texture;
-            }
-            SDL_FreeSurface(digitSurf);
-        }
-    }
-    
-    SDL_Surface* digitSurf = TTF_RenderUTF8_Blended(font64, "0", color);
-    if (digitSurf) {
-        m_scoreDigitTexture = std::make_shared<Texture2D>();
-        if (m_scoreDigitTexture->LoadFromSDLSurface(digitSurf)) {
-            m_scoreDigitTexture->SetSharpFiltering();
-        }
-        SDL_FreeSurface(digitSurf);
-    }
-    
-    m_scoreDigitObjectsP1.clear();
-    std::vector<Vector3> p1Positions;
-    p1Positions.push_back(Vector3(-0.96f, 0.788f, 0.0f));  // ID 941
-    p1Positions.push_back(Vector3(-0.905f, 0.788f, 0.0f)); // ID 942
-    p1Positions.push_back(Vector3(-0.85f, 0.788f, 0.0f));  // ID 943
-    p1Positions.push_back(Vector3(-0.795f, 0.788f, 0.0f)); // ID 944
-    p1Positions.push_back(Vector3(-0.74f, 0.788f, 0.0f));  // ID 945
-    
-    for (int i = 0; i < 5; ++i) {
-        auto digitObj = std::make_shared<Object>();
-        digitObj->SetId(941 + i);
-        digitObj->SetModel(0);
-        digitObj->SetShader(0);
-        digitObj->SetDynamicTexture(m_scoreDigitTexture);
-        digitObj->SetPosition(p1Positions[i]);
-        digitObj->SetRotation(Vector3(0.0f, 0.0f, 0.0f));
-        digitObj->SetScale(Vector3(0.05f, 0.08f, 1.0f));
-        m_scoreDigitObjectsP1.push_back(digitObj);
-    }
-    
-    // Create score digit objects for Player 2
-    m_scoreDigitObjectsP2.clear();
-    std::vector<Vector3> p2Positions;
-    p2Positions.push_back(Vector3(0.74f, 0.788f, 0.0f));   // ID 947
-    p2Positions.push_back(Vector3(0.795f, 0.788f, 0.0f));  // ID 948
-    p2Positions.push_back(Vector3(0.85f, 0.788f, 0.0f));   // ID 949
-    p2Positions.push_back(Vector3(0.905f, 0.788f, 0.0f));  // ID 950
-    p2Positions.push_back(Vector3(0.96f, 0.788f, 0.0f));   // ID 951
-    
-    for (int i = 0; i < 5; ++i) {
-        auto digitObj = std::make_shared<Object>();
-        digitObj->SetId(947 + i);
-        digitObj->SetModel(0);
-        digitObj->SetShader(0);
-        digitObj->SetDynamicTexture(m_scoreDigitTexture);
-        digitObj->SetPosition(p2Positions[i]);
-        digitObj->SetRotation(Vector3(0.0f, 0.0f, 0.0f));
-        digitObj->SetScale(Vector3(0.05f, 0.08f, 1.0f));
-        m_scoreDigitObjectsP2.push_back(digitObj);
-    }
-    
-    TTF_CloseFont(font32);
-    TTF_CloseFont(font64);
-    
-    CreateTimeDigitObjects();
+void GSPlay::CreateHudText() {
+    m_hudText.Clear();
+    m_hudText.SetAtlas(m_hudGlyphs);
+
+    // "SCORE" labels; the font is monospaced, so five equal cells cover the old 0.27 x 0.1 text quad
+    const float labelWidth = 0.27f / 5.0f;
+    int label = m_hudText.GetCellCount();
+    for (int i = 0; i < 5; ++i) m_hudText.AddCell(-0.846f - 0.135f + labelWidth * (i + 0.5f), 0.925f, labelWidth, 0.1f);
+    m_hudText.SetText(label, "SCORE");
+    label = m_hudText.GetCellCount();
+    for (int i = 0; i < 5; ++i) m_hudText.AddCell(0.849f - 0.135f + labelWidth * (i + 0.5f), 0.925f, labelWidth, 0.1f);
+    m_hudText.SetText(label, "SCORE");
+
+    m_scoreCellsP1 = m_hudText.GetCellCount();
+    for (int i = 0; i < 5; ++i) m_hudText.AddCell(-0.96f + 0.055f * i, 0.788f, 0.05f, 0.08f);
+    m_scoreCellsP2 = m_hudText.GetCellCount();
+    for (int i = 0; i < 5; ++i) m_hudText.AddCell(0.74f + 0.055f * i, 0.788f, 0.05f, 0.08f);
+
+    // MM:SS, with a narrower cell for the colon
+    const float timeX[5] = { -0.105f, -0.045f, 0.0f, 0.045f, 0.105f };
+    m_timeCells = m_hudText.GetCellCount();
+    for (int i = 0; i < 5; ++i) m_hudText.AddCell(timeX[i], 0.678f, i == 2 ? 0.024f : 0.05f, 0.06f);
 }
 
-void GSPlay::CreateTimeDigitObjects() {
-    if (TTF_WasInit() == 0) {
-        TTF_Init();
-    }
-    
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-    if (!font) {
-        std::cout << "Failed to load font for time digits: " << TTF_GetError() << std::endl;
-        return;
-    }
-    
-    TTF_SetFontHinting(font, TTF_HINTING_NONE);
-    TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
-    
-    SDL_Color whiteColor = {255, 255, 255, 255};
-    SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "0", whiteColor);
-    if (surf) {
-        m_timeDigitTexture = std::make_shared<Texture2D>();
-        if (m_timeDigitTexture->LoadFromSDLSurface(surf)) {
-            m_timeDigitTexture->SetSharpFiltering();
-        }
-        SDL_FreeSurface(surf);
-    }
-    
-    SDL_Color redColor = {255, 0, 0, 255};
-    SDL_Surface* redSurf = TTF_RenderUTF8_Blended(font, "0", redColor);
-    if (redSurf) {
-        m_redTimeDigitTexture = std::make_shared<Texture2D>();
-        if (m_redTimeDigitTexture->LoadFromSDLSurface(redSurf)) {
-            m_redTimeDigitTexture->SetSharpFiltering();
-        }
-        SDL_FreeSurface(redSurf);
-    }
-    
-    m_redDigitTextures.clear();
-    m_redDigitTextures.resize(10);
-    
-    for (int i = 0; i < 10; ++i) {
-        std::string digitStr = std::to_string(i);
-        SDL_Surface* digitSurf = TTF_RenderUTF8_Blended(font, digitStr.c_str(), redColor);
-        if (digitSurf) {
-            auto texture = std::make_shared<Texture2D>();
-            if (texture->LoadFromSDLSurface(digitSurf)) {
-                texture->SetSharpFiltering();
-                m_redDigitTextures[i] = texture;
-            }
-            SDL_FreeSurface(digitSurf);
-        }
-    }
-    
-    m_timeDigitObjects.clear();
-    std::vector<Vector3> timePositions;
-    timePositions.push_back(Vector3(-0.105f, 0.678f, 0.0f));
-    timePositions.push_back(Vector3(-0.045f, 0.678f, 0.0f));
-    timePositions.push_back(Vector3(0.0f, 0.678f, 0.0f));
-    timePositions.push_back(Vector3(0.045f, 0.678f, 0.0f));
-    timePositions.push_back(Vector3(0.105f, 0.678f, 0.0f));
-    
-    for (int i = 0; i < 5; ++i) {
-        auto digitObj = std::make_shared<Object>();
-        digitObj->SetId(953 + i);
-        digitObj->SetModel(0);
-        digitObj->SetShader(0);
-        digitObj->SetDynamicTexture(m_timeDigitTexture);
-        digitObj->SetPosition(timePositions[i]);
-        digitObj->SetRotation(Vector3(0.0f, 0.0f, 0.0f));
-        
-        if (i == 2) {
-            digitObj->SetScale(Vector3(0.024f, 0.06f, 1.0f));
-        } else {
-            digitObj->SetScale(Vector3(0.05f, 0.06f, 1.0f));
-        }
-        
-        m_timeDigitObjects.push_back(digitObj);
-    }
-    
-    TTF_CloseFont(font);
+void GSPlay::SetupHudLayer() {
+    SceneManager* scene = SceneManager::GetInstance();
+    m_hud.Clear();
+    for (int id = HUD_FIRST_OBJECT_ID; id <= HUD_LAST_OBJECT_ID; ++id) {
+        // Portraits are redrawn from their character's frame by DrawHudPortraits
+        if (id == 916 || id == 917) continue;
+        m_hud.AddObject(scene->GetObject(id));
+    }
+    scene->SetDeferredIdRange(HUD_FIRST_OBJECT_ID, HUD_LAST_OBJECT_ID, [this] { DrawHud(); });
+
+    // Base width defined in scene file: 0.94
+    m_hud.AddBar(scene->GetObject(914), 0.94f, [this] { return m_player.GetHealth() / m_player.GetMaxHealth(); });
+    m_hud.AddBar(scene->GetObject(915), 0.94f, [this] { return m_player2.GetHealth() / m_player2.GetMaxHealth(); });
+    m_hud.AddBar(scene->GetObject(932), 0.94f, [this] { return m_player.GetStamina() / m_player.GetMaxStamina(); });
+    m_hud.AddBar(scene->GetObject(933), 0.94f, [this] { return m_player2.GetStamina() / m_player2.GetMaxStamina(); });
+
+    m_hud.Bind([this] {
+        return (uint64_t)m_player.GetWeapon() | (uint64_t)m_player2.GetWeapon() << 8 |
+               (uint64_t)(uint16_t)m_player1GunTexId << 16 | (uint64_t)(uint16_t)m_player2GunTexId << 32;
+    }, [this] { UpdateHudWeapons(); });
+    m_hud.Bind([this] { return (uint64_t)(uint32_t)m_p1Bombs | (uint64_t)(uint32_t)m_p2Bombs << 32; },
+               [this] { UpdateHudBombDigits(); });
+    m_hud.Bind([this] { return (uint64_t)(uint32_t)m_p1SpecialItemTexId; }, [this] { UpdateHudSpecialIcon(true); });
+    m_hud.Bind([this] { return (uint64_t)(uint32_t)m_p2SpecialItemTexId; }, [this] { UpdateHudSpecialIcon(false); });
+
+    m_hud.AddRedrawKey([this] { return HudPortraitKey(m_player); });
+    m_hud.AddRedrawKey([this] { return HudPortraitKey(m_player2); });
+    m_hud.AddRedrawKey([this] { return (uint64_t)m_hudText.GetRevision() | (uint64_t)m_gameEnded << 32; });
+}
+
+void GSPlay::DrawHud() {
+    float aspect = (float)Globals::screenWidth / (float)Globals::screenHeight;
+    Matrix uiView;
+    Matrix uiProj;
+    uiView.SetLookAt(Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+    uiProj.SetOrthographic(-aspect, aspect, -1.0f, 1.0f, 0.1f, 100.0f);
+    m_hud.Draw(uiView, uiProj, [this, &uiView, &uiProj] {
+        if (m_gameEnded) return;
+        DrawHudPortraits();
+        m_hudText.Draw(uiView, uiProj);
+    });
+}
+
+// Everything DrawHudPortraits reads from a character
+uint64_t GSPlay::HudPortraitKey(const Character& character) const {
+    StateHash hash;
+    hash.Add(character.GetBodyTextureId());
+    hash.Add(character.GetCurrentSheetFrame());
+    hash.Add(character.IsFacingLeft());
+    hash.Add(ComputeHudPortraitScale(character, Vector3(1.0f, 1.0f, 1.0f)));
+    hash.Add(ComputeHudPortraitOffset(character));
+    if (character.IsGunMode() || character.IsGrenadeMode()) {
+        hash.Add(character.GetTopSheetFrame());
+        hash.Add(character.GetHeadTextureId());
+        hash.Add(character.GetAimAngleDeg());
+        hash.Add(character.GetHeadOffsetX());
+        hash.Add(character.GetHeadOffsetY());
+    }
+    return hash.Get();
 }
 
 int GSPlay::AmmoCapacityFor(int texId) const {
@@ -1136,9 +968,16 @@ int GSPlay::AmmoCapacityFor(int texId) const {
 }
 
 void GSPlay::Update(float deltaTime) {
+    ++m_matchTick;
+    m_player.SaveRenderState();
+    m_player2.SaveRenderState();
+    if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
+        cam->SnapshotPosition();
+    }
+
     if (m_isPaused) {
         if (m_inputManager) {
-            m_inputManager->Update();
+            BeginInputTick();
         } else {
             m_inputManager = InputManager::GetInstance();
         }
@@ -1157,12 +996,12 @@ void GSPlay::Update(float deltaTime) {
     UpdateEndScreenVisibility();
     
     if (m_inputManager) {
+        BeginInputTick();
         if (!m_gameEnded) {
             HandleItemPickup();
             m_player.ProcessInput(deltaTime, m_inputManager);
             m_player2.ProcessInput(deltaTime, m_inputManager);
         }
-        m_inputManager->Update();
     } else {
         m_inputManager = InputManager::GetInstance();
     }
@@ -1172,63 +1011,6 @@ void GSPlay::Update(float deltaTime) {
         m_player2.Update(deltaTime);
     }
 
-    auto checkFireDamage = [&](Character& source, Character& target){
-        CharacterAnimation* anim = source.GetAnimation();
-        if (!anim) return;
-        if (!anim->IsOrcFireActive()) return;
-        float l, r, b, t; anim->GetOrcFireAabb(l, r, b, t);
-        {
-            const float DAMAGE_Y_SCALE = 0.7f;
-            float centerY = 0.5f * (b + t);
-            float halfH = 0.5f * (t - b) * DAMAGE_Y_SCALE;
-            b = centerY - halfH;
-            t = centerY + halfH;
-        }
-        Vector3 pos = target.GetPosition();
-        float hx = pos.x + target.GetHurtboxOffsetX();
-        float hy = pos.y + target.GetHurtboxOffsetY();
-        float halfW = target.GetHurtboxWidth() * 0.5f;
-        float halfH = target.GetHurtboxHeight() * 0.5f;
-        float tl = hx - halfW, tr = hx + halfW, tb = hy - halfH, tt = hy + halfH;
-        bool overlapX = (r >= tl) && (l <= tr);
-        bool overlapY = (t >= tb) && (b <= tt);
-        if (overlapX && overlapY) {
-            if (IsCharacterInvincible(target)) {
-                return;
-            }
-            
-            ProcessDamageAndScore(source, target, 100.0f);
-            target.CancelAllCombos();
-            if (CharacterMovement* mv = target.GetMovement()) { mv->SetInputLocked(false); }
-        }
-    };
-    checkFireDamage(m_player, m_player2);
-    checkFireDamage(m_player2, m_player);
-
-    auto checkBatWindDamage = [&](Character& source, Character& target){
-        CharacterAnimation* anim = source.GetAnimation();
-        if (!anim) return;
-        if (!anim->IsBatWindActive()) return;
-        if (anim->HasBatWindDealtDamage()) return;
-        float l, r, b, t; anim->GetBatWindAabb(l, r, b, t);
-        Vector3 pos = target.GetPosition();
-        float hx = pos.x + target.GetHurtboxOffsetX();
-        float hy = pos.y + target.GetHurtboxOffsetY();
-        float halfW = target.GetHurtboxWidth() * 0.5f;
-        float halfH = target.GetHurtboxHeight() * 0.5f;
-        float tl = hx - halfW, tr = hx + halfW, tb = hy - halfH, tt = hy + halfH;
-        bool overlapX = (r >= tl) && (l <= tr);
-        bool overlapY = (t >= tb) && (b <= tt);
-        if (overlapX && overlapY) {
-            ProcessDamageAndScore(source, target, 100.0f);
-            target.CancelAllCombos();
-            if (CharacterMovement* mv = target.GetMovement()) { mv->SetInputLocked(false); }
-            anim->MarkBatWindDealtDamage();
-        }
-    };
-    checkBatWindDamage(m_player, m_player2);
-    checkBatWindDamage(m_player2, m_player);
-
     auto onJump = [&](Character& ch){
         if (ch.GetMovement() && ch.GetMovement()->ConsumeJustStartedUpwardJump()) {
             SoundManager::Instance().PlaySFXByID(18, 0);
@@ -1247,12 +1029,23 @@ void GSPlay::Update(float deltaTime) {
     m_prevRollingP1 = rollingP1;
     m_prevRollingP2 = rollingP2;
     if (!m_gameEnded) {
-        UpdateBullets(deltaTime);
-        UpdateEnergyOrbProjectiles(deltaTime);
-        UpdateLightningEffects(deltaTime);
-        UpdateFireRains(deltaTime);
-        UpdateFireRainSpawnQueue();
-        CheckLightningDamage();
+        m_frameGraph.Reset();
+        m_frameGraph.Add("Bullets", [this, deltaTime] { UpdateBullets(deltaTime); }, RES_WALLS, RES_BULLETS);
+        m_frameGraph.Add("EnergyOrbs", [this, deltaTime] { UpdateEnergyOrbProjectiles(deltaTime); }, 0, RES_ORBS);
+        m_frameGraph.Add("Lightning", [this, deltaTime] { UpdateLightningEffects(deltaTime); }, 0, RES_LIGHTNING);
+        m_frameGraph.Add("FireRains", [this, deltaTime] {
+            UpdateFireRains(deltaTime);
+            UpdateFireRainSpawnQueue();
+        }, RES_WALLS, RES_FIRE_RAIN);
+        m_frameGraph.Add("Bombs", [this, deltaTime] { UpdateBombs(deltaTime); }, RES_WALLS, RES_BOMBS);
+        m_frameGraph.Add("Explosions", [this, deltaTime] { UpdateExplosions(deltaTime); }, 0, RES_EXPLOSIONS);
+        RunFrameGraph();
+
+        AppendCombatEvents(m_bulletEvents);
+        AppendCombatEvents(m_orbEvents);
+        AppendCombatEvents(m_lightningEvents);
+        AppendCombatEvents(m_fireRainEvents);
+        AppendCombatEvents(m_bombEvents);
         
         if (m_player.IsKitsuneEnergyOrbAnimationComplete()) {
             SpawnEnergyOrbProjectile(m_player);
@@ -1261,68 +1054,255 @@ void GSPlay::Update(float deltaTime) {
             SpawnEnergyOrbProjectile(m_player2);
         }
         
-        UpdateBombs(deltaTime);
-        UpdateExplosions(deltaTime);
         UpdateGrenadeFuse();
+        RunCollisionPhase();
         UpdateGunBursts();
         UpdateGunReloads();
         TryCompletePendingShots();
-        UpdateHudWeapons();
         UpdateHudAmmoAnim(deltaTime);
-        UpdateHudBombDigits();
-    }
-    
-        if (!m_gameEnded) {
-            if (m_player.CheckHitboxCollision(m_player2)) {
-                if (!IsCharacterInvincible(m_player2)) {
-                    if (m_player.IsWerewolf() && m_player.GetAnimation() && (((m_player.GetAnimation()->GetCurrentAnimation() == 1) && m_player.IsAnimationPlaying()) || m_player.GetAnimation()->IsWerewolfComboHitWindowActive())) {
-                        ProcessDamageAndScore(m_player, m_player2, 100.0f);
-                        m_player2.TriggerGetHit(m_player);
-                    } else if (m_player.IsWerewolf() && m_player.GetAnimation() && ((m_player.GetAnimation()->GetCurrentAnimation() == 3 && m_player.IsAnimationPlaying()))) {
-                        ProcessDamageAndScore(m_player, m_player2, 100.0f);
-                        m_player2.TriggerGetHit(m_player);
-                    } else {
-                        m_player2.TriggerGetHit(m_player);
-                    }
-                }
-            }
-        
-            if (m_player2.CheckHitboxCollision(m_player)) {
-                if (!IsCharacterInvincible(m_player)) {
-                    if (m_player2.IsWerewolf() && m_player2.GetAnimation() && (((m_player2.GetAnimation()->GetCurrentAnimation() == 1) && m_player2.IsAnimationPlaying()) || m_player2.GetAnimation()->IsWerewolfComboHitWindowActive())) {
-                        ProcessDamageAndScore(m_player2, m_player, 100.0f);
-                        m_player.TriggerGetHit(m_player2);
-                    } else if (m_player2.IsWerewolf() && m_player2.GetAnimation() && ((m_player2.GetAnimation()->GetCurrentAnimation() == 3 && m_player2.IsAnimationPlaying()))) {
-                        ProcessDamageAndScore(m_player2, m_player, 100.0f);
-                        m_player.TriggerGetHit(m_player2);
-                    } else {
-                        m_player.TriggerGetHit(m_player2);
-                    }
-                }
-            }
-        }
-    
-    Camera* camera = SceneManager::GetInstance()->GetActiveCamera();
-    if (camera && camera->IsAutoZoomEnabled()) {
-        Vector3 player1Pos = m_player.GetPosition();
-        Vector3 player2Pos = m_player2.GetPosition();
-        camera->UpdateCameraForCharacters(player1Pos, player2Pos, deltaTime);
     }
     
     m_player1Health = m_player.GetHealth();
     m_player2Health = m_player2.GetHealth();
-    
+
+    m_frameGraph.Reset();
+    m_frameGraph.Add("Camera", [this, deltaTime] {
+        Camera* camera = SceneManager::GetInstance()->GetActiveCamera();
+        if (camera && camera->IsAutoZoomEnabled()) {
+            Vector3 player1Pos = m_player.GetPosition();
+            Vector3 player2Pos = m_player2.GetPosition();
+            camera->UpdateCameraForCharacters(player1Pos, player2Pos, deltaTime);
+        }
+    }, RES_PLAYERS, RES_CAMERA);
+    m_frameGraph.Add("HealthBars", [this] {
+        UpdateHealthBars();
+        UpdateStaminaBars();
+    }, RES_PLAYERS, RES_HUD);
+    m_frameGraph.Add("Bloods", [this, deltaTime] { UpdateBloods(deltaTime); }, RES_WALLS, RES_BLOOD);
+    RunFrameGraph();
+    m_dumpFrameGraph = false;
+    m_hud.Update();
+}
+
+void GSPlay::BeginInputTick() {
+    m_inputManager->BeginTick(SimulationClock::Instance().GetInputDeadline());
+    if (m_recordingActive) {
+        m_recording.MarkApplied(m_matchTick - 1, m_inputManager->GetAppliedTotal());
+    }
+}
+
+uint64_t GSPlay::ComputeStateHash() const {
+    StateHash hash;
+    hash.Add(m_gameTime);
+    hash.Add(m_gameEnded);
+    hash.Add(m_isPaused);
+    const Character* players[2] = { &m_player, &m_player2 };
+    for (const Character* ch : players) {
+        const Vector3 pos = ch->GetPosition();
+        hash.Add(pos.x); hash.Add(pos.y);
+        hash.Add(ch->GetHealth());
+        hash.Add(ch->GetCurrentAnimation());
+        hash.Add(ch->IsDead());
+    }
+    hash.Add(m_player1Health); hash.Add(m_player2Health);
+    hash.Add(m_player1Score); hash.Add(m_player2Score);
+    hash.Add(m_p1Bombs); hash.Add(m_p2Bombs);
+    hash.Add(m_player1GunTexId); hash.Add(m_player2GunTexId);
+    const int ammo[] = { m_p1Ammo40, m_p1Ammo41, m_p1Ammo42, m_p1Ammo43, m_p1Ammo45, m_p1Ammo46, m_p1Ammo47,
+                         m_p2Ammo40, m_p2Ammo41, m_p2Ammo42, m_p2Ammo43, m_p2Ammo45, m_p2Ammo46, m_p2Ammo47 };
+    hash.Add(ammo);
+    hash.Add(m_bullets.Size());
+    // Summed per object so the hash does not depend on where in the scene list
+    // an object sits; a restored snapshot re-creates items at the end of it
+    uint64_t objects = 0;
+    for (const auto& obj : SceneManager::GetInstance()->GetObjects()) {
+        if (!obj) continue;
+        const Vector3& pos = obj->GetPosition();
+        StateHash objectHash;
+        objectHash.Add(obj->GetId());
+        objectHash.Add(obj->IsVisible());
+        objectHash.Add(pos.x); objectHash.Add(pos.y);
+        objects += objectHash.Get();
+    }
+    hash.Add(objects);
+    return hash.Get();
+}
+
+namespace {
+    const uint32_t SNAPSHOT_MAGIC = 0x53534B42; // "BKSS"
+    const uint32_t SNAPSHOT_VERSION = 5;
+}
+
+template <class Archive>
+void GSPlay::TransferState(Archive& ar) {
+    ar(m_gameTime); ar(m_gameTimer); ar(m_gameEnded); ar(m_isPaused);
+    ar(m_player1Health); ar(m_player2Health); ar(m_player1Score); ar(m_player2Score);
+    ar(m_p1GrenadePressTime); ar(m_p2GrenadePressTime); ar(m_p1HeldBombObj); ar(m_p2HeldBombObj);
+    ar(m_p1GrenadeExplodedInHand); ar(m_p2GrenadeExplodedInHand); ar(m_p1Bombs); ar(m_p2Bombs);
+    ar(m_p1ShotPending); ar(m_p2ShotPending); ar(m_p1GunStartTime); ar(m_p2GunStartTime);
+    ar(m_p1NextShotAllowed); ar(m_p2NextShotAllowed); ar(m_player1GunTexId); ar(m_player2GunTexId);
+    ar(m_p1BurstActive); ar(m_p1BurstRemaining); ar(m_p1NextBurstTime); ar(m_p2BurstActive);
+    ar(m_p2BurstRemaining); ar(m_p2NextBurstTime); ar(m_p1ReloadPending); ar(m_p1ReloadExitTime);
+    ar(m_p2ReloadPending); ar(m_p2ReloadExitTime);
+    ar(m_p1Ammo40); ar(m_p1Ammo41); ar(m_p1Ammo42); ar(m_p1Ammo43); ar(m_p1Ammo45); ar(m_p1Ammo46); ar(m_p1Ammo47);
+    ar(m_p2Ammo40); ar(m_p2Ammo41); ar(m_p2Ammo42); ar(m_p2Ammo43); ar(m_p2Ammo45); ar(m_p2Ammo46); ar(m_p2Ammo47);
+    ar(m_p1HudAmmoShown); ar(m_p2HudAmmoShown); ar(m_p1HudAmmoTarget); ar(m_p2HudAmmoTarget);
+    ar(m_p1HudAmmoNextTick); ar(m_p2HudAmmoNextTick);
+    ar(m_prevJumpingP1); ar(m_prevJumpingP2); ar(m_prevRollingP1); ar(m_prevRollingP2);
+    ar(m_p1SpecialExpireTime); ar(m_p2SpecialExpireTime); ar(m_p1SpecialType); ar(m_p2SpecialType);
+    ar(m_p1SpecialItemTexId); ar(m_p2SpecialItemTexId);
+    ar(m_isAxeAvailable); ar(m_isSwordAvailable); ar(m_isPipeAvailable); ar(m_itemBlinkTimer);
+    ar(m_p1Respawned); ar(m_p2Respawned); ar(m_p1Invincible); ar(m_p2Invincible);
+    ar(m_p1InvincibilityTimer); ar(m_p2InvincibilityTimer); ar(m_gameStartBlinkActive); ar(m_gameStartBlinkTimer);
+
+    m_player.TransferState(ar);
+    m_player2.TransferState(ar);
+    MatchContext::Current().TransferState(ar);
+
+    // Item objects are created and removed by the spawner, so they are brought
+    // in line with the restored slots before the scene matches objects by id
+    ar.Each(m_spawnSlots, [&ar](SpawnSlot& s) {
+        ar(s.pos); ar(s.currentId); ar(s.typeId);
+        ar(s.lifeTimer); ar(s.respawnTimer); ar(s.respawnDelay); ar(s.active);
+    });
+    ar(m_itemLives);
+    ar.Each(m_respawnSlots, [&ar](RespawnSlot& s) { ar(s.pos); ar(s.occupied); });
+    if (Archive::IS_LOADING) {
+        RestoreItemObjects();
+    }
+    SceneManager::GetInstance()->TransferState(ar);
+
+    auto transferObject = [&ar](Object& obj) { obj.TransferState(ar); };
+    m_bullets.TransferState(ar);
+    m_bulletPool.TransferState(ar, transferObject);
+    m_bazokaBulletPool.TransferState(ar, transferObject);
+    ar(m_bazokaTrails);
+    m_bazokaTrailPool.TransferState(ar, transferObject);
+    ar(m_bloodDrops);
+    for (Pool<Object>& pool : m_bloodPools) {
+        pool.TransferState(ar, transferObject);
+    }
+    ar(m_bombs);
+    m_bombPool.TransferState(ar, transferObject);
+    ar(m_explosions);
+    m_explosionPool.TransferState(ar, transferObject);
+    ar(m_lightningEffects);
+    m_lightningPool.TransferState(ar, transferObject);
+    ar.Each(m_fireRains, [&ar](FireRain& fr) {
+        ar(fr.isActive); ar(fr.isFading);
+        ar(fr.lifetime); ar(fr.maxLifetime); ar(fr.fadeTimer); ar(fr.fadeDuration);
+        ar(fr.position); ar(fr.velocity); ar(fr.objectIndex);
+        ar(fr.damagedP1); ar(fr.damagedP2); ar(fr.attackerId);
+    });
+    m_fireRainAnims.TransferState(ar);
+    m_fireRainPool.TransferState(ar, transferObject);
+    ar(m_fireRainSpawnQueue);
+
+    // Orbs are never freed while a match runs; the count only shrinks back to the snapshot's
+    uint32_t orbCount = (uint32_t)m_energyOrbProjectiles.size();
+    ar(orbCount);
+    if (Archive::IS_LOADING && ar.Ok() && orbCount < m_energyOrbProjectiles.size()) {
+        m_energyOrbProjectiles.resize(orbCount);
+    }
+    for (uint32_t i = 0; i < orbCount && ar.Ok(); ++i) {
+        int ownerId = i < m_energyOrbProjectiles.size() ? m_energyOrbProjectiles[i]->GetOwnerId() : 0;
+        ar(ownerId);
+        if (i >= m_energyOrbProjectiles.size()) {
+            CreateEnergyOrbProjectile(ownerId);
+        }
+        m_energyOrbProjectiles[i]->TransferState(ar);
+    }
+}
+
+void GSPlay::SaveSnapshot(std::vector<uint8_t>& out) {
+    SnapshotWriter ar(out);
+    uint32_t magic = SNAPSHOT_MAGIC;
+    uint32_t version = SNAPSHOT_VERSION;
+    ar(magic);
+    ar(version);
+    TransferState(ar);
+}
+
+bool GSPlay::RestoreSnapshot(const std::vector<uint8_t>& data) {
+    SnapshotReader ar(data);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    ar(magic);
+    ar(version);
+    if (!ar.Ok() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        std::cout << "[Snapshot] not a match snapshot of this build" << std::endl;
+        return false;
+    }
+    TransferState(ar);
+    m_hud.Invalidate();
+    if (!ar.Ok() || !ar.AtEnd()) {
+        std::cout << "[Snapshot] buffer does not match the match layout; state is partially restored" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void GSPlay::RestoreItemObjects() {
+    SceneManager* scene = SceneManager::GetInstance();
+    const int slotCount = (int)m_spawnSlots.size();
+
+    // Item instances are <item id> * 100 + <slot>; drop the ones no restored slot holds
+    m_itemObjectScratch.clear();
+    for (const auto& obj : scene->GetObjects()) {
+        const int id = obj->GetId();
+        const int slot = id % 100;
+        if (id < 100 || slot >= slotCount || m_itemTemplates.find(id / 100) == m_itemTemplates.end()) continue;
+        if (!m_spawnSlots[slot].active || m_spawnSlots[slot].currentId != id) {
+            m_itemObjectScratch.push_back(id);
+        }
+    }
+    for (int id : m_itemObjectScratch) {
+        scene->RemoveObject(id);
+    }
+
+    m_objectIdToSlot.clear();
+    for (int slot = 0; slot < slotCount; ++slot) {
+        const SpawnSlot& s = m_spawnSlots[slot];
+        if (!s.active) continue;
+        if (!scene->GetObject(s.currentId)) {
+            CreateItemObject(slot, s.typeId);
+        }
+        m_objectIdToSlot[s.currentId] = slot;
+    }
+}
+
+void GSPlay::RestoreMatchStart() {
+    if (m_matchStartSnapshot.empty() || !RestoreSnapshot(m_matchStartSnapshot)) {
+        ResetGame();
+        return;
+    }
+    HideEndScreen();
+    UpdateScoreDisplay();
+    UpdateTimeDisplay();
     UpdateHealthBars();
-    UpdateStaminaBars();
+    UpdateHudWeapons();
+    UpdateHudBombDigits();
+    UpdateHudAmmoDigits();
+    UpdateHudSpecialIcon(true);
+    UpdateHudSpecialIcon(false);
+    HidePauseScreen();
+}
 
-    UpdateCloudMovement(deltaTime);
-    
-    UpdateFanRotation(deltaTime);
+void GSPlay::RunFrameGraph() {
+    m_frameGraph.Run();
+    if (m_dumpFrameGraph) {
+        m_frameGraph.Dump(std::cout);
+    }
+}
 
-    UpdateBloods(deltaTime);
+bool GSPlay::IsIdle() const {
+    return m_isPaused;
 }
 
 void GSPlay::Draw() {
+    if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
+        cam->SetRenderAlpha(SimulationClock::Instance().GetAlpha());
+    }
     SceneManager::GetInstance()->Draw();
     
     if (!m_gameEnded) {
@@ -1332,54 +1312,6 @@ void GSPlay::Draw() {
             m_player2.Draw(cam);
         }
 
-        // Draw HUD portraits with independent UVs
-        DrawHudPortraits();
-        
-        if (m_scoreTextP1 && m_scoreTextP2) {
-            float aspect = (float)Globals::screenWidth / (float)Globals::screenHeight;
-            Matrix uiView;
-            Matrix uiProj;
-            uiView.SetLookAt(Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
-            uiProj.SetOrthographic(-aspect, aspect, -1.0f, 1.0f, 0.1f, 100.0f);
-            
-            m_scoreTextP1->Draw(uiView, uiProj);
-            m_scoreTextP2->Draw(uiView, uiProj);
-        }
-        
-        if (!m_scoreDigitObjectsP1.empty() && !m_scoreDigitObjectsP2.empty()) {
-            float aspect = (float)Globals::screenWidth / (float)Globals::screenHeight;
-            Matrix uiView;
-            Matrix uiProj;
-            uiView.SetLookAt(Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
-            uiProj.SetOrthographic(-aspect, aspect, -1.0f, 1.0f, 0.1f, 100.0f);
-            
-            for (auto& digitObj : m_scoreDigitObjectsP1) {
-                if (digitObj) {
-                    digitObj->Draw(uiView, uiProj);
-                }
-            }
-            
-            for (auto& digitObj : m_scoreDigitObjectsP2) {
-                if (digitObj) {
-                    digitObj->Draw(uiView, uiProj);
-                }
-            }
-        }
-        
-        if (!m_timeDigitObjects.empty()) {
-            float aspect = (float)Globals::screenWidth / (float)Globals::screenHeight;
-            Matrix uiView;
-            Matrix uiProj;
-            uiView.SetLookAt(Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
-            uiProj.SetOrthographic(-aspect, aspect, -1.0f, 1.0f, 0.1f, 100.0f);
-            
-            for (auto& digitObj : m_timeDigitObjects) {
-                if (digitObj) {
-                    digitObj->Draw(uiView, uiProj);
-                }
-            }
-        }
-        
         if (cam) { DrawBullets(cam); }
         if (cam) { DrawEnergyOrbProjectiles(cam); }
         if (cam) { DrawLightningEffects(cam); }
@@ -1410,103 +1342,25 @@ void GSPlay::Draw() {
             quitButton->Draw(uiView, uiProj);
         }
     }
-    
-    static float lastPosX = m_player.GetPosition().x;
-    static int lastAnim = m_player.GetCurrentAnimation();
-    static float lastPosX2 = m_player2.GetPosition().x;
-    static int lastAnim2 = m_player2.GetCurrentAnimation();
-    static bool wasMoving = false;
-    static bool wasMoving2 = false;
-        
-    const bool* keyStates = m_inputManager ? m_inputManager->GetKeyStates() : nullptr;
-    if (!keyStates) {
-        return;
-    }
-    bool isMoving = keyStates ? (keyStates['A'] || keyStates['D']) : false;
-    bool isMoving2 = keyStates ? (keyStates[0x25] || keyStates[0x27]) : false;
-        
-    if (abs(m_player.GetPosition().x - lastPosX) > 0.01f || 
-        lastAnim != m_player.GetCurrentAnimation() ||
-        (isMoving && !wasMoving)) {
-            
-        if (m_player.IsInCombo()) {
-            if (m_player.GetComboCount() > 0) {
-                if (m_player.IsComboCompleted()) {
-                }
-                if (isMoving) {
-                }
-            } else if (m_player.GetAxeComboCount() > 0) {
-                if (m_player.IsAxeComboCompleted()) {
-                }
-                if (isMoving) {
-                }
-            }
-        } else if (m_player.GetCurrentAnimation() == 19) {
-        }            
-        lastPosX = m_player.GetPosition().x;
-        lastAnim = m_player.GetCurrentAnimation();
-        wasMoving = isMoving;
-    }
-    
-    if (abs(m_player2.GetPosition().x - lastPosX2) > 0.01f || 
-        lastAnim2 != m_player2.GetCurrentAnimation() ||
-        (isMoving2 && !wasMoving2)) {
-            
-        if (m_player2.IsInCombo()) {
-            if (m_player2.GetComboCount() > 0) {
-                if (m_player2.IsComboCompleted()) {
-                }
-                if (isMoving2) {
-                }
-            } else if (m_player2.GetAxeComboCount() > 0) {
-                if (m_player2.IsAxeComboCompleted()) {
-                }
-                if (isMoving2) {
-                }
-            }
-        } else if (m_player2.GetCurrentAnimation() == 19) {
-        }
-            
-        lastPosX2 = m_player2.GetPosition().x;
-        lastAnim2 = m_player2.GetCurrentAnimation();
-        wasMoving2 = isMoving2;
-    }
-}
-
-int GSPlay::CreateOrAcquireFireRainObject() {
-    if (!m_freeFireRainSlots.empty()) {
-        int idx = m_freeFireRainSlots.back();
-        m_freeFireRainSlots.pop_back();
-        if (idx >= 0 && idx < (int)m_fireRainObjects.size() && m_fireRainObjects[idx]) {
-            m_fireRainObjects[idx]->SetVisible(true);
-        }
-        return idx;
-    }
-    std::unique_ptr<Object> obj = std::make_unique<Object>(61000 + (int)m_fireRainObjects.size());
-    obj->SetModel(0);
-    obj->SetTexture(66, 0);
-    obj->SetShader(0);
-    obj->SetScale(0.6f, 0.6f, 1.0f);
-    obj->SetVisible(true);
-    obj->MakeModelInstanceCopy();
-    m_fireRainObjects.push_back(std::move(obj));
-    return (int)m_fireRainObjects.size() - 1;
 }
 
 void GSPlay::SpawnFireRainAt(float x, float y, int attackerId) {
     GSPlay::FireRain* fr = nullptr;
+    int slot = 0;
     for (auto& r : m_fireRains) {
         if (!r.isActive) { fr = &r; break; }
+        ++slot;
     }
     if (!fr) {
         if ((int)m_fireRains.size() < MAX_FIRERAIN) {
             m_fireRains.push_back(FireRain{});
             fr = &m_fireRains.back();
+            m_fireRainAnims.Add();
         }
     }
     if (!fr) return;
 
-    int objIndex = CreateOrAcquireFireRainObject();
+    int objIndex = m_fireRainPool.Acquire();
     fr->objectIndex = objIndex;
     fr->isActive = true;
     fr->isFading = false;
@@ -1516,33 +1370,24 @@ void GSPlay::SpawnFireRainAt(float x, float y, int attackerId) {
     fr->velocity = Vector3(0.0f, -1.5f, 0.0f);
     fr->attackerId = attackerId;
 
-    if (!fr->anim) fr->anim = std::make_shared<AnimationManager>();
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(66)) {
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        fr->anim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        fr->anim->Play(0, true);
-        if (texData->animations.size() > 1) {
-            fr->fadeDuration = texData->animations[1].duration;
+    if (m_fireRainAnims.SetSheet(slot, 66)) {
+        m_fireRainAnims.Play(slot, 0, true);
+        if (const AnimationData* fade = m_fireRainAnims.GetAnimation(slot, 1)) {
+            fr->fadeDuration = fade->duration;
         }
     }
 
-    if (objIndex >= 0 && objIndex < (int)m_fireRainObjects.size() && m_fireRainObjects[objIndex]) {
-        m_fireRainObjects[objIndex]->SetTexture(66, 0);
-        m_fireRainObjects[objIndex]->SetPosition(fr->position);
-        if (fr->anim) {
-            float u0, v0, u1, v1;
-            fr->anim->GetUV(u0, v0, u1, v1);
-            m_fireRainObjects[objIndex]->SetCustomUV(u0, v0, u1, v1);
+    if (Object* obj = m_fireRainPool.Get(objIndex)) {
+        obj->SetPosition(fr->position);
+        if (m_fireRainAnims.HasSheet(slot)) {
+            obj->SetSpriteFrame(m_fireRainAnims.GetSheetFrame(slot));
         }
     }
 }
 
 void GSPlay::UpdateFireRains(float deltaTime) {
-    for (auto& fr : m_fireRains) {
+    for (int i = 0; i < (int)m_fireRains.size(); ++i) {
+        FireRain& fr = m_fireRains[i];
         if (!fr.isActive) continue;
 
         fr.lifetime += deltaTime;
@@ -1551,97 +1396,54 @@ void GSPlay::UpdateFireRains(float deltaTime) {
 
             bool hitWall = CheckFireRainWallCollision(fr.position, FIRE_RAIN_COLLISION_W * 0.5f, FIRE_RAIN_COLLISION_H * 0.5f);
             if (hitWall) {
-                SoundManager::Instance().PlaySFXByID(27, 0);
-                
-                if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
-                    cam->AddShake(0.01f, 0.18f, 18.0f);
-                }
+                EmitSFX(m_fireRainEvents, 27);
+                EmitShake(m_fireRainEvents, 0.01f, 0.18f, 18.0f);
                 fr.isFading = true;
                 fr.fadeTimer = 0.0f;
-                if (fr.anim) fr.anim->Play(1, false);
+                if (m_fireRainAnims.HasSheet(i)) m_fireRainAnims.Play(i, 1, false);
                 fr.damagedP1 = false;
                 fr.damagedP2 = false;
             }
         } else {
             fr.fadeTimer += deltaTime;
-            bool fadeAnimFinished = (fr.anim && !fr.anim->IsPlaying());
-            if (fr.fadeTimer >= fr.fadeDuration || fadeAnimFinished) {
-                fr.isActive = false;
-                fr.isFading = false;
-                fr.lifetime = 0.0f;
-                fr.fadeTimer = 0.0f;
-                if (fr.objectIndex >= 0 && fr.objectIndex < (int)m_fireRainObjects.size() && m_fireRainObjects[fr.objectIndex]) {
-                    m_fireRainObjects[fr.objectIndex]->SetVisible(false);
-                    m_freeFireRainSlots.push_back(fr.objectIndex);
-                }
-                fr.objectIndex = -1;
-                continue;
+            if (fr.fadeTimer >= fr.fadeDuration) {
+                RetireFireRain(i);
             }
         }
+    }
 
-        if (fr.anim) fr.anim->Update(deltaTime);
-        if (fr.objectIndex >= 0 && fr.objectIndex < (int)m_fireRainObjects.size() && m_fireRainObjects[fr.objectIndex]) {
-            m_fireRainObjects[fr.objectIndex]->SetPosition(fr.position);
-            if (fr.anim) {
-                float u0, v0, u1, v1;
-                fr.anim->GetUV(u0, v0, u1, v1);
-                m_fireRainObjects[fr.objectIndex]->SetCustomUV(u0, v0, u1, v1);
-            }
+    // Every drop's animation in one pass; drops whose fade clip just ended are retired
+    m_fireRainAnimsFinished.clear();
+    m_fireRainAnims.Update(deltaTime, m_fireRainAnimsFinished);
+    for (const AnimationBatch::Finished& e : m_fireRainAnimsFinished) {
+        if (m_fireRains[e.slot].isFading) {
+            RetireFireRain(e.slot);
         }
+    }
 
-        if (fr.isFading) {
-            float halfW = FIRE_RAIN_DAMAGE_W * 0.5f;
-            float halfH = FIRE_RAIN_DAMAGE_H * 0.5f;
-            float aLeft = fr.position.x - halfW;
-            float aRight = fr.position.x + halfW;
-            float aBottom = fr.position.y - halfH;
-            float aTop = fr.position.y + halfH;
-
-            auto checkDamage = [&](Character& target, bool& alreadyDamaged){
-                if (alreadyDamaged) return;
-                Vector3 pos = target.GetPosition();
-                float hx = pos.x + target.GetHurtboxOffsetX();
-                float hy = pos.y + target.GetHurtboxOffsetY();
-                float halfW2 = target.GetHurtboxWidth() * 0.5f;
-                float halfH2 = target.GetHurtboxHeight() * 0.5f;
-                float bLeft = hx - halfW2;
-                float bRight = hx + halfW2;
-                float bBottom = hy - halfH2;
-                float bTop = hy + halfH2;
-                bool overlapX = aRight >= bLeft && aLeft <= bRight;
-                bool overlapY = aTop >= bBottom && aBottom <= bTop;
-                if (overlapX && overlapY) {
-                    if (IsCharacterInvincible(target)) {
-                        return;
-                    }
-                    
-                    SoundManager::Instance().PlaySFXByID(27, 0);
-                    
-                    float prev = target.GetHealth();
-                    if (fr.attackerId > 0) {
-                        Character& attacker = (fr.attackerId == 1) ? m_player : m_player2;
-                        if (&target != &attacker) {
-                            ProcessDamageAndScore(attacker, target, 100.0f);
-                        } else {
-                        }
-                    } else {
-                        target.TakeDamage(100.0f);
-                        if (prev > 0.0f && target.GetHealth() <= 0.0f) {
-                            ProcessSelfDeath(target);
-                        }
-                    }
-                    target.CancelAllCombos();
-                    if (CharacterMovement* mv = target.GetMovement()) { mv->SetInputLocked(false); }
-                    alreadyDamaged = true;
-                }
-            };
-
-            checkDamage(m_player, fr.damagedP1);
-            checkDamage(m_player2, fr.damagedP2);
+    for (int i = 0; i < (int)m_fireRains.size(); ++i) {
+        const FireRain& fr = m_fireRains[i];
+        if (!fr.isActive) continue;
+        if (Object* obj = m_fireRainPool.Get(fr.objectIndex)) {
+            obj->SetPosition(fr.position);
+            if (m_fireRainAnims.HasSheet(i)) {
+                obj->SetSpriteFrame(m_fireRainAnims.GetSheetFrame(i));
+            }
         }
     }
 }
 
+void GSPlay::RetireFireRain(int index) {
+    FireRain& fr = m_fireRains[index];
+    fr.isActive = false;
+    fr.isFading = false;
+    fr.lifetime = 0.0f;
+    fr.fadeTimer = 0.0f;
+    m_fireRainPool.Release(fr.objectIndex);
+    fr.objectIndex = -1;
+    m_fireRainAnims.Stop(index);
+}
+
 bool GSPlay::CheckFireRainWallCollision(const Vector3& pos, float halfW, float halfH) const {
     if (!m_wallCollision) return false;
     const auto& walls = m_wallCollision->GetWalls();
@@ -1662,8 +1464,9 @@ bool GSPlay::CheckFireRainWallCollision(const Vector3& pos, float halfW, float h
 }
 
 void GSPlay::DrawFireRains(Camera* camera) {
-    for (auto& frObj : m_fireRainObjects) {
-        if (frObj && frObj->IsVisible()) {
+    for (int i = 0; i < m_fireRainPool.Size(); ++i) {
+        Object* frObj = m_fireRainPool.Get(i);
+        if (m_fireRainPool.IsInUse(i) && frObj->IsVisible()) {
             frObj->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
@@ -1675,8 +1478,9 @@ void GSPlay::QueueFireRainWave(float xStart, float xEnd, float step, float y, fl
     for (float x = xStart; x <= xEnd + 1e-6f; x += step) {
         xs.push_back(x);
     }
+    MatchContext& context = MatchContext::Current();
     for (float x : xs) {
-        float r = (float)rand() / (float)RAND_MAX;
+        float r = context.RandomUnit(MatchContext::RNG_FIRE_RAIN);
         float spawnOffset = r * duration;
         m_fireRainSpawnQueue.push_back(FireRainEvent{ m_gameTime + spawnOffset, x, attackerId });
     }
@@ -1697,35 +1501,6 @@ void GSPlay::UpdateFireRainSpawnQueue() {
     m_fireRainSpawnQueue.resize(writeIdx);
 }
 
-int GSPlay::CreateOrAcquireBombObjectFromProto(int protoObjectId) {
-    if (!m_freeBombSlots.empty()) {
-        int idx = m_freeBombSlots.back();
-        m_freeBombSlots.pop_back();
-        if (m_bombObjs[idx]) {
-            if (Object* proto = SceneManager::GetInstance()->GetObject(protoObjectId)) {
-                m_bombObjs[idx]->SetModel(proto->GetModelId());
-                const std::vector<int>& texIds = proto->GetTextureIds();
-                if (!texIds.empty()) m_bombObjs[idx]->SetTexture(texIds[0], 0);
-                m_bombObjs[idx]->SetShader(proto->GetShaderId());
-                m_bombObjs[idx]->SetScale(proto->GetScale());
-            }
-            m_bombObjs[idx]->SetVisible(true);
-        }
-        return idx;
-    }
-    std::unique_ptr<Object> obj = std::make_unique<Object>(50000 + (int)m_bombObjs.size());
-    if (Object* proto = SceneManager::GetInstance()->GetObject(protoObjectId)) {
-        obj->SetModel(proto->GetModelId());
-        const std::vector<int>& texIds = proto->GetTextureIds();
-        if (!texIds.empty()) obj->SetTexture(texIds[0], 0);
-        obj->SetShader(proto->GetShaderId());
-        obj->SetScale(proto->GetScale());
-    }
-    obj->SetVisible(true);
-    m_bombObjs.push_back(std::move(obj));
-    return (int)m_bombObjs.size() - 1;
-}
-
 void GSPlay::SpawnBombFromCharacter(const Character& ch, float overrideLife) {
     Vector3 pivot = ch.GetGunTopWorldPosition();
     Vector3 base  = ch.GetPosition();
@@ -1750,7 +1525,7 @@ void GSPlay::SpawnBombFromCharacter(const Character& ch, float overrideLife) {
     float len = dir.Length();
     if (len > 1e-6f) dir = dir / len; else dir = Vector3(faceSign, 0.0f, 0.0f);
 
-    int slot = CreateOrAcquireBombObjectFromProto(m_bombObjectId);
+    int slot = m_bombPool.Acquire();
     Bomb b; b.x = spawn.x; b.y = spawn.y;
     b.vx = dir.x * BOMB_SPEED; b.vy = dir.y * BOMB_SPEED;
     b.life = (overrideLife > 0.0f) ? overrideLife : BOMB_LIFETIME; b.objIndex = slot; b.angleRad = angleWorld; b.faceSign = faceSign;
@@ -1760,10 +1535,7 @@ void GSPlay::SpawnBombFromCharacter(const Character& ch, float overrideLife) {
 
 void GSPlay::UpdateBombs(float dt) {
     auto removeBomb = [&](decltype(m_bombs.begin())& it){
-        if (it->objIndex >= 0 && it->objIndex < (int)m_bombObjs.size() && m_bombObjs[it->objIndex]) {
-            m_freeBombSlots.push_back(it->objIndex);
-            m_bombObjs[it->objIndex]->SetVisible(false);
-        }
+        m_bombPool.Release(it->objIndex);
         it = m_bombs.erase(it);
     };
 
@@ -1824,10 +1596,8 @@ void GSPlay::UpdateBombs(float dt) {
         }
 
         if (it->life <= 0.0f) {
-            SpawnExplosionAt(it->x, it->y, BAZOKA_EXPLOSION_RADIUS_MUL, it->attackerId);
-            if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
-                cam->AddShake(0.04f, 0.4f, 18.0f);
-            }
+            EmitExplosion(m_bombEvents, it->x, it->y, BAZOKA_EXPLOSION_RADIUS_MUL, it->attackerId);
+            EmitShake(m_bombEvents, 0.04f, 0.4f, 18.0f);
             removeBomb(it);
             continue;
         }
@@ -1835,43 +1605,12 @@ void GSPlay::UpdateBombs(float dt) {
     }
 }
 
-int GSPlay::CreateOrAcquireExplosionObjectFromProto(int protoObjectId) {
-    if (!m_freeExplosionSlots.empty()) {
-        int idx = m_freeExplosionSlots.back();
-        m_freeExplosionSlots.pop_back();
-        if (m_explosionObjs[idx]) {
-            if (Object* proto = SceneManager::GetInstance()->GetObject(protoObjectId)) {
-                m_explosionObjs[idx]->SetModel(proto->GetModelId());
-                const std::vector<int>& texIds = proto->GetTextureIds();
-                if (!texIds.empty()) m_explosionObjs[idx]->SetTexture(texIds[0], 0);
-                m_explosionObjs[idx]->SetShader(proto->GetShaderId());
-                m_explosionObjs[idx]->SetScale(proto->GetScale());
-            }
-            m_explosionObjs[idx]->MakeModelInstanceCopy();
-            m_explosionObjs[idx]->SetVisible(true);
-        }
-        return idx;
-    }
-    std::unique_ptr<Object> obj = std::make_unique<Object>(60000 + (int)m_explosionObjs.size());
-    if (Object* proto = SceneManager::GetInstance()->GetObject(protoObjectId)) {
-        obj->SetModel(proto->GetModelId());
-        const std::vector<int>& texIds = proto->GetTextureIds();
-        if (!texIds.empty()) obj->SetTexture(texIds[0], 0);
-        obj->SetShader(proto->GetShaderId());
-        obj->SetScale(proto->GetScale());
-    }
-    obj->MakeModelInstanceCopy();
-    obj->SetVisible(true);
-    m_explosionObjs.push_back(std::move(obj));
-    return (int)m_explosionObjs.size() - 1;
-}
-
 void GSPlay::SpawnExplosionAt(float x, float y, float radiusMul, int attackerId) {
-    int idx = CreateOrAcquireExplosionObjectFromProto(m_explosionObjectId);
-    Explosion e{}; e.x = x; e.y = y; e.objIdx = idx; e.cols = 11; e.rows = 1; e.frameIndex = 0; e.frameCount = 11; e.frameTimer = 0.0f; e.frameDuration = EXPLOSION_FRAME_DURATION; e.damageRadiusMul = radiusMul; e.attackerId = attackerId;
-    if (idx >= 0 && idx < (int)m_explosionObjs.size() && m_explosionObjs[idx]) {
-        m_explosionObjs[idx]->SetPosition(x, y, 0.0f);
-        SetSpriteUV(m_explosionObjs[idx].get(), e.cols, e.rows, 0);
+    int idx = m_explosionPool.Acquire();
+    Explosion e{}; e.x = x; e.y = y; e.objIdx = idx; e.frameIndex = 0; e.frameCount = 11; e.frameTimer = 0.0f; e.frameDuration = EXPLOSION_FRAME_DURATION; e.damageRadiusMul = radiusMul; e.attackerId = attackerId;
+    if (Object* obj = m_explosionPool.Get(idx)) {
+        obj->SetPosition(x, y, 0.0f);
+        obj->SetSpriteFrame(0);
     }
     SoundManager::Instance().PlaySFXByID(8, 0); 
     m_explosions.push_back(e);
@@ -1880,73 +1619,17 @@ void GSPlay::SpawnExplosionAt(float x, float y, float radiusMul, int attackerId)
 void GSPlay::UpdateExplosions(float dt) {
     for (size_t i = 0; i < m_explosions.size(); ) {
         Explosion& e = m_explosions[i];
-        if (e.frameIndex == 0 && e.frameTimer <= 0.0f) {
-            float halfW = 0.15f, halfH = 0.15f;
-            if (e.objIdx >= 0 && e.objIdx < (int)m_explosionObjs.size() && m_explosionObjs[e.objIdx]) {
-                const Vector3& sc = m_explosionObjs[e.objIdx]->GetScale();
-                float mul = (e.damageRadiusMul > 0.0f) ? e.damageRadiusMul : EXPLOSION_DAMAGE_RADIUS_MUL;
-                halfW = fabsf(sc.x) * 0.5f * mul;
-                halfH = fabsf(sc.y) * 0.5f * mul;
-            }
-            auto applyDamage = [&](Character& target){
-                Vector3 pos = target.GetPosition();
-                float hx = pos.x + target.GetHurtboxOffsetX();
-                float hy = pos.y + target.GetHurtboxOffsetY();
-                float thw = target.GetHurtboxWidth() * 0.5f;
-                float thh = target.GetHurtboxHeight() * 0.5f;
-                float tLeft = hx - thw, tRight = hx + thw, tBottom = hy - thh, tTop = hy + thh;
-                float eLeft = e.x - halfW, eRight = e.x + halfW, eBottom = e.y - halfH, eTop = e.y + halfH;
-                bool overlap = !(tRight < eLeft || tLeft > eRight || tTop < eBottom || tBottom > eTop);
-                if (!overlap) return;
-                // radial falloff by distance to center
-                float dx = hx - e.x; float dy = hy - e.y;
-                float dist = sqrtf(dx*dx + dy*dy);
-                float maxR = (halfW > halfH ? halfW : halfH);
-                float ratio = 1.0f - (dist / (maxR + 1e-6f));
-                if (ratio < 0.0f) ratio = 0.0f; if (ratio > 1.0f) ratio = 1.0f;
-                float damage = 100.0f * ratio;
-                if (damage <= 0.0f) return;
-                
-                if (IsCharacterInvincible(target)) {
-                    return;
-                }
-                
-                if (e.attackerId > 0) {
-                    Character& attacker = (e.attackerId == 1) ? m_player : m_player2;
-                    if (&target != &attacker) {
-                        ProcessDamageAndScore(attacker, target, damage);
-                    } else {
-                        target.TakeDamage(damage);
-                    }
-                } else {
-                    target.TakeDamage(damage);
-                }
-                target.CancelAllCombos();
-                if (CharacterMovement* mv = target.GetMovement()) mv->SetInputLocked(false);
-                if (target.GetHealth() <= 0.0f) {
-                    ProcessSelfDeath(target);
-                }
-            };
-            applyDamage(m_player);
-            applyDamage(m_player2);
-        }
-
         e.frameTimer += dt;
         while (e.frameTimer >= e.frameDuration) {
             e.frameTimer -= e.frameDuration;
             e.frameIndex += 1;
             if (e.frameIndex >= e.frameCount) break;
-            int idx = e.objIdx;
-            if (idx >= 0 && idx < (int)m_explosionObjs.size() && m_explosionObjs[idx]) {
-                SetSpriteUV(m_explosionObjs[idx].get(), e.cols, e.rows, e.frameIndex);
+            if (Object* obj = m_explosionPool.Get(e.objIdx)) {
+                obj->SetSpriteFrame(e.frameIndex);
             }
         }
         if (e.frameIndex >= e.frameCount) {
-            int idx = e.objIdx;
-            if (idx >= 0 && idx < (int)m_explosionObjs.size() && m_explosionObjs[idx]) {
-                m_explosionObjs[idx]->SetVisible(false);
-                m_freeExplosionSlots.push_back(idx);
-            }
+            m_explosionPool.Release(e.objIdx);
             m_explosions[i] = m_explosions.back();
             m_explosions.pop_back();
         } else {
@@ -1957,28 +1640,12 @@ void GSPlay::UpdateExplosions(float dt) {
 
 void GSPlay::DrawExplosions(class Camera* cam) {
     for (const Explosion& e : m_explosions) {
-        int idx = e.objIdx;
-        if (idx >= 0 && idx < (int)m_explosionObjs.size() && m_explosionObjs[idx]) {
-            m_explosionObjs[idx]->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
+        if (Object* obj = m_explosionPool.Get(e.objIdx)) {
+            obj->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
         }
     }
 }
 
-void GSPlay::SetSpriteUV(Object* obj, int cols, int rows, int frameIndex) {
-    if (!obj || cols <= 0 || rows <= 0 || frameIndex < 0) return;
-    int total = cols * rows;
-    if (frameIndex >= total) frameIndex = total - 1;
-    int col = frameIndex % cols;
-    int row = frameIndex / cols;
-    float du = 1.0f / cols;
-    float dv = 1.0f / rows;
-    float u0 = col * du;
-    float v0 = row * dv;
-    float u1 = u0 + du;
-    float v1 = v0 + dv;
-    obj->SetCustomUV(u0, v0, u1, v1);
-}
-
 void GSPlay::UpdateGrenadeFuse() {
     auto checkFuse = [&](Character& ch, float& pressTime){
         if (pressTime < 0.0f) return;
@@ -2000,12 +1667,11 @@ void GSPlay::UpdateGrenadeFuse() {
 
 void GSPlay::DrawBombs(Camera* cam) {
     for (const Bomb& b : m_bombs) {
-        int idx = b.objIndex;
-        if (idx >= 0 && idx < (int)m_bombObjs.size() && m_bombObjs[idx]) {
-            m_bombObjs[idx]->SetPosition(b.x, b.y, 0.0f);
+        if (Object* obj = m_bombPool.Get(b.objIndex)) {
+            obj->SetPosition(b.x, b.y, 0.0f);
             float desired = atan2f(b.vy, b.vx);
-            m_bombObjs[idx]->SetRotation(0.0f, 0.0f, desired);
-            m_bombObjs[idx]->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
+            obj->SetRotation(0.0f, 0.0f, desired);
+            obj->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
         }
     }
 }
@@ -2085,19 +1751,14 @@ void GSPlay::DrawHudPortraits() {
     Matrix uiProj;
     uiView.SetLookAt(Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
     uiProj.SetOrthographic(-aspect, aspect, -1.0f, 1.0f, 0.1f, 100.0f);
-    UpdateHudSpecialIcon(true);
-    UpdateHudSpecialIcon(false);
 
     // HUD Player 1 (ID 916)
     if (Object* hud1 = scene->GetObject(916)) {
         hud1->SetTexture(m_player.GetBodyTextureId(), 0);
-        float u0, v0, u1, v1;
-        m_player.GetCurrentFrameUV(u0, v0, u1, v1);
+        const int frame1 = m_player.GetCurrentSheetFrame();
         // Flip horizontally if player is facing left so HUD mirrors in the same direction
         bool flip = m_player.IsFacingLeft();
-        if (flip) {
-            std::swap(u0, u1);
-        }
+        const int flipFlags1 = flip ? Object::SPRITE_FLIP_X : 0;
         float baseScaleX1 = hud1->GetScale().x;
         float baseScaleY1 = hud1->GetScale().y;
         float baseScaleZ1 = hud1->GetScale().z;
@@ -2108,17 +1769,12 @@ void GSPlay::DrawHudPortraits() {
         float oldPosZ1b = hud1->GetPosition().z;
         Vector3 offset1 = ComputeHudPortraitOffset(m_player);
         hud1->SetPosition(oldPosX1b + offset1.x, oldPosY1b + offset1.y, oldPosZ1b + offset1.z);
-        hud1->SetCustomUV(u0, v0, u1, v1);
+        hud1->SetSpriteFrame(frame1, flipFlags1);
         hud1->Draw(uiView, uiProj);
         hud1->SetScale(baseScaleX1, baseScaleY1, baseScaleZ1);
         hud1->SetPosition(oldPosX1b, oldPosY1b, oldPosZ1b);
 
         if (m_player.IsGunMode() || m_player.IsGrenadeMode()) {
-            float hu0, hv0, hu1, hv1;
-            m_player.GetTopFrameUV(hu0, hv0, hu1, hv1);
-            if (flip) {
-                std::swap(hu0, hu1);
-            }
             float offX = m_player.GetHeadOffsetX();
             float offY = m_player.GetHeadOffsetY();
             float sign = flip ? -1.0f : 1.0f;
@@ -2139,11 +1795,11 @@ void GSPlay::DrawHudPortraits() {
 
             int headTex = m_player.GetHeadTextureId();
             hud1->SetTexture(headTex, 0);
-            hud1->SetCustomUV(hu0, hv0, hu1, hv1);
+            hud1->SetSpriteFrame(m_player.GetTopSheetFrame(), flipFlags1);
             hud1->Draw(uiView, uiProj);
             // Restore body texture
             hud1->SetTexture(m_player.GetBodyTextureId(), 0);
-            hud1->SetCustomUV(u0, v0, u1, v1);
+            hud1->SetSpriteFrame(frame1, flipFlags1);
             hud1->SetPosition(oldPosX1, oldPosY1, oldPosZ1);
             hud1->SetRotation(oldRotX1, oldRotY1, oldRotZ1);
         }
@@ -2152,12 +1808,9 @@ void GSPlay::DrawHudPortraits() {
     // HUD Player 2 (ID 917)
     if (Object* hud2 = scene->GetObject(917)) {
         hud2->SetTexture(m_player2.GetBodyTextureId(), 0);
-        float u0, v0, u1, v1;
-        m_player2.GetCurrentFrameUV(u0, v0, u1, v1);
+        const int frame2 = m_player2.GetCurrentSheetFrame();
         bool flip2 = m_player2.IsFacingLeft();
-        if (flip2) {
-            std::swap(u0, u1);
-        }
+        const int flipFlags2 = flip2 ? Object::SPRITE_FLIP_X : 0;
         float baseScaleX2 = hud2->GetScale().x;
         float baseScaleY2 = hud2->GetScale().y;
         float baseScaleZ2 = hud2->GetScale().z;
@@ -2168,17 +1821,12 @@ void GSPlay::DrawHudPortraits() {
         float oldPosZ2b = hud2->GetPosition().z;
         Vector3 offset2 = ComputeHudPortraitOffset(m_player2);
         hud2->SetPosition(oldPosX2b + offset2.x, oldPosY2b + offset2.y, oldPosZ2b + offset2.z);
-        hud2->SetCustomUV(u0, v0, u1, v1);
+        hud2->SetSpriteFrame(frame2, flipFlags2);
         hud2->Draw(uiView, uiProj);
         hud2->SetScale(baseScaleX2, baseScaleY2, baseScaleZ2);
         hud2->SetPosition(oldPosX2b, oldPosY2b, oldPosZ2b);
 
         if (m_player2.IsGunMode() || m_player2.IsGrenadeMode()) {
-            float hu0, hv0, hu1, hv1;
-            m_player2.GetTopFrameUV(hu0, hv0, hu1, hv1);
-            if (flip2) {
-                std::swap(hu0, hu1);
-            }
             float offX = m_player2.GetHeadOffsetX();
             float offY = m_player2.GetHeadOffsetY();
             float sign2 = flip2 ? -1.0f : 1.0f;
@@ -2199,10 +1847,10 @@ void GSPlay::DrawHudPortraits() {
 
             int headTex = m_player2.GetHeadTextureId();
             hud2->SetTexture(headTex, 0);
-            hud2->SetCustomUV(hu0, hv0, hu1, hv1);
+            hud2->SetSpriteFrame(m_player2.GetTopSheetFrame(), flipFlags2);
             hud2->Draw(uiView, uiProj);
             hud2->SetTexture(m_player2.GetBodyTextureId(), 0);
-            hud2->SetCustomUV(u0, v0, u1, v1);
+            hud2->SetSpriteFrame(frame2, flipFlags2);
             hud2->SetPosition(oldPosX2, oldPosY2, oldPosZ2);
             hud2->SetRotation(oldRotX2, oldRotY2, oldRotZ2);
         }
@@ -2254,7 +1902,11 @@ Vector3 GSPlay::ComputeHudPortraitOffset(const Character& ch) const {
 
 void GSPlay::HandleKeyEvent(unsigned char key, bool bIsPressed) {
     if (m_inputManager) {
-        m_inputManager->UpdateKeyState(key, bIsPressed);
+        const double time = SimulationClock::Instance().GetEventTime();
+        m_inputManager->QueueKeyEvent(key, bIsPressed, time);
+        if (m_recordingActive) {
+            m_recording.AddKey(m_matchTick, key, bIsPressed, time);
+        }
     }
     
     if (key == 27) {
@@ -2527,6 +2179,20 @@ void GSPlay::HandleKeyEvent(unsigned char key, bool bIsPressed) {
         //     }
         //     break;
             
+        case 0x76: // F7: overdraw view, additive grey per fragment
+            RenderPacket::SetOverdrawView(!RenderPacket::GetOverdrawView());
+            std::cout << "[Overdraw] view " << (RenderPacket::GetOverdrawView() ? "on" : "off") << std::endl;
+            break;
+
+        case 0x77: // F8: depth-tested opaque pass on/off, for comparing overdraw
+            RenderPacket::SetDepthPasses(!RenderPacket::GetDepthPasses());
+            std::cout << "[Overdraw] depth passes " << (RenderPacket::GetDepthPasses() ? "on" : "off") << std::endl;
+            break;
+
+        case 0x78: // F9: dump the next tick's job graphs
+            m_dumpFrameGraph = true;
+            break;
+
         case 'R':
         case 'r':
             m_player.ResetHealth();
@@ -2580,7 +2246,7 @@ void GSPlay::SpawnBulletFromCharacter(const Character& ch) {
     float len = dir.Length();
     if (len > 1e-6f) dir = dir / len; else dir = Vector3(faceSign, 0.0f, 0.0f);
 
-    int slot = CreateOrAcquireBulletObject();
+    int slot = m_bulletPool.Acquire();
     bool isP1 = (&ch == &m_player);
     int gunTex = isP1 ? m_player1GunTexId : m_player2GunTexId;
     float speedMul = 1.0f;
@@ -2599,13 +2265,8 @@ void GSPlay::SpawnBulletFromCharacter(const Character& ch) {
     } else if (gunTex == 47) { // Uzi
         speedMul = 1.5f; damage = 10.0f;
     }
-    Bullet b;
-    b.x = spawn.x; b.y = spawn.y;
-    b.vx = dir.x * BULLET_SPEED * speedMul; b.vy = dir.y * BULLET_SPEED * speedMul;
-    b.life = BULLET_LIFETIME; b.objIndex = slot;
-    b.angleRad = angleWorld; b.faceSign = faceSign;
-    b.ownerId = isP1 ? 1 : 2; b.damage = damage;
-    m_bullets.push_back(b);
+    AddBullet(spawn.x, spawn.y, dir.x * BULLET_SPEED * speedMul, dir.y * BULLET_SPEED * speedMul,
+              isP1 ? 1 : 2, damage, angleWorld, faceSign, false, slot);
 }
 
 void GSPlay::SpawnBulletFromCharacterWithJitter(const Character& ch, float jitterDeg) {
@@ -2637,7 +2298,7 @@ void GSPlay::SpawnBulletFromCharacterWithJitter(const Character& ch, float jitte
     float len = dir.Length();
     if (len > 1e-6f) dir = dir / len; else dir = Vector3(faceSign, 0.0f, 0.0f);
 
-    int slot = CreateOrAcquireBulletObject();
+    int slot = m_bulletPool.Acquire();
     bool isP1 = (&ch == &m_player);
     int gunTex = isP1 ? m_player1GunTexId : m_player2GunTexId;
     float speedMul = 1.0f;
@@ -2656,8 +2317,8 @@ void GSPlay::SpawnBulletFromCharacterWithJitter(const Character& ch, float jitte
     } else if (gunTex == 47) { // Uzi burst
         speedMul = 1.5f; damage = 10.0f;
     }
-    Bullet b; b.x = spawn.x; b.y = spawn.y; b.vx = dir.x * BULLET_SPEED * speedMul; b.vy = dir.y * BULLET_SPEED * speedMul; b.life = BULLET_LIFETIME; b.objIndex = slot; b.angleRad = angleWorld; b.faceSign = faceSign; b.ownerId = isP1 ? 1 : 2; b.damage = damage;
-    m_bullets.push_back(b);
+    AddBullet(spawn.x, spawn.y, dir.x * BULLET_SPEED * speedMul, dir.y * BULLET_SPEED * speedMul,
+              isP1 ? 1 : 2, damage, angleWorld, faceSign, false, slot);
 }
 
 void GSPlay::SpawnBazokaBulletFromCharacter(const Character& ch, float jitterDeg, float speedMul, float damage) {
@@ -2685,119 +2346,61 @@ void GSPlay::SpawnBazokaBulletFromCharacter(const Character& ch, float jitterDeg
     float len = dir.Length();
     if (len > 1e-6f) dir = dir / len; else dir = Vector3(faceSign, 0.0f, 0.0f);
 
-    int slot = CreateOrAcquireBulletObjectFromProto(m_bazokaBulletObjectId);
-    const bool isP1 = (&ch == &m_player);
-    Bullet b; b.x = spawn.x; b.y = spawn.y;
-    b.vx = dir.x * BULLET_SPEED * speedMul; b.vy = dir.y * BULLET_SPEED * speedMul;
-    b.life = BULLET_LIFETIME; b.objIndex = slot; b.angleRad = angleWorld; b.faceSign = faceSign;
-    b.ownerId = isP1 ? 1 : 2; b.damage = damage; b.isBazoka = true; b.trailTimer = 0.0f;
-    if ((int)m_bullets.size() < MAX_BULLETS) {
-        m_bullets.push_back(b);
-    }
-}
-
-void GSPlay::UpdateBullets(float dt) {
-    auto removeBullet = [&](decltype(m_bullets.begin())& it){
-        if (it->objIndex >= 0 && it->objIndex < (int)m_bulletObjs.size() && m_bulletObjs[it->objIndex]) {
-            m_freeBulletSlots.push_back(it->objIndex);
-            m_bulletObjs[it->objIndex]->SetVisible(false);
-        }
-        it = m_bullets.erase(it);
-    };
-
-    auto aabbOverlap = [](float aLeft, float aRight, float aBottom, float aTop,
-                          float bLeft, float bRight, float bBottom, float bTop){
-        return (aLeft < bRight && aRight > bLeft && aBottom < bTop && aTop > bBottom);
-    };
-
-    // Update all bullets
-    for (auto it = m_bullets.begin(); it != m_bullets.end(); ) {
-        float dx = it->vx * dt;
-        float dy = it->vy * dt;
-        it->x += dx;
-        it->y += dy;
-        it->life -= dt;
-
-        if (it->isBazoka) {
-            it->trailTimer += dt;
-            if (it->trailTimer >= BAZOKA_TRAIL_SPAWN_INTERVAL) {
-                it->trailTimer = 0.0f;
-                if ((int)m_bazokaTrails.size() < MAX_BAZOKA_TRAILS) {
-                    int idx = CreateOrAcquireBazokaTrailObject();
-                float backX = it->x - cosf(it->angleRad) * BAZOKA_TRAIL_BACK_OFFSET;
-                float backY = it->y - sinf(it->angleRad) * BAZOKA_TRAIL_BACK_OFFSET;
-                Trail t; t.x = backX; t.y = backY; t.life = BAZOKA_TRAIL_LIFETIME; t.objIndex = idx; t.angle = it->angleRad; t.alpha = 1.0f;
-                    m_bazokaTrails.push_back(t);
-                }
-            }
-        }
+    int slot = m_bazokaBulletPool.Acquire();
+    const bool isP1 = (&ch == &m_player);
+    AddBullet(spawn.x, spawn.y, dir.x * BULLET_SPEED * speedMul, dir.y * BULLET_SPEED * speedMul,
+              isP1 ? 1 : 2, damage, angleWorld, faceSign, true, slot);
+}
 
-        if (it->life <= 0.0f) { removeBullet(it); continue; }
+void GSPlay::AddBullet(float x, float y, float vx, float vy, int ownerId, float damage,
+                      float angleRad, float faceSign, bool isBazoka, int objIndex) {
+    uint8_t flags = isBazoka ? (uint8_t)BulletSystem::FLAG_BAZOKA : (uint8_t)0;
+    if (m_bullets.Spawn(x, y, vx, vy, BULLET_LIFETIME, ownerId, flags, damage, angleRad, faceSign, objIndex) < 0) {
+        ReleaseBulletObject(objIndex, isBazoka);
+    }
+}
 
-        if (m_wallCollision) {
-            Vector3 pos(it->x, it->y, 0.0f);
-            if (m_wallCollision->CheckWallCollision(pos, BULLET_COLLISION_WIDTH, BULLET_COLLISION_HEIGHT, 0.0f, 0.0f)) {
-                if (it->isBazoka) {
-                    SpawnExplosionAt(it->x, it->y, BAZOKA_EXPLOSION_RADIUS_MUL, it->ownerId);
-                    if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
-                        cam->AddShake(0.03f, 0.35f, 18.0f);
-                    }
-                }
-                SoundManager::Instance().PlaySFXByID(4, 0); // "WallGetHit"
-                removeBullet(it); continue;
-            }
-        }
+void GSPlay::ReleaseBulletObject(int objIndex, bool isBazoka) {
+    if (isBazoka) {
+        m_bazokaBulletPool.Release(objIndex);
+    } else {
+        m_bulletPool.Release(objIndex);
+    }
+}
 
-        Character* target = (it->ownerId == 1) ? &m_player2 : &m_player;
-        Character* attacker = (it->ownerId == 1) ? &m_player : &m_player2;
-        if (target) {
-            Vector3 targetPos = target->GetPosition();
-            float hx = targetPos.x + target->GetHurtboxOffsetX();
-            float hy = targetPos.y + target->GetHurtboxOffsetY();
-            float halfW = target->GetHurtboxWidth() * 0.5f;
-            float halfH = target->GetHurtboxHeight() * 0.5f;
-            float tLeft = hx - halfW;
-            float tRight = hx + halfW;
-            float tBottom = hy - halfH;
-            float tTop = hy + halfH;
-
-            float bHalfW = BULLET_COLLISION_WIDTH * 0.5f;
-            float bHalfH = BULLET_COLLISION_HEIGHT * 0.5f;
-            float bLeft = it->x - bHalfW;
-            float bRight = it->x + bHalfW;
-            float bBottom = it->y - bHalfH;
-            float bTop = it->y + bHalfH;
-
-            if (aabbOverlap(bLeft, bRight, bBottom, bTop, tLeft, tRight, tBottom, tTop)) {
-                if (IsCharacterInvincible(*target)) {
-                    removeBullet(it); continue;
-                }
-                
-                float dmg = it->damage > 0.0f ? it->damage : 10.0f;
-                if (attacker) {
-                    ProcessDamageAndScore(*attacker, *target, dmg);
-                } else {
-                    target->TakeDamage(dmg);
-                }
-                target->CancelAllCombos();
-                if (CharacterMovement* mv = target->GetMovement()) {
-                    mv->SetInputLocked(false);
-                }
-                if (target->GetHealth() <= 0.0f && attacker) {
-                    target->TriggerDieFromAttack(*attacker);
-                }
-                SpawnBloodAt(it->x, it->y, it->angleRad);
-                if (it->isBazoka) {
-                    SpawnExplosionAt(it->x, it->y, BAZOKA_EXPLOSION_RADIUS_MUL, it->ownerId);
-                    if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
-                        cam->AddShake(0.03f, 0.35f, 18.0f);
-                    }
-                }
-                removeBullet(it); continue;
+void GSPlay::UpdateBullets(float dt) {
+    m_bullets.Integrate(dt);
+
+    // Bazoka trails follow the integrated position, expired rockets included
+    for (int i = 0; i < m_bullets.Size(); ++i) {
+        if (!m_bullets.IsBazoka(i)) continue;
+        float& trailTimer = m_bullets.TrailTimer(i);
+        trailTimer += dt;
+        if (trailTimer >= BAZOKA_TRAIL_SPAWN_INTERVAL) {
+            trailTimer = 0.0f;
+            if ((int)m_bazokaTrails.size() < MAX_BAZOKA_TRAILS) {
+                int idx = m_bazokaTrailPool.Acquire();
+                float angle = m_bullets.GetAngle(i);
+                float backX = m_bullets.GetX(i) - cosf(angle) * BAZOKA_TRAIL_BACK_OFFSET;
+                float backY = m_bullets.GetY(i) - sinf(angle) * BAZOKA_TRAIL_BACK_OFFSET;
+                Trail t; t.x = backX; t.y = backY; t.life = BAZOKA_TRAIL_LIFETIME; t.objIndex = idx; t.angle = angle; t.alpha = 1.0f;
+                m_bazokaTrails.push_back(t);
             }
         }
+    }
 
-        ++it;
+    // Wall hits come out in bullet order; target hits are left to the collision phase
+    m_bulletHits.clear();
+    if (m_wallCollision) {
+        m_bullets.CollideWalls(*m_wallCollision, BULLET_COLLISION_WIDTH, BULLET_COLLISION_HEIGHT, m_bulletHits);
+    }
+    for (const BulletSystem::Hit& hit : m_bulletHits) {
+        const int i = hit.index;
+        if (m_bullets.IsBazoka(i)) {
+            EmitExplosion(m_bulletEvents, m_bullets.GetX(i), m_bullets.GetY(i), BAZOKA_EXPLOSION_RADIUS_MUL, m_bullets.GetOwnerId(i));
+            EmitShake(m_bulletEvents, 0.03f, 0.35f, 18.0f);
+        }
+        EmitSFX(m_bulletEvents, 4); // "WallGetHit"
     }
 
     for (size_t i = 0; i < m_bazokaTrails.size(); ) {
@@ -2805,92 +2408,64 @@ void GSPlay::UpdateBullets(float dt) {
         tr.life -= dt;
         tr.alpha = (tr.life > 0.0f) ? (tr.life / BAZOKA_TRAIL_LIFETIME) : 0.0f;
         if (tr.life <= 0.0f) {
-            if (tr.objIndex >= 0 && tr.objIndex < (int)m_bazokaTrailObjs.size() && m_bazokaTrailObjs[tr.objIndex]) {
-                m_freeBazokaTrailSlots.push_back(tr.objIndex);
-                m_bazokaTrailObjs[tr.objIndex]->SetVisible(false);
-            }
+            m_bazokaTrailPool.Release(tr.objIndex);
             m_bazokaTrails[i] = m_bazokaTrails.back();
             m_bazokaTrails.pop_back();
         } else {
-            if (tr.objIndex >= 0 && tr.objIndex < (int)m_bazokaTrailObjs.size() && !m_bazokaTrailTextures.empty()) {
+            Object* trailObj = m_bazokaTrailPool.Get(tr.objIndex);
+            if (trailObj && !m_bazokaTrailTextures.empty()) {
                 float ratio = tr.alpha;
                 int idxTex = (ratio > 0.75f) ? 0 : (ratio > 0.5f) ? 1 : (ratio > 0.25f) ? 2 : 3;
                 if (idxTex >= (int)m_bazokaTrailTextures.size()) {
                     idxTex = (int)m_bazokaTrailTextures.size() - 1;
                 }
                 if (idxTex < 0) idxTex = 0;
-                m_bazokaTrailObjs[tr.objIndex]->SetDynamicTexture(m_bazokaTrailTextures[idxTex]);
+                trailObj->SetDynamicTexture(m_bazokaTrailTextures[idxTex]);
             }
             ++i;
         }
     }
 }
 
-int GSPlay::CreateOrAcquireBulletObject() {
-    if (!m_freeBulletSlots.empty()) {
-        int idx = m_freeBulletSlots.back();
-        m_freeBulletSlots.pop_back();
-        if (m_bulletObjs[idx]) {
-            SceneManager* scene = SceneManager::GetInstance();
-            if (Object* proto = scene->GetObject(m_bulletObjectId)) {
-                m_bulletObjs[idx]->SetModel(proto->GetModelId());
+namespace {
+    // Copies render state from a scene prototype, once per pool slot
+    Pool<Object>::InitFunc BindToPrototype(int protoObjectId, int idBase, bool instanceModel) {
+        return [protoObjectId, idBase, instanceModel](Object& obj, int slot) {
+            obj.SetId(idBase + slot);
+            if (Object* proto = SceneManager::GetInstance()->GetObject(protoObjectId)) {
+                obj.SetModel(proto->GetModelId());
                 const std::vector<int>& texIds = proto->GetTextureIds();
-                if (!texIds.empty()) m_bulletObjs[idx]->SetTexture(texIds[0], 0);
-                m_bulletObjs[idx]->SetShader(proto->GetShaderId());
-                m_bulletObjs[idx]->SetScale(proto->GetScale());
+                if (!texIds.empty()) obj.SetTexture(texIds[0], 0);
+                obj.SetShader(proto->GetShaderId());
+                obj.SetScale(proto->GetScale());
             }
-            m_bulletObjs[idx]->SetVisible(true);
-        }
-        return idx;
-    }
-    SceneManager* scene = SceneManager::GetInstance();
-    Object* proto = scene->GetObject(m_bulletObjectId);
-    std::unique_ptr<Object> obj = std::make_unique<Object>(20000 + (int)m_bulletObjs.size());
-    if (proto) {
-        obj->SetModel(proto->GetModelId());
-        const std::vector<int>& texIds = proto->GetTextureIds();
-        if (!texIds.empty()) obj->SetTexture(texIds[0], 0);
-        obj->SetShader(proto->GetShaderId());
-        obj->SetScale(proto->GetScale());
+            if (instanceModel) obj.MakeModelInstanceCopy();
+            obj.SetVisible(false);
+        };
     }
-    obj->SetVisible(true);
-    m_bulletObjs.push_back(std::move(obj));
-    return (int)m_bulletObjs.size() - 1;
-}
-
-int GSPlay::CreateOrAcquireBulletObjectFromProto(int protoObjectId) {
-    if (!m_freeBulletSlots.empty()) {
-        int idx = m_freeBulletSlots.back();
-        m_freeBulletSlots.pop_back();
-        if (m_bulletObjs[idx]) {
-            SceneManager* scene = SceneManager::GetInstance();
-            if (Object* proto = scene->GetObject(protoObjectId)) {
-                m_bulletObjs[idx]->SetModel(proto->GetModelId());
-                const std::vector<int>& texIds = proto->GetTextureIds();
-                if (!texIds.empty()) m_bulletObjs[idx]->SetTexture(texIds[0], 0);
-                m_bulletObjs[idx]->SetShader(proto->GetShaderId());
-                m_bulletObjs[idx]->SetScale(proto->GetScale());
-            }
-            m_bulletObjs[idx]->SetVisible(true);
-        }
-        return idx;
+
+    Pool<Object>::InitFunc BindToTexture(int textureId, int idBase, float scaleX, float scaleY) {
+        return [textureId, idBase, scaleX, scaleY](Object& obj, int slot) {
+            obj.SetId(idBase + slot);
+            obj.SetModel(0);
+            obj.SetTexture(textureId, 0);
+            obj.SetShader(0);
+            obj.SetScale(scaleX, scaleY, 1.0f);
+            obj.MakeModelInstanceCopy();
+            obj.SetVisible(false);
+        };
     }
-    SceneManager* scene = SceneManager::GetInstance();
-    Object* proto = scene->GetObject(protoObjectId);
-    std::unique_ptr<Object> obj = std::make_unique<Object>(20000 + (int)m_bulletObjs.size());
-    if (proto) {
-        obj->SetModel(proto->GetModelId());
-        const std::vector<int>& texIds = proto->GetTextureIds();
-        if (!texIds.empty()) obj->SetTexture(texIds[0], 0);
-        obj->SetShader(proto->GetShaderId());
-        obj->SetScale(proto->GetScale());
+
+    void SetupPool(Pool<Object>& pool, Pool<Object>::InitFunc init, int prewarm) {
+        pool.Destroy();
+        pool.SetInitializer(init);
+        pool.SetAcquireHook([](Object& obj) { obj.SetVisible(true); });
+        pool.SetReleaseHook([](Object& obj) { obj.SetVisible(false); });
+        pool.Prewarm(prewarm);
     }
-    obj->SetVisible(true);
-    m_bulletObjs.push_back(std::move(obj));
-    return (int)m_bulletObjs.size() - 1;
 }
 
-int GSPlay::CreateOrAcquireBazokaTrailObject() {
+void GSPlay::InitObjectPools() {
     if (m_bazokaTrailTextures.empty()) {
         for (int i = 0; i < 4; ++i) {
             int alpha = 220 - i * 60; if (alpha < 40) alpha = 40;
@@ -2901,34 +2476,65 @@ int GSPlay::CreateOrAcquireBazokaTrailObject() {
         }
     }
 
-    if (!m_freeBazokaTrailSlots.empty()) {
-        int idx = m_freeBazokaTrailSlots.back();
-        m_freeBazokaTrailSlots.pop_back();
-        if (m_bazokaTrailObjs[idx]) {
-            m_bazokaTrailObjs[idx]->SetVisible(true);
-        }
-        return idx;
-    }
-    std::unique_ptr<Object> obj = std::make_unique<Object>(30000 + (int)m_bazokaTrailObjs.size());
-    if (Object* proto = SceneManager::GetInstance()->GetObject(m_bulletObjectId)) {
-        obj->SetModel(proto->GetModelId());
-        obj->SetShader(proto->GetShaderId());
-        const Vector3& sc = proto->GetScale();
-        obj->SetScale(sc.x * BAZOKA_TRAIL_SCALE_X, sc.y * BAZOKA_TRAIL_SCALE_Y, sc.z);
-        if (!m_bazokaTrailTextures.empty()) obj->SetDynamicTexture(m_bazokaTrailTextures[0]);
+    SetupPool(m_bulletPool,       BindToPrototype(m_bulletObjectId, 20000, false), 128);
+    SetupPool(m_bazokaBulletPool, BindToPrototype(m_bazokaBulletObjectId, 25000, false), 16);
+    SetupPool(m_bloodPools[0],    BindToPrototype(m_bloodProtoIdA, 40000, false), 32);
+    SetupPool(m_bloodPools[1],    BindToPrototype(m_bloodProtoIdB, 43000, false), 32);
+    SetupPool(m_bloodPools[2],    BindToPrototype(m_bloodProtoIdC, 46000, false), 32);
+    SetupPool(m_bombPool,         BindToPrototype(m_bombObjectId, 50000, false), 8);
+    SetupPool(m_explosionPool,    BindToPrototype(m_explosionObjectId, 60000, true), 16);
+    SetupPool(m_lightningPool,    BindToTexture(64, 62000, 1.0f, -3.6f), 4);
+    SetupPool(m_fireRainPool,     BindToTexture(66, 61000, 0.6f, 0.6f), 128);
+
+    const int trailProtoId = m_bulletObjectId;
+    const float trailScaleX = BAZOKA_TRAIL_SCALE_X;
+    const float trailScaleY = BAZOKA_TRAIL_SCALE_Y;
+    std::shared_ptr<Texture2D> trailTex = m_bazokaTrailTextures.empty() ? nullptr : m_bazokaTrailTextures[0];
+    SetupPool(m_bazokaTrailPool, [trailProtoId, trailScaleX, trailScaleY, trailTex](Object& obj, int slot) {
+        obj.SetId(30000 + slot);
+        if (Object* proto = SceneManager::GetInstance()->GetObject(trailProtoId)) {
+            obj.SetModel(proto->GetModelId());
+            obj.SetShader(proto->GetShaderId());
+            const Vector3& sc = proto->GetScale();
+            obj.SetScale(sc.x * trailScaleX, sc.y * trailScaleY, sc.z);
+            if (trailTex) obj.SetDynamicTexture(trailTex);
+        }
+        obj.SetVisible(false);
+    }, 128);
+}
+
+void GSPlay::LogObjectPoolStats() const {
+    struct Entry { const char* name; const Pool<Object>* pool; };
+    const Entry entries[] = {
+        { "bullet",       &m_bulletPool },
+        { "bazoka",       &m_bazokaBulletPool },
+        { "bazoka trail", &m_bazokaTrailPool },
+        { "blood A",      &m_bloodPools[0] },
+        { "blood B",      &m_bloodPools[1] },
+        { "blood C",      &m_bloodPools[2] },
+        { "bomb",         &m_bombPool },
+        { "explosion",    &m_explosionPool },
+        { "lightning",    &m_lightningPool },
+        { "fire rain",    &m_fireRainPool },
+    };
+    for (const Entry& e : entries) {
+        std::cout << "[Pool] " << e.name << ": in use " << e.pool->InUse()
+                  << ", peak " << e.pool->HighWaterMark()
+                  << ", slots " << e.pool->Size() << std::endl;
     }
-    obj->SetVisible(true);
-    m_bazokaTrailObjs.push_back(std::move(obj));
-    return (int)m_bazokaTrailObjs.size() - 1;
 }
 
 void GSPlay::DrawBullets(Camera* cam) {
-    for (const Bullet& b : m_bullets) {
-        int idx = b.objIndex;
-        if (idx >= 0 && idx < (int)m_bulletObjs.size() && m_bulletObjs[idx]) {
-            m_bulletObjs[idx]->SetPosition(b.x, b.y, 0.0f);
-            float desiredAngle = (b.faceSign < 0.0f) ? (b.angleRad + 3.14159265f) : b.angleRad;
-            const Vector3& sc = m_bulletObjs[idx]->GetScale();
+    // Bullets fly in straight lines, so the previous tick is recovered from velocity
+    const float back = (1.0f - SimulationClock::Instance().GetAlpha()) * SimulationClock::TICK_DT;
+    for (int i = 0; i < m_bullets.Size(); ++i) {
+        Pool<Object>& pool = m_bullets.IsBazoka(i) ? m_bazokaBulletPool : m_bulletPool;
+        if (Object* obj = pool.Get(m_bullets.GetObjIndex(i))) {
+            obj->SetPosition(m_bullets.GetX(i) - m_bullets.GetVX(i) * back,
+                             m_bullets.GetY(i) - m_bullets.GetVY(i) * back, 0.0f);
+            const float angleRad = m_bullets.GetAngle(i);
+            float desiredAngle = (m_bullets.GetFaceSign(i) < 0.0f) ? (angleRad + 3.14159265f) : angleRad;
+            const Vector3& sc = obj->GetScale();
             float sx = fabsf(sc.x);
             float sy = fabsf(sc.y);
             if (sy < 1e-6f) sy = 1e-6f;
@@ -2936,68 +2542,35 @@ void GSPlay::DrawBullets(Camera* cam) {
             float c = cosf(desiredAngle);
             float s = sinf(desiredAngle);
             float compensated = atan2f(k * s, c);
-            m_bulletObjs[idx]->SetRotation(0.0f, 0.0f, compensated);
-            m_bulletObjs[idx]->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
+            obj->SetRotation(0.0f, 0.0f, compensated);
+            obj->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
         }
     }
 
     for (const Trail& t : m_bazokaTrails) {
-        int idx = t.objIndex;
-        if (idx >= 0 && idx < (int)m_bazokaTrailObjs.size() && m_bazokaTrailObjs[idx]) {
-            m_bazokaTrailObjs[idx]->SetPosition(t.x, t.y, 0.0f);
-            m_bazokaTrailObjs[idx]->SetRotation(0.0f, 0.0f, t.angle);
-            m_bazokaTrailObjs[idx]->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
-        }
-    }
-}
-
-int GSPlay::CreateOrAcquireBloodObjectFromProto(int protoObjectId) {
-    if (!m_freeBloodSlots.empty()) {
-        int idx = m_freeBloodSlots.back();
-        m_freeBloodSlots.pop_back();
-        if (m_bloodObjs[idx]) {
-            SceneManager* scene = SceneManager::GetInstance();
-            if (Object* proto = scene->GetObject(protoObjectId)) {
-                m_bloodObjs[idx]->SetModel(proto->GetModelId());
-                const std::vector<int>& texIds = proto->GetTextureIds();
-                if (!texIds.empty()) m_bloodObjs[idx]->SetTexture(texIds[0], 0);
-                m_bloodObjs[idx]->SetShader(proto->GetShaderId());
-                m_bloodObjs[idx]->SetScale(proto->GetScale());
-            }
-            m_bloodObjs[idx]->SetVisible(true);
+        if (Object* obj = m_bazokaTrailPool.Get(t.objIndex)) {
+            obj->SetPosition(t.x, t.y, 0.0f);
+            obj->SetRotation(0.0f, 0.0f, t.angle);
+            obj->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
         }
-        return idx;
-    }
-    SceneManager* scene = SceneManager::GetInstance();
-    Object* proto = scene->GetObject(protoObjectId);
-    std::unique_ptr<Object> obj = std::make_unique<Object>(40000 + (int)m_bloodObjs.size());
-    if (proto) {
-        obj->SetModel(proto->GetModelId());
-        const std::vector<int>& texIds = proto->GetTextureIds();
-        if (!texIds.empty()) obj->SetTexture(texIds[0], 0);
-        obj->SetShader(proto->GetShaderId());
-        obj->SetScale(proto->GetScale());
     }
-    obj->SetVisible(true);
-    m_bloodObjs.push_back(std::move(obj));
-    return (int)m_bloodObjs.size() - 1;
 }
 
 void GSPlay::SpawnBloodAt(float x, float y, float baseAngleRad) {
     float backX = cosf(baseAngleRad) * -0.15f;
     float backY = sinf(baseAngleRad) * -0.05f;
+    MatchContext& context = MatchContext::Current();
 
-    int protos[3] = { m_bloodProtoIdA, m_bloodProtoIdB, m_bloodProtoIdC };
     for (int i = 0; i < 3; ++i) {
-        int idx = CreateOrAcquireBloodObjectFromProto(protos[i]);
-        float rx = ((float)rand() / (float)RAND_MAX - 0.5f) * 0.02f;
-        float ry = ((float)rand() / (float)RAND_MAX - 0.5f) * 0.02f;
-        float angJitter = ((float)rand() / (float)RAND_MAX - 0.5f) * 0.6f;
-        float speedMul = 0.6f + ((float)rand() / (float)RAND_MAX) * 0.6f; // [0.6,1.2]
+        int idx = m_bloodPools[i].Acquire();
+        float rx = (context.RandomUnit(MatchContext::RNG_BLOOD) - 0.5f) * 0.02f;
+        float ry = (context.RandomUnit(MatchContext::RNG_BLOOD) - 0.5f) * 0.02f;
+        float angJitter = (context.RandomUnit(MatchContext::RNG_BLOOD) - 0.5f) * 0.6f;
+        float speedMul = 0.6f + context.RandomUnit(MatchContext::RNG_BLOOD) * 0.6f; // [0.6,1.2]
 
-        if (idx >= 0 && idx < (int)m_bloodObjs.size() && m_bloodObjs[idx]) {
-            m_bloodObjs[idx]->SetPosition(x + rx, y + ry, 0.0f);
-            m_bloodObjs[idx]->SetRotation(0.0f, 0.0f, baseAngleRad + angJitter);
+        if (Object* obj = m_bloodPools[i].Get(idx)) {
+            obj->SetPosition(x + rx, y + ry, 0.0f);
+            obj->SetRotation(0.0f, 0.0f, baseAngleRad + angJitter);
         }
 
         BloodDrop d;
@@ -3009,6 +2582,7 @@ void GSPlay::SpawnBloodAt(float x, float y, float baseAngleRad) {
         d.vy = backY * speedMul + dirY * 0.03f + 0.05f; // give a tad upward kick
         d.angle = baseAngleRad + angJitter;
         d.objIdx = idx;
+        d.pool = i;
         m_bloodDrops.push_back(d);
     }
 }
@@ -3016,10 +2590,7 @@ void GSPlay::SpawnBloodAt(float x, float y, float baseAngleRad) {
 void GSPlay::UpdateBloods(float dt) {
     auto removeDrop = [&](size_t idx){
         BloodDrop& d = m_bloodDrops[idx];
-        if (d.objIdx >= 0 && d.objIdx < (int)m_bloodObjs.size() && m_bloodObjs[d.objIdx]) {
-            m_bloodObjs[d.objIdx]->SetVisible(false);
-            m_freeBloodSlots.push_back(d.objIdx);
-        }
+        m_bloodPools[d.pool].Release(d.objIdx);
         m_bloodDrops[idx] = m_bloodDrops.back();
         m_bloodDrops.pop_back();
     };
@@ -3034,9 +2605,9 @@ void GSPlay::UpdateBloods(float dt) {
 
         d.angle += 2.0f * dt;
 
-        if (d.objIdx >= 0 && d.objIdx < (int)m_bloodObjs.size() && m_bloodObjs[d.objIdx]) {
-            m_bloodObjs[d.objIdx]->SetPosition(d.x, d.y, 0.0f);
-            m_bloodObjs[d.objIdx]->SetRotation(0.0f, 0.0f, d.angle);
+        if (Object* obj = m_bloodPools[d.pool].Get(d.objIdx)) {
+            obj->SetPosition(d.x, d.y, 0.0f);
+            obj->SetRotation(0.0f, 0.0f, d.angle);
         }
 
         bool collided = false;
@@ -3054,9 +2625,8 @@ void GSPlay::UpdateBloods(float dt) {
 
 void GSPlay::DrawBloods(Camera* cam) {
     for (const BloodDrop& d : m_bloodDrops) {
-        int idx = d.objIdx;
-        if (idx >= 0 && idx < (int)m_bloodObjs.size() && m_bloodObjs[idx]) {
-            m_bloodObjs[idx]->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
+        if (Object* obj = m_bloodPools[d.pool].Get(d.objIdx)) {
+            obj->Draw(cam->GetViewMatrix(), cam->GetProjectionMatrix());
         }
     }
 }
@@ -3137,14 +2707,9 @@ void GSPlay::TryCompletePendingShots() {
             float len = dir.Length();
             if (len > 1e-6f) dir = dir / len; else dir = Vector3(faceSign, 0.0f, 0.0f);
 
-            int slot = CreateOrAcquireBulletObjectFromProto(m_bazokaBulletObjectId);
-            Bullet b; b.x = spawn.x; b.y = spawn.y;
-            b.vx = dir.x * BULLET_SPEED * 1.4f; b.vy = dir.y * BULLET_SPEED * 1.4f;
-            b.life = BULLET_LIFETIME; b.objIndex = slot; b.angleRad = angleWorld; b.faceSign = faceSign;
-            b.ownerId = isP1 ? 1 : 2; b.damage = 100.0f; b.isBazoka = true; b.trailTimer = 0.0f;
-            if ((int)m_bullets.size() < MAX_BULLETS) {
-                m_bullets.push_back(b);
-            }
+            int slot = m_bazokaBulletPool.Acquire();
+            AddBullet(spawn.x, spawn.y, dir.x * BULLET_SPEED * 1.4f, dir.y * BULLET_SPEED * 1.4f,
+                      isP1 ? 1 : 2, 100.0f, angleWorld, faceSign, true, slot);
             ammoBaz -= 1; UpdateHudAmmoDigits(); StartHudAmmoAnimation(isP1); TryUnequipIfEmpty(43, isP1);
             ch.MarkGunShotFired();
             SoundManager::Instance().PlaySFXByID(24, 0);
@@ -3195,7 +2760,7 @@ void GSPlay::UpdateGunBursts() {
                 if (ammoUzi < 5) { active = false; ch.SetGunMode(false); if (ch.GetMovement()) ch.GetMovement()->SetInputLocked(false); return; }
                 ammoUzi -= 5; UpdateHudAmmoDigits(); StartHudAmmoAnimation(isP1Local); TryUnequipIfEmpty(47, isP1Local);
             }
-            float r = (float)rand() / (float)RAND_MAX; // [0,1]
+            float r = MatchContext::Current().RandomUnit(MatchContext::RNG_WEAPONS); // [0,1)
             float baseJitter = 1.0f;
             if (gunTex == 47) baseJitter = 3.0f;
             float jitter = (r * 2.0f - 1.0f) * baseJitter;
@@ -3267,6 +2832,9 @@ static float MousePixelToWorldY(int y, Camera* cam) {
 }
 
 void GSPlay::HandleMouseEvent(int x, int y, bool bIsPressed) {
+    if (m_recordingActive) {
+        m_recording.AddMouse(m_matchTick, x, y, bIsPressed);
+    }
     if (!bIsPressed) return;
 
     if (m_gameEnded) {
@@ -3297,13 +2865,24 @@ void GSPlay::Pause() {
 }
 
 void GSPlay::Exit() {
+    LogObjectPoolStats();
+    if (m_recordingActive) {
+        m_recording.End(m_matchTick, ComputeStateHash());
+        std::ostringstream path;
+        path << s_recordDirectory << "/match_" << m_recording.GetSeed() << ".bkr";
+        if (m_recording.Save(path.str())) {
+            std::cout << "[Recording] " << m_matchTick << " ticks, " << m_recording.GetEvents().size()
+                      << " input events -> " << path.str() << std::endl;
+        }
+        m_recordingActive = false;
+    }
     SoundManager::Instance().StopMusic();
     HidePauseScreen();
     m_isPaused = false;
 }
 
 void GSPlay::Cleanup() {
-    m_animManager = nullptr;
+    SceneManager::GetInstance()->SetDeferredIdRange(-1, -2, nullptr);
     if (m_inputManager) {
         InputManager::DestroyInstance();
         m_inputManager = nullptr;
@@ -3355,23 +2934,6 @@ void GSPlay::UpdateHealthBars() {
         Vector3 currentScale(scaleRef.x, scaleRef.y, scaleRef.z);
         healthBar2->SetScale(healthRatio2 * 0.18f, currentScale.y, currentScale.z);
     }
-
-    // Update HUD health bars (fixed position)
-    Object* hudHealth1 = sceneManager->GetObject(914);
-    if (hudHealth1) {
-        float healthRatio1 = m_player.GetHealth() / m_player.GetMaxHealth();
-        const Vector3& hudScale1 = hudHealth1->GetScale();
-        // Base width defined in scene file: 0.94
-        hudHealth1->SetScale(healthRatio1 * 0.94f, hudScale1.y, hudScale1.z);
-    }
-
-    Object* hudHealth2 = sceneManager->GetObject(915);
-    if (hudHealth2) {
-        float healthRatio2 = m_player2.GetHealth() / m_player2.GetMaxHealth();
-        const Vector3& hudScale2 = hudHealth2->GetScale();
-        // Base width defined in scene file: 0.94
-        hudHealth2->SetScale(healthRatio2 * 0.94f, hudScale2.y, hudScale2.z);
-    }
 }
 
 void GSPlay::UpdateStaminaBars() {
@@ -3413,78 +2975,30 @@ void GSPlay::UpdateStaminaBars() {
         Vector3 currentScale2(scaleRef2.x, scaleRef2.y, scaleRef2.z);
         staminaBar2->SetScale(staminaRatio2 * 0.18f, currentScale2.y, currentScale2.z);
     }
-
-    if (Object* hudStamina1 = sceneManager->GetObject(932)) {
-        float staminaRatio1 = m_player.GetStamina() / m_player.GetMaxStamina();
-        const Vector3& hudScale1 = hudStamina1->GetScale();
-        hudStamina1->SetScale(staminaRatio1 * 0.94f, hudScale1.y, hudScale1.z);
-    }
-    if (Object* hudStamina2 = sceneManager->GetObject(933)) {
-        float staminaRatio2 = m_player2.GetStamina() / m_player2.GetMaxStamina();
-        const Vector3& hudScale2 = hudStamina2->GetScale();
-        hudStamina2->SetScale(staminaRatio2 * 0.94f, hudScale2.y, hudScale2.z);
-    }
 }
 
-void GSPlay::UpdateCloudMovement(float deltaTime) {
+void GSPlay::SetupSceneBehaviors() {
     SceneManager* sceneManager = SceneManager::GetInstance();
-    
-    int cloudIds[] = {51, 52, 53, 54, 55, 56, 57, 58, 59, 60};
-    
-    for (int cloudId : cloudIds) {
-        Object* cloud = sceneManager->GetObject(cloudId);
-        if (cloud) {
-            const Vector3& currentPos = cloud->GetPosition();
-            float newX = currentPos.x - CLOUD_MOVE_SPEED * deltaTime;
-            cloud->SetPosition(newX, currentPos.y, currentPos.z);
-        }
-    }
-    
-    for (int cloudId : cloudIds) {
-        Object* cloud = sceneManager->GetObject(cloudId);
-        if (cloud) {
-            const Vector3& currentPos = cloud->GetPosition();
-            
-            if (currentPos.x <= CLOUD_LEFT_BOUNDARY) {
-                float rightmostX = -1000.0f;
-                for (int otherCloudId : cloudIds) {
-                    Object* otherCloud = sceneManager->GetObject(otherCloudId);
-                    if (otherCloud) {
-                        const Vector3& otherPos = otherCloud->GetPosition();
-                        if (otherPos.x > rightmostX) {
-                            rightmostX = otherPos.x;
-                        }
-                    }
-                }
-                
-                float newX = rightmostX + CLOUD_SPACING;
-                cloud->SetPosition(newX, currentPos.y, currentPos.z);
-            }
-        }
-    }
-}
+    SceneBehaviors& behaviors = sceneManager->GetBehaviors();
+    behaviors.Clear();
 
-void GSPlay::UpdateFanRotation(float deltaTime) {
-    SceneManager* sceneManager = SceneManager::GetInstance();
-    
-    int fanIds[] = {800, 801, 802, 803, 804, 805, 806, 807, 808, 809, 810, 811, 812, 813, 814};
-    const float FAN_ROTATION_SPEED = 90.0f;
-    
-    for (int fanId : fanIds) {
-        Object* fan = sceneManager->GetObject(fanId);
-        if (fan) {
-            const Vector3& currentRotation = fan->GetRotation();
-            float speed = (fanId == 814) ? (FAN_ROTATION_SPEED * 0.01f) : FAN_ROTATION_SPEED;
-            float newZRotation = currentRotation.z + speed * deltaTime;
+    // Lift platform (Object ID 30): 0.2 units/sec with a 1 second pause at each end
+    behaviors.AddLift(sceneManager->GetObject(30),
+        1.375005f, -1.301985f, 0.0f,
+        1.375005f, 0.217009f, 0.0f,
+        0.2f, 1.0f);
 
-            if (newZRotation >= 360.0f) {
-                newZRotation -= 360.0f;
-            }
+    int clouds = behaviors.AddScrollGroup(CLOUD_MOVE_SPEED, CLOUD_LEFT_BOUNDARY, CLOUD_SPACING);
+    for (int cloudId = 51; cloudId <= 60; ++cloudId) {
+        behaviors.AddToScrollGroup(clouds, sceneManager->GetObject(cloudId));
+    }
 
-            fan->SetRotation(currentRotation.x, currentRotation.y, newZRotation);
-        }
+    const float FAN_ROTATION_SPEED = 90.0f;
+    for (int fanId = 800; fanId <= 814; ++fanId) {
+        float speed = (fanId == 814) ? (FAN_ROTATION_SPEED * 0.01f) : FAN_ROTATION_SPEED;
+        behaviors.AddRotation(sceneManager->GetObject(fanId), SceneBehaviors::AXIS_Z, speed, 360.0f);
     }
-} 
+}
 
 void GSPlay::HandleItemPickup() {
     if (!m_inputManager) return;
@@ -3509,8 +3023,7 @@ void GSPlay::HandleItemPickup() {
     Object* item_kitsune  = scene->GetObject(1508); 
     Object* item_orc      = scene->GetObject(1509);
 
-    const bool* keys = m_inputManager->GetKeyStates();
-    if (!keys) return;
+    const KeyStates& keys = m_inputManager->GetKeyStates();
 
     const PlayerInputConfig& cfg1 = m_player.GetMovement()->GetInputConfig();
     bool p1Sit = keys[cfg1.sitKey];
@@ -3810,12 +3323,7 @@ void GSPlay::SpawnEnergyOrbProjectile(Character& character) {
     }
     
     if (!projectile && m_energyOrbProjectiles.size() < MAX_ENERGY_ORB_PROJECTILES) {
-        m_energyOrbProjectiles.push_back(std::make_unique<EnergyOrbProjectile>());
-        projectile = m_energyOrbProjectiles.back().get();
-        projectile->Initialize();
-        projectile->SetWallCollision(m_wallCollision.get());
-        int attackerId = (&character == &m_player) ? 1 : 2;
-        projectile->SetExplosionCallback([this, attackerId](float x) { SpawnLightningEffect(x, attackerId); });
+        projectile = CreateEnergyOrbProjectile((&character == &m_player) ? 1 : 2);
     }
     
     if (projectile) {
@@ -3834,6 +3342,16 @@ void GSPlay::SpawnEnergyOrbProjectile(Character& character) {
     }
 }
 
+EnergyOrbProjectile* GSPlay::CreateEnergyOrbProjectile(int attackerId) {
+    m_energyOrbProjectiles.push_back(std::make_unique<EnergyOrbProjectile>());
+    EnergyOrbProjectile* projectile = m_energyOrbProjectiles.back().get();
+    projectile->Initialize();
+    projectile->SetWallCollision(m_wallCollision.get());
+    // Runs inside the EnergyOrbs job (or on a detonate key); the strike spawns on the main thread
+    projectile->SetExplosionCallback([this, attackerId](float x) { EmitLightning(m_orbEvents, x, attackerId); });
+    return projectile;
+}
+
 void GSPlay::UpdateEnergyOrbProjectiles(float deltaTime) {
     for (auto& projectile : m_energyOrbProjectiles) {
         if (projectile->IsActive()) {
@@ -3876,7 +3394,7 @@ void GSPlay::SpawnLightningEffect(float x, int attackerId) {
     }
     
     if (lightning) {
-        int objIndex = CreateOrAcquireLightningObject();
+        int objIndex = m_lightningPool.Acquire();
         if (objIndex >= 0) {
             lightning->x = x;
             lightning->lifetime = 0.0f;
@@ -3896,14 +3414,11 @@ void GSPlay::SpawnLightningEffect(float x, int attackerId) {
             lightning->attackerId = attackerId;
             
             // Set lightning object position and scale
-            if (objIndex < (int)m_lightningObjects.size() && m_lightningObjects[objIndex]) {
-                m_lightningObjects[objIndex]->SetPosition(x, 0.0f, 0.0f);
-                m_lightningObjects[objIndex]->SetScale(1.0f, -3.9f, 1.0f);
+            if (Object* obj = m_lightningPool.Get(objIndex)) {
+                obj->SetPosition(x, 0.0f, 0.0f);
+                obj->SetScale(1.0f, -3.9f, 1.0f);
                 
-                float frameWidth = 1.0f / 32.0f;
-                float uStart = 0.0f;
-                float uEnd = frameWidth;
-                m_lightningObjects[objIndex]->SetCustomUV(uStart, 1.0f, uEnd, 0.0f);
+                obj->SetSpriteFrame(0, Object::SPRITE_FLIP_Y);
                 if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
                     cam->AddShake(0.05f, lightning->maxLifetime, 22.0f);
                 }
@@ -3918,27 +3433,20 @@ void GSPlay::UpdateLightningEffects(float deltaTime) {
             lightning.lifetime += deltaTime;
             lightning.frameTimer += deltaTime;
 
-            if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
-                cam->AddShake(0.03f, 0.08f, 22.0f);
-            }
+            EmitShake(m_lightningEvents, 0.03f, 0.08f, 22.0f);
             
             if (lightning.frameTimer >= lightning.frameDuration) {
                 lightning.frameTimer = 0.0f;
                 lightning.currentFrame++;
                 
-                if (lightning.objectIndex >= 0 && lightning.objectIndex < (int)m_lightningObjects.size() && m_lightningObjects[lightning.objectIndex]) {
-                    float frameWidth = 1.0f / 32.0f;
-                    float uStart = lightning.currentFrame * frameWidth;
-                    float uEnd = uStart + frameWidth;
-                    m_lightningObjects[lightning.objectIndex]->SetCustomUV(uStart, 1.0f, uEnd, 0.0f); 
+                if (Object* obj = m_lightningPool.Get(lightning.objectIndex)) {
+                    obj->SetSpriteFrame(lightning.currentFrame, Object::SPRITE_FLIP_Y);
                 }
             }
             
             if (lightning.lifetime >= lightning.maxLifetime) {
                 lightning.isActive = false;
-                if (lightning.objectIndex >= 0 && lightning.objectIndex < (int)m_freeLightningSlots.size()) {
-                    m_freeLightningSlots.push_back(lightning.objectIndex);
-                }
+                m_lightningPool.Release(lightning.objectIndex);
             }
         }
     }
@@ -3946,96 +3454,352 @@ void GSPlay::UpdateLightningEffects(float deltaTime) {
 
 void GSPlay::DrawLightningEffects(Camera* camera) {
     for (auto& lightning : m_lightningEffects) {
-        if (lightning.isActive && lightning.objectIndex >= 0 && lightning.objectIndex < (int)m_lightningObjects.size()) {
-            if (m_lightningObjects[lightning.objectIndex]) {
-                m_lightningObjects[lightning.objectIndex]->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
+        if (lightning.isActive) {
+            if (Object* obj = m_lightningPool.Get(lightning.objectIndex)) {
+                obj->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
             }
         }
     }
 }
 
-int GSPlay::CreateOrAcquireLightningObject() {
-    if (!m_freeLightningSlots.empty()) {
-        int idx = m_freeLightningSlots.back();
-        m_freeLightningSlots.pop_back();
-        if (m_lightningObjects[idx]) {
-            m_lightningObjects[idx]->SetVisible(true);
+void GSPlay::RunCollisionPhase() {
+    BuildCollisionWorld();
+    m_collisionWorld.GeneratePairs(m_collisionPairs);
+    ResolveCollisionPairs();
+
+    m_releasedBulletSlots.clear();
+    m_bullets.Compact(m_releasedBulletSlots);
+    for (const BulletSystem::Released& r : m_releasedBulletSlots) {
+        ReleaseBulletObject(r.objIndex, (r.flags & BulletSystem::FLAG_BAZOKA) != 0);
+    }
+
+    ApplyCombatEvents();
+}
+
+void GSPlay::BuildCollisionWorld() {
+    typedef CollisionWorld CW;
+    m_collisionWorld.Clear();
+
+    Character* players[2] = { &m_player, &m_player2 };
+    for (int p = 0; p < 2; ++p) {
+        const Character& ch = *players[p];
+        Vector3 pos = ch.GetPosition();
+        float hx = pos.x + ch.GetHurtboxOffsetX();
+        float hy = pos.y + ch.GetHurtboxOffsetY();
+        float halfW = ch.GetHurtboxWidth() * 0.5f;
+        float halfH = ch.GetHurtboxHeight() * 0.5f;
+        m_collisionWorld.Add(CW::LAYER_HURTBOX, 0, hx - halfW, hx + halfW, hy - halfH, hy + halfH,
+                             SOURCE_PLAYER, p, (uint8_t)(p + 1));
+    }
+
+    // Registration order is the order events are emitted in
+    for (int p = 0; p < 2; ++p) {
+        CharacterAnimation* anim = players[p]->GetAnimation();
+        if (!anim || !anim->IsOrcFireActive()) continue;
+        float l, r, b, t; anim->GetOrcFireAabb(l, r, b, t);
+        const float DAMAGE_Y_SCALE = 0.7f;
+        float centerY = 0.5f * (b + t);
+        float halfH = 0.5f * (t - b) * DAMAGE_Y_SCALE;
+        m_collisionWorld.Add(CW::LAYER_HITBOX, CW::LAYER_HURTBOX, l, r, centerY - halfH, centerY + halfH,
+                             SOURCE_ORC_FIRE, p, (uint8_t)(p + 1));
+    }
+    for (int p = 0; p < 2; ++p) {
+        CharacterAnimation* anim = players[p]->GetAnimation();
+        if (!anim || !anim->IsBatWindActive() || anim->HasBatWindDealtDamage()) continue;
+        float l, r, b, t; anim->GetBatWindAabb(l, r, b, t);
+        m_collisionWorld.Add(CW::LAYER_HITBOX, CW::LAYER_HURTBOX, l, r, b, t,
+                             SOURCE_BAT_WIND, p, (uint8_t)(p + 1));
+    }
+
+    const float bulletHalfW = BULLET_COLLISION_WIDTH * 0.5f;
+    const float bulletHalfH = BULLET_COLLISION_HEIGHT * 0.5f;
+    for (int i = 0; i < m_bullets.Size(); ++i) {
+        if (m_bullets.IsDead(i)) continue;
+        float x = m_bullets.GetX(i), y = m_bullets.GetY(i);
+        m_collisionWorld.Add(CW::LAYER_PROJECTILE, CW::LAYER_HURTBOX, x - bulletHalfW, x + bulletHalfW, y - bulletHalfH, y + bulletHalfH,
+                             SOURCE_BULLET, i, (uint8_t)m_bullets.GetOwnerId(i));
+    }
+
+    const float rainHalfW = FIRE_RAIN_DAMAGE_W * 0.5f;
+    const float rainHalfH = FIRE_RAIN_DAMAGE_H * 0.5f;
+    for (int i = 0; i < (int)m_fireRains.size(); ++i) {
+        const FireRain& fr = m_fireRains[i];
+        if (!fr.isActive || !fr.isFading) continue;
+        if (fr.damagedP1 && fr.damagedP2) continue;
+        m_collisionWorld.Add(CW::LAYER_HAZARD, CW::LAYER_HURTBOX, fr.position.x - rainHalfW, fr.position.x + rainHalfW,
+                             fr.position.y - rainHalfH, fr.position.y + rainHalfH,
+                             SOURCE_FIRE_RAIN, i, (uint8_t)fr.attackerId);
+    }
+
+    for (int i = 0; i < (int)m_lightningEffects.size(); ++i) {
+        const LightningEffect& lightning = m_lightningEffects[i];
+        if (!lightning.isActive || lightning.hasDealtDamage) continue;
+        m_collisionWorld.Add(CW::LAYER_HAZARD, CW::LAYER_HURTBOX, lightning.hitboxLeft, lightning.hitboxRight,
+                             lightning.hitboxBottom, lightning.hitboxTop,
+                             SOURCE_LIGHTNING, i, (uint8_t)lightning.attackerId);
+    }
+
+    // Explosions only get one chance to deal damage
+    for (int i = 0; i < (int)m_explosions.size(); ++i) {
+        Explosion& e = m_explosions[i];
+        if (!e.damagePending) continue;
+        e.damagePending = false;
+        float halfW = 0.15f, halfH = 0.15f;
+        if (Object* obj = m_explosionPool.Get(e.objIdx)) {
+            const Vector3& sc = obj->GetScale();
+            float mul = (e.damageRadiusMul > 0.0f) ? e.damageRadiusMul : EXPLOSION_DAMAGE_RADIUS_MUL;
+            halfW = fabsf(sc.x) * 0.5f * mul;
+            halfH = fabsf(sc.y) * 0.5f * mul;
+        }
+        m_collisionWorld.Add(CW::LAYER_HAZARD, CW::LAYER_HURTBOX, e.x - halfW, e.x + halfW, e.y - halfH, e.y + halfH,
+                             SOURCE_EXPLOSION, i, (uint8_t)e.attackerId);
+    }
+
+    for (int p = 0; p < 2; ++p) {
+        const Character& ch = *players[p];
+        if (!ch.IsHitboxActive()) continue;
+        Vector3 pos = ch.GetPosition();
+        float hx = pos.x + ch.GetHitboxOffsetX();
+        float hy = pos.y + ch.GetHitboxOffsetY();
+        float halfW = ch.GetHitboxWidth() * 0.5f;
+        float halfH = ch.GetHitboxHeight() * 0.5f;
+        m_collisionWorld.Add(CW::LAYER_HITBOX, CW::LAYER_HURTBOX, hx - halfW, hx + halfW, hy - halfH, hy + halfH,
+                             SOURCE_MELEE, p, (uint8_t)(p + 1));
+    }
+}
+
+void GSPlay::ResolveCollisionPairs() {
+    typedef CombatEvent CE;
+    for (const CollisionWorld::Pair& pair : m_collisionPairs) {
+        const CollisionWorld::Collider& src = m_collisionWorld.Get(pair.collider);
+        const CollisionWorld::Collider& dst = m_collisionWorld.Get(pair.other);
+        if (dst.kind != SOURCE_PLAYER) continue;
+
+        const int t = dst.source;
+        const int targetId = t + 1;
+        Character& target = (t == 0) ? m_player : m_player2;
+        const bool invincible = IsCharacterInvincible(target);
+
+        switch (src.kind) {
+        case SOURCE_ORC_FIRE:
+            if (src.owner == targetId || invincible) break;
+            EmitDamage(t, src.owner, 100.0f, CE::DAMAGE_SCORE | CE::DAMAGE_CANCEL_COMBOS);
+            break;
+
+        case SOURCE_BAT_WIND: {
+            if (src.owner == targetId) break;
+            Character& source = (src.source == 0) ? m_player : m_player2;
+            CharacterAnimation* anim = source.GetAnimation();
+            if (!anim || anim->HasBatWindDealtDamage()) break;
+            EmitDamage(t, src.owner, 100.0f, CE::DAMAGE_SCORE | CE::DAMAGE_CANCEL_COMBOS);
+            anim->MarkBatWindDealtDamage();
+            break;
+        }
+
+        case SOURCE_BULLET: {
+            const int i = src.source;
+            if (src.owner == targetId || m_bullets.IsDead(i)) break;
+            // An invincible target still absorbs the bullet
+            m_bullets.Kill(i);
+            if (invincible) break;
+            const float bx = m_bullets.GetX(i);
+            const float by = m_bullets.GetY(i);
+            float dmg = m_bullets.GetDamage(i) > 0.0f ? m_bullets.GetDamage(i) : 10.0f;
+            EmitDamage(t, src.owner, dmg, CE::DAMAGE_SCORE | CE::DAMAGE_CANCEL_COMBOS | CE::DAMAGE_DIE_FROM_ATTACK);
+            EmitBlood(bx, by, m_bullets.GetAngle(i));
+            if (m_bullets.IsBazoka(i)) {
+                EmitExplosion(bx, by, BAZOKA_EXPLOSION_RADIUS_MUL, src.owner);
+                EmitShake(0.03f, 0.35f, 18.0f);
+            }
+            break;
+        }
+
+        case SOURCE_FIRE_RAIN: {
+            FireRain& fr = m_fireRains[src.source];
+            bool& alreadyDamaged = (t == 0) ? fr.damagedP1 : fr.damagedP2;
+            if (alreadyDamaged || invincible) break;
+            EmitSFX(27);
+            if (src.owner > 0) {
+                // The caster is not hurt by their own rain but still gets interrupted
+                float dmg = (src.owner != targetId) ? 100.0f : 0.0f;
+                EmitDamage(t, src.owner, dmg, CE::DAMAGE_SCORE | CE::DAMAGE_CANCEL_COMBOS);
+            } else {
+                EmitDamage(t, 0, 100.0f, CE::DAMAGE_SELF_DEATH | CE::DAMAGE_CANCEL_COMBOS);
+            }
+            alreadyDamaged = true;
+            break;
+        }
+
+        case SOURCE_LIGHTNING:
+            if (invincible) break;
+            if (src.owner > 0) {
+                EmitDamage(t, src.owner, 100.0f, CE::DAMAGE_SCORE);
+            } else {
+                EmitDamage(t, 0, 100.0f, CE::DAMAGE_SELF_DEATH);
+            }
+            m_lightningEffects[src.source].hasDealtDamage = true;
+            break;
+
+        case SOURCE_EXPLOSION: {
+            // radial falloff by distance to center
+            const Explosion& e = m_explosions[src.source];
+            float dx = m_collisionWorld.GetCenterX(pair.other) - e.x;
+            float dy = m_collisionWorld.GetCenterY(pair.other) - e.y;
+            float dist = sqrtf(dx*dx + dy*dy);
+            float halfW = m_collisionWorld.GetHalfWidth(pair.collider);
+            float halfH = m_collisionWorld.GetHalfHeight(pair.collider);
+            float maxR = (halfW > halfH ? halfW : halfH);
+            float ratio = 1.0f - (dist / (maxR + 1e-6f));
+            if (ratio < 0.0f) ratio = 0.0f;
+            if (ratio > 1.0f) ratio = 1.0f;
+            float damage = 100.0f * ratio;
+            if (damage <= 0.0f || invincible) break;
+            uint8_t flags = CE::DAMAGE_CANCEL_COMBOS | CE::DAMAGE_DEATH_IF_DEAD;
+            if (src.owner > 0 && src.owner != targetId) flags |= CE::DAMAGE_SCORE;
+            EmitDamage(t, src.owner, damage, flags);
+            break;
+        }
+
+        case SOURCE_MELEE: {
+            if (src.owner == targetId || invincible) break;
+            Character& attacker = (src.source == 0) ? m_player : m_player2;
+            CharacterAnimation* anim = attacker.GetAnimation();
+            bool werewolfHeavy = attacker.IsWerewolf() && anim &&
+                (((anim->GetCurrentAnimation() == 1 || anim->GetCurrentAnimation() == 3) && attacker.IsAnimationPlaying()) ||
+                 anim->IsWerewolfComboHitWindowActive());
+            EmitDamage(t, src.owner, werewolfHeavy ? 100.0f : 0.0f, CE::DAMAGE_SCORE | CE::DAMAGE_GET_HIT);
+            break;
+        }
+
+        default:
+            break;
         }
-        return idx;
     }
-    
-    std::unique_ptr<Object> obj = std::make_unique<Object>(60000 + (int)m_lightningObjects.size());
-    
-    obj->SetModel(0);
-    obj->SetTexture(64, 0);
-    obj->SetShader(0);
-    obj->SetScale(1.0f, -3.6f, 1.0f);
-    obj->SetVisible(true);
-    
-    obj->MakeModelInstanceCopy();
-    
-    m_lightningObjects.push_back(std::move(obj));
-    return (int)m_lightningObjects.size() - 1;
 }
 
-void GSPlay::CheckLightningDamage() {
-    for (auto& lightning : m_lightningEffects) {
-        if (lightning.isActive && !lightning.hasDealtDamage) {
-            Vector3 playerPos = m_player.GetPosition();
-            float playerHurtboxX = playerPos.x + m_player.GetHurtboxOffsetX();
-            float playerHurtboxY = playerPos.y + m_player.GetHurtboxOffsetY();
-            float playerHurtboxLeft = playerHurtboxX - m_player.GetHurtboxWidth() * 0.5f;
-            float playerHurtboxRight = playerHurtboxX + m_player.GetHurtboxWidth() * 0.5f;
-            float playerHurtboxTop = playerHurtboxY + m_player.GetHurtboxHeight() * 0.5f;
-            float playerHurtboxBottom = playerHurtboxY - m_player.GetHurtboxHeight() * 0.5f;
-            
-            bool collisionX1 = lightning.hitboxRight >= playerHurtboxLeft && lightning.hitboxLeft <= playerHurtboxRight;
-            bool collisionY1 = lightning.hitboxTop >= playerHurtboxBottom && lightning.hitboxBottom <= playerHurtboxTop;
-            
-            if (collisionX1 && collisionY1) {
-                if (!IsCharacterInvincible(m_player)) {
-                    if (lightning.attackerId > 0) {
-                        Character& attacker = (lightning.attackerId == 1) ? m_player : m_player2;
-                        ProcessDamageAndScore(attacker, m_player, 100.0f);
-                    } else {
-                        float prevHealth = m_player.GetHealth();
-                        m_player.TakeDamage(100);
-                        if (prevHealth > 0.0f && m_player.GetHealth() <= 0.0f) {
-                            ProcessSelfDeath(m_player);
-                        }
+void GSPlay::ApplyCombatEvents() {
+    typedef CombatEvent CE;
+    for (const CombatEvent& e : m_combatEvents) {
+        switch (e.type) {
+        case CE::EVENT_DAMAGE: {
+            Character& target = (e.target == 0) ? m_player : m_player2;
+            Character* attacker = (e.attacker == 1) ? &m_player : (e.attacker == 2) ? &m_player2 : nullptr;
+            if (e.value > 0.0f) {
+                if ((e.flags & CE::DAMAGE_SCORE) && attacker) {
+                    ProcessDamageAndScore(*attacker, target, e.value);
+                } else {
+                    float prev = target.GetHealth();
+                    target.TakeDamage(e.value);
+                    if ((e.flags & CE::DAMAGE_SELF_DEATH) && prev > 0.0f && target.GetHealth() <= 0.0f) {
+                        ProcessSelfDeath(target);
                     }
-                    lightning.hasDealtDamage = true;
                 }
             }
-            
-            Vector3 player2Pos = m_player2.GetPosition();
-            float player2HurtboxX = player2Pos.x + m_player2.GetHurtboxOffsetX();
-            float player2HurtboxY = player2Pos.y + m_player2.GetHurtboxOffsetY();
-            float player2HurtboxLeft = player2HurtboxX - m_player2.GetHurtboxWidth() * 0.5f;
-            float player2HurtboxRight = player2HurtboxX + m_player2.GetHurtboxWidth() * 0.5f;
-            float player2HurtboxTop = player2HurtboxY + m_player2.GetHurtboxHeight() * 0.5f;
-            float player2HurtboxBottom = player2HurtboxY - m_player2.GetHurtboxHeight() * 0.5f;
-            
-            bool collisionX2 = lightning.hitboxRight >= player2HurtboxLeft && lightning.hitboxLeft <= player2HurtboxRight;
-            bool collisionY2 = lightning.hitboxTop >= player2HurtboxBottom && lightning.hitboxBottom <= player2HurtboxTop;
-            
-            if (collisionX2 && collisionY2) {
-                if (!IsCharacterInvincible(m_player2)) {
-                    if (lightning.attackerId > 0) {
-                        Character& attacker = (lightning.attackerId == 1) ? m_player : m_player2;
-                        ProcessDamageAndScore(attacker, m_player2, 100.0f);
-                    } else {
-                        float prevHealth = m_player2.GetHealth();
-                        m_player2.TakeDamage(100);
-                        if (prevHealth > 0.0f && m_player2.GetHealth() <= 0.0f) {
-                            ProcessSelfDeath(m_player2);
-                        }
-                    }
-                    lightning.hasDealtDamage = true;
-                }
+            if ((e.flags & CE::DAMAGE_GET_HIT) && attacker) {
+                target.TriggerGetHit(*attacker);
+            }
+            if (e.flags & CE::DAMAGE_CANCEL_COMBOS) {
+                target.CancelAllCombos();
+                if (CharacterMovement* mv = target.GetMovement()) { mv->SetInputLocked(false); }
+            }
+            if ((e.flags & CE::DAMAGE_DIE_FROM_ATTACK) && attacker && target.GetHealth() <= 0.0f) {
+                target.TriggerDieFromAttack(*attacker);
+            }
+            if ((e.flags & CE::DAMAGE_DEATH_IF_DEAD) && target.GetHealth() <= 0.0f) {
+                ProcessSelfDeath(target);
+            }
+            break;
+        }
+        case CE::EVENT_SFX:
+            SoundManager::Instance().PlaySFXByID(e.sfxId, 0);
+            break;
+        case CE::EVENT_SHAKE:
+            if (Camera* cam = SceneManager::GetInstance()->GetActiveCamera()) {
+                cam->AddShake(e.value, e.x, e.y);
             }
+            break;
+        case CE::EVENT_EXPLOSION:
+            SpawnExplosionAt(e.x, e.y, e.value, e.attacker);
+            break;
+        case CE::EVENT_BLOOD:
+            SpawnBloodAt(e.x, e.y, e.angle);
+            break;
+        case CE::EVENT_LIGHTNING:
+            SpawnLightningEffect(e.x, e.attacker);
+            break;
         }
     }
+    m_combatEvents.clear();
+}
+
+void GSPlay::EmitDamage(int target, int attackerId, float damage, uint8_t flags) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_DAMAGE;
+    e.flags = flags;
+    e.target = (uint8_t)target;
+    e.attacker = (uint8_t)attackerId;
+    e.value = damage;
+    m_combatEvents.push_back(e);
+}
+
+void GSPlay::EmitSFX(int sfxId) {
+    EmitSFX(m_combatEvents, sfxId);
+}
+
+void GSPlay::EmitShake(float amplitude, float duration, float frequency) {
+    EmitShake(m_combatEvents, amplitude, duration, frequency);
+}
+
+void GSPlay::EmitExplosion(float x, float y, float radiusMul, int attackerId) {
+    EmitExplosion(m_combatEvents, x, y, radiusMul, attackerId);
+}
+
+void GSPlay::EmitSFX(std::vector<CombatEvent>& out, int sfxId) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_SFX;
+    e.sfxId = sfxId;
+    out.push_back(e);
+}
+
+void GSPlay::EmitShake(std::vector<CombatEvent>& out, float amplitude, float duration, float frequency) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_SHAKE;
+    e.value = amplitude;
+    e.x = duration;
+    e.y = frequency;
+    out.push_back(e);
+}
+
+void GSPlay::EmitExplosion(std::vector<CombatEvent>& out, float x, float y, float radiusMul, int attackerId) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_EXPLOSION;
+    e.attacker = (uint8_t)attackerId;
+    e.value = radiusMul;
+    e.x = x;
+    e.y = y;
+    out.push_back(e);
+}
+
+void GSPlay::EmitLightning(std::vector<CombatEvent>& out, float x, int attackerId) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_LIGHTNING;
+    e.attacker = (uint8_t)attackerId;
+    e.x = x;
+    out.push_back(e);
+}
+
+void GSPlay::AppendCombatEvents(std::vector<CombatEvent>& events) {
+    m_combatEvents.insert(m_combatEvents.end(), events.begin(), events.end());
+    events.clear();
+}
+
+void GSPlay::EmitBlood(float x, float y, float angle) {
+    CombatEvent e{};
+    e.type = CombatEvent::EVENT_BLOOD;
+    e.x = x;
+    e.y = y;
+    e.angle = angle;
+    m_combatEvents.push_back(e);
 }
 
 void GSPlay::InitializeRespawnSlots() {
@@ -4177,7 +3941,7 @@ int GSPlay::ChooseRandomRespawnPosition() {
     }
     
     if (!availablePositions.empty()) {
-        static std::mt19937 rng{ std::random_device{}() };
+        std::mt19937& rng = MatchContext::Current().GetRng(MatchContext::RNG_RESPAWN);
         std::uniform_int_distribution<int> dist(0, (int)availablePositions.size() - 1);
         int randomIndex = dist(rng);
         return availablePositions[randomIndex];
@@ -4314,50 +4078,15 @@ void GSPlay::UpdateTimeDisplay() {
 }
 
 void GSPlay::UpdateTimeDigit(int digitPosition, int digitValue) {
-    if (digitPosition < 0 || digitPosition >= (int)m_timeDigitObjects.size()) {
-        return;
-    }
-    
-    auto& digitObj = m_timeDigitObjects[digitPosition];
-    if (!digitObj) {
+    if (digitPosition < 0 || digitPosition >= 5) {
         return;
     }
-    
-    bool isWarningTime = (m_gameTimer <= WARNING_TIME);
-    
-    if (digitValue == -1) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
-        if (font) {
-            SDL_Color color = isWarningTime ? SDL_Color{255, 0, 0, 255} : SDL_Color{255, 255, 255, 255};
-            SDL_Surface* surf = TTF_RenderUTF8_Blended(font, ":", color);
-            if (surf) {
-                auto colonTexture = std::make_shared<Texture2D>();
-                if (colonTexture->LoadFromSDLSurface(surf)) {
-                    colonTexture->SetSharpFiltering();
-                    digitObj->SetDynamicTexture(colonTexture);
-                }
-                SDL_FreeSurface(surf);
-            }
-            TTF_CloseFont(font);
-        }
+    if (digitValue != -1 && (digitValue < 0 || digitValue > 9)) {
         return;
     }
     
-    if (digitValue >= 0 && digitValue <= 9) {
-        if (isWarningTime) {
-            if (digitValue < (int)m_redDigitTextures.size() && m_redDigitTextures[digitValue]) {
-                digitObj->SetDynamicTexture(m_redDigitTextures[digitValue]);
-            }
-        } else {
-            if (digitValue < (int)m_digitTextures.size() && m_digitTextures[digitValue]) {
-                digitObj->SetDynamicTexture(m_digitTextures[digitValue]);
-            }
-        }
-    }
+    const GlyphAtlas::Color color = (m_gameTimer <= WARNING_TIME) ? GlyphAtlas::RED : GlyphAtlas::WHITE;
+    m_hudText.SetGlyph(m_timeCells + digitPosition, digitValue == -1 ? ':' : (char)('0' + digitValue), color);
 }
 
 void GSPlay::UpdateScoreDisplay() {
@@ -4379,22 +4108,10 @@ void GSPlay::UpdateScoreDisplay() {
 void GSPlay::UpdateScoreDigit(int playerId, int digitPosition, int digitValue) {
     if (digitValue < 0 || digitValue > 9) return;
     if (digitPosition < 0 || digitPosition > 4) return;
+    if (playerId != 1 && playerId != 2) return;
     
-    std::vector<std::shared_ptr<Object>>* digitObjects = nullptr;
-    if (playerId == 1) {
-        digitObjects = &m_scoreDigitObjectsP1;
-    } else if (playerId == 2) {
-        digitObjects = &m_scoreDigitObjectsP2;
-    } else {
-        return;
-    }
-    
-    if (digitPosition >= (int)digitObjects->size()) return;
-    
-    auto& digitObj = (*digitObjects)[digitPosition];
-    if (digitObj && digitValue < (int)m_digitTextures.size() && m_digitTextures[digitValue]) {
-        digitObj->SetDynamicTexture(m_digitTextures[digitValue]);
-    }
+    const int firstCell = (playerId == 1) ? m_scoreCellsP1 : m_scoreCellsP2;
+    m_hudText.SetGlyph(firstCell + digitPosition, (char)('0' + digitValue));
 }
 
 void GSPlay::ProcessDamageAndScore(Character& attacker, Character& target, float damage) {
@@ -4597,11 +4314,7 @@ void GSPlay::UpdateWinnerText() {
         winnerText = "DRAW";
     }
     
-    if (TTF_WasInit() == 0) {
-        TTF_Init();
-    }
-    
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+    TTF_Font* font = OpenHudFont(64);
     if (font) {
         SDL_Color color = {255, 0, 0, 255};
         SDL_Surface* surf = TTF_RenderUTF8_Blended(font, winnerText, color);
@@ -4624,11 +4337,7 @@ void GSPlay::UpdateFinalScoreText() {
     Object* finalScoreObj = scene->GetObject(960);
     if (!finalScoreObj) return;
     
-    if (TTF_WasInit() == 0) {
-        TTF_Init();
-    }
-    
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+    TTF_Font* font = OpenHudFont(64);
     if (font) {
         SDL_Color color = {0, 0, 255, 255}; 
         SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "FINAL SCORE", color);
@@ -4651,11 +4360,7 @@ void GSPlay::UpdatePlayerScoreLabels() {
     
     Object* playerLabelObj = scene->GetObject(968);
     if (playerLabelObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "PLAYER", color);
@@ -4673,11 +4378,7 @@ void GSPlay::UpdatePlayerScoreLabels() {
     
     Object* scoreLabelObj = scene->GetObject(969);
     if (scoreLabelObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "SCORE", color);
@@ -4701,11 +4402,7 @@ void GSPlay::UpdatePlayerLabels() {
     
     Object* p1LabelObj = scene->GetObject(970);
     if (p1LabelObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "P1", color);
@@ -4723,11 +4420,7 @@ void GSPlay::UpdatePlayerLabels() {
     
     Object* p2LabelObj = scene->GetObject(971);
     if (p2LabelObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             SDL_Surface* surf = TTF_RenderUTF8_Blended(font, "P2", color);
@@ -4751,11 +4444,7 @@ void GSPlay::UpdatePlayerScores() {
     
     Object* p1ScoreObj = scene->GetObject(972);
     if (p1ScoreObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             char scoreText[6];
@@ -4775,11 +4464,7 @@ void GSPlay::UpdatePlayerScores() {
     
     Object* p2ScoreObj = scene->GetObject(973);
     if (p2ScoreObj) {
-        if (TTF_WasInit() == 0) {
-            TTF_Init();
-        }
-        
-        TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+        TTF_Font* font = OpenHudFont(64);
         if (font) {
             SDL_Color color = {0, 0, 0, 255};
             char scoreText[6];
@@ -4799,6 +4484,7 @@ void GSPlay::UpdatePlayerScores() {
 }
 
 void GSPlay::ResetGame() {
+    m_hud.Invalidate();
     m_gameEnded = false;
     m_gameTime = 0.0f;
     m_gameTimer = GAME_DURATION;
@@ -4822,20 +4508,10 @@ void GSPlay::ResetGame() {
     m_p2GrenadeExplodedInHand = false;
     
     if (m_player.GetAnimation()) {
-        m_player.GetAnimation()->Initialize(m_animManager, 1000);
-    }
-    
-    auto animManager2 = std::make_shared<AnimationManager>();
-    const TextureData* textureData2 = ResourceManager::GetInstance()->GetTextureData(11);
-    if (textureData2 && textureData2->spriteWidth > 0 && textureData2->spriteHeight > 0) {
-        std::vector<AnimationData> animations2;
-        for (const auto& anim : textureData2->animations) {
-            animations2.push_back({anim.startFrame, anim.numFrames, anim.duration, 0.0f});
-        }
-        animManager2->Initialize(textureData2->spriteWidth, textureData2->spriteHeight, animations2);
+        m_player.GetAnimation()->Initialize(10, 1000);
     }
     if (m_player2.GetAnimation()) {
-        m_player2.GetAnimation()->Initialize(animManager2, 1001);
+        m_player2.GetAnimation()->Initialize(11, 1001);
     }
     
     // Reset health and stamina
@@ -5024,7 +4700,7 @@ void GSPlay::HandleEndScreenInput(int x, int y, bool isPressed) {
         if (worldX >= buttonLeft && worldX <= buttonRight && 
             worldY >= buttonBottom && worldY <= buttonTop) {
             SoundManager::Instance().PlaySFXByID(33, 0);
-            ResetGame();
+            RestoreMatchStart();
             return;
         }
     }
@@ -5053,13 +4729,8 @@ void GSPlay::HandleEndScreenInput(int x, int y, bool isPressed) {
 }
 
 void GSPlay::CreatePauseTextTexture() {
-    if (TTF_WasInit() == 0) {
-        TTF_Init();
-    }
-    
-    TTF_Font* font = TTF_OpenFont("../Resources/Font/PressStart2P-Regular.ttf", 64);
+    TTF_Font* font = OpenHudFont(64);
     if (!font) {
-        std::cout << "Failed to load font for pause text: " << TTF_GetError() << std::endl;
         return;
     }
     
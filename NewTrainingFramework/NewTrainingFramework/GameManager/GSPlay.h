@@ -2,46 +2,61 @@
 #include "GameStateBase.h"
 #include "SceneManager.h"
 #include "../GameObject/AnimationManager.h"
+#include "../GameObject/AnimationBatch.h"
 #include "../GameObject/Character.h"
 #include "../GameObject/InputManager.h"
 #include "../GameObject/WallCollision.h"
 #include "../GameObject/EnergyOrbProjectile.h"
+#include "../GameObject/BulletSystem.h"
+#include "../GameObject/Pool.h"
+#include "../GameObject/CollisionWorld.h"
+#include "../GameObject/TextBatch.h"
+#include "FrameGraph.h"
+#include "HudLayer.h"
+#include "MatchRecording.h"
 #include "../../Utilities/Math.h"
 #include <vector>
+#include <string>
 #include <unordered_map>
 
 class GSPlay : public GameStateBase {
 private:
     float m_gameTime;
+    Character m_player;
+    Character m_player2;
+    InputManager* m_inputManager;
     
 
     static const int ANIM_OBJECT_ID = 1000;
-    std::shared_ptr<AnimationManager> m_animManager;
     
     static bool s_showHitboxHurtbox;
     static bool s_showPlatformBoxes;
     static bool s_showWallBoxes;
     static bool s_showLadderBoxes;
     static bool s_showTeleportBoxes;
+
+    // Input recording; matches are written to s_recordDirectory when it is set
+    static std::string s_recordDirectory;
+    MatchRecording m_recording;
+    bool m_recordingActive = false;
+    uint32_t m_matchTick = 0;   // Update() calls since Init
+    void BeginInputTick();
+
+    std::vector<uint8_t> m_matchStartSnapshot;
+    std::vector<int> m_itemObjectScratch;
+    template <class Archive>
+    void TransferState(Archive& ar);
+    void RestoreItemObjects();
+    void RestoreMatchStart();
     
     // Health system variables
     float m_player1Health;
     float m_player2Health;
     const float MAX_HEALTH = 100.0f;
     const float HEALTH_DAMAGE = 10.0f; // Máu mất mỗi lần nhấn T
-    
-    // Cloud movement system
-    float m_cloudSpeed;
-    struct Bullet {
-        float x; float y;
-        float vx; float vy;
-        float life; int objIndex;
-        float angleRad; float faceSign;
-        int ownerId; float damage;
-        bool isBazoka = false;
-        float trailTimer = 0.0f;
-    };
-    std::vector<Bullet> m_bullets;
+    BulletSystem m_bullets;
+    std::vector<BulletSystem::Hit> m_bulletHits;
+    std::vector<BulletSystem::Released> m_releasedBulletSlots;
     static constexpr int MAX_BULLETS = 10000;
     const float BULLET_SPEED = 3.5f;
     const float BULLET_LIFETIME = 2.0f;
@@ -51,11 +66,97 @@ private:
     const float BULLET_COLLISION_HEIGHT = 0.02f;
     int m_bulletObjectId = 1300;
     int m_bazokaBulletObjectId = 1301;
-    std::vector<std::unique_ptr<Object>> m_bulletObjs;
-    std::vector<int> m_freeBulletSlots;
-    int CreateOrAcquireBulletObject();
-    int CreateOrAcquireBulletObjectFromProto(int protoObjectId);
+    Pool<Object> m_bulletPool;
+    Pool<Object> m_bazokaBulletPool;
+    void ReleaseBulletObject(int objIndex, bool isBazoka);
+    void AddBullet(float x, float y, float vx, float vy, int ownerId, float damage,
+                   float angleRad, float faceSign, bool isBazoka, int objIndex);
     void DrawBullets(Camera* cam);
+
+    // Collision phase: every damage source registers its boxes once per tick,
+    // overlaps are resolved into combat events and the events are applied in one batch
+    enum CombatSource : uint8_t {
+        SOURCE_PLAYER,
+        SOURCE_ORC_FIRE,
+        SOURCE_BAT_WIND,
+        SOURCE_BULLET,
+        SOURCE_FIRE_RAIN,
+        SOURCE_LIGHTNING,
+        SOURCE_EXPLOSION,
+        SOURCE_MELEE,
+    };
+    struct CombatEvent {
+        enum Type : uint8_t {
+            EVENT_DAMAGE,
+            EVENT_SFX,
+            EVENT_SHAKE,
+            EVENT_EXPLOSION,
+            EVENT_BLOOD,
+            EVENT_LIGHTNING,
+        };
+        enum DamageFlags : uint8_t {
+            DAMAGE_SCORE           = 1 << 0, // credit the attacker through ProcessDamageAndScore
+            DAMAGE_SELF_DEATH      = 1 << 1, // unscored damage that kills counts as a self death
+            DAMAGE_DEATH_IF_DEAD   = 1 << 2, // ProcessSelfDeath whenever the target ends at 0 health
+            DAMAGE_DIE_FROM_ATTACK = 1 << 3,
+            DAMAGE_CANCEL_COMBOS   = 1 << 4, // also unlocks movement input
+            DAMAGE_GET_HIT         = 1 << 5,
+        };
+        uint8_t type;
+        uint8_t flags;
+        uint8_t target;    // 0 = player 1, 1 = player 2
+        uint8_t attacker;  // player id, 0 when none
+        int sfxId;
+        float value;       // damage, explosion radius multiplier or shake amplitude
+        float x; float y;  // world position; shake duration and frequency
+        float angle;
+    };
+    CollisionWorld m_collisionWorld;
+    std::vector<CollisionWorld::Pair> m_collisionPairs;
+    std::vector<CombatEvent> m_combatEvents;
+    void RunCollisionPhase();
+    void BuildCollisionWorld();
+    void ResolveCollisionPairs();
+    void ApplyCombatEvents();
+    void EmitDamage(int target, int attackerId, float damage, uint8_t flags);
+    void EmitSFX(int sfxId);
+    void EmitShake(float amplitude, float duration, float frequency);
+    void EmitExplosion(float x, float y, float radiusMul, int attackerId);
+    void EmitBlood(float x, float y, float angle);
+    // Jobs emit into their own list; the lists are appended to m_combatEvents in a fixed order
+    static void EmitSFX(std::vector<CombatEvent>& out, int sfxId);
+    static void EmitShake(std::vector<CombatEvent>& out, float amplitude, float duration, float frequency);
+    static void EmitExplosion(std::vector<CombatEvent>& out, float x, float y, float radiusMul, int attackerId);
+    static void EmitLightning(std::vector<CombatEvent>& out, float x, int attackerId);
+    void AppendCombatEvents(std::vector<CombatEvent>& events);
+
+    // Effect updates run as frame-graph jobs; each declares the state it touches
+    enum JobResource : FrameGraph::ResourceMask {
+        RES_WALLS      = 1 << 0,
+        RES_BULLETS    = 1 << 1,  // bullets and bazoka trails
+        RES_ORBS       = 1 << 2,
+        RES_LIGHTNING  = 1 << 3,
+        RES_FIRE_RAIN  = 1 << 4,
+        RES_BOMBS      = 1 << 5,
+        RES_EXPLOSIONS = 1 << 6,
+        RES_BLOOD      = 1 << 7,
+        RES_CAMERA     = 1 << 8,
+        RES_AUDIO      = 1 << 9,
+        RES_PLAYERS    = 1 << 10,
+        RES_HUD        = 1 << 11,
+    };
+    FrameGraph m_frameGraph;
+    bool m_dumpFrameGraph = false;
+    std::vector<CombatEvent> m_bulletEvents;
+    std::vector<CombatEvent> m_orbEvents;
+    std::vector<CombatEvent> m_lightningEvents;
+    std::vector<CombatEvent> m_fireRainEvents;
+    std::vector<CombatEvent> m_bombEvents;
+    void RunFrameGraph();
+
+    // Render object pools for transient effects, bound to their scene prototypes
+    void InitObjectPools();
+    void LogObjectPoolStats() const;
     
     void SpawnBulletFromCharacter(const Character& ch);
     void SpawnBulletFromCharacterWithJitter(const Character& ch, float jitterDeg);
@@ -69,9 +170,7 @@ private:
     struct Trail { float x; float y; float life; int objIndex; float angle; float alpha; };
     std::vector<Trail> m_bazokaTrails;
     static constexpr int MAX_BAZOKA_TRAILS = 2048;
-    std::vector<std::unique_ptr<Object>> m_bazokaTrailObjs;
-    std::vector<int> m_freeBazokaTrailSlots;
-    int CreateOrAcquireBazokaTrailObject();
+    Pool<Object> m_bazokaTrailPool;
     const float BAZOKA_TRAIL_LIFETIME = 0.35f;
     const float BAZOKA_TRAIL_SPAWN_INTERVAL = 0.001f;
     const float BAZOKA_TRAIL_SCALE_X = 0.4f;
@@ -84,17 +183,16 @@ private:
         float vx; float vy;
         float angle;
         int objIdx;
+        int pool;
     };
     std::vector<BloodDrop> m_bloodDrops;
-    std::vector<std::unique_ptr<Object>> m_bloodObjs;
-    std::vector<int> m_freeBloodSlots;
+    Pool<Object> m_bloodPools[3];
     static constexpr float BLOOD_GRAVITY = 3.8f;
     static constexpr float BLOOD_COLLISION_WIDTH  = 0.015f;
     static constexpr float BLOOD_COLLISION_HEIGHT = 0.015f;
     int m_bloodProtoIdA = 1400;
     int m_bloodProtoIdB = 1401;
     int m_bloodProtoIdC = 1402;
-    int CreateOrAcquireBloodObjectFromProto(int protoObjectId);
     void SpawnBloodAt(float x, float y, float baseAngleRad);
     void UpdateBloods(float dt);
     void DrawBloods(class Camera* cam);
@@ -102,10 +200,8 @@ private:
      // Bomb system
      struct Bomb { float x; float y; float vx; float vy; float life; int objIndex; float angleRad; float faceSign; bool grounded = false; bool atRest = false; int attackerId = 0; };
      std::vector<Bomb> m_bombs;
-     std::vector<std::unique_ptr<Object>> m_bombObjs;
-     std::vector<int> m_freeBombSlots;
+     Pool<Object> m_bombPool;
      int m_bombObjectId = 1500;
-     int CreateOrAcquireBombObjectFromProto(int protoObjectId);
      void SpawnBombFromCharacter(const Character& ch, float overrideLife = -1.0f);
      void UpdateBombs(float dt);
      void DrawBombs(class Camera* cam);
@@ -124,23 +220,18 @@ private:
      struct Explosion {
          float x; float y;
          int objIdx;
-         int cols; int rows;
          int frameIndex; int frameCount;
          float frameTimer; float frameDuration;
-         bool damagedP1 = false;
-         bool damagedP2 = false;
          float damageRadiusMul = 1.0f;
          int attackerId = 0;
+         bool damagePending = true;
      };
      std::vector<Explosion> m_explosions;
-     std::vector<std::unique_ptr<Object>> m_explosionObjs;
-     std::vector<int> m_freeExplosionSlots;
+     Pool<Object> m_explosionPool;
      int m_explosionObjectId = 1501;
-     int CreateOrAcquireExplosionObjectFromProto(int protoObjectId);
      void SpawnExplosionAt(float x, float y, float radiusMul = EXPLOSION_DAMAGE_RADIUS_MUL, int attackerId = 0);
      void UpdateExplosions(float dt);
      void DrawExplosions(class Camera* cam);
-     void SetSpriteUV(Object* obj, int cols, int rows, int frameIndex);
      static constexpr float EXPLOSION_FRAME_DURATION = 0.05f;
      static constexpr float EXPLOSION_DAMAGE_RADIUS_MUL = 1.8f;
      static constexpr float BAZOKA_EXPLOSION_RADIUS_MUL = 1.8f;
@@ -195,6 +286,7 @@ private:
     std::vector<std::unique_ptr<EnergyOrbProjectile>> m_energyOrbProjectiles;
     static constexpr int MAX_ENERGY_ORB_PROJECTILES = 1000;
     void SpawnEnergyOrbProjectile(Character& character);
+    EnergyOrbProjectile* CreateEnergyOrbProjectile(int attackerId);
     void UpdateEnergyOrbProjectiles(float deltaTime);
     void DrawEnergyOrbProjectiles(class Camera* camera);
     void DetonatePlayerProjectiles(int playerId);
@@ -217,14 +309,11 @@ private:
         int attackerId = 0;
     };
     std::vector<LightningEffect> m_lightningEffects;
-    std::vector<std::unique_ptr<Object>> m_lightningObjects;
-    std::vector<int> m_freeLightningSlots;
+    Pool<Object> m_lightningPool;
     static constexpr int MAX_LIGHTNING_EFFECTS = 1000;
     void SpawnLightningEffect(float x, int attackerId = 0);
     void UpdateLightningEffects(float deltaTime);
     void DrawLightningEffects(class Camera* camera);
-    int CreateOrAcquireLightningObject();
-    void CheckLightningDamage();
 
     struct FireRain {
         bool isActive = false;
@@ -236,22 +325,23 @@ private:
         Vector3 position = Vector3(0.0f, 0.0f, 0.0f);
         Vector3 velocity = Vector3(0.0f, -1.5f, 0.0f);
         int objectIndex = -1;
-        std::shared_ptr<AnimationManager> anim;
         bool damagedP1 = false;
         bool damagedP2 = false;
         int attackerId = 0; 
     };
     std::vector<FireRain> m_fireRains;
-    std::vector<std::unique_ptr<Object>> m_fireRainObjects;
-    std::vector<int> m_freeFireRainSlots;
+    // Slot i plays m_fireRains[i]
+    AnimationBatch m_fireRainAnims;
+    std::vector<AnimationBatch::Finished> m_fireRainAnimsFinished;
+    Pool<Object> m_fireRainPool;
     static constexpr int MAX_FIRERAIN = 100000;
     static constexpr float FIRE_RAIN_COLLISION_W = 0.05f;
     static constexpr float FIRE_RAIN_COLLISION_H = 0.05f;
     static constexpr float FIRE_RAIN_DAMAGE_W = 0.18f;
     static constexpr float FIRE_RAIN_DAMAGE_H = 0.18f;
-    int CreateOrAcquireFireRainObject();
     void SpawnFireRainAt(float x, float y, int attackerId = 0);
     void UpdateFireRains(float deltaTime);
+    void RetireFireRain(int index);
     void DrawFireRains(class Camera* camera);
     bool CheckFireRainWallCollision(const Vector3& pos, float halfW, float halfH) const;
 
@@ -300,6 +390,7 @@ public:
     void Init() override;
     void Update(float deltaTime) override;
     void Draw() override;
+    bool IsIdle() const override;
     void HandleKeyEvent(unsigned char key, bool bIsPressed) override;
     void HandleMouseEvent(int x, int y, bool bIsPressed) override;
     void HandleMouseMove(int x, int y) override;
@@ -313,17 +404,26 @@ public:
     static bool IsShowWallBoxes() { return s_showWallBoxes; }
     static bool IsShowLadderBoxes() { return s_showLadderBoxes; }
     static bool IsShowTeleportBoxes() { return s_showTeleportBoxes; }
+
+    // Every match played afterwards is recorded to <directory>/match_<seed>.bkr
+    static void SetRecordDirectory(const std::string& directory) { s_recordDirectory = directory; }
+    // Hash of the gameplay state a replay has to reproduce
+    uint64_t ComputeStateHash() const;
+
+    // The whole mutable match state as a flat buffer (see Snapshot.h). Restoring
+    // does no GL work and leaves the HUD text textures alone, so it is cheap
+    // enough for rollback; a rematch restores the snapshot taken at the end of
+    // Init and then refreshes the HUD. Returns false on a foreign or damaged buffer.
+    void SaveSnapshot(std::vector<uint8_t>& out);
+    bool RestoreSnapshot(const std::vector<uint8_t>& data);
     
     // Health system methods
     void UpdateHealthBars();
     float GetPlayer1Health() const { return m_player1Health; }
     float GetPlayer2Health() const { return m_player2Health; }
     
-    // Cloud movement system
-    void UpdateCloudMovement(float deltaTime);
-    
-    // Fan rotation system
-    void UpdateFanRotation(float deltaTime);
+    // Registers the lift, clouds and fans with SceneManager's behavior lists
+    void SetupSceneBehaviors();
 
 private:
     bool m_prevJumpingP1 = false;
@@ -387,22 +487,29 @@ private:
     Vector3 m_hudBombIcon1BaseScale = Vector3(0.0f, 0.0f, 1.0f);
     Vector3 m_hudBombIcon2BaseScale = Vector3(0.0f, 0.0f, 1.0f);
     void UpdateHudBombDigits();
+    // Points two scene quads at the glyphs of a 0-99 value
+    void SetHudTwoDigits(int value, int leftId, int rightId);
 
-    // Score HUD Text
-    std::shared_ptr<Object> m_scoreTextP1;
-    std::shared_ptr<Object> m_scoreTextP2;
-    std::shared_ptr<Texture2D> m_scoreTextTexture;
+    // HUD text: score labels, score digits and the match clock share one glyph batch
+    static const int HUD_FONT_SIZE = 64;
+    std::shared_ptr<GlyphAtlas> m_hudGlyphs;
+    TextBatch m_hudText;
+    int m_scoreCellsP1 = 0;
+    int m_scoreCellsP2 = 0;
+    int m_timeCells = 0;
+    void CreateHudText();
 
-    // Score HUD Digits
-    std::vector<std::shared_ptr<Object>> m_scoreDigitObjectsP1; // IDs 941-945
-    std::vector<std::shared_ptr<Object>> m_scoreDigitObjectsP2; // IDs 947-951
-    std::shared_ptr<Texture2D> m_scoreDigitTexture;
+    // HUD objects 900-957, portraits and text, re-rendered only when they change
+    static const int HUD_FIRST_OBJECT_ID = 900;
+    static const int HUD_LAST_OBJECT_ID = 957;
+    HudLayer m_hud;
+    void SetupHudLayer();
+    void DrawHud();
+    uint64_t HudPortraitKey(const Character& character) const;
 
     // Score System
     int m_player1Score = 0;
     int m_player2Score = 0;
-    std::vector<std::shared_ptr<Texture2D>> m_digitTextures;
-    void CreateAllScoreTextures();
     void AddScore(int playerId, int points);
     void UpdateScoreDisplay();
     void UpdateScoreDigit(int playerId, int digitPosition, int digitValue);
@@ -425,6 +532,7 @@ private:
     void InitializeRandomItemSpawns();
     void UpdateRandomItemSpawns(float deltaTime);
     bool SpawnItemIntoSlot(int slotIndex, int typeId);
+    Object* CreateItemObject(int slotIndex, int itemId);
     int  ChooseRandomAvailableItemId();
     void MarkSlotPickedByObjectId(int objectId);
 
@@ -450,11 +558,6 @@ private:
     float m_gameTimer = 300.0f;
     const float GAME_DURATION = 300.0f;
     const float WARNING_TIME = 60.0f;
-    std::vector<std::shared_ptr<Object>> m_timeDigitObjects; 
-    std::shared_ptr<Texture2D> m_timeDigitTexture;
-    std::vector<std::shared_ptr<Texture2D>> m_redDigitTextures;
-    std::shared_ptr<Texture2D> m_redTimeDigitTexture;
-    void CreateTimeDigitObjects();
     void UpdateTimeDisplay();
     void UpdateTimeDigit(int digitPosition, int digitValue);
     void UpdateGameTimer(float deltaTime);
@@ -21,6 +21,9 @@ public:
     virtual void Exit() = 0;
     virtual void Cleanup() = 0;
 
+    // True when nothing changes without input, so the main loop can throttle
+    virtual bool IsIdle() const { return false; }
+
     // Getters
     StateType GetStateType() const { return m_stateType; }
 }; 
\ No newline at end of file
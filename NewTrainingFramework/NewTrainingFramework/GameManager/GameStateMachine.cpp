@@ -1,23 +1,24 @@
 #include "stdafx.h"
 #include "GameStateMachine.h"
+#include "MatchContext.h"
 #include "GSIntro.h"
 #include "GSMenu.h"
 #include "GSPlay.h"
 #include <iostream>
 
-GameStateMachine* GameStateMachine::s_instance = nullptr;
-
 GameStateMachine* GameStateMachine::GetInstance() {
-    if (!s_instance) {
-        s_instance = new GameStateMachine();
+    GameStateMachine*& instance = MatchContext::Current().m_stateMachine;
+    if (!instance) {
+        instance = new GameStateMachine();
     }
-    return s_instance;
+    return instance;
 }
 
 void GameStateMachine::DestroyInstance() {
-    if (s_instance) {
-        delete s_instance;
-        s_instance = nullptr;
+    GameStateMachine*& instance = MatchContext::Current().m_stateMachine;
+    if (instance) {
+        delete instance;
+        instance = nullptr;
     }
 }
 
@@ -89,6 +90,10 @@ void GameStateMachine::Update(float deltaTime) {
     }
 }
 
+bool GameStateMachine::IsIdle() const {
+    return !m_pNextState && m_pActiveState && m_pActiveState->IsIdle();
+}
+
 void GameStateMachine::Draw() {
     if (m_pActiveState) {
         m_pActiveState->Draw();
@@ -6,8 +6,6 @@
 
 class GameStateMachine {
 private:
-    static GameStateMachine* s_instance;
-    
     std::stack<std::unique_ptr<GameStateBase>> m_stateStack;
     std::unique_ptr<GameStateBase> m_pActiveState;
     std::unique_ptr<GameStateBase> m_pNextState;
@@ -32,6 +30,7 @@ public:
     void HandleKeyEvent(unsigned char key, bool bIsPressed);
     void HandleMouseEvent(int x, int y, bool bIsPressed);
     void HandleMouseMove(int x, int y);
+    bool IsIdle() const;
 
     // Utilities
     GameStateBase* CurrentState();
@@ -0,0 +1,367 @@
+#include "stdafx.h"
+#include "HeadlessRunner.h"
+#include "ResourceManager.h"
+#include "GameStateMachine.h"
+#include "MatchContext.h"
+#include "SimulationClock.h"
+#include "SoundManager.h"
+#include "FrameTimeStats.h"
+#include "MatchRecording.h"
+#include "GSPlay.h"
+#include "../GameObject/CharacterMovement.h"
+#include "../GameObject/AnimationGraph.h"
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Holds one action key at a time for a random number of ticks
+class ScriptedPlayer {
+public:
+    explicit ScriptedPlayer(const PlayerInputConfig& config)
+        : m_heldKey(0), m_ticksLeft(0) {
+        const int keys[] = { config.moveLeftKey, config.moveRightKey, config.jumpKey, config.sitKey,
+                             config.rollKey, config.punchKey, config.axeKey, config.kickKey };
+        m_keys.assign(keys, keys + sizeof(keys) / sizeof(keys[0]));
+    }
+
+    void Tick(GameStateMachine* machine, unsigned int& seed) {
+        if (--m_ticksLeft > 0) return;
+        if (m_heldKey) {
+            machine->HandleKeyEvent((unsigned char)m_heldKey, false);
+        }
+        // One extra slot means "no key" so idle stretches show up too
+        const unsigned int pick = NextRand(seed) % (unsigned int)(m_keys.size() + 1);
+        m_heldKey = pick < m_keys.size() ? m_keys[pick] : 0;
+        m_ticksLeft = 6 + (int)(NextRand(seed) % 48u);
+        if (m_heldKey) {
+            machine->HandleKeyEvent((unsigned char)m_heldKey, true);
+        }
+    }
+
+private:
+    static unsigned int NextRand(unsigned int& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    }
+
+    std::vector<int> m_keys;
+    int m_heldKey;
+    int m_ticksLeft;
+};
+
+}
+
+bool HeadlessRunner::LoadSharedResources() {
+    esSetHeadless(GL_TRUE);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    SoundManager::Instance().SetMuted(true);
+
+    ResourceManager::GetInstance()->LoadAtlas("../Resources/Atlas/Atlas.txt");
+    if (!ResourceManager::GetInstance()->LoadFromFile("../Resources/RM.txt")) {
+        std::cout << "[Headless] failed to load ../Resources/RM.txt" << std::endl;
+        ResourceManager::DestroyInstance();
+        return false;
+    }
+    if (!AnimationGraph::Instance().Load("../Resources/AnimGraph.txt")) {
+        ResourceManager::DestroyInstance();
+        return false;
+    }
+    return true;
+}
+
+void HeadlessRunner::ReleaseSharedResources() {
+    SoundManager::Instance().Shutdown();
+    ResourceManager::DestroyInstance();
+}
+
+void HeadlessRunner::SimulateMatch(int tickCount, unsigned int seed, FrameTimeStats* tickMs) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    MatchContext context(seed);
+    MatchContext::Scope bind(context);
+
+    GameStateMachine* machine = GameStateMachine::GetInstance();
+    machine->ChangeState(StateType::PLAY);
+    machine->PerformStateChange();
+
+    ScriptedPlayer player1(CharacterMovement::PLAYER1_INPUT);
+    ScriptedPlayer player2(CharacterMovement::PLAYER2_INPUT);
+    unsigned int scriptSeed = seed;
+    SimulationClock& clock = SimulationClock::Instance();
+    for (int i = 0; i < tickCount; ++i) {
+        player1.Tick(machine, scriptSeed);
+        player2.Tick(machine, scriptSeed);
+
+        auto t0 = Clock::now();
+        clock.Step();
+        machine->Update(SimulationClock::TICK_DT);
+        if (tickMs) {
+            tickMs->Add(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        }
+    }
+}
+
+int HeadlessRunner::Run(int tickCount, unsigned int seed) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    auto loadStart = Clock::now();
+    if (!LoadSharedResources()) {
+        return -1;
+    }
+    auto loadEnd = Clock::now();
+
+    FrameTimeStats tickMs;
+    tickMs.Reserve(tickCount);
+    auto runStart = Clock::now();
+    SimulateMatch(tickCount, seed, &tickMs);
+    auto runEnd = Clock::now();
+
+    const double wallSec = std::chrono::duration<double>(runEnd - runStart).count();
+    const int tickRate = SimulationClock::TICK_RATE;
+
+    std::cout << "[Headless] " << tickCount << " ticks at " << tickRate
+              << " Hz, seed " << seed << std::endl;
+    std::cout << "  load:     " << std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms" << std::endl;
+    tickMs.Print(std::cout, "tick");
+    if (wallSec > 0.0) {
+        std::cout << "  rate:     " << tickCount / wallSec << " ticks/s ("
+                  << tickCount / wallSec / tickRate << "x real time, including match setup)" << std::endl;
+    }
+
+    ReleaseSharedResources();
+    return 0;
+}
+
+double HeadlessRunner::RunPass(int matchCount, int threadCount, int tickCount, unsigned int seed) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    std::atomic<int> nextMatch(0);
+    auto worker = [&]() {
+        for (int match = nextMatch++; match < matchCount; match = nextMatch++) {
+            SimulateMatch(tickCount, seed + (unsigned int)match, nullptr);
+        }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int HeadlessRunner::RunMatches(int matchCount, int threadCount, int tickCount, unsigned int seed) {
+    if (threadCount < 1) {
+        threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (!LoadSharedResources()) {
+        return -1;
+    }
+
+    std::cout << "[Headless] " << matchCount << " matches x " << tickCount << " ticks, seeds "
+              << seed << ".." << seed + (unsigned int)std::max(matchCount - 1, 0) << std::endl;
+    const double serialSec = RunPass(matchCount, 1, tickCount, seed);
+    std::cout << "  1 thread:   " << serialSec << " s, " << matchCount / serialSec << " matches/s" << std::endl;
+    if (threadCount > 1) {
+        const double parallelSec = RunPass(matchCount, threadCount, tickCount, seed);
+        std::cout << "  " << threadCount << " threads:  " << parallelSec << " s, " << matchCount / parallelSec
+                  << " matches/s (" << serialSec / parallelSec << "x)" << std::endl;
+    }
+
+    ReleaseSharedResources();
+    return 0;
+}
+
+uint64_t HeadlessRunner::ReplayMatch(const MatchRecording& recording, FrameTimeStats* tickMs) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    MatchContext context(0);
+    context.PresetMatchSeed(recording.GetSeed());
+    MatchContext::Scope bind(context);
+
+    const std::vector<MatchRecording::Event>& events = recording.GetEvents();
+    const uint32_t tickCount = recording.GetTickCount();
+
+    // A tick's deadline is the latest stamp among the events it applied, which
+    // makes BeginTick stop at exactly the event the live tick stopped at
+    std::vector<double> deadlines(tickCount, -1.0);
+    for (const MatchRecording::Event& e : events) {
+        if ((e.flags & MatchRecording::EVENT_MOUSE) || e.consumeTick >= tickCount) continue;
+        deadlines[e.consumeTick] = std::max(deadlines[e.consumeTick], MatchRecording::ToSeconds(e.timeUs));
+    }
+
+    // The live match entered GSPlay inside the Update of its first tick
+    SimulationClock& clock = SimulationClock::Instance();
+    clock.BeginReplay(recording.GetStartTick() - 1);
+    GameStateMachine* machine = GameStateMachine::GetInstance();
+    machine->ChangeState(StateType::PLAY);
+
+    size_t next = 0;
+    auto dispatchUntil = [&](uint32_t tick) {
+        for (; next < events.size() && events[next].dispatchTick <= tick; ++next) {
+            const MatchRecording::Event& e = events[next];
+            const bool pressed = (e.flags & MatchRecording::EVENT_PRESSED) != 0;
+            if (e.flags & MatchRecording::EVENT_MOUSE) {
+                machine->HandleMouseEvent(e.x, e.y, pressed);
+            } else {
+                clock.SetReplayEventTime(MatchRecording::ToSeconds(e.timeUs));
+                machine->HandleKeyEvent(e.key, pressed);
+            }
+        }
+    };
+
+    for (uint32_t tick = 0; tick < tickCount; ++tick) {
+        dispatchUntil(tick);
+        auto t0 = Clock::now();
+        clock.SetReplayInputDeadline(deadlines[tick]);
+        clock.Step();
+        machine->Update(SimulationClock::TICK_DT);
+        if (tickMs) {
+            tickMs->Add(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        }
+    }
+    dispatchUntil(tickCount);
+
+    GSPlay* play = dynamic_cast<GSPlay*>(machine->CurrentState());
+    return play ? play->ComputeStateHash() : 0;
+}
+
+int HeadlessRunner::Replay(const std::string& path) {
+    std::vector<std::string> paths(1, path);
+    return RunReplayBenchmark(paths, 1);
+}
+
+int HeadlessRunner::RunReplayBenchmark(const std::vector<std::string>& paths, int repeats) {
+    std::vector<MatchRecording> recordings(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!recordings[i].Load(paths[i])) {
+            return -1;
+        }
+    }
+    if (!LoadSharedResources()) {
+        return -1;
+    }
+    if (repeats < 1) repeats = 1;
+
+    uint64_t totalTicks = 0;
+    for (const MatchRecording& recording : recordings) {
+        totalTicks += recording.GetTickCount();
+    }
+    FrameTimeStats tickMs;
+    tickMs.Reserve((int)(totalTicks * (uint64_t)repeats));
+
+    std::cout << "[Replay] " << recordings.size() << " recording(s), " << totalTicks
+              << " ticks, " << repeats << " pass(es)" << std::endl;
+    int mismatches = 0;
+    for (int pass = 0; pass < repeats; ++pass) {
+        for (size_t i = 0; i < recordings.size(); ++i) {
+            const MatchRecording& recording = recordings[i];
+            const uint64_t hash = ReplayMatch(recording, &tickMs);
+            const bool match = hash == recording.GetFinalHash();
+            if (!match) {
+                ++mismatches;
+            }
+            if (pass == 0 || !match) {
+                std::cout << "  " << paths[i] << ": seed " << recording.GetSeed() << ", "
+                          << recording.GetTickCount() << " ticks, " << recording.GetEvents().size()
+                          << " events, hash " << std::hex << hash << std::dec
+                          << (match ? " ok" : " MISMATCH") << std::endl;
+            }
+        }
+    }
+    tickMs.Print(std::cout, "tick");
+
+    ReleaseSharedResources();
+    if (mismatches) {
+        std::cout << "[Replay] " << mismatches << " replay(s) diverged from their recording" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int HeadlessRunner::RunSnapshotBenchmark(int tickCount, unsigned int seed) {
+    typedef std::chrono::high_resolution_clock Clock;
+    // Rollback-style pattern: one snapshot per tick kept for ROLLBACK_DEPTH ticks,
+    // and every ROLLBACK_INTERVAL ticks the oldest one is restored
+    const int ROLLBACK_DEPTH = 8;
+    const int ROLLBACK_INTERVAL = 30;
+
+    if (!LoadSharedResources()) {
+        return -1;
+    }
+
+    int mismatches = 0;
+    size_t minBytes = SIZE_MAX, maxBytes = 0;
+    FrameTimeStats saveMs, restoreMs;
+    saveMs.Reserve(tickCount);
+    restoreMs.Reserve(tickCount / ROLLBACK_INTERVAL + 1);
+    {
+        MatchContext context(seed);
+        MatchContext::Scope bind(context);
+
+        GameStateMachine* machine = GameStateMachine::GetInstance();
+        machine->ChangeState(StateType::PLAY);
+        machine->PerformStateChange();
+        GSPlay* play = dynamic_cast<GSPlay*>(machine->CurrentState());
+        if (!play) {
+            std::cout << "[Snapshot] GSPlay did not start" << std::endl;
+            ReleaseSharedResources();
+            return -1;
+        }
+
+        std::vector<uint8_t> snapshots[ROLLBACK_DEPTH];
+        uint64_t hashes[ROLLBACK_DEPTH] = {};
+        ScriptedPlayer player1(CharacterMovement::PLAYER1_INPUT);
+        ScriptedPlayer player2(CharacterMovement::PLAYER2_INPUT);
+        unsigned int scriptSeed = seed;
+        SimulationClock& clock = SimulationClock::Instance();
+        for (int i = 0; i < tickCount; ++i) {
+            player1.Tick(machine, scriptSeed);
+            player2.Tick(machine, scriptSeed);
+            clock.Step();
+            machine->Update(SimulationClock::TICK_DT);
+
+            const int slot = i % ROLLBACK_DEPTH;
+            auto t0 = Clock::now();
+            play->SaveSnapshot(snapshots[slot]);
+            saveMs.Add(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+            hashes[slot] = play->ComputeStateHash();
+            minBytes = std::min(minBytes, snapshots[slot].size());
+            maxBytes = std::max(maxBytes, snapshots[slot].size());
+
+            if (i >= ROLLBACK_DEPTH && i % ROLLBACK_INTERVAL == 0) {
+                const int oldest = (i + 1) % ROLLBACK_DEPTH;
+                t0 = Clock::now();
+                const bool ok = play->RestoreSnapshot(snapshots[oldest]);
+                restoreMs.Add(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+                if (!ok || play->ComputeStateHash() != hashes[oldest]) {
+                    ++mismatches;
+                    std::cout << "  tick " << i << ": state restored from tick " << i - ROLLBACK_DEPTH + 1
+                              << " does not hash like the saved one" << std::endl;
+                }
+            }
+        }
+    }
+
+    std::cout << "[Snapshot] " << tickCount << " ticks, seed " << seed << ", snapshot "
+              << minBytes << ".." << maxBytes << " bytes" << std::endl;
+    saveMs.Print(std::cout, "save");
+    restoreMs.Print(std::cout, "restore");
+
+    ReleaseSharedResources();
+    if (mismatches) {
+        std::cout << "[Snapshot] " << mismatches << " restore(s) diverged" << std::endl;
+        return 1;
+    }
+    return 0;
+}
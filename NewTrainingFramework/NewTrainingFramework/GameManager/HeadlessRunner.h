@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FrameTimeStats;
+class MatchRecording;
+
+// Runs matches with the null GL backend: resources load once as metadata only,
+// each match gets its own MatchContext with GSPlay entered directly, and a
+// seeded script presses both players' keys every tick at SimulationClock::TICK_DT.
+class HeadlessRunner {
+public:
+    // One match on the calling thread; prints the per-tick cost distribution
+    static int Run(int tickCount, unsigned int seed);
+    // matchCount matches of tickCount ticks spread over threadCount workers;
+    // prints matches per second against a single-thread pass over the same seeds
+    static int RunMatches(int matchCount, int threadCount, int tickCount, unsigned int seed);
+    // Replays one recorded match and checks its final state hash
+    static int Replay(const std::string& path);
+    // Replays every recording repeats times; prints per-tick CPU time percentiles
+    // over the whole corpus and fails when any final hash differs
+    static int RunReplayBenchmark(const std::vector<std::string>& paths, int repeats);
+    // Scripted match that snapshots every tick and periodically rolls back a few
+    // ticks; prints snapshot size and save/restore latency and fails when a
+    // restored state hashes differently from the one that was saved
+    static int RunSnapshotBenchmark(int tickCount, unsigned int seed);
+
+private:
+    static bool LoadSharedResources();
+    static void ReleaseSharedResources();
+    static void SimulateMatch(int tickCount, unsigned int seed, FrameTimeStats* tickMs);
+    static double RunPass(int matchCount, int threadCount, int tickCount, unsigned int seed);
+    static uint64_t ReplayMatch(const MatchRecording& recording, FrameTimeStats* tickMs);
+};
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "HudLayer.h"
+#include "ResourceManager.h"
+#include "MatchRecording.h"
+#include "../Core/Globals.h"
+#include "../GameObject/Object.h"
+#include "../GameObject/Model.h"
+#include "../GameObject/RenderPacket.h"
+#include "../GameObject/RenderTarget.h"
+#include "../GameObject/Texture2D.h"
+#include <cstring>
+
+namespace {
+    const int COMPOSITE_SHADER_ID = 0;
+
+    uint64_t FloatKey(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+HudLayer::HudLayer() : m_renderedKey(0), m_rendered(false) {
+}
+
+HudLayer::~HudLayer() {
+}
+
+void HudLayer::Clear() {
+    m_objects.clear();
+    m_bindings.clear();
+    m_redrawKeys.clear();
+    m_rendered = false;
+}
+
+void HudLayer::AddObject(Object* object) {
+    if (!object) return;
+    m_objects.push_back(object);
+    m_rendered = false;
+}
+
+void HudLayer::AddBar(Object* bar, float fullWidth, std::function<float()> ratio) {
+    if (!bar) return;
+    Bind([ratio] { return FloatKey(ratio()); }, [bar, fullWidth, ratio] {
+        const Vector3& scale = bar->GetScale();
+        bar->SetScale(ratio() * fullWidth, scale.y, scale.z);
+    });
+}
+
+void HudLayer::Bind(std::function<uint64_t()> value, std::function<void()> apply) {
+    Binding binding;
+    binding.value = value;
+    binding.apply = apply;
+    binding.applied = 0;
+    binding.valid = false;
+    m_bindings.push_back(binding);
+}
+
+void HudLayer::AddRedrawKey(std::function<uint64_t()> key) {
+    m_redrawKeys.push_back(key);
+    m_rendered = false;
+}
+
+void HudLayer::Update() {
+    for (Binding& binding : m_bindings) {
+        const uint64_t value = binding.value();
+        if (binding.valid && value == binding.applied) continue;
+        binding.applied = value;
+        binding.valid = true;
+        binding.apply();
+    }
+}
+
+void HudLayer::Invalidate() {
+    for (Binding& binding : m_bindings) {
+        binding.valid = false;
+    }
+    m_rendered = false;
+}
+
+uint64_t HudLayer::ContentKey() const {
+    StateHash hash;
+    for (const Object* object : m_objects) {
+        hash.Add(object->GetRevision());
+    }
+    for (const auto& key : m_redrawKeys) {
+        hash.Add(key());
+    }
+    return hash.Get();
+}
+
+void HudLayer::DrawDirect(const Matrix& uiView, const Matrix& uiProj, const std::function<void()>& drawContent) {
+    for (Object* object : m_objects) {
+        object->Draw(uiView, uiProj);
+    }
+    if (drawContent) drawContent();
+}
+
+void HudLayer::Draw(const Matrix& uiView, const Matrix& uiProj, const std::function<void()>& drawContent) {
+    if (esIsHeadless()) return;
+
+    if (!m_target) {
+        m_target = std::make_shared<RenderTarget>();
+    }
+    if (m_target->Resize(Globals::screenWidth, Globals::screenHeight)) {
+        m_rendered = false;
+    }
+    if (!m_target->GetTexture() || !m_target->GetTexture()->GetTextureId()) {
+        DrawDirect(uiView, uiProj, drawContent);
+        return;
+    }
+
+    const uint64_t key = ContentKey();
+    if (!m_rendered || key != m_renderedKey) {
+        RenderPacket::BeginTarget(m_target);
+        DrawDirect(uiView, uiProj, drawContent);
+        RenderPacket::EndTarget(m_target);
+        m_renderedKey = key;
+        m_rendered = true;
+    }
+    Composite();
+}
+
+void HudLayer::Composite() {
+    if (!m_quad) {
+        // Clip-space quad; framebuffer textures have v = 0 at the bottom
+        m_quad = std::make_shared<Model>();
+        m_quad->vertices.push_back(Vertex(-1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f));
+        m_quad->vertices.push_back(Vertex(-1.0f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f));
+        m_quad->vertices.push_back(Vertex( 1.0f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f));
+        m_quad->vertices.push_back(Vertex( 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f));
+        const GLushort indices[6] = { 0, 1, 2, 0, 2, 3 };
+        m_quad->indices.assign(indices, indices + 6);
+        m_quad->vertexCount = 4;
+        m_quad->indexCount = 6;
+    }
+    if (!m_shader) {
+        m_shader = ResourceManager::GetInstance()->GetShader(COMPOSITE_SHADER_ID);
+        if (!m_shader) return;
+    }
+
+    RenderPacket::DrawCommand command;
+    command.model = m_quad;
+    command.shader = m_shader;
+    command.textureCount = 1;
+    command.textures[0] = m_target->GetTexture();
+    Matrix identity;
+    identity.SetIdentity();
+    memcpy(command.mvp, &identity.m[0][0], sizeof(command.mvp));
+    command.hasQuadUV = false;
+    command.time = 0.0f;
+    command.premultiplied = true;
+    RenderPacket::Issue(std::move(command));
+}
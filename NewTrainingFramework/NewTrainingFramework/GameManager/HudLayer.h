@@ -0,0 +1,65 @@
+#pragma once
+#include "../../Utilities/Math.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Object;
+class Model;
+class Shaders;
+class RenderTarget;
+
+// In-match HUD kept in retained mode. Widgets are bound to game values through
+// getters; Update() polls them and only touches a widget's objects when its
+// value differs from the one last applied. Draw() renders the HUD into a cached
+// target only when a bound value, a HUD object or a redraw key changed since
+// the last rendering, and otherwise just composites the cached image.
+class HudLayer {
+public:
+    HudLayer();
+    ~HudLayer();
+
+    void Clear();
+
+    // Scene object drawn into the cached image, in the order added
+    void AddObject(Object* object);
+    // Bar whose width follows ratio() * fullWidth
+    void AddBar(Object* bar, float fullWidth, std::function<float()> ratio);
+    // Counters and icons: apply() runs whenever value() returns something new
+    void Bind(std::function<uint64_t()> value, std::function<void()> apply);
+    // Content drawn by the Draw() callback, such as portraits and text; key()
+    // changes whenever that content would look different
+    void AddRedrawKey(std::function<uint64_t()> key);
+
+    // Re-applies bindings whose value changed
+    void Update();
+    // Next Update() re-applies every binding and next Draw() re-renders
+    void Invalidate();
+
+    // drawContent draws everything that is not a HUD object, with the UI matrices
+    void Draw(const Matrix& uiView, const Matrix& uiProj, const std::function<void()>& drawContent);
+
+private:
+    struct Binding {
+        std::function<uint64_t()> value;
+        std::function<void()> apply;
+        uint64_t applied;
+        bool valid;
+    };
+
+    // Folds object revisions and redraw keys into one value
+    uint64_t ContentKey() const;
+    void DrawDirect(const Matrix& uiView, const Matrix& uiProj, const std::function<void()>& drawContent);
+    void Composite();
+
+    std::vector<Object*> m_objects;
+    std::vector<Binding> m_bindings;
+    std::vector<std::function<uint64_t()>> m_redrawKeys;
+
+    std::shared_ptr<RenderTarget> m_target;
+    std::shared_ptr<Model> m_quad;
+    std::shared_ptr<Shaders> m_shader;
+    uint64_t m_renderedKey;
+    bool m_rendered;
+};
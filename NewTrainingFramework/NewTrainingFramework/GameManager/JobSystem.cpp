@@ -0,0 +1,113 @@
+#include "stdafx.h"
+#include "JobSystem.h"
+
+namespace {
+    thread_local int t_threadIndex = 0;
+}
+
+JobSystem& JobSystem::Instance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem()
+    : m_queued(0), m_running(false) {
+    m_queues.emplace_back(new WorkQueue());
+}
+
+JobSystem::~JobSystem() {
+    Stop();
+}
+
+void JobSystem::Start(int workerCount) {
+    Stop();
+    if (workerCount < 0) {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+    if (workerCount == 0) return;
+
+    m_running = true;
+    for (int i = 1; i <= workerCount; ++i) {
+        m_queues.emplace_back(new WorkQueue());
+    }
+    for (int i = 1; i <= workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Stop() {
+    if (!m_running) return;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_queues.resize(1);
+}
+
+int JobSystem::CurrentThreadIndex() {
+    return t_threadIndex;
+}
+
+void JobSystem::Push(const Task& task) {
+    WorkQueue& queue = *m_queues[t_threadIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    {
+        // Counted under the sleep lock so a worker cannot miss the wakeup
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        ++m_queued;
+    }
+    if (!m_workers.empty()) {
+        m_wake.notify_one();
+    }
+}
+
+bool JobSystem::PopOwn(int index, Task& task) {
+    WorkQueue& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(int thief, Task& task) {
+    const int count = (int)m_queues.size();
+    for (int offset = 1; offset < count; ++offset) {
+        WorkQueue& queue = *m_queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::RunOne() {
+    if (m_queued.load() == 0) return false;
+    Task task;
+    if (!PopOwn(t_threadIndex, task) && !Steal(t_threadIndex, task)) {
+        return false;
+    }
+    --m_queued;
+    task.func(task.owner, task.index);
+    return true;
+}
+
+void JobSystem::WorkerLoop(int index) {
+    t_threadIndex = index;
+    while (m_running) {
+        if (RunOne()) continue;
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return !m_running || m_queued.load() > 0; });
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing task pool. Every worker owns a deque: it pushes and pops its
+// own tasks at the back and steals from the front of the others when it runs
+// dry. Threads that are not workers (the main thread, match runner threads)
+// share queue 0 and help by calling RunOne() while they wait for their tasks.
+class JobSystem {
+public:
+    typedef void (*TaskFunc)(void* owner, int index);
+    struct Task {
+        TaskFunc func;
+        void* owner;
+        int index;
+    };
+
+    static JobSystem& Instance();
+
+    // workerCount < 0 picks hardware threads - 1; 0 leaves the pool stopped
+    void Start(int workerCount);
+    void Stop();
+    int GetWorkerCount() const { return (int)m_workers.size(); }
+
+    void Push(const Task& task);
+    // Runs one queued task on the calling thread; false when none was found
+    bool RunOne();
+
+    // 0 for threads outside the pool, 1..GetWorkerCount() for workers
+    static int CurrentThreadIndex();
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool PopOwn(int queue, Task& task);
+    bool Steal(int thief, Task& task);
+    void WorkerLoop(int index);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<int> m_queued;
+    std::atomic<bool> m_running;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+};
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "MatchContext.h"
+#include "SceneManager.h"
+#include "GameStateMachine.h"
+#include "SimulationClock.h"
+#include "Snapshot.h"
+#include "../GameObject/InputManager.h"
+
+namespace {
+    thread_local MatchContext* t_bound = nullptr;
+
+    MatchContext* DefaultContext() {
+        static MatchContext context(std::random_device{}());
+        return &context;
+    }
+
+    MatchContext* BoundOrDefault() {
+        return t_bound ? t_bound : DefaultContext();
+    }
+}
+
+MatchContext::MatchContext(uint32_t seed)
+    : m_sceneManager(nullptr), m_inputManager(nullptr), m_stateMachine(nullptr),
+      m_clock(nullptr), m_seedSource(seed), m_matchSeed(seed), m_hasPresetSeed(false) {
+    SeedStreams(seed);
+}
+
+MatchContext::~MatchContext() {
+    // States clean up through the singletons, so tear down with this context bound
+    MatchContext* previous = t_bound;
+    t_bound = this;
+    GameStateMachine::DestroyInstance();
+    SceneManager::DestroyInstance();
+    InputManager::DestroyInstance();
+    delete m_clock;
+    m_clock = nullptr;
+    t_bound = (previous == this) ? nullptr : previous;
+}
+
+void MatchContext::SeedStreams(uint32_t seed) {
+    for (int i = 0; i < RNG_STREAM_COUNT; ++i) {
+        std::seed_seq seq{ seed, (uint32_t)i };
+        m_streams[i].seed(seq);
+    }
+}
+
+uint32_t MatchContext::BeginMatch() {
+    m_matchSeed = m_hasPresetSeed ? m_matchSeed : (uint32_t)m_seedSource();
+    m_hasPresetSeed = false;
+    SeedStreams(m_matchSeed);
+    return m_matchSeed;
+}
+
+void MatchContext::PresetMatchSeed(uint32_t seed) {
+    m_matchSeed = seed;
+    m_hasPresetSeed = true;
+}
+
+template <class Archive>
+void MatchContext::TransferState(Archive& ar) {
+    ar(m_matchSeed);
+    for (int i = 0; i < RNG_STREAM_COUNT; ++i) {
+        ar(m_streams[i]);
+    }
+}
+
+template void MatchContext::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void MatchContext::TransferState<SnapshotReader>(SnapshotReader&);
+
+MatchContext& MatchContext::Current() {
+    return *BoundOrDefault();
+}
+
+void MatchContext::Bind(MatchContext* context) {
+    t_bound = context;
+}
+
+MatchContext::Scope::Scope(MatchContext& context)
+    : m_previous(t_bound) {
+    t_bound = &context;
+}
+
+MatchContext::Scope::~Scope() {
+    t_bound = m_previous;
+}
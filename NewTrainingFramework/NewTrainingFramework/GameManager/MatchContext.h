@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+class SceneManager;
+class InputManager;
+class GameStateMachine;
+class SimulationClock;
+
+// Everything a single match mutates while it runs. The SceneManager,
+// InputManager, GameStateMachine and SimulationClock accessors resolve through
+// the context bound to the calling thread, falling back to a process default, so
+// gameplay code keeps calling GetInstance() while several matches run side by
+// side on different threads. ResourceManager stays process-wide: it is loaded
+// once up front and only read while matches run.
+class MatchContext {
+public:
+    explicit MatchContext(uint32_t seed);
+    ~MatchContext();
+
+    static MatchContext& Current();
+    // Binds context to the calling thread; nullptr restores the process default
+    static void Bind(MatchContext* context);
+
+    // Binds a context for the lifetime of the scope and restores the previous one
+    class Scope {
+    public:
+        explicit Scope(MatchContext& context);
+        ~Scope();
+    private:
+        MatchContext* m_previous;
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Each system draws from its own stream, so a change in how often one of
+    // them rolls does not shift the others and replays stay aligned
+    enum RngStream {
+        RNG_ITEMS,
+        RNG_RESPAWN,
+        RNG_FIRE_RAIN,
+        RNG_WEAPONS,
+        RNG_BLOOD,
+        RNG_STREAM_COUNT
+    };
+
+    // Picks the seed of a new match (the preset one when set, otherwise the next
+    // value from the context seed) and reseeds every stream from it
+    uint32_t BeginMatch();
+    // Makes the next BeginMatch() use seed; replays preset the recorded one
+    void PresetMatchSeed(uint32_t seed);
+    uint32_t GetMatchSeed() const { return m_matchSeed; }
+
+    std::mt19937& GetRng(RngStream stream) { return m_streams[stream]; }
+    // Match seed and stream positions, so a restored match rolls the same numbers
+    template <class Archive>
+    void TransferState(Archive& ar);
+    // Uniform in [0,1); unlike std::uniform_real_distribution the result does
+    // not depend on the standard library, so recordings replay across toolchains
+    float RandomUnit(RngStream stream) { return (float)(m_streams[stream]() >> 8) * (1.0f / 16777216.0f); }
+
+private:
+    friend class SceneManager;
+    friend class InputManager;
+    friend class GameStateMachine;
+    friend class SimulationClock;
+
+    SceneManager* m_sceneManager;
+    InputManager* m_inputManager;
+    GameStateMachine* m_stateMachine;
+    SimulationClock* m_clock;
+    std::mt19937 m_seedSource;
+    std::mt19937 m_streams[RNG_STREAM_COUNT];
+    uint32_t m_matchSeed;
+    bool m_hasPresetSeed;
+
+    void SeedStreams(uint32_t seed);
+
+    MatchContext(const MatchContext&) = delete;
+    MatchContext& operator=(const MatchContext&) = delete;
+};
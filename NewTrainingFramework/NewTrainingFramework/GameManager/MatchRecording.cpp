@@ -0,0 +1,214 @@
+#include "stdafx.h"
+#include "MatchRecording.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char RECORDING_MAGIC[4] = { 'B', 'K', 'R', 'P' };
+    const uint32_t RECORDING_VERSION = 1;
+
+    void PutVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((char)(uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((char)(uint8_t)value);
+    }
+
+    void PutFixed(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back((char)(uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    uint64_t ZigZag(int64_t value) {
+        return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    }
+
+    int64_t UnZigZag(uint64_t value) {
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    class Reader {
+    public:
+        Reader(const std::string& data) : m_data(data), m_pos(0), m_ok(true) {}
+
+        uint8_t Byte() {
+            if (m_pos >= m_data.size()) { m_ok = false; return 0; }
+            return (uint8_t)m_data[m_pos++];
+        }
+        uint64_t Fixed(int bytes) {
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) value |= (uint64_t)Byte() << (8 * i);
+            return value;
+        }
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const uint8_t b = Byte();
+                value |= (uint64_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) return value;
+            }
+            m_ok = false;
+            return 0;
+        }
+        bool Ok() const { return m_ok; }
+
+    private:
+        const std::string& m_data;
+        size_t m_pos;
+        bool m_ok;
+    };
+}
+
+void StateHash::Add(const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i) {
+        m_value ^= bytes[i];
+        m_value *= 1099511628211ull;
+    }
+}
+
+MatchRecording::MatchRecording()
+    : m_seed(0), m_startTick(0), m_tickCount(0), m_finalHash(0), m_firstInput(0), m_appliedKeys(0) {
+}
+
+void MatchRecording::Begin(uint32_t seed, uint64_t startTick, uint32_t firstInput) {
+    m_seed = seed;
+    m_startTick = startTick;
+    m_tickCount = 0;
+    m_finalHash = 0;
+    m_events.clear();
+    m_keyEvents.clear();
+    m_firstInput = firstInput;
+    m_appliedKeys = 0;
+}
+
+void MatchRecording::AddKey(uint32_t tick, uint8_t key, bool pressed, double time) {
+    Event e = {};
+    e.dispatchTick = tick;
+    e.consumeTick = UINT32_MAX;
+    e.timeUs = (int64_t)std::floor(time * 1e6 + 0.5);
+    e.flags = pressed ? EVENT_PRESSED : 0;
+    e.key = key;
+    m_keyEvents.push_back((uint32_t)m_events.size());
+    m_events.push_back(e);
+}
+
+void MatchRecording::AddMouse(uint32_t tick, int x, int y, bool pressed) {
+    Event e = {};
+    e.dispatchTick = tick;
+    e.flags = (uint8_t)(EVENT_MOUSE | (pressed ? EVENT_PRESSED : 0));
+    e.x = (uint16_t)(x < 0 ? 0 : x);
+    e.y = (uint16_t)(y < 0 ? 0 : y);
+    m_events.push_back(e);
+}
+
+void MatchRecording::MarkApplied(uint32_t tick, uint32_t appliedTotal) {
+    const size_t applied = (size_t)(appliedTotal - m_firstInput);
+    while (m_appliedKeys < m_keyEvents.size() && m_appliedKeys < applied) {
+        m_events[m_keyEvents[m_appliedKeys++]].consumeTick = tick;
+    }
+}
+
+void MatchRecording::End(uint32_t tickCount, uint64_t finalHash) {
+    m_tickCount = tickCount;
+    m_finalHash = finalHash;
+    // Still queued when the match ended: never applied within the recorded ticks
+    for (size_t i = m_appliedKeys; i < m_keyEvents.size(); ++i) {
+        m_events[m_keyEvents[i]].consumeTick = tickCount;
+    }
+    m_appliedKeys = m_keyEvents.size();
+}
+
+bool MatchRecording::Save(const std::string& path) const {
+    std::string out(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    PutFixed(out, RECORDING_VERSION, 4);
+    PutFixed(out, m_seed, 4);
+    PutFixed(out, m_startTick, 8);
+    PutFixed(out, m_tickCount, 4);
+    PutFixed(out, m_finalHash, 8);
+    PutVarint(out, m_events.size());
+
+    uint32_t prevTick = 0;
+    int64_t prevTimeUs = 0;
+    for (const Event& e : m_events) {
+        out.push_back((char)e.flags);
+        PutVarint(out, e.dispatchTick - prevTick);
+        prevTick = e.dispatchTick;
+        if (e.flags & EVENT_MOUSE) {
+            PutVarint(out, e.x);
+            PutVarint(out, e.y);
+        } else {
+            out.push_back((char)e.key);
+            PutVarint(out, ZigZag(e.timeUs - prevTimeUs));
+            prevTimeUs = e.timeUs;
+            PutVarint(out, e.consumeTick - e.dispatchTick);
+        }
+    }
+
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        std::cout << "[Recording] cannot write " << path << std::endl;
+        return false;
+    }
+    file.write(out.data(), (std::streamsize)out.size());
+    return (bool)file;
+}
+
+bool MatchRecording::Load(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        std::cout << "[Recording] cannot open " << path << std::endl;
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(RECORDING_MAGIC) || memcmp(data.data(), RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) {
+        std::cout << "[Recording] " << path << " is not a match recording" << std::endl;
+        return false;
+    }
+
+    Reader in(data);
+    for (size_t i = 0; i < sizeof(RECORDING_MAGIC); ++i) in.Byte();
+    const uint32_t version = (uint32_t)in.Fixed(4);
+    if (version != RECORDING_VERSION) {
+        std::cout << "[Recording] " << path << " has version " << version << ", expected " << RECORDING_VERSION << std::endl;
+        return false;
+    }
+    m_seed = (uint32_t)in.Fixed(4);
+    m_startTick = in.Fixed(8);
+    m_tickCount = (uint32_t)in.Fixed(4);
+    m_finalHash = in.Fixed(8);
+    const uint64_t count = in.Varint();
+
+    m_events.clear();
+    m_keyEvents.clear();
+    uint32_t prevTick = 0;
+    int64_t prevTimeUs = 0;
+    for (uint64_t i = 0; i < count && in.Ok(); ++i) {
+        Event e = {};
+        e.flags = in.Byte();
+        e.dispatchTick = prevTick + (uint32_t)in.Varint();
+        prevTick = e.dispatchTick;
+        if (e.flags & EVENT_MOUSE) {
+            e.x = (uint16_t)in.Varint();
+            e.y = (uint16_t)in.Varint();
+        } else {
+            e.key = in.Byte();
+            e.timeUs = prevTimeUs + UnZigZag(in.Varint());
+            prevTimeUs = e.timeUs;
+            e.consumeTick = e.dispatchTick + (uint32_t)in.Varint();
+        }
+        m_events.push_back(e);
+    }
+    if (!in.Ok()) {
+        std::cout << "[Recording] " << path << " is truncated" << std::endl;
+        m_events.clear();
+        return false;
+    }
+    m_appliedKeys = 0;
+    return true;
+}
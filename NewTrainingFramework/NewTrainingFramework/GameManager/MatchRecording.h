@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// FNV-1a over the raw bytes of whatever is added; used to compare the end state
+// of a live match with its replay
+class StateHash {
+public:
+    StateHash() : m_value(1469598103934665603ull) {}
+
+    void Add(const void* data, size_t size);
+    template <typename T>
+    void Add(const T& value) { Add(&value, sizeof(T)); }
+
+    uint64_t Get() const { return m_value; }
+
+private:
+    uint64_t m_value;
+};
+
+// One match's input exactly as GSPlay saw it. Every key and mouse event is kept
+// with the number of ticks that had run when it was dispatched; key events also
+// keep their timestamp and the tick whose BeginTick applied them. Together with
+// the match seed and the clock tick the match started on, that is enough to
+// replay the match tick for tick. Saved as a small varint-packed binary file.
+class MatchRecording {
+public:
+    enum EventFlags : uint8_t {
+        EVENT_PRESSED = 1 << 0,
+        EVENT_MOUSE   = 1 << 1,
+    };
+
+    struct Event {
+        uint32_t dispatchTick;   // ticks completed when the event arrived
+        uint32_t consumeTick;    // tick that applied it; keys only
+        int64_t timeUs;          // simulation time stamp; keys only
+        uint8_t flags;
+        uint8_t key;
+        uint16_t x, y;           // logical position; mouse only
+    };
+
+    MatchRecording();
+
+    // firstInput is InputManager::GetQueuedTotal() when recording starts
+    void Begin(uint32_t seed, uint64_t startTick, uint32_t firstInput);
+    void AddKey(uint32_t tick, uint8_t key, bool pressed, double time);
+    void AddMouse(uint32_t tick, int x, int y, bool pressed);
+    // Call after each BeginTick with InputManager::GetAppliedTotal()
+    void MarkApplied(uint32_t tick, uint32_t appliedTotal);
+    void End(uint32_t tickCount, uint64_t finalHash);
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+    uint32_t GetSeed() const { return m_seed; }
+    uint64_t GetStartTick() const { return m_startTick; }
+    uint32_t GetTickCount() const { return m_tickCount; }
+    uint64_t GetFinalHash() const { return m_finalHash; }
+    const std::vector<Event>& GetEvents() const { return m_events; }
+
+    static double ToSeconds(int64_t timeUs) { return (double)timeUs / 1e6; }
+
+private:
+    uint32_t m_seed;
+    uint64_t m_startTick;
+    uint32_t m_tickCount;
+    uint64_t m_finalHash;
+    std::vector<Event> m_events;
+
+    // Recording only: key events in queue order, and how many have been applied
+    std::vector<uint32_t> m_keyEvents;
+    uint32_t m_firstInput;
+    size_t m_appliedKeys;
+};
@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include "RenderThread.h"
+#include <chrono>
+
+RenderThread& RenderThread::Instance() {
+    static RenderThread instance;
+    return instance;
+}
+
+RenderThread::RenderThread()
+    : m_recordIndex(0)
+    , m_submitIndex(0)
+    , m_esContext(nullptr)
+    , m_resourceContext(EGL_NO_CONTEXT)
+    , m_resourceSurface(EGL_NO_SURFACE)
+    , m_running(false)
+    , m_stopRequested(false) {
+    for (int i = 0; i < PACKET_COUNT; ++i) {
+        m_states[i] = PACKET_FREE;
+        m_fences[i] = 0;
+    }
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+bool RenderThread::CreateResourceContext() {
+    EGLDisplay display = m_esContext->eglDisplay;
+    EGLint configId = 0;
+    EGLint numConfigs = 0;
+    EGLConfig config;
+    eglQueryContext(display, m_esContext->eglContext, EGL_CONFIG_ID, &configId);
+    EGLint configAttribs[] = { EGL_CONFIG_ID, configId, EGL_NONE };
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs < 1) {
+        return false;
+    }
+
+    EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+    m_resourceContext = eglCreateContext(display, config, m_esContext->eglContext, contextAttribs);
+    if (m_resourceContext == EGL_NO_CONTEXT) {
+        return false;
+    }
+
+    // The window surface can only be current on one thread; the loader context
+    // runs surfaceless where supported and on a 1x1 pbuffer otherwise
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_resourceContext)) {
+        return true;
+    }
+    EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    m_resourceSurface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+    if (m_resourceSurface != EGL_NO_SURFACE &&
+        eglMakeCurrent(display, m_resourceSurface, m_resourceSurface, m_resourceContext)) {
+        return true;
+    }
+
+    if (m_resourceSurface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, m_resourceSurface);
+        m_resourceSurface = EGL_NO_SURFACE;
+    }
+    eglDestroyContext(display, m_resourceContext);
+    m_resourceContext = EGL_NO_CONTEXT;
+    eglMakeCurrent(display, m_esContext->eglSurface, m_esContext->eglSurface, m_esContext->eglContext);
+    return false;
+}
+
+bool RenderThread::Start(ESContext* esContext) {
+    if (m_running || !esContext || esContext->eglDisplay == EGL_NO_DISPLAY) {
+        return m_running;
+    }
+    m_esContext = esContext;
+    if (!CreateResourceContext()) {
+        esLogMessage("[RenderThread] no shared GL context, rendering on the main thread\n");
+        return false;
+    }
+
+    for (int i = 0; i < PACKET_COUNT; ++i) {
+        m_states[i] = PACKET_FREE;
+        m_fences[i] = 0;
+    }
+    m_recordIndex = 0;
+    m_submitIndex = 0;
+    m_stopRequested = false;
+    m_submitMs.Clear();
+    m_running = true;
+    m_thread = std::thread(&RenderThread::ThreadLoop, this);
+    return true;
+}
+
+void RenderThread::Stop() {
+    if (!m_running) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_changed.notify_all();
+    m_thread.join();
+    m_running = false;
+
+    for (int i = 0; i < PACKET_COUNT; ++i) {
+        if (m_fences[i]) {
+            glDeleteSync(m_fences[i]);
+            m_fences[i] = 0;
+        }
+        m_packets[i].Clear();
+        m_states[i] = PACKET_FREE;
+    }
+
+    EGLDisplay display = m_esContext->eglDisplay;
+    eglMakeCurrent(display, m_esContext->eglSurface, m_esContext->eglSurface, m_esContext->eglContext);
+    if (m_resourceSurface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, m_resourceSurface);
+        m_resourceSurface = EGL_NO_SURFACE;
+    }
+    eglDestroyContext(display, m_resourceContext);
+    m_resourceContext = EGL_NO_CONTEXT;
+}
+
+RenderPacket& RenderThread::BeginFrame() {
+    RenderPacket& packet = m_packets[m_recordIndex];
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return m_states[m_recordIndex] == PACKET_FREE; });
+        m_states[m_recordIndex] = PACKET_RECORDING;
+    }
+
+    RenderPacket::SetRecording(&packet);
+    return packet;
+}
+
+void RenderThread::EndFrame() {
+    RenderPacket::SetRecording(nullptr);
+    // Textures and buffers created on this context this frame must be complete
+    // before the render context samples them
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fences[m_recordIndex] = fence;
+        m_states[m_recordIndex] = PACKET_READY;
+    }
+    m_changed.notify_all();
+    m_recordIndex = (m_recordIndex + 1) % PACKET_COUNT;
+}
+
+void RenderThread::ThreadLoop() {
+    typedef std::chrono::high_resolution_clock Clock;
+    EGLDisplay display = m_esContext->eglDisplay;
+    EGLSurface surface = m_esContext->eglSurface;
+    eglMakeCurrent(display, surface, surface, m_esContext->eglContext);
+    eglSwapInterval(display, m_esContext->swapInterval);
+    // Blend state is per context; every game state uses the same function
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    for (;;) {
+        const int index = m_submitIndex;
+        GLsync fence;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this, index]() { return m_stopRequested || m_states[index] == PACKET_READY; });
+            if (m_stopRequested) break;
+            m_states[index] = PACKET_RENDERING;
+            fence = m_fences[index];
+            m_fences[index] = 0;
+        }
+
+        auto submitStart = Clock::now();
+        if (fence) {
+            glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(fence);
+        }
+        m_packets[index].Submit();
+        eglSwapBuffers(display, surface);
+        // Drop the resource references once the frame is on screen
+        m_packets[index].Clear();
+        m_submitMs.Add(std::chrono::duration<double, std::milli>(Clock::now() - submitStart).count());
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_states[index] = PACKET_FREE;
+        }
+        m_changed.notify_all();
+        m_submitIndex = (index + 1) % PACKET_COUNT;
+    }
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
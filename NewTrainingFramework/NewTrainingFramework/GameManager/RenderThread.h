@@ -0,0 +1,67 @@
+#pragma once
+#include "../GameObject/RenderPacket.h"
+#include "FrameTimeStats.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "../../Utilities/utilities.h"
+
+// Moves GL submission off the simulation thread. The render thread owns the
+// window context and presents RenderPackets; the main thread keeps a second
+// context that shares objects with it, so textures and buffers are still
+// created where they are loaded. Two packets alternate: the main thread records
+// frame N+1 while frame N is submitted, and BeginFrame() only blocks when the
+// render thread is a whole frame behind.
+class RenderThread {
+public:
+    static RenderThread& Instance();
+
+    // Call with the window context current; false leaves rendering on the main thread
+    bool Start(ESContext* esContext);
+    // Joins the render thread and makes the window context current here again
+    void Stop();
+    bool IsRunning() const { return m_running; }
+
+    // Waits for a free packet and starts recording Object::Draw calls into it
+    RenderPacket& BeginFrame();
+    // Stops recording and queues the packet for presentation
+    void EndFrame();
+
+    // Time the render thread spent per frame in Submit() and eglSwapBuffers
+    const FrameTimeStats& GetSubmitStats() const { return m_submitMs; }
+
+private:
+    RenderThread();
+    ~RenderThread();
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    enum PacketState {
+        PACKET_FREE,
+        PACKET_RECORDING,
+        PACKET_READY,
+        PACKET_RENDERING,
+    };
+    static const int PACKET_COUNT = 2;
+
+    bool CreateResourceContext();
+    void ThreadLoop();
+
+    RenderPacket m_packets[PACKET_COUNT];
+    PacketState m_states[PACKET_COUNT];
+    GLsync m_fences[PACKET_COUNT];
+    int m_recordIndex;
+    int m_submitIndex;
+
+    ESContext* m_esContext;
+    EGLContext m_resourceContext;
+    EGLSurface m_resourceSurface;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_running;
+    bool m_stopRequested;
+
+    FrameTimeStats m_submitMs;
+};
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "ResourceManager.h"
 #include "../GameObject/Texture2D.h"
+#include "../GameObject/AnimationLibrary.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -26,10 +28,6 @@ ResourceManager::~ResourceManager() {
 }
 
 bool ResourceManager::LoadFromFile(const std::string& filepath) {
-    char buffer[1000];
-    if (GetCurrentDirectoryA(1000, buffer)) {
-    }
-    
     std::ifstream file(filepath);
     if (!file.is_open()) {
         std::ifstream testFile(filepath, std::ios::in);
@@ -120,6 +118,18 @@ bool ResourceManager::LoadFromFile(const std::string& filepath) {
                         file.seekg(currentPos);
                     }
                 }
+
+                std::string arrayName;
+                currentPos = file.tellg();
+                if (std::getline(file, line)) {
+                    if (line.find("ARRAY") == 0) {
+                        std::istringstream ss(line);
+                        std::string keyword;
+                        ss >> keyword >> arrayName;
+                    } else {
+                        file.seekg(currentPos);
+                    }
+                }
                 
                 std::vector<AnimationFrame> animations;
                 currentPos = file.tellg();
@@ -149,7 +159,7 @@ bool ResourceManager::LoadFromFile(const std::string& filepath) {
                 }
                 
                 if (!filepath.empty()) {
-                    LoadTexture(id, filepath, tiling, spriteWidth, spriteHeight, animations);
+                    LoadTexture(id, filepath, tiling, spriteWidth, spriteHeight, animations, arrayName);
                 }
                 
                 continue;
@@ -186,6 +196,7 @@ bool ResourceManager::LoadFromFile(const std::string& filepath) {
     }
     
     file.close();
+    PackTextureArrays();
     return true;
 }
 
@@ -222,7 +233,8 @@ std::shared_ptr<Model> ResourceManager::GetModel(int id) {
 }
 
 bool ResourceManager::LoadTexture(int id, const std::string& filepath, const std::string& tiling, 
-                                int spriteWidth, int spriteHeight, const std::vector<AnimationFrame>& animations) {
+                                int spriteWidth, int spriteHeight, const std::vector<AnimationFrame>& animations,
+                                const std::string& arrayName) {
     for (const auto& textureData : m_textures) {
         if (textureData.id == id) {
             return false;
@@ -230,7 +242,10 @@ bool ResourceManager::LoadTexture(int id, const std::string& filepath, const std
     }
     
     auto texture = std::make_shared<Texture2D>();
-    if (!texture->LoadFromFile(filepath, tiling)) {
+    if (const AtlasRegion* region = FindAtlasRegion(id, filepath)) {
+        texture->SetAtlasRegion(m_atlasPages[region->page], region->x, region->y, region->width, region->height, filepath,
+                                (Texture2D::AlphaClass)region->alphaClass);
+    } else if (!texture->LoadFromFile(filepath, tiling)) {
         return false;
     }
     
@@ -243,6 +258,16 @@ bool ResourceManager::LoadTexture(int id, const std::string& filepath, const std
     } else {
         texture->SetMixedFiltering();
     }
+    if (spriteWidth > 0 && spriteHeight > 0) {
+        texture->SetSheetGrid(spriteWidth, spriteHeight);
+    }
+    if (!animations.empty()) {
+        AnimationLibrary& library = AnimationLibrary::Instance();
+        library.BeginSheet(id);
+        for (const AnimationFrame& clip : animations) {
+            library.AddClip(clip.startFrame, clip.numFrames, clip.duration);
+        }
+    }
     
     TextureData textureData;
     textureData.id = id;
@@ -252,11 +277,211 @@ bool ResourceManager::LoadTexture(int id, const std::string& filepath, const std
     textureData.spriteWidth = spriteWidth;
     textureData.spriteHeight = spriteHeight;
     textureData.animations = animations;
+    textureData.arrayName = arrayName;
     m_textures.push_back(textureData);
     
     return true;
 }
 
+bool ResourceManager::LoadAtlas(const std::string& manifestPath) {
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        std::cout << "[ResourceManager] no atlas manifest at " << manifestPath << ", textures load one by one" << std::endl;
+        return false;
+    }
+
+    std::vector<std::shared_ptr<Texture2D>> pages;
+    std::vector<AtlasRegion> regions;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+        size_t start = line.find('"');
+        size_t end = line.rfind('"');
+        std::string path = (start != std::string::npos && end > start) ? line.substr(start + 1, end - start - 1) : "";
+
+        if (keyword == "PAGE") {
+            int index = -1;
+            ss >> index;
+            auto page = std::make_shared<Texture2D>();
+            if (index != (int)pages.size() || path.empty() || !page->LoadFromFile(path, "GL_CLAMP_TO_EDGE")) {
+                std::cout << "[ResourceManager] cannot load atlas page: " << line << std::endl;
+                return false;
+            }
+            page->SetMixedFiltering();
+            pages.push_back(page);
+        } else if (keyword == "TEXTURE") {
+            AtlasRegion region;
+            region.filepath = path;
+            std::string alphaName;
+            Texture2D::AlphaClass alphaClass;
+            uint64_t hash = 0;
+            if (!(ss >> region.id >> region.page >> region.x >> region.y >> region.width >> region.height >> alphaName
+                     >> std::hex >> hash) ||
+                !Texture2D::ParseAlphaClass(alphaName, alphaClass) || region.page < 0 || region.page >= (int)pages.size()) {
+                std::cout << "[ResourceManager] bad atlas entry: " << line << std::endl;
+                return false;
+            }
+            region.alphaClass = alphaClass;
+            // A source edited since the last pack, even at the same size, loads from its own file
+            int width = 0, height = 0, bpp = 0;
+            char* pixels = LoadTGA(region.filepath.c_str(), &width, &height, &bpp);
+            const bool current = pixels && width == region.width && height == region.height &&
+                                 Texture2D::HashPixels((const unsigned char*)pixels, width, height, bpp) == hash;
+            delete[] pixels;
+            if (!current) {
+                std::cout << "[ResourceManager] atlas entry for texture " << region.id << " is stale, rerun --pack-atlas" << std::endl;
+                continue;
+            }
+            regions.push_back(region);
+        }
+    }
+
+    m_atlasPages = pages;
+    m_atlasRegions = regions;
+    return true;
+}
+
+bool ResourceManager::LoadSpriteTrims(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cout << "[ResourceManager] no sprite trims at " << path << ", sheets draw whole cells" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword) || keyword != "SHEET") {
+            continue;
+        }
+        int id = -1, columns = 0, rows = 0, width = 0, height = 0;
+        uint64_t hash = 0;
+        ss >> id >> columns >> rows >> width >> height >> std::hex >> hash;
+        size_t start = line.find('"');
+        size_t end = line.rfind('"');
+        const std::string filepath = (start != std::string::npos && end > start) ? line.substr(start + 1, end - start - 1) : "";
+
+        // The frame lines follow even when the sheet is skipped
+        const int frames = columns * rows;
+        std::vector<float> trims;
+        trims.reserve(frames * 4);
+        const float cellWidth = columns > 0 ? (float)width / columns : 1.0f;
+        const float cellHeight = rows > 0 ? (float)height / rows : 1.0f;
+        for (int f = 0; f < frames && std::getline(file, line); ++f) {
+            int x = 0, y = 0, w = 0, h = 0;
+            std::istringstream frame(line);
+            frame >> x >> y >> w >> h;
+            trims.push_back(x / cellWidth);
+            trims.push_back(y / cellHeight);
+            trims.push_back((x + w) / cellWidth);
+            trims.push_back((y + h) / cellHeight);
+        }
+
+        const TextureData* data = GetTextureData(id);
+        const Texture2D* texture = data ? data->texture.get() : nullptr;
+        if (!texture || data->filepath != filepath || texture->GetSheetColumns() != columns ||
+            texture->GetSheetRows() != rows || texture->GetWidth() != width || texture->GetHeight() != height ||
+            texture->GetContentHash() != hash || (int)trims.size() != frames * 4) {
+            std::cout << "[ResourceManager] sprite trims for texture " << id << " are stale, rerun --trim-sheets" << std::endl;
+            continue;
+        }
+        data->texture->SetFrameTrims(trims);
+    }
+    return true;
+}
+
+const AtlasRegion* ResourceManager::FindAtlasRegion(int id, const std::string& filepath) const {
+    for (const AtlasRegion& region : m_atlasRegions) {
+        if (region.id == id && region.filepath == filepath) {
+            return &region;
+        }
+    }
+    return nullptr;
+}
+
+void ResourceManager::PackTextureArrays() {
+    // A layer is as large as the largest sheet of its group; smaller sheets
+    // are shelf-packed side by side, tallest first, with a texel between them
+    const int gutter = 1;
+    struct Shelf {
+        int layer;
+        int y;
+        int height;
+        int x;
+    };
+
+    std::vector<std::string> names;
+    for (const TextureData& data : m_textures) {
+        if (!data.arrayName.empty() && !data.texture->IsPacked() &&
+            std::find(names.begin(), names.end(), data.arrayName) == names.end()) {
+            names.push_back(data.arrayName);
+        }
+    }
+
+    for (const std::string& name : names) {
+        std::vector<TextureData*> members;
+        int layerWidth = 0, layerHeight = 0;
+        for (TextureData& data : m_textures) {
+            if (data.arrayName != name || data.texture->IsPacked()) continue;
+            if (data.texture->GetChannels() != 32) {
+                std::cout << "[ResourceManager] texture " << data.id << " is not 32-bit, left out of array '" << name << "'" << std::endl;
+                continue;
+            }
+            members.push_back(&data);
+            layerWidth = std::max(layerWidth, data.texture->GetWidth());
+            layerHeight = std::max(layerHeight, data.texture->GetHeight());
+        }
+        if (members.size() < 2) continue;
+        std::stable_sort(members.begin(), members.end(), [](const TextureData* a, const TextureData* b) {
+            return a->texture->GetHeight() > b->texture->GetHeight();
+        });
+
+        std::vector<Shelf> shelves;
+        std::vector<int> layerUsed;     // height taken by shelves, per layer
+        std::vector<int> placeLayer(members.size()), placeX(members.size()), placeY(members.size());
+        for (size_t i = 0; i < members.size(); ++i) {
+            const int w = members[i]->texture->GetWidth();
+            const int h = members[i]->texture->GetHeight();
+            Shelf* shelf = nullptr;
+            for (Shelf& s : shelves) {
+                if (h <= s.height && s.x + w <= layerWidth) {
+                    shelf = &s;
+                    break;
+                }
+            }
+            if (!shelf) {
+                int layer = 0;
+                while (layer < (int)layerUsed.size() && layerUsed[layer] + h > layerHeight) ++layer;
+                if (layer == (int)layerUsed.size()) layerUsed.push_back(0);
+                shelves.push_back({ layer, layerUsed[layer], h, 0 });
+                layerUsed[layer] = std::min(layerHeight, layerUsed[layer] + h + gutter);
+                shelf = &shelves.back();
+            }
+            placeLayer[i] = shelf->layer;
+            placeX[i] = shelf->x;
+            placeY[i] = shelf->y;
+            shelf->x += w + gutter;
+        }
+
+        auto array = std::make_shared<Texture2D>();
+        if (!array->CreateArray(layerWidth, layerHeight, (int)layerUsed.size())) continue;
+        int packed = 0;
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (members[i]->texture->PackInto(array, placeLayer[i], placeX[i], placeY[i])) {
+                ++packed;
+            }
+        }
+        m_textureArrays.push_back(array);
+        std::cout << "[ResourceManager] array '" << name << "': " << packed << " sheets in "
+                  << layerUsed.size() << " layers of " << layerWidth << "x" << layerHeight << std::endl;
+    }
+}
+
 std::shared_ptr<Texture2D> ResourceManager::GetTexture(int id) {
     for (const auto& textureData : m_textures) {
         if (textureData.id == id) {
@@ -312,6 +537,9 @@ void ResourceManager::ClearModels() {
 
 void ResourceManager::ClearTextures() {
     m_textures.clear();
+    m_textureArrays.clear();
+    m_atlasPages.clear();
+    m_atlasRegions.clear();
 }
 
 void ResourceManager::ClearShaders() {
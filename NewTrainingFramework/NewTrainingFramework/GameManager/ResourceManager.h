@@ -30,6 +30,18 @@ struct TextureData {
     int spriteWidth;
     int spriteHeight;
     std::vector<AnimationFrame> animations;
+
+    // ARRAY line in RM.txt; sheets with the same name share one texture array
+    std::string arrayName;
+};
+
+// Where the atlas packer put one texture; see ResourceManager::LoadAtlas
+struct AtlasRegion {
+    int id;
+    int page;
+    int x, y, width, height;
+    int alphaClass;         // Texture2D::AlphaClass, measured by the packer
+    std::string filepath;   // source file, to tell a stale manifest entry
 };
 
 struct ShaderData {
@@ -46,8 +58,15 @@ private:
     std::vector<ModelData> m_models;
     std::vector<TextureData> m_textures;
     std::vector<ShaderData> m_shaders;
+    std::vector<std::shared_ptr<Texture2D>> m_textureArrays;
+    std::vector<std::shared_ptr<Texture2D>> m_atlasPages;
+    std::vector<AtlasRegion> m_atlasRegions;
     
     ResourceManager() = default;
+
+    // Packs the sheets of each ARRAY group into the layers of one texture array
+    void PackTextureArrays();
+    const AtlasRegion* FindAtlasRegion(int id, const std::string& filepath) const;
     
 public:
     // Singleton access
@@ -58,15 +77,25 @@ public:
     
     // Load resources from RM.txt file
     bool LoadFromFile(const std::string& filepath);
+    // Reads the manifest written by --pack-atlas and loads its pages; call it
+    // before LoadFromFile so listed textures come out of the pages instead of
+    // their own files. False when there is no usable manifest.
+    bool LoadAtlas(const std::string& manifestPath);
+    // Reads the per-frame bounds written by --trim-sheets into the loaded sheets;
+    // call it after LoadFromFile. Sheets missing from the file, or repainted since it
+    // was written, draw whole cells.
+    bool LoadSpriteTrims(const std::string& path);
     
     bool LoadModel(int id, const std::string& filepath);
     std::shared_ptr<Model> GetModel(int id);
     void ClearModels();
 
     bool LoadTexture(int id, const std::string& filepath, const std::string& tiling = "GL_REPEAT", 
-                    int spriteWidth = 0, int spriteHeight = 0, const std::vector<AnimationFrame>& animations = {});
+                    int spriteWidth = 0, int spriteHeight = 0, const std::vector<AnimationFrame>& animations = {},
+                    const std::string& arrayName = "");
     std::shared_ptr<Texture2D> GetTexture(int id);
     const TextureData* GetTextureData(int id);
+    const std::vector<TextureData>& GetTextures() const { return m_textures; }
     void ClearTextures();
 
     bool LoadShader(int id, const std::string& vsPath, const std::string& fsPath);
@@ -1,5 +1,7 @@
 #include "stdafx.h"
 #include "SceneManager.h"
+#include "MatchContext.h"
+#include "Snapshot.h"
 #include "../Core/Globals.h"
 #include <fstream>
 #include <iostream>
@@ -11,24 +13,26 @@ bool GSPlay_IsShowPlatformBoxes();
 #define M_PI 3.14159265358979323846
 #endif
 
-SceneManager* SceneManager::s_instance = nullptr;
-
 SceneManager* SceneManager::GetInstance() {
-    if (!s_instance) {
-        s_instance = new SceneManager();
+    SceneManager*& instance = MatchContext::Current().m_sceneManager;
+    if (!instance) {
+        instance = new SceneManager();
     }
-    return s_instance;
+    return instance;
 }
 
 void SceneManager::DestroyInstance() {
-    if (s_instance) {
-        delete s_instance;
-        s_instance = nullptr;
+    SceneManager*& instance = MatchContext::Current().m_sceneManager;
+    if (instance) {
+        delete instance;
+        instance = nullptr;
     }
 }
 
 SceneManager::SceneManager() 
-    : m_activeCameraIndex(-1) {
+    : m_activeCameraIndex(-1)
+    , m_deferredFirstId(-1)
+    , m_deferredLastId(-2) {
     // Create default 2D camera
     CreateCamera();
     m_activeCameraIndex = 0;
@@ -257,6 +261,11 @@ Object* SceneManager::GetObject(int id) {
 }
 
 void SceneManager::RemoveObject(int id) {
+    for (auto& obj : m_objects) {
+        if (obj->GetId() == id) {
+            m_behaviors.Remove(obj.get());
+        }
+    }
     auto it = std::remove_if(m_objects.begin(), m_objects.end(),
         [id](const std::unique_ptr<Object>& obj) {
             return obj->GetId() == id;
@@ -268,7 +277,17 @@ void SceneManager::RemoveObject(int id) {
 }
 
 void SceneManager::RemoveAllObjects() {
+    m_behaviors.Clear();
     m_objects.clear();
+    m_deferredFirstId = -1;
+    m_deferredLastId = -2;
+    m_drawDeferred = nullptr;
+}
+
+void SceneManager::SetDeferredIdRange(int firstId, int lastId, std::function<void()> drawRange) {
+    m_deferredFirstId = firstId;
+    m_deferredLastId = lastId;
+    m_drawDeferred = std::move(drawRange);
 }
 
 Camera* SceneManager::CreateCamera() {
@@ -304,9 +323,7 @@ void SceneManager::SetActiveCamera(int index) {
 }
 
 void SceneManager::Update(float deltaTime) {
-    for (auto& obj : m_objects) {
-        obj->Update(deltaTime);
-    }
+    m_behaviors.Update(deltaTime);
 }
 
 void SceneManager::Draw() {
@@ -331,8 +348,16 @@ void SceneManager::Draw() {
     
     // Draw all objects except character objects (ID 1000, 1001)
     // Character objects will be drawn by Character class
+    bool deferredDrawn = false;
     for (auto& obj : m_objects) {
         int objId = obj->GetId();
+        if (objId >= m_deferredFirstId && objId <= m_deferredLastId) {
+            if (!deferredDrawn && m_drawDeferred) {
+                m_drawDeferred();
+            }
+            deferredDrawn = true;
+            continue;
+        }
         if (objId != 1000 && objId != 1001) {
             // Platform boxes
             if ((objId >= 500 && objId < 600)) {
@@ -395,3 +420,36 @@ void SceneManager::Clear() {
     m_activeCameraIndex = -1;
 }
 
+
+template <class Archive>
+void SceneManager::TransferState(Archive& ar) {
+    uint32_t count = (uint32_t)m_objects.size();
+    ar(count);
+    for (uint32_t i = 0; i < count && ar.Ok(); ++i) {
+        int id = i < m_objects.size() ? m_objects[i]->GetId() : -1;
+        ar(id);
+        // Same order as when saved unless objects were added or removed since
+        Object* obj = (i < m_objects.size() && m_objects[i]->GetId() == id) ? m_objects[i].get() : GetObject(id);
+        if (obj) {
+            obj->TransferState(ar);
+        } else {
+            Object skipped(id);
+            skipped.TransferState(ar);
+        }
+    }
+    m_behaviors.TransferState(ar);
+
+    bool hasCamera = GetActiveCamera() != nullptr;
+    ar(hasCamera);
+    if (hasCamera) {
+        if (Camera* camera = GetActiveCamera()) {
+            camera->TransferState(ar);
+        } else {
+            Camera skipped;
+            skipped.TransferState(ar);
+        }
+    }
+}
+
+template void SceneManager::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void SceneManager::TransferState<SnapshotReader>(SnapshotReader&);
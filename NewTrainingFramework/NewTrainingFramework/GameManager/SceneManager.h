@@ -1,7 +1,9 @@
 #pragma once
 #include "../GameObject/Object.h"
 #include "../GameObject/Camera.h"
+#include "../GameObject/SceneBehaviors.h"
 #include "StateType.h"
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -23,14 +25,17 @@ struct CameraConfig {
 
 class SceneManager {
 private:
-    static SceneManager* s_instance;
-
     std::vector<std::unique_ptr<Object>> m_objects;
     std::vector<std::unique_ptr<Camera>> m_cameras;
+    SceneBehaviors m_behaviors;
 
     int m_activeCameraIndex;
     CameraConfig m_cameraConfig;
 
+    int m_deferredFirstId;
+    int m_deferredLastId;
+    std::function<void()> m_drawDeferred;
+
     SceneManager();
    
 public:
@@ -48,6 +53,9 @@ public:
     Object* GetObject(int id);
     void RemoveObject(int id);
     void RemoveAllObjects();
+
+    // Only objects registered here are touched by Update()
+    SceneBehaviors& GetBehaviors() { return m_behaviors; }
     
     // Camera management (2D only)
     Camera* CreateCamera();
@@ -64,12 +72,22 @@ public:
     void Update(float deltaTime);
     void Draw();
 
+    // Objects with ids in [firstId, lastId] are left out of Draw(); drawRange runs
+    // once instead, where the first of them sits in the draw order (GSPlay's
+    // cached HUD). Cleared with the objects.
+    void SetDeferredIdRange(int firstId, int lastId, std::function<void()> drawRange);
+
     // 2D input handling only
     void HandleInput(unsigned char key, bool isPressed);
 
     void Clear();
     const std::vector<std::unique_ptr<Object>>& GetObjects() const { return m_objects; }
 
+    // Object transforms and visibility, behavior progress and the active camera.
+    // Objects are matched by id; creating or removing them is up to the caller.
+    template <class Archive>
+    void TransferState(Archive& ar);
+
 private:
     std::string GetSceneFileForState(StateType stateType);
     bool ParseCameraConfig(std::ifstream& file, const std::string& line);
@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include "SheetTrimmer.h"
+#include "ResourceManager.h"
+#include "../GameObject/Texture2D.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+int SheetTrimmer::Run(const std::string& rmPath, const std::string& outputPath) {
+    esSetHeadless(GL_TRUE);
+    ResourceManager* resources = ResourceManager::GetInstance();
+    if (!resources->LoadFromFile(rmPath)) {
+        std::cout << "[SheetTrimmer] failed to load " << rmPath << std::endl;
+        ResourceManager::DestroyInstance();
+        return 1;
+    }
+
+    std::ofstream out(outputPath);
+    if (!out.is_open()) {
+        std::cout << "[SheetTrimmer] cannot write " << outputPath << std::endl;
+        ResourceManager::DestroyInstance();
+        return 1;
+    }
+    out << "# Written by --trim-sheets from " << rmPath << "; rerun it after changing a sheet\n";
+    out << "# SHEET <texture id> <columns> <rows> <width> <height> <pixel hash> \"<file>\"\n";
+    out << "# then per frame: <x> <y> <width> <height> of its visible texels, in texels from the\n";
+    out << "# bottom-left of the cell; 0 0 0 0 when the frame is empty\n";
+
+    long long cellArea = 0, keptArea = 0;
+    int sheetCount = 0;
+    for (const TextureData& data : resources->GetTextures()) {
+        const int columns = data.spriteWidth, rows = data.spriteHeight;
+        if (columns <= 0 || rows <= 0 || data.texture->GetChannels() != 32) {
+            continue;
+        }
+        int width, height, bpp;
+        unsigned char* pixels = (unsigned char*)LoadTGA(data.filepath.c_str(), &width, &height, &bpp);
+        if (!pixels) {
+            std::cout << "[SheetTrimmer] cannot read " << data.filepath << std::endl;
+            continue;
+        }
+
+        const int cellWidth = width / columns, cellHeight = height / rows;
+        long long sheetKept = 0;
+        out << "SHEET " << data.id << " " << columns << " " << rows << " " << width << " " << height << " "
+            << std::hex << std::setw(16) << std::setfill('0') << Texture2D::HashPixels(pixels, width, height, bpp)
+            << std::dec << " \"" << data.filepath << "\"\n";
+        for (int frame = 0; frame < columns * rows; ++frame) {
+            // Frame 0 is the top-left cell; LoadTGA rows run bottom-up
+            const int cellX = (frame % columns) * cellWidth;
+            const int cellY = (rows - 1 - frame / columns) * cellHeight;
+            int minX = cellWidth, minY = cellHeight, maxX = -1, maxY = -1;
+            for (int y = 0; y < cellHeight; ++y) {
+                const unsigned char* row = pixels + ((size_t)(cellY + y) * width + cellX) * 4;
+                for (int x = 0; x < cellWidth; ++x) {
+                    if (row[x * 4 + 3] != 0) {
+                        minX = std::min(minX, x);
+                        maxX = std::max(maxX, x);
+                        minY = std::min(minY, y);
+                        maxY = std::max(maxY, y);
+                    }
+                }
+            }
+            if (maxX < 0) {
+                out << "0 0 0 0\n";
+                continue;
+            }
+            out << minX << " " << minY << " " << maxX - minX + 1 << " " << maxY - minY + 1 << "\n";
+            sheetKept += (long long)(maxX - minX + 1) * (maxY - minY + 1);
+        }
+        delete[] pixels;
+
+        const long long sheetArea = (long long)cellWidth * cellHeight * columns * rows;
+        std::cout << "[SheetTrimmer] texture " << data.id << ": " << (sheetArea > 0 ? 100.0 * sheetKept / sheetArea : 0.0)
+                  << "% of the cell area is drawn" << std::endl;
+        cellArea += sheetArea;
+        keptArea += sheetKept;
+        ++sheetCount;
+    }
+    ResourceManager::DestroyInstance();
+
+    std::cout << "[SheetTrimmer] " << sheetCount << " sheets, " << (cellArea > 0 ? 100.0 * keptArea / cellArea : 0.0)
+              << "% of the cell area left to draw" << std::endl;
+    return 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+
+// Offline step behind --trim-sheets. Finds the visible texels of every frame
+// of every 32-bit sprite sheet in RM.txt and writes their bounds to
+// SpriteTrim.txt, which ResourceManager::LoadSpriteTrims hands to the sheets so
+// sprites only rasterise that part of their cell. Rerun after changing a sheet.
+class SheetTrimmer {
+public:
+    // 0 on success
+    static int Run(const std::string& rmPath, const std::string& outputPath);
+};
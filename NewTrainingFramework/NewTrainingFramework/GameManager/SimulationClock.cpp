@@ -0,0 +1,84 @@
+#include "stdafx.h"
+#include "SimulationClock.h"
+#include "MatchContext.h"
+#include <cfloat>
+#include <cmath>
+#include "../../Utilities/utilities.h"
+
+SimulationClock& SimulationClock::Instance() {
+    SimulationClock*& instance = MatchContext::Current().m_clock;
+    if (!instance) {
+        instance = new SimulationClock();
+    }
+    return *instance;
+}
+
+SimulationClock::SimulationClock()
+    : m_accumulator(0.0)
+    , m_alpha(1.0f)
+    , m_tick(0)
+    , m_droppedTicks(0)
+    , m_stepsPending(0)
+    , m_wallAtAdvance(-1.0)
+    , m_timeAtAdvance(0.0)
+    , m_replaying(false)
+    , m_replayEventTime(0.0)
+    , m_replayDeadline(0.0) {
+}
+
+int SimulationClock::Advance(double realDelta) {
+    const double tickDt = 1.0 / TICK_RATE;
+    if (realDelta < 0.0) realDelta = 0.0;
+    m_accumulator += realDelta;
+
+    int steps = (int)(m_accumulator / tickDt);
+    m_accumulator -= steps * tickDt;
+    if (steps > MAX_STEPS_PER_FRAME) {
+        // Spiral-of-death guard: after a long stall run a bounded burst and
+        // let the simulation fall behind real time instead of catching up
+        m_droppedTicks += (uint64_t)(steps - MAX_STEPS_PER_FRAME);
+        steps = MAX_STEPS_PER_FRAME;
+    }
+
+    m_alpha = (float)(m_accumulator / tickDt);
+    if (m_alpha > 1.0f) m_alpha = 1.0f;
+
+    m_stepsPending = steps;
+    m_wallAtAdvance = esGetTime();
+    m_timeAtAdvance = (double)(m_tick + (uint64_t)steps) * tickDt + m_accumulator;
+    return steps;
+}
+
+double SimulationClock::GetEventTime() const {
+    if (m_replaying) {
+        return m_replayEventTime;
+    }
+    const double tickTime = (double)m_tick / TICK_RATE;
+    double time = tickTime;
+    if (m_wallAtAdvance >= 0.0) {
+        time = m_timeAtAdvance + (esGetEventTime() - m_wallAtAdvance);
+        if (time < tickTime) time = tickTime;
+    }
+    return std::floor(time * 1e6 + 0.5) / 1e6;
+}
+
+double SimulationClock::GetInputDeadline() const {
+    if (m_replaying) {
+        return m_replayDeadline;
+    }
+    if (m_stepsPending > 0) {
+        return (double)m_tick / TICK_RATE;
+    }
+    return DBL_MAX;
+}
+
+void SimulationClock::BeginReplay(uint64_t tick) {
+    m_tick = tick;
+    m_accumulator = 0.0;
+    m_alpha = 1.0f;
+    m_stepsPending = 0;
+    m_wallAtAdvance = -1.0;
+    m_replaying = true;
+    m_replayEventTime = (double)tick / TICK_RATE;
+    m_replayDeadline = -1.0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// Fixed-step simulation clock. The platform loop feeds real elapsed time into
+// Advance() and runs one Update(TICK_DT) per returned step, so gameplay sees
+// the same sequence of ticks regardless of frame rate. Rendering reads
+// GetAlpha() to blend between the previous and the current tick. Each
+// MatchContext owns its own clock.
+class SimulationClock {
+public:
+    static const int TICK_RATE = 120;
+    static constexpr float TICK_DT = 1.0f / TICK_RATE;
+    // Catch-up cap; time beyond this many ticks in one frame is dropped
+    static const int MAX_STEPS_PER_FRAME = 8;
+
+    static SimulationClock& Instance();
+
+    // Adds realDelta to the accumulator and returns how many ticks to run
+    int Advance(double realDelta);
+    // Called once before every simulated tick
+    void Step() { ++m_tick; if (m_stepsPending > 0) --m_stepsPending; }
+
+    // Simulation time (seconds) of the input event being dispatched, rounded to
+    // whole microseconds so recordings store it exactly. Live, the platform
+    // timestamp is mapped through the last Advance(); a clock that is stepped
+    // directly (headless) stamps events with the current tick.
+    double GetEventTime() const;
+    // Latest event time the current tick consumes: the tick's end time, except
+    // on the last tick of a frame, which takes everything already queued
+    double GetInputDeadline() const;
+
+    // Replay: the clock restarts at tick and event stamps and input deadlines
+    // come from the recording instead of wall time
+    void BeginReplay(uint64_t tick);
+    void SetReplayEventTime(double time) { m_replayEventTime = time; }
+    void SetReplayInputDeadline(double deadline) { m_replayDeadline = deadline; }
+
+    float GetAlpha() const { return m_alpha; }
+    uint64_t GetTick() const { return m_tick; }
+    // Simulation time since startup; replaces wall-clock reads in gameplay code
+    unsigned int GetTimeMs() const { return (unsigned int)(m_tick * 1000 / TICK_RATE); }
+    float GetTime() const { return (float)((double)m_tick / TICK_RATE); }
+    uint64_t GetDroppedTicks() const { return m_droppedTicks; }
+
+private:
+    SimulationClock();
+
+    double m_accumulator;
+    float m_alpha;
+    uint64_t m_tick;
+    uint64_t m_droppedTicks;
+    int m_stepsPending;
+    double m_wallAtAdvance;   // esGetTime() of the last Advance, negative before the first
+    double m_timeAtAdvance;   // simulation time that wall time corresponds to
+    bool m_replaying;
+    double m_replayEventTime;
+    double m_replayDeadline;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "../../Utilities/Math.h"
+
+// Flat binary image of the mutable match state. Each stateful class lists its
+// fields once in a TransferState(Archive&) template; SnapshotWriter appends
+// them to a byte buffer and SnapshotReader copies them back in the same order,
+// so saving and restoring cannot drift apart. Nothing position-dependent is
+// stored: objects are addressed by id or slot, never by pointer, and a buffer
+// is only meaningful to the build that wrote it.
+class SnapshotWriter {
+public:
+    static const bool IS_LOADING = false;
+
+    // Clears buffer but keeps its capacity, so repeated saves do not allocate
+    explicit SnapshotWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer) { m_buffer.clear(); }
+
+    void Raw(const void* data, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void operator()(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "transfer the members of non-trivial types one by one");
+        Raw(&value, sizeof(T));
+    }
+    void operator()(Vector3& v) { Raw(&v.x, sizeof(float)); Raw(&v.y, sizeof(float)); Raw(&v.z, sizeof(float)); }
+
+    template <typename T>
+    void operator()(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "use Each() for vectors of non-trivial types");
+        uint32_t count = (uint32_t)values.size();
+        (*this)(count);
+        if (count) Raw(values.data(), count * sizeof(T));
+    }
+
+    // Vectors whose elements hold non-trivial members; transfer(element) is called per entry
+    template <typename T, typename F>
+    void Each(std::vector<T>& values, F transfer) {
+        uint32_t count = (uint32_t)values.size();
+        (*this)(count);
+        for (T& value : values) transfer(value);
+    }
+
+    bool Ok() const { return true; }
+    void Fail() {}
+    size_t Size() const { return m_buffer.size(); }
+
+private:
+    std::vector<uint8_t>& m_buffer;
+};
+
+class SnapshotReader {
+public:
+    static const bool IS_LOADING = true;
+
+    explicit SnapshotReader(const std::vector<uint8_t>& buffer)
+        : m_data(buffer.data()), m_size(buffer.size()), m_pos(0), m_ok(true) {}
+
+    // Leaves data, vectors included, untouched once the buffer runs out; check Ok() afterwards
+    void Raw(void* data, size_t size) {
+        if (!m_ok || size > m_size - m_pos) { m_ok = false; return; }
+        memcpy(data, m_data + m_pos, size);
+        m_pos += size;
+    }
+
+    template <typename T>
+    void operator()(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "transfer the members of non-trivial types one by one");
+        Raw(&value, sizeof(T));
+    }
+    void operator()(Vector3& v) { Raw(&v.x, sizeof(float)); Raw(&v.y, sizeof(float)); Raw(&v.z, sizeof(float)); }
+
+    template <typename T>
+    void operator()(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "use Each() for vectors of non-trivial types");
+        const uint32_t count = ReadCount(sizeof(T));
+        if (!m_ok) return;
+        values.resize(count);
+        if (count) Raw(values.data(), count * sizeof(T));
+    }
+
+    template <typename T, typename F>
+    void Each(std::vector<T>& values, F transfer) {
+        const uint32_t count = ReadCount(1);
+        if (!m_ok) return;
+        values.resize(count);
+        for (T& value : values) transfer(value);
+    }
+
+    bool Ok() const { return m_ok; }
+    // For a caller that finds the data inconsistent; every later read is skipped
+    void Fail() { m_ok = false; }
+    bool AtEnd() const { return m_pos == m_size; }
+
+private:
+    // Element count, rejected when it cannot fit in what is left of the buffer
+    uint32_t ReadCount(size_t minElementSize) {
+        uint32_t count = 0;
+        (*this)(count);
+        if ((size_t)count * minElementSize > m_size - m_pos) {
+            m_ok = false;
+            return 0;
+        }
+        return count;
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_ok;
+};
@@ -41,6 +41,7 @@ void SoundManager::LoadMusic(const std::string& name, const std::string& path) {
 }
 
 void SoundManager::PlayMusic(const std::string& name, int loop) {
+    if (m_muted) return;
     Mix_Music* music = nullptr;
     auto it = m_musicMap.find(name);
     if (it != m_musicMap.end()) {
@@ -64,10 +65,19 @@ void SoundManager::PlayMusic(const std::string& name, int loop) {
 }
 
 void SoundManager::StopMusic() {
+    if (m_muted) return;
     Mix_HaltMusic();
     m_currentMusic = nullptr;
 }
 
+void SoundManager::SetMuted(bool muted) {
+    if (muted && !m_muted) {
+        StopAllChannels();
+        StopMusic();
+    }
+    m_muted = muted;
+}
+
 void SoundManager::LoadMusicByID(int id, const std::string& path) {
     if (m_musicMapByID.count(id) == 0) {
         Mix_Music* music = Mix_LoadMUS(path.c_str());
@@ -81,6 +91,7 @@ void SoundManager::LoadMusicByID(int id, const std::string& path) {
 }
 
 void SoundManager::PlayMusicByID(int id, int loop) {
+    if (m_muted) return;
     Mix_Music* music = nullptr;
     auto it = m_musicMapByID.find(id);
     if (it != m_musicMapByID.end()) {
@@ -128,6 +139,7 @@ void SoundManager::LoadSFXByID(int id, const std::string& path) {
 }
 
 void SoundManager::PlaySFX(const std::string& name, int loops) {
+    if (m_muted) return;
     Mix_Chunk* chunk = nullptr;
     auto it = m_sfxMap.find(name);
     if (it != m_sfxMap.end()) {
@@ -149,6 +161,7 @@ void SoundManager::PlaySFX(const std::string& name, int loops) {
 }
 
 void SoundManager::PlaySFXByID(int id, int loops) {
+    if (m_muted) return;
     Mix_Chunk* chunk = nullptr;
     auto it = m_sfxMapByID.find(id);
     if (it != m_sfxMapByID.end()) {
@@ -309,6 +322,7 @@ void SoundManager::ReserveChannels(int numChannels) {
 }
 
 void SoundManager::PlaySFXOnChannel(int channel, const std::string& name, int loops) {
+    if (m_muted) return;
     Mix_Chunk* chunk = nullptr;
     auto it = m_sfxMap.find(name);
     if (it != m_sfxMap.end()) {
@@ -325,6 +339,7 @@ void SoundManager::PlaySFXOnChannel(int channel, const std::string& name, int lo
 }
 
 void SoundManager::PlaySFXByIDOnChannel(int channel, int id, int loops) {
+    if (m_muted) return;
     Mix_Chunk* chunk = nullptr;
     auto it = m_sfxMapByID.find(id);
     if (it != m_sfxMapByID.end()) {
@@ -37,6 +37,11 @@ public:
     
     void Shutdown();
 
+    // Output is process-wide; while muted, play and stop calls return before
+    // touching any state, which is what lets matches on worker threads share it
+    void SetMuted(bool muted);
+    bool IsMuted() const { return m_muted; }
+
 private:
     SoundManager();
     ~SoundManager();
@@ -50,4 +55,5 @@ private:
     std::map<int, std::string> m_audioPathByID;
     std::map<std::string, std::string> m_audioPathByName;
     Mix_Music* m_currentMusic = nullptr;
+    bool m_muted = false;
 }; 
\ No newline at end of file
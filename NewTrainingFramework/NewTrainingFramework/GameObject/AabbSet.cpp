@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "AabbSet.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AABBSET_USE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AABBSET_USE_SSE 1
+#endif
+
+void AabbSet::Clear() {
+    m_left.clear();
+    m_right.clear();
+    m_bottom.clear();
+    m_top.clear();
+}
+
+void AabbSet::Reserve(int count) {
+    m_left.reserve(count);
+    m_right.reserve(count);
+    m_bottom.reserve(count);
+    m_top.reserve(count);
+}
+
+int AabbSet::Add(float left, float right, float bottom, float top) {
+    m_left.push_back(left);
+    m_right.push_back(right);
+    m_bottom.push_back(bottom);
+    m_top.push_back(top);
+    return Size() - 1;
+}
+
+void AabbSet::Set(int i, float left, float right, float bottom, float top) {
+    m_left[i] = left;
+    m_right[i] = right;
+    m_bottom[i] = bottom;
+    m_top[i] = top;
+}
+
+namespace {
+    inline bool OverlapScalar(float ql, float qr, float qb, float qt,
+                              float bl, float br, float bb, float bt, bool inclusive) {
+        if (inclusive) {
+            return ql <= br && qr >= bl && qb <= bt && qt >= bb;
+        }
+        return ql < br && qr > bl && qb < bt && qt > bb;
+    }
+
+    inline void ScatterBits(int bits, int lanes, uint32_t bit, uint32_t* outMasks) {
+        for (int k = 0; k < lanes; ++k) {
+            if (bits & (1 << k)) outMasks[k] |= bit;
+        }
+    }
+
+    // Tests every query against one target box; queries are either explicit boxes
+    // (qr/qt non-null) or points expanded by halfW/halfH.
+    void TestAgainstBox(const float* ql, const float* qr, const float* qb, const float* qt,
+                        float halfW, float halfH, int count,
+                        float bl, float br, float bb, float bt,
+                        bool inclusive, uint32_t bit, uint32_t* outMasks) {
+        const bool points = (qr == nullptr);
+        int i = 0;
+#if defined(AABBSET_USE_AVX)
+        const __m256 vbl = _mm256_set1_ps(bl), vbr = _mm256_set1_ps(br);
+        const __m256 vbb = _mm256_set1_ps(bb), vbt = _mm256_set1_ps(bt);
+        const __m256 vhw = _mm256_set1_ps(halfW), vhh = _mm256_set1_ps(halfH);
+        for (; i + 8 <= count; i += 8) {
+            __m256 l, r, b, t;
+            if (points) {
+                __m256 x = _mm256_loadu_ps(ql + i), y = _mm256_loadu_ps(qb + i);
+                l = _mm256_sub_ps(x, vhw); r = _mm256_add_ps(x, vhw);
+                b = _mm256_sub_ps(y, vhh); t = _mm256_add_ps(y, vhh);
+            } else {
+                l = _mm256_loadu_ps(ql + i); r = _mm256_loadu_ps(qr + i);
+                b = _mm256_loadu_ps(qb + i); t = _mm256_loadu_ps(qt + i);
+            }
+            __m256 m;
+            if (inclusive) {
+                m = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(l, vbr, _CMP_LE_OQ), _mm256_cmp_ps(r, vbl, _CMP_GE_OQ)),
+                                  _mm256_and_ps(_mm256_cmp_ps(b, vbt, _CMP_LE_OQ), _mm256_cmp_ps(t, vbb, _CMP_GE_OQ)));
+            } else {
+                m = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(l, vbr, _CMP_LT_OQ), _mm256_cmp_ps(r, vbl, _CMP_GT_OQ)),
+                                  _mm256_and_ps(_mm256_cmp_ps(b, vbt, _CMP_LT_OQ), _mm256_cmp_ps(t, vbb, _CMP_GT_OQ)));
+            }
+            int bits = _mm256_movemask_ps(m);
+            if (bits) ScatterBits(bits, 8, bit, outMasks + i);
+        }
+#elif defined(AABBSET_USE_SSE)
+        const __m128 vbl = _mm_set1_ps(bl), vbr = _mm_set1_ps(br);
+        const __m128 vbb = _mm_set1_ps(bb), vbt = _mm_set1_ps(bt);
+        const __m128 vhw = _mm_set1_ps(halfW), vhh = _mm_set1_ps(halfH);
+        for (; i + 4 <= count; i += 4) {
+            __m128 l, r, b, t;
+            if (points) {
+                __m128 x = _mm_loadu_ps(ql + i), y = _mm_loadu_ps(qb + i);
+                l = _mm_sub_ps(x, vhw); r = _mm_add_ps(x, vhw);
+                b = _mm_sub_ps(y, vhh); t = _mm_add_ps(y, vhh);
+            } else {
+                l = _mm_loadu_ps(ql + i); r = _mm_loadu_ps(qr + i);
+                b = _mm_loadu_ps(qb + i); t = _mm_loadu_ps(qt + i);
+            }
+            __m128 m;
+            if (inclusive) {
+                m = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(l, vbr), _mm_cmpge_ps(r, vbl)),
+                               _mm_and_ps(_mm_cmple_ps(b, vbt), _mm_cmpge_ps(t, vbb)));
+            } else {
+                m = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(l, vbr), _mm_cmpgt_ps(r, vbl)),
+                               _mm_and_ps(_mm_cmplt_ps(b, vbt), _mm_cmpgt_ps(t, vbb)));
+            }
+            int bits = _mm_movemask_ps(m);
+            if (bits) ScatterBits(bits, 4, bit, outMasks + i);
+        }
+#endif
+        for (; i < count; ++i) {
+            float l, r, b, t;
+            if (points) {
+                l = ql[i] - halfW; r = ql[i] + halfW;
+                b = qb[i] - halfH; t = qb[i] + halfH;
+            } else {
+                l = ql[i]; r = qr[i]; b = qb[i]; t = qt[i];
+            }
+            if (OverlapScalar(l, r, b, t, bl, br, bb, bt, inclusive)) outMasks[i] |= bit;
+        }
+    }
+}
+
+void AabbSet::Query(const AabbSet& queries, OverlapMode mode, uint32_t* outMasks) const {
+    const int count = queries.Size();
+    for (int i = 0; i < count; ++i) outMasks[i] = 0;
+    if (count == 0) return;
+
+    const int targets = Size() < MAX_TARGETS ? Size() : MAX_TARGETS;
+    for (int j = 0; j < targets; ++j) {
+        TestAgainstBox(queries.m_left.data(), queries.m_right.data(), queries.m_bottom.data(), queries.m_top.data(),
+                       0.0f, 0.0f, count,
+                       m_left[j], m_right[j], m_bottom[j], m_top[j],
+                       mode == OVERLAP_INCLUSIVE, 1u << j, outMasks);
+    }
+}
+
+void AabbSet::QueryPoints(const float* x, const float* y, int count, float halfW, float halfH,
+                          OverlapMode mode, uint32_t* outMasks) const {
+    for (int i = 0; i < count; ++i) outMasks[i] = 0;
+    if (count == 0) return;
+
+    const int targets = Size() < MAX_TARGETS ? Size() : MAX_TARGETS;
+    for (int j = 0; j < targets; ++j) {
+        TestAgainstBox(x, nullptr, y, nullptr,
+                       halfW, halfH, count,
+                       m_left[j], m_right[j], m_bottom[j], m_top[j],
+                       mode == OVERLAP_INCLUSIVE, 1u << j, outMasks);
+    }
+}
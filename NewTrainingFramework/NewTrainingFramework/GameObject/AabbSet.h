@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Packed axis-aligned boxes in structure-of-arrays layout.
+// Query() tests a batch of boxes (or points with a fixed extent) against every
+// box in this set and writes one hit bitmask per query: bit j is set when the
+// query overlaps box j. A set used as the target of a query holds at most 32 boxes.
+class AabbSet {
+public:
+    enum OverlapMode {
+        OVERLAP_STRICT,     // touching edges do not count (a < b)
+        OVERLAP_INCLUSIVE,  // touching edges count (a <= b)
+    };
+
+    static constexpr int MAX_TARGETS = 32;
+
+    void Clear();
+    void Reserve(int count);
+    int Add(float left, float right, float bottom, float top);
+    void Set(int i, float left, float right, float bottom, float top);
+
+    int Size() const { return (int)m_left.size(); }
+    float GetLeft(int i) const { return m_left[i]; }
+    float GetRight(int i) const { return m_right[i]; }
+    float GetBottom(int i) const { return m_bottom[i]; }
+    float GetTop(int i) const { return m_top[i]; }
+
+    // outMasks must hold queries.Size() entries
+    void Query(const AabbSet& queries, OverlapMode mode, uint32_t* outMasks) const;
+    // Each query is the box [x - halfW, x + halfW] x [y - halfH, y + halfH]
+    void QueryPoints(const float* x, const float* y, int count, float halfW, float halfH,
+                     OverlapMode mode, uint32_t* outMasks) const;
+
+    static bool HasHit(uint32_t mask, int target) { return (mask & (1u << target)) != 0; }
+
+private:
+    std::vector<float> m_left;
+    std::vector<float> m_right;
+    std::vector<float> m_bottom;
+    std::vector<float> m_top;
+};
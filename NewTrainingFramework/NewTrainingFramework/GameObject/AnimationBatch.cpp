@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include "AnimationBatch.h"
+#include "AnimationLibrary.h"
+#include "AnimationManager.h"
+#include "../GameManager/Snapshot.h"
+#include <chrono>
+#include <iostream>
+
+AnimationBatch::AnimationBatch() {
+}
+
+void AnimationBatch::Reserve(int capacity) {
+    m_timer.reserve(capacity);
+    m_step.reserve(capacity);
+    m_frame.reserve(capacity);
+    m_numFrames.reserve(capacity);
+    m_flags.reserve(capacity);
+    m_sheet.reserve(capacity);
+    m_clip.reserve(capacity);
+    m_startFrame.reserve(capacity);
+}
+
+void AnimationBatch::Clear() {
+    m_timer.clear();
+    m_step.clear();
+    m_frame.clear();
+    m_numFrames.clear();
+    m_flags.clear();
+    m_sheet.clear();
+    m_clip.clear();
+    m_startFrame.clear();
+}
+
+int AnimationBatch::Add() {
+    m_timer.push_back(0.0f);
+    m_step.push_back(0.0f);
+    m_frame.push_back(0);
+    m_numFrames.push_back(0);
+    m_flags.push_back(0);
+    m_sheet.push_back(-1);
+    m_clip.push_back(-1);
+    m_startFrame.push_back(0);
+    return Size() - 1;
+}
+
+bool AnimationBatch::SetSheet(int slot, int textureId) {
+    int sheet = AnimationLibrary::Instance().FindSheet(textureId);
+    if (sheet < 0) {
+        return false;
+    }
+    m_sheet[slot] = (int16_t)sheet;
+    return true;
+}
+
+const AnimationData* AnimationBatch::GetAnimation(int slot, int clip) const {
+    return AnimationLibrary::Instance().GetClip(m_sheet[slot], clip);
+}
+
+void AnimationBatch::Play(int slot, int clip, bool loop) {
+    const AnimationData* data = AnimationLibrary::Instance().GetClip(m_sheet[slot], clip);
+    if (!data) {
+        return;
+    }
+    m_clip[slot] = (int16_t)clip;
+    m_startFrame[slot] = data->startFrame;
+    m_numFrames[slot] = data->numFrames;
+    m_step[slot] = data->numFrames > 1 ? data->frameTime : (float)data->duration / 1000.0f;
+    m_frame[slot] = 0;
+    m_timer[slot] = 0.0f;
+    m_flags[slot] = (uint8_t)(FLAG_PLAYING | (loop ? FLAG_LOOPING : 0));
+}
+
+void AnimationBatch::Stop(int slot) {
+    m_flags[slot] &= (uint8_t)~FLAG_PLAYING;
+    m_frame[slot] = 0;
+    m_timer[slot] = 0.0f;
+}
+
+void AnimationBatch::Update(float dt, std::vector<Finished>& outFinished) {
+    const int n = Size();
+    float* timer = m_timer.data();
+    const uint8_t* flags = m_flags.data();
+    for (int i = 0; i < n; ++i) {
+        timer[i] += (flags[i] & FLAG_PLAYING) ? dt : 0.0f;
+    }
+
+    // Only slots whose timer crossed a frame boundary leave this loop's fast path
+    const float* step = m_step.data();
+    for (int i = 0; i < n; ++i) {
+        if (timer[i] < step[i] || !(m_flags[i] & FLAG_PLAYING)) continue;
+
+        if (m_numFrames[i] <= 1) {
+            m_flags[i] &= (uint8_t)~FLAG_PLAYING;
+            outFinished.push_back({ i, m_clip[i] });
+            continue;
+        }
+        timer[i] -= step[i];
+        if (++m_frame[i] < m_numFrames[i]) continue;
+        if (m_flags[i] & FLAG_LOOPING) {
+            m_frame[i] = 0;
+        } else {
+            m_frame[i] = m_numFrames[i] - 1;
+            m_flags[i] &= (uint8_t)~FLAG_PLAYING;
+            outFinished.push_back({ i, m_clip[i] });
+        }
+    }
+}
+
+template <class Archive>
+void AnimationBatch::TransferState(Archive& ar) {
+    ar(m_timer); ar(m_step); ar(m_frame); ar(m_numFrames); ar(m_flags);
+    ar(m_clip); ar(m_startFrame);
+
+    // Sheets by texture id, as in AnimationManager::TransferState
+    const AnimationLibrary& library = AnimationLibrary::Instance();
+    std::vector<int32_t> textureIds;
+    if (!Archive::IS_LOADING) {
+        textureIds.reserve(m_sheet.size());
+        for (int16_t sheet : m_sheet) {
+            textureIds.push_back(sheet >= 0 ? library.GetTextureId(sheet) : -1);
+        }
+    }
+    ar(textureIds);
+    if (Archive::IS_LOADING) {
+        m_sheet.resize(textureIds.size());
+        for (size_t i = 0; i < textureIds.size(); ++i) {
+            m_sheet[i] = (int16_t)library.FindSheet(textureIds[i]);
+        }
+    }
+}
+
+template void AnimationBatch::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void AnimationBatch::TransferState<SnapshotReader>(SnapshotReader&);
+
+void AnimationBatch::RunBenchmark(int instanceCount, int frameCount) {
+    typedef std::chrono::high_resolution_clock Clock;
+    const float dt = 1.0f / 60.0f;
+
+    // Runs before RM.txt loads, so the library only holds this sheet:
+    // an 8-frame loop and a 6-frame one-shot, like the fire-rain sheet
+    const int textureId = 0;
+    AnimationLibrary& library = AnimationLibrary::Instance();
+    library.BeginSheet(textureId);
+    library.AddClip(0, 8, 400);
+    library.AddClip(8, 6, 300);
+
+    AnimationBatch batch;
+    batch.Reserve(instanceCount);
+    std::vector<AnimationManager> managers(instanceCount);
+    for (int i = 0; i < instanceCount; ++i) {
+        const int clip = (i % 4 == 0) ? 1 : 0;
+        batch.Add();
+        batch.SetSheet(i, textureId);
+        batch.Play(i, clip, clip == 0);
+        managers[i].SetSheet(textureId);
+        managers[i].Play(clip, clip == 0);
+    }
+
+    std::vector<Finished> finished;
+    finished.reserve(instanceCount);
+    double batchMs = 0.0, managerMs = 0.0;
+    long long events = 0;
+    for (int f = 0; f < frameCount; ++f) {
+        finished.clear();
+        auto t0 = Clock::now();
+        batch.Update(dt, finished);
+        auto t1 = Clock::now();
+        for (AnimationManager& anim : managers) {
+            anim.Update(dt);
+        }
+        auto t2 = Clock::now();
+
+        // Restart one-shots the way fire rain respawns, so events keep coming
+        for (const Finished& e : finished) {
+            batch.Play(e.slot, e.clip, false);
+            managers[e.slot].Play(e.clip, false);
+        }
+        events += (long long)finished.size();
+        batchMs   += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        managerMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+
+    const double perFrame = frameCount > 0 ? 1.0 / frameCount : 0.0;
+    const double perInstance = instanceCount > 0 ? 1e6 / instanceCount : 0.0;
+    std::cout << "[AnimationBatch] " << instanceCount << " instances x " << frameCount << " frames" << std::endl;
+    std::cout << "  batch:    " << batchMs * perFrame << " ms/frame (" << batchMs * perFrame * perInstance << " ns/instance)" << std::endl;
+    std::cout << "  managers: " << managerMs * perFrame << " ms/frame (" << managerMs * perFrame * perInstance << " ns/instance)" << std::endl;
+    std::cout << "  finished: " << (double)events * perFrame << " events/frame" << std::endl;
+}
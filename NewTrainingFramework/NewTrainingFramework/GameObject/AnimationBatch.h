@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+struct AnimationData;
+
+// Playback state of many effect instances kept as structure-of-arrays, with the
+// clip parameters copied in at Play() so Update() advances every slot in one
+// pass without touching AnimationLibrary. Same stepping rules as
+// AnimationManager. Slots are never removed: an owner keeps its slot index and
+// reuses it, the way fire-rain entries are reused once inactive.
+class AnimationBatch {
+public:
+    // A non-looping clip reached its last frame during Update()
+    struct Finished {
+        int slot;
+        int clip;
+    };
+
+    AnimationBatch();
+
+    void Reserve(int capacity);
+    void Clear();
+
+    // Appends a stopped slot without a sheet and returns its index
+    int Add();
+    // Same contract as AnimationManager::SetSheet; false when the texture has no clips
+    bool SetSheet(int slot, int textureId);
+    void Play(int slot, int clip, bool loop);
+    void Stop(int slot);
+
+    // One pass over every slot; finished clips are appended to outFinished
+    void Update(float dt, std::vector<Finished>& outFinished);
+
+    template <class Archive>
+    void TransferState(Archive& ar);
+
+    int  Size() const { return (int)m_timer.size(); }
+    bool HasSheet(int slot) const { return m_sheet[slot] >= 0; }
+    bool IsPlaying(int slot) const { return (m_flags[slot] & FLAG_PLAYING) != 0; }
+    int  GetClip(int slot) const { return m_clip[slot]; }
+    const AnimationData* GetAnimation(int slot, int clip) const;
+    // -1 before Play(); see AnimationManager::GetSheetFrame
+    int  GetSheetFrame(int slot) const { return m_clip[slot] >= 0 ? m_startFrame[slot] + m_frame[slot] : -1; }
+
+    // Ticks instanceCount looping and one-shot instances for frameCount frames and prints ns per instance
+    static void RunBenchmark(int instanceCount, int frameCount);
+
+private:
+    enum Flags : uint8_t {
+        FLAG_PLAYING = 1 << 0,
+        FLAG_LOOPING = 1 << 1,
+    };
+
+    // Hot columns, touched every Update()
+    std::vector<float> m_timer;
+    std::vector<float> m_step;        // seconds per frame; the clip duration for single-frame clips
+    std::vector<int32_t> m_frame;
+    std::vector<int32_t> m_numFrames;
+    std::vector<uint8_t> m_flags;
+
+    // Cold columns, touched on Play() and draw
+    std::vector<int16_t> m_sheet;
+    std::vector<int16_t> m_clip;
+    std::vector<int32_t> m_startFrame;
+};
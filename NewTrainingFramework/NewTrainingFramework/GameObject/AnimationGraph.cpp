@@ -0,0 +1,250 @@
+#include "stdafx.h"
+#include "AnimationGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const char* const FORM_NAMES[AnimationGraph::FORM_COUNT] = {
+        "normal", "gun", "grenade", "bat_demon", "werewolf", "kitsune", "orc"
+    };
+
+    const char* const CONDITION_NAMES[AnimationGraph::COND_COUNT] = {
+        "moving", "running", "airborne", "rolling", "sitting", "dying", "combo", "axe_combo",
+        "kicking", "hit", "ladder", "move_key", "run_key", "sit_key", "clip_done",
+        "bat_slash", "werewolf_combo", "werewolf_pounce", "kitsune_orb", "orc_meteor", "orc_flame"
+    };
+
+    int FindName(const char* const* names, int count, const std::string& name) {
+        for (int i = 0; i < count; ++i) {
+            if (name == names[i]) return i;
+        }
+        return -1;
+    }
+
+    // As written in the file, before the per-state tables are built
+    struct Rule {
+        int priority;
+        int order;
+        int from;            // -1 for '*'
+        AnimationGraph::Transition transition;
+    };
+
+    struct FormSource {
+        int textureId = -1;
+        std::vector<std::string> stateNames;
+        std::vector<AnimationGraph::State> states;
+        std::vector<Rule> rules;
+        std::vector<std::pair<int, std::string>> pending;  // rule index, target name; resolved at the end
+        std::vector<std::pair<int, std::string>> pendingFrom;
+    };
+
+    int FindState(const FormSource& form, const std::string& name) {
+        for (size_t i = 0; i < form.stateNames.size(); ++i) {
+            if (form.stateNames[i] == name) return (int)i;
+        }
+        return -1;
+    }
+}
+
+AnimationGraph& AnimationGraph::Instance() {
+    static AnimationGraph s_graph;
+    return s_graph;
+}
+
+bool AnimationGraph::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cout << "[AnimGraph] cannot open " << path << std::endl;
+        return false;
+    }
+
+    FormSource sources[FORM_COUNT];
+    FormSource* form = nullptr;
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& message) {
+        std::cout << "[AnimGraph] " << path << ":" << lineNumber << ": " << message << std::endl;
+        return false;
+    };
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+
+        if (keyword == "FORM") {
+            std::string name;
+            ss >> name;
+            int index = FindName(FORM_NAMES, FORM_COUNT, name);
+            if (index < 0) return fail("unknown form '" + name + "'");
+            form = &sources[index];
+            std::string option;
+            while (ss >> option) {
+                if (option == "TEXTURE" && (ss >> form->textureId)) continue;
+                return fail("unexpected '" + option + "'");
+            }
+            continue;
+        }
+        if (!form) return fail("'" + keyword + "' before any FORM");
+
+        if (keyword == "STATE") {
+            std::string name;
+            State state = { -1, 0, 0 };
+            if (!(ss >> name >> state.clip)) return fail("expected STATE <name> <clip>");
+            if (FindState(*form, name) >= 0) return fail("state '" + name + "' defined twice");
+            std::string option;
+            while (ss >> option) {
+                if (option == "LOOP") {
+                    state.flags |= STATE_LOOP;
+                } else if (option == "LOCK_INPUT") {
+                    state.flags |= STATE_LOCK_INPUT;
+                } else if (option == "MANUAL") {
+                    state.flags |= STATE_MANUAL;
+                } else if (option == "END") {
+                    std::string action;
+                    ss >> action;
+                    int bit = FindName(CONDITION_NAMES, COND_COUNT, action);
+                    if (bit < 0) return fail("unknown action '" + action + "'");
+                    state.endAction = 1u << bit;
+                } else {
+                    return fail("unexpected '" + option + "'");
+                }
+            }
+            form->stateNames.push_back(name);
+            form->states.push_back(state);
+        } else if (keyword == "RULE") {
+            Rule rule = {};
+            std::string from, to;
+            if (!(ss >> rule.priority >> from >> to)) return fail("expected RULE <priority> <from> <to> [conditions]");
+            rule.order = (int)form->rules.size();
+            rule.from = -1;
+            rule.transition.target = -1;
+            std::string token;
+            while (ss >> token) {
+                if (token == "RESTART") {
+                    rule.transition.restart = 1;
+                    continue;
+                }
+                const bool negate = token[0] == '!';
+                int bit = FindName(CONDITION_NAMES, COND_COUNT, negate ? token.substr(1) : token);
+                if (bit < 0) return fail("unknown condition '" + token + "'");
+                (negate ? rule.transition.forbid : rule.transition.require) |= 1u << bit;
+            }
+            if (from != "*") form->pendingFrom.push_back(std::make_pair(rule.order, from));
+            if (to != "-") form->pending.push_back(std::make_pair(rule.order, to));
+            form->rules.push_back(rule);
+        } else {
+            return fail("unknown keyword '" + keyword + "'");
+        }
+    }
+
+    // Resolve names now that every state of the form is known, then flatten
+    m_states.clear();
+    m_stateTransitions.clear();
+    m_transitions.clear();
+    for (int f = 0; f < FORM_COUNT; ++f) {
+        FormSource& src = sources[f];
+        for (const auto& p : src.pending) {
+            int state = FindState(src, p.second);
+            if (state < 0) return fail("form '" + std::string(FORM_NAMES[f]) + "' has no state '" + p.second + "'");
+            src.rules[p.first].transition.target = (int16_t)state;
+        }
+        for (const auto& p : src.pendingFrom) {
+            int state = FindState(src, p.second);
+            if (state < 0) return fail("form '" + std::string(FORM_NAMES[f]) + "' has no state '" + p.second + "'");
+            src.rules[p.first].from = state;
+        }
+        std::stable_sort(src.rules.begin(), src.rules.end(), [](const Rule& a, const Rule& b) {
+            return a.priority > b.priority;
+        });
+
+        FormInfo& info = m_forms[f];
+        info.textureId = src.textureId;
+        info.firstState = (int)m_states.size();
+        info.stateCount = (int)src.states.size();
+        info.entry.first = (int)m_transitions.size();
+        for (const Rule& rule : src.rules) {
+            if (rule.from < 0) m_transitions.push_back(rule.transition);
+        }
+        info.entry.count = (int)m_transitions.size() - info.entry.first;
+
+        for (int s = 0; s < info.stateCount; ++s) {
+            Range range = { (int)m_transitions.size(), 0 };
+            for (const Rule& rule : src.rules) {
+                if (rule.from < 0 || rule.from == s) m_transitions.push_back(rule.transition);
+            }
+            range.count = (int)m_transitions.size() - range.first;
+            m_states.push_back(src.states[s]);
+            m_stateTransitions.push_back(range);
+        }
+    }
+    return true;
+}
+
+const AnimationGraph::Transition* AnimationGraph::Evaluate(int form, int state, uint32_t conditions) const {
+    const FormInfo& info = m_forms[form];
+    const Range& range = (state >= 0 && state < info.stateCount) ? m_stateTransitions[info.firstState + state] : info.entry;
+    const Transition* t = m_transitions.data() + range.first;
+    const Transition* end = t + range.count;
+    for (; t != end; ++t) {
+        if ((conditions & t->require) == t->require && (conditions & t->forbid) == 0) {
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+void AnimationGraph::RunBenchmark(const std::string& path, int characterCount, int frameCount) {
+    typedef std::chrono::high_resolution_clock Clock;
+    AnimationGraph& graph = Instance();
+    if (!graph.IsLoaded() && !graph.Load(path)) {
+        return;
+    }
+
+    // Condition masks change slowly in a match: most frames repeat the last
+    // one and a few flip a movement or action bit
+    unsigned int seed = 12345u;
+    auto nextRand = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    const int maskCount = 4096;
+    std::vector<uint32_t> masks(maskCount);
+    uint32_t mask = 0;
+    for (uint32_t& m : masks) {
+        if (nextRand() % 8 == 0) mask ^= 1u << (nextRand() % COND_COUNT);
+        m = mask;
+    }
+
+    std::vector<int> forms(characterCount);
+    std::vector<int> states(characterCount, -1);
+    for (int c = 0; c < characterCount; ++c) {
+        forms[c] = c % FORM_COUNT;
+    }
+
+    long long evaluations = 0, transitions = 0;
+    auto t0 = Clock::now();
+    for (int f = 0; f < frameCount; ++f) {
+        for (int c = 0; c < characterCount; ++c) {
+            const Transition* t = graph.Evaluate(forms[c], states[c], masks[(f + c * 97) % maskCount]);
+            if (t && t->target >= 0 && t->target != states[c]) {
+                states[c] = t->target;
+                ++transitions;
+            }
+            ++evaluations;
+        }
+    }
+    auto t1 = Clock::now();
+
+    const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << "[AnimGraph] " << characterCount << " characters x " << frameCount << " frames, "
+              << graph.m_transitions.size() << " compiled transitions" << std::endl;
+    std::cout << "  evaluate:    " << (evaluations > 0 ? ms * 1e6 / evaluations : 0.0) << " ns/character" << std::endl;
+    std::cout << "  transitions: " << (frameCount > 0 ? (double)transitions / frameCount : 0.0) << " per frame" << std::endl;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Body clip selection for each character form, read from AnimGraph.txt. A form
+// lists its states (clip, loop and behaviour flags) and prioritised
+// transitions guarded by condition bits. Load() compiles every state's
+// outgoing transitions, wildcard ones merged in, into one flat array sorted by
+// priority, so a tick is a walk over a few 12-byte entries comparing masks.
+class AnimationGraph {
+public:
+    enum Form {
+        FORM_NORMAL,
+        FORM_GUN,
+        FORM_GRENADE,
+        FORM_BAT_DEMON,
+        FORM_WEREWOLF,
+        FORM_KITSUNE,
+        FORM_ORC,
+        FORM_COUNT
+    };
+
+    // Filled in by CharacterAnimation once per evaluation; names in AnimGraph.txt
+    // are the lower-case enum names without the prefix
+    enum Condition : uint32_t {
+        COND_MOVING          = 1u << 0,
+        COND_RUNNING         = 1u << 1,
+        COND_AIRBORNE        = 1u << 2,
+        COND_ROLLING         = 1u << 3,
+        COND_SITTING         = 1u << 4,
+        COND_DYING           = 1u << 5,
+        COND_COMBO           = 1u << 6,
+        COND_AXE_COMBO       = 1u << 7,
+        COND_KICKING         = 1u << 8,
+        COND_HIT             = 1u << 9,
+        COND_LADDER          = 1u << 10,
+        COND_MOVE_KEY        = 1u << 11,
+        COND_RUN_KEY         = 1u << 12,
+        COND_SIT_KEY         = 1u << 13,
+        COND_CLIP_DONE       = 1u << 14,
+        COND_BAT_SLASH       = 1u << 15,
+        COND_WEREWOLF_COMBO  = 1u << 16,
+        COND_WEREWOLF_POUNCE = 1u << 17,
+        COND_KITSUNE_ORB     = 1u << 18,
+        COND_ORC_METEOR      = 1u << 19,
+        COND_ORC_FLAME       = 1u << 20,
+        COND_COUNT           = 21
+    };
+
+    enum StateFlags : uint8_t {
+        STATE_LOOP       = 1 << 0,
+        STATE_LOCK_INPUT = 1 << 1,  // movement input is locked while the clip plays
+        STATE_MANUAL     = 1 << 2,  // frames are stepped by code (ladder climbing)
+    };
+
+    struct State {
+        int16_t clip;
+        uint8_t flags;
+        uint32_t endAction;  // action condition cleared by code when the clip finishes; 0 for none
+    };
+
+    struct Transition {
+        uint32_t require;
+        uint32_t forbid;
+        int16_t target;      // state index within the form; -1 leaves playback alone
+        uint8_t restart;     // replay the clip even when it is already current
+    };
+
+    static AnimationGraph& Instance();
+
+    bool Load(const std::string& path);
+    bool IsLoaded() const { return !m_states.empty(); }
+
+    // First transition out of state (-1 for none yet) whose conditions hold; nullptr when none does
+    const Transition* Evaluate(int form, int state, uint32_t conditions) const;
+    const State& GetState(int form, int state) const { return m_states[m_forms[form].firstState + state]; }
+    // Body texture the form swaps to; -1 when the form keeps the character's own
+    int GetTextureId(int form) const { return m_forms[form].textureId; }
+
+    // Evaluates characterCount characters for frameCount frames over recorded-looking condition masks
+    static void RunBenchmark(const std::string& path, int characterCount, int frameCount);
+
+private:
+    struct Range {
+        int first;
+        int count;
+    };
+
+    struct FormInfo {
+        int textureId;
+        int firstState;
+        int stateCount;
+        Range entry;         // transitions taken before the form has a state
+    };
+
+    FormInfo m_forms[FORM_COUNT];
+    std::vector<State> m_states;
+    std::vector<Range> m_stateTransitions;  // parallel to m_states
+    std::vector<Transition> m_transitions;
+};
@@ -0,0 +1,39 @@
+#include "stdafx.h"
+#include "AnimationLibrary.h"
+
+AnimationLibrary& AnimationLibrary::Instance() {
+    static AnimationLibrary s_library;
+    return s_library;
+}
+
+void AnimationLibrary::BeginSheet(int textureId) {
+    if (textureId < 0) return;
+    if (textureId >= (int)m_sheetByTexture.size()) {
+        m_sheetByTexture.resize(textureId + 1, -1);
+    }
+    m_sheetByTexture[textureId] = (int16_t)m_sheets.size();
+    Sheet sheet = { textureId, (int)m_clips.size(), 0 };
+    m_sheets.push_back(sheet);
+}
+
+void AnimationLibrary::AddClip(int startFrame, int numFrames, int duration) {
+    if (m_sheets.empty()) return;
+    AnimationData clip = { startFrame, numFrames, duration, 0.1f };
+    if (numFrames > 1) {
+        clip.frameTime = (float)duration / (numFrames - 1) / 1000.0f;
+    }
+    m_clips.push_back(clip);
+    m_sheets.back().clipCount++;
+}
+
+int AnimationLibrary::FindSheet(int textureId) const {
+    if (textureId < 0 || textureId >= (int)m_sheetByTexture.size()) return -1;
+    return m_sheetByTexture[textureId];
+}
+
+const AnimationData* AnimationLibrary::GetClip(int sheet, int clip) const {
+    if (sheet < 0 || sheet >= (int)m_sheets.size()) return nullptr;
+    const Sheet& s = m_sheets[sheet];
+    if (clip < 0 || clip >= s.clipCount) return nullptr;
+    return &m_clips[s.firstClip + clip];
+}
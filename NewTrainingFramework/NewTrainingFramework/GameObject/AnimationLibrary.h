@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+struct AnimationData {
+    int startFrame;
+    int numFrames;
+    int duration;
+    float frameTime;
+};
+
+// Clip tables of every sprite sheet in RM.txt, compiled once while the
+// resources load (frame times included) and read-only afterwards. Playback
+// refers to a sheet by its index here, so a form change or an effect spawn
+// swaps an index instead of copying a table.
+class AnimationLibrary {
+public:
+    static AnimationLibrary& Instance();
+
+    // Resource loading only: opens the sheet of a texture; AddClip appends to it
+    void BeginSheet(int textureId);
+    void AddClip(int startFrame, int numFrames, int duration);
+
+    // -1 when the texture has no clips
+    int FindSheet(int textureId) const;
+    int GetTextureId(int sheet) const { return m_sheets[sheet].textureId; }
+    int GetClipCount(int sheet) const { return m_sheets[sheet].clipCount; }
+    // nullptr when clip is out of range
+    const AnimationData* GetClip(int sheet, int clip) const;
+
+private:
+    struct Sheet {
+        int textureId;
+        int firstClip;
+        int clipCount;
+    };
+
+    std::vector<Sheet> m_sheets;
+    std::vector<AnimationData> m_clips;
+    std::vector<int16_t> m_sheetByTexture;
+};
@@ -1,113 +1,111 @@
 #include "stdafx.h"
 #include "AnimationManager.h"
-#include <iostream>
+#include "../GameManager/Snapshot.h"
 
 AnimationManager::AnimationManager() 
-    : m_spriteWidth(0), m_spriteHeight(0), m_currentAnimation(-1), 
-      m_currentFrame(0), m_timer(0.0f), m_isLooping(false), m_isPlaying(false) {
+    : m_sheet(-1), m_currentAnimation(-1), m_currentFrame(0), m_timer(0.0f), m_flags(0) {
 }
 
-AnimationManager::~AnimationManager() {
+bool AnimationManager::SetSheet(int textureId) {
+    int sheet = AnimationLibrary::Instance().FindSheet(textureId);
+    if (sheet < 0) {
+        return false;
+    }
+    m_sheet = (int16_t)sheet;
+    return true;
 }
 
-void AnimationManager::Initialize(int spriteWidth, int spriteHeight, const std::vector<AnimationData>& animations) {
-    m_spriteWidth = spriteWidth;
-    m_spriteHeight = spriteHeight;
-    m_animations = animations;
-    
-    for (auto& anim : m_animations) {
-        if (anim.numFrames > 1) {
-            anim.frameTime = (float)anim.duration / (anim.numFrames - 1) / 1000.0f;
-        } else {
-            anim.frameTime = 0.1f;
-        }
-    }
+const AnimationData* AnimationManager::CurrentClip() const {
+    return AnimationLibrary::Instance().GetClip(m_sheet, m_currentAnimation);
 }
 
 void AnimationManager::Play(int animationIndex, bool loop) {
-    if (animationIndex < 0 || animationIndex >= static_cast<int>(m_animations.size())) {
+    if (animationIndex < 0 || animationIndex >= GetAnimationCount()) {
         return;
     }
     
-    m_currentAnimation = animationIndex;
+    m_currentAnimation = (int16_t)animationIndex;
     m_currentFrame = 0;
     m_timer = 0.0f;
-    m_isLooping = loop;
-    m_isPlaying = true;
-    
+    SetFlag(FLAG_LOOPING, loop);
+    SetFlag(FLAG_PLAYING, true);
 }
 
 void AnimationManager::Stop() {
-    m_isPlaying = false;
+    SetFlag(FLAG_PLAYING, false);
     m_currentFrame = 0;
     m_timer = 0.0f;
 }
 
 void AnimationManager::Pause() {
-    m_isPlaying = false;
+    SetFlag(FLAG_PLAYING, false);
 }
 
 void AnimationManager::Resume() {
-    m_isPlaying = true;
+    SetFlag(FLAG_PLAYING, true);
 }
 
 void AnimationManager::Update(float deltaTime) {
-    if (!m_isPlaying || m_currentAnimation < 0 || m_currentAnimation >= static_cast<int>(m_animations.size())) {
+    const AnimationData* currentAnim = CurrentClip();
+    if (!IsPlaying() || !currentAnim) {
         return;
     }
     
-    const AnimationData& currentAnim = m_animations[m_currentAnimation];
-    
-    if (currentAnim.numFrames <= 1) {
+    if (currentAnim->numFrames <= 1) {
         // Single frame animation - auto-finish after duration
         m_timer += deltaTime;
-        if (m_timer >= (float)currentAnim.duration / 1000.0f) {
-            m_isPlaying = false;
+        if (m_timer >= (float)currentAnim->duration / 1000.0f) {
+            SetFlag(FLAG_PLAYING, false);
         }
         return;
     }
     
     m_timer += deltaTime;
     
-    if (m_timer >= currentAnim.frameTime) {
-        m_timer -= currentAnim.frameTime;
+    if (m_timer >= currentAnim->frameTime) {
+        m_timer -= currentAnim->frameTime;
         m_currentFrame++;
         
-        if (m_currentFrame >= currentAnim.numFrames) {
-            if (m_isLooping) {
+        if (m_currentFrame >= currentAnim->numFrames) {
+            if (m_flags & FLAG_LOOPING) {
                 m_currentFrame = 0;
             } else {
-                m_currentFrame = currentAnim.numFrames - 1;
-                m_isPlaying = false;
+                m_currentFrame = currentAnim->numFrames - 1;
+                SetFlag(FLAG_PLAYING, false);
             }
         }
     }
 }
 
-void AnimationManager::GetUV(float& u0, float& v0, float& u1, float& v1) const {
-    if (m_currentAnimation < 0 || m_currentAnimation >= static_cast<int>(m_animations.size())) {
-        u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
-        return;
+int AnimationManager::GetSheetFrame() const {
+    const AnimationData* currentAnim = CurrentClip();
+    if (!currentAnim) {
+        return -1;
     }
-    
-    const AnimationData& currentAnim = m_animations[m_currentAnimation];
-    int frameIndex = currentAnim.startFrame + m_currentFrame;
-    
-    int frameX = frameIndex % m_spriteWidth;
-    int frameY = frameIndex / m_spriteWidth;
-    
-    float du = 1.0f / m_spriteWidth;
-    float dv = 1.0f / m_spriteHeight;
-    
-    u0 = frameX * du;
-    v0 = (m_spriteHeight - 1 - frameY) * dv;
-    u1 = u0 + du;
-    v1 = v0 + dv;
+    return currentAnim->startFrame + m_currentFrame;
+}
+
+int AnimationManager::GetAnimationCount() const {
+    return m_sheet >= 0 ? AnimationLibrary::Instance().GetClipCount(m_sheet) : 0;
 }
 
 const AnimationData* AnimationManager::GetAnimation(int index) const {
-    if (index >= 0 && index < static_cast<int>(m_animations.size())) {
-        return &m_animations[index];
+    return AnimationLibrary::Instance().GetClip(m_sheet, index);
+}
+
+template <class Archive>
+void AnimationManager::TransferState(Archive& ar) {
+    // Sheet indices follow RM.txt load order, so the sheet is stored by texture
+    int textureId = m_sheet >= 0 ? AnimationLibrary::Instance().GetTextureId(m_sheet) : -1;
+    ar(textureId);
+    if (Archive::IS_LOADING) {
+        m_sheet = (int16_t)AnimationLibrary::Instance().FindSheet(textureId);
     }
-    return nullptr;
-} 
\ No newline at end of file
+    ar(m_currentAnimation);
+    ar(m_currentFrame);
+    ar(m_timer);
+    ar(m_flags);
+}
+
+template void AnimationManager::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void AnimationManager::TransferState<SnapshotReader>(SnapshotReader&);
@@ -1,48 +1,56 @@
 #pragma once
-#include <vector>
-#include <string>
-#include <memory>
-
-struct AnimationData {
-    int startFrame;
-    int numFrames;
-    int duration;
-    float frameTime;
-};
+#include "AnimationLibrary.h"
+#include <cstdint>
 
+// Playback of one clip from the shared AnimationLibrary. It holds only the
+// sheet and clip indices, the frame, the timer and its flags, so it lives by
+// value in its owner and binding another sheet never allocates.
 class AnimationManager {
 private:
-    int m_spriteWidth;
-    int m_spriteHeight;
-    std::vector<AnimationData> m_animations;
-    
-    int m_currentAnimation;
-    int m_currentFrame;
+    enum Flags : uint32_t {
+        FLAG_PLAYING = 1 << 0,
+        FLAG_LOOPING = 1 << 1,
+    };
+
+    int16_t m_sheet;
+    int16_t m_currentAnimation;
+    int32_t m_currentFrame;
     float m_timer;
-    bool m_isLooping;
-    bool m_isPlaying;
+    uint32_t m_flags;
+
+    const AnimationData* CurrentClip() const;
+    void SetFlag(uint32_t flag, bool on) { m_flags = on ? (m_flags | flag) : (m_flags & ~flag); }
 
 public:
     AnimationManager();
-    ~AnimationManager();
-    
-    void Initialize(int spriteWidth, int spriteHeight, const std::vector<AnimationData>& animations);
+
+    // Plays clips from the sheet of textureId; the clip index, frame and timer
+    // carry over. False, with nothing changed, when the texture has no clips.
+    bool SetSheet(int textureId);
+    bool HasSheet() const { return m_sheet >= 0; }
     
     void Play(int animationIndex, bool loop = true);
     void Stop();
     void Pause();
     void Resume();
-    void SetPlaying(bool playing) { m_isPlaying = playing; }
+    void SetPlaying(bool playing) { SetFlag(FLAG_PLAYING, playing); }
     
     void Update(float deltaTime);
     
     int GetCurrentAnimation() const { return m_currentAnimation; }
     int GetCurrentFrame() const { return m_currentFrame; }
     void SetCurrentFrame(int frame) { m_currentFrame = frame; }
-    bool IsPlaying() const { return m_isPlaying; }
+    bool IsPlaying() const { return (m_flags & FLAG_PLAYING) != 0; }
     
-    void GetUV(float& u0, float& v0, float& u1, float& v1) const;
+    // Cell of the sprite sheet to draw, for Object::SetSpriteFrame; -1 before Play()
+    int GetSheetFrame() const;
     
-    int GetAnimationCount() const { return m_animations.size(); }
+    int GetAnimationCount() const;
     const AnimationData* GetAnimation(int index) const;
-}; 
\ No newline at end of file
+
+    // Sheet (by texture id) and playback position
+    template <class Archive>
+    void TransferState(Archive& ar);
+};
+
+static_assert(sizeof(AnimationManager) == 16, "playback state is meant to stay 16 bytes");
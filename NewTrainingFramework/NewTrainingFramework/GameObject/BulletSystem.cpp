@@ -0,0 +1,258 @@
+#include "stdafx.h"
+#include "BulletSystem.h"
+#include "WallCollision.h"
+#include "CollisionWorld.h"
+#include "../GameManager/Snapshot.h"
+#include <chrono>
+#include <cmath>
+
+BulletSystem::BulletSystem()
+    : m_capacity(0) {
+}
+
+BulletSystem::~BulletSystem() {
+}
+
+void BulletSystem::Reserve(int capacity) {
+    m_capacity = capacity;
+    m_x.reserve(capacity);
+    m_y.reserve(capacity);
+    m_vx.reserve(capacity);
+    m_vy.reserve(capacity);
+    m_life.reserve(capacity);
+    m_owner.reserve(capacity);
+    m_flags.reserve(capacity);
+    m_damage.reserve(capacity);
+    m_angle.reserve(capacity);
+    m_faceSign.reserve(capacity);
+    m_trailTimer.reserve(capacity);
+    m_objIndex.reserve(capacity);
+}
+
+void BulletSystem::Clear() {
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_life.clear();
+    m_owner.clear();
+    m_flags.clear();
+    m_damage.clear();
+    m_angle.clear();
+    m_faceSign.clear();
+    m_trailTimer.clear();
+    m_objIndex.clear();
+}
+
+template <class Archive>
+void BulletSystem::TransferState(Archive& ar) {
+    ar(m_x); ar(m_y); ar(m_vx); ar(m_vy); ar(m_life); ar(m_owner); ar(m_flags);
+    ar(m_damage); ar(m_angle); ar(m_faceSign); ar(m_trailTimer); ar(m_objIndex);
+}
+
+template void BulletSystem::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void BulletSystem::TransferState<SnapshotReader>(SnapshotReader&);
+
+int BulletSystem::Spawn(float x, float y, float vx, float vy, float life,
+                        int ownerId, uint8_t flags, float damage,
+                        float angleRad, float faceSign, int objIndex) {
+    if (m_capacity > 0 && Size() >= m_capacity) {
+        return -1;
+    }
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_vx.push_back(vx);
+    m_vy.push_back(vy);
+    m_life.push_back(life);
+    m_owner.push_back(ownerId);
+    m_flags.push_back(flags);
+    m_damage.push_back(damage);
+    m_angle.push_back(angleRad);
+    m_faceSign.push_back(faceSign);
+    m_trailTimer.push_back(0.0f);
+    m_objIndex.push_back(objIndex);
+    return Size() - 1;
+}
+
+void BulletSystem::Integrate(float dt) {
+    const int n = Size();
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* life = m_life.data();
+    const float* vx = m_vx.data();
+    const float* vy = m_vy.data();
+    for (int i = 0; i < n; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+    }
+
+    uint8_t* flags = m_flags.data();
+    for (int i = 0; i < n; ++i) {
+        flags[i] |= (life[i] <= 0.0f) ? (uint8_t)FLAG_DEAD : (uint8_t)0;
+    }
+}
+
+void BulletSystem::CollideWalls(const WallCollision& walls, float width, float height, std::vector<Hit>& outHits) {
+    const std::vector<Wall>& wallList = walls.GetWalls();
+    if (wallList.empty()) return;
+
+    // Wall edges are loop invariant, so expand them once per pass
+    struct Edges { float left; float right; float bottom; float top; };
+    std::vector<Edges> edges;
+    edges.reserve(wallList.size());
+    for (const Wall& w : wallList) {
+        edges.push_back({ w.GetLeft(), w.GetRight(), w.GetBottom(), w.GetTop() });
+    }
+
+    const float halfW = width * 0.5f;
+    const float halfH = height * 0.5f;
+    const int n = Size();
+    for (int i = 0; i < n; ++i) {
+        if (m_flags[i] & FLAG_DEAD) continue;
+        const float bLeft = m_x[i] - halfW;
+        const float bRight = m_x[i] + halfW;
+        const float bBottom = m_y[i] - halfH;
+        const float bTop = m_y[i] + halfH;
+        for (const Edges& e : edges) {
+            if (bLeft < e.right && bRight > e.left && bBottom < e.top && bTop > e.bottom) {
+                m_flags[i] |= FLAG_DEAD;
+                outHits.push_back({ i });
+                break;
+            }
+        }
+    }
+}
+
+void BulletSystem::RemoveAt(int i) {
+    const int last = Size() - 1;
+    if (i != last) {
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_life[i] = m_life[last];
+        m_owner[i] = m_owner[last];
+        m_flags[i] = m_flags[last];
+        m_damage[i] = m_damage[last];
+        m_angle[i] = m_angle[last];
+        m_faceSign[i] = m_faceSign[last];
+        m_trailTimer[i] = m_trailTimer[last];
+        m_objIndex[i] = m_objIndex[last];
+    }
+    m_x.pop_back();
+    m_y.pop_back();
+    m_vx.pop_back();
+    m_vy.pop_back();
+    m_life.pop_back();
+    m_owner.pop_back();
+    m_flags.pop_back();
+    m_damage.pop_back();
+    m_angle.pop_back();
+    m_faceSign.pop_back();
+    m_trailTimer.pop_back();
+    m_objIndex.pop_back();
+}
+
+void BulletSystem::Compact(std::vector<Released>& outReleased) {
+    for (int i = 0; i < Size(); ) {
+        if (m_flags[i] & FLAG_DEAD) {
+            if (m_objIndex[i] >= 0) outReleased.push_back({ m_objIndex[i], m_flags[i] });
+            RemoveAt(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void BulletSystem::RunBenchmark(int bulletCount, int frameCount) {
+    typedef std::chrono::high_resolution_clock Clock;
+    const float dt = 1.0f / 60.0f;
+    const float size = 0.02f;
+
+    WallCollision walls;
+    walls.AddWall(0.0f, -1.2f, 4.0f, 0.2f, -1);
+    walls.AddWall(-2.0f, 0.0f, 0.2f, 2.6f, -1);
+    walls.AddWall(2.0f, 0.0f, 0.2f, 2.6f, -1);
+    walls.AddWall(0.0f, 0.3f, 0.6f, 0.05f, -1);
+
+    const float hurtboxes[2][4] = {
+        { -0.8f, -0.7f, -0.6f, -0.4f },
+        {  0.7f,  0.8f, -0.6f, -0.4f },
+    };
+    CollisionWorld world;
+    world.Reserve(bulletCount + 2);
+    std::vector<CollisionWorld::Pair> pairs;
+
+    unsigned int seed = 12345u;
+    auto nextRand = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float)((seed >> 8) & 0xFFFF) / 65535.0f;
+    };
+
+    BulletSystem bullets;
+    bullets.Reserve(bulletCount);
+    auto refill = [&]() {
+        while (bullets.Size() < bulletCount) {
+            float a = nextRand() * 6.2831853f;
+            bullets.Spawn(nextRand() * 3.6f - 1.8f, nextRand() * 2.0f - 1.0f,
+                          cosf(a) * 3.5f, sinf(a) * 3.5f, 0.1f + nextRand() * 2.0f,
+                          (nextRand() < 0.5f) ? 1 : 2, 0, 10.0f, a, 1.0f, -1);
+        }
+    };
+
+    std::vector<Hit> hits;
+    std::vector<Released> freed;
+    hits.reserve(bulletCount);
+    freed.reserve(bulletCount);
+
+    double integrateMs = 0.0, wallMs = 0.0, targetMs = 0.0, compactMs = 0.0;
+    long long removed = 0;
+    for (int f = 0; f < frameCount; ++f) {
+        refill();
+        hits.clear();
+        freed.clear();
+
+        auto t0 = Clock::now();
+        bullets.Integrate(dt);
+        auto t1 = Clock::now();
+        bullets.CollideWalls(walls, size, size, hits);
+        auto t2 = Clock::now();
+        // Same registration the game's collision phase does for bullets
+        world.Clear();
+        for (int p = 0; p < 2; ++p) {
+            world.Add(CollisionWorld::LAYER_HURTBOX, 0, hurtboxes[p][0], hurtboxes[p][1], hurtboxes[p][2], hurtboxes[p][3],
+                      0, p, (uint8_t)(p + 1));
+        }
+        for (int i = 0; i < bullets.Size(); ++i) {
+            if (bullets.IsDead(i)) continue;
+            float x = bullets.GetX(i), y = bullets.GetY(i);
+            world.Add(CollisionWorld::LAYER_PROJECTILE, CollisionWorld::LAYER_HURTBOX,
+                      x - size * 0.5f, x + size * 0.5f, y - size * 0.5f, y + size * 0.5f,
+                      1, i, (uint8_t)bullets.GetOwnerId(i));
+        }
+        world.GeneratePairs(pairs);
+        for (const CollisionWorld::Pair& pair : pairs) {
+            const CollisionWorld::Collider& c = world.Get(pair.collider);
+            if (c.owner != world.Get(pair.other).owner) bullets.Kill(c.source);
+        }
+        auto t3 = Clock::now();
+        int before = bullets.Size();
+        bullets.Compact(freed);
+        auto t4 = Clock::now();
+
+        removed += before - bullets.Size();
+        integrateMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        wallMs      += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        targetMs    += std::chrono::duration<double, std::milli>(t3 - t2).count();
+        compactMs   += std::chrono::duration<double, std::milli>(t4 - t3).count();
+    }
+
+    const double inv = frameCount > 0 ? 1.0 / frameCount : 0.0;
+    std::cout << "[BulletSystem] " << bulletCount << " bullets x " << frameCount << " frames" << std::endl;
+    std::cout << "  integrate: " << integrateMs * inv << " ms/frame" << std::endl;
+    std::cout << "  walls:     " << wallMs * inv << " ms/frame" << std::endl;
+    std::cout << "  targets:   " << targetMs * inv << " ms/frame" << std::endl;
+    std::cout << "  compact:   " << compactMs * inv << " ms/frame (" << (double)removed * inv << " removed/frame)" << std::endl;
+    std::cout << "  total:     " << (integrateMs + wallMs + targetMs + compactMs) * inv << " ms/frame" << std::endl;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+class WallCollision;
+
+// Projectile state kept as structure-of-arrays so integration and collision
+// run over tightly packed floats. Dead entries are only flagged during the
+// frame and compacted with swap-remove in Compact().
+class BulletSystem {
+public:
+    enum Flags : uint8_t {
+        FLAG_BAZOKA = 1 << 0,
+        FLAG_DEAD   = 1 << 1,
+    };
+
+    struct Hit {
+        int index;
+    };
+
+    struct Released {
+        int objIndex;
+        uint8_t flags;
+    };
+
+    BulletSystem();
+    ~BulletSystem();
+
+    void Reserve(int capacity);
+    void Clear();
+
+    int Spawn(float x, float y, float vx, float vy, float life,
+              int ownerId, uint8_t flags, float damage,
+              float angleRad, float faceSign, int objIndex);
+
+    // Tight loop over positions and lifetimes; marks expired bullets dead
+    void Integrate(float dt);
+    // Batched wall pass; appends hits for live bullets and marks them dead.
+    // Hits against characters are found by the game's CollisionWorld phase.
+    void CollideWalls(const WallCollision& walls, float width, float height, std::vector<Hit>& outHits);
+    // Swap-remove every dead entry; released render slots are appended to outReleased
+    void Compact(std::vector<Released>& outReleased);
+
+    // Every column; restoring within the reserved capacity does not allocate
+    template <class Archive>
+    void TransferState(Archive& ar);
+
+    int  Size() const { return (int)m_x.size(); }
+    int  Capacity() const { return m_capacity; }
+    bool IsDead(int i) const { return (m_flags[i] & FLAG_DEAD) != 0; }
+    bool IsBazoka(int i) const { return (m_flags[i] & FLAG_BAZOKA) != 0; }
+    void Kill(int i) { m_flags[i] |= FLAG_DEAD; }
+
+    float GetX(int i) const { return m_x[i]; }
+    float GetY(int i) const { return m_y[i]; }
+    float GetVX(int i) const { return m_vx[i]; }
+    float GetVY(int i) const { return m_vy[i]; }
+    float GetAngle(int i) const { return m_angle[i]; }
+    float GetFaceSign(int i) const { return m_faceSign[i]; }
+    float GetDamage(int i) const { return m_damage[i]; }
+    int   GetOwnerId(int i) const { return m_owner[i]; }
+    int   GetObjIndex(int i) const { return m_objIndex[i]; }
+    float& TrailTimer(int i) { return m_trailTimer[i]; }
+
+    // Simulates bulletCount live bullets for frameCount frames and prints per-pass timings
+    static void RunBenchmark(int bulletCount, int frameCount);
+
+private:
+    void RemoveAt(int i);
+
+    int m_capacity;
+
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_vx;
+    std::vector<float> m_vy;
+    std::vector<float> m_life;
+    std::vector<int> m_owner;
+    std::vector<uint8_t> m_flags;
+
+    // Cold data, only touched on hit, draw and trail spawn
+    std::vector<float> m_damage;
+    std::vector<float> m_angle;
+    std::vector<float> m_faceSign;
+    std::vector<float> m_trailTimer;
+    std::vector<int> m_objIndex;
+};
@@ -1,7 +1,8 @@
 #include "stdafx.h"
 #include "Camera.h"
 #include <cmath>
-#include <SDL.h>
+#include "../GameManager/SimulationClock.h"
+#include "../GameManager/Snapshot.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -111,7 +112,7 @@ void Camera::UpdateShake(float dt) {
     float t = m_shakeTimeRemaining / (m_shakeDuration > 0.0f ? m_shakeDuration : 1.0f);
     if (t < 0.0f) t = 0.0f;
     float amp = m_shakeAmplitude * (0.5f + 0.5f * t);
-    float time = SDL_GetTicks() / 1000.0f;
+    float time = SimulationClock::Instance().GetTime();
     float ox = sinf(time * m_shakeFrequency * 6.2831853f) * amp;
     float oy = cosf(time * (m_shakeFrequency * 0.8f) * 6.2831853f) * amp;
     m_shakeOffset.x = ox;
@@ -253,6 +254,7 @@ void Camera::SetCameraPadding(float paddingX, float paddingY) {
 void Camera::ResetToInitialState() {
     m_position = m_initialPosition;
     m_target = m_initialTarget;
+    m_hasSnapshot = false;
     
     m_currentZoom = m_initialZoom;
     m_targetZoom = m_initialZoom;
@@ -288,9 +290,29 @@ const Matrix& Camera::GetViewProjectionMatrix() {
     return m_viewProjectionMatrix;
 }
 
+void Camera::SnapshotPosition() {
+    m_prevX = m_position.x;
+    m_prevY = m_position.y;
+    m_hasSnapshot = true;
+}
+
+void Camera::SetRenderAlpha(float alpha) {
+    if (alpha == m_renderAlpha) return;
+    m_renderAlpha = alpha;
+    if (m_hasSnapshot) {
+        m_viewNeedsUpdate = true;
+        m_vpMatrixNeedsUpdate = true;
+    }
+}
+
 void Camera::UpdateViewMatrix() {
-    Vector3 posCopy(m_position.x, m_position.y, m_position.z);
-    Vector3 targetCopy(m_target.x, m_target.y, m_target.z);
+    float ox = 0.0f, oy = 0.0f;
+    if (m_hasSnapshot) {
+        ox = (m_prevX - m_position.x) * (1.0f - m_renderAlpha);
+        oy = (m_prevY - m_position.y) * (1.0f - m_renderAlpha);
+    }
+    Vector3 posCopy(m_position.x + ox, m_position.y + oy, m_position.z);
+    Vector3 targetCopy(m_target.x + ox, m_target.y + oy, m_target.z);
     Vector3 upCopy(m_up.x, m_up.y, m_up.z);
     m_viewMatrix.SetLookAt(posCopy, targetCopy, upCopy);
     m_viewNeedsUpdate = false;
@@ -321,4 +343,22 @@ void Camera::AddShake(float amplitude, float duration, float frequency) {
     m_shakeDuration = duration;
     m_shakeFrequency = frequency;
     m_shakeTimeRemaining = duration;
-}
\ No newline at end of file
+}
+
+template <class Archive>
+void Camera::TransferState(Archive& ar) {
+    ar(m_position); ar(m_target);
+    ar(m_left); ar(m_right); ar(m_bottom); ar(m_top);
+    ar(m_currentZoom); ar(m_targetZoom); ar(m_autoZoomEnabled); ar(m_verticalOffset);
+    ar(m_shakeTimeRemaining); ar(m_shakeDuration); ar(m_shakeAmplitude); ar(m_shakeFrequency);
+    ar(m_shakeOffset);
+    ar(m_prevX); ar(m_prevY); ar(m_hasSnapshot);
+    if (Archive::IS_LOADING) {
+        m_viewNeedsUpdate = true;
+        m_projectionNeedsUpdate = true;
+        m_vpMatrixNeedsUpdate = true;
+    }
+}
+
+template void Camera::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void Camera::TransferState<SnapshotReader>(SnapshotReader&);
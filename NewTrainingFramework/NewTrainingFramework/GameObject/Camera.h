@@ -41,6 +41,12 @@ private:
     float m_shakeAmplitude = 0.0f;
     float m_shakeFrequency = 20.0f;
     Vector3 m_shakeOffset = Vector3(0.0f, 0.0f, 0.0f);
+
+    // Render interpolation: the view matrix is built between the snapshot and m_position
+    float m_prevX = 0.0f;
+    float m_prevY = 0.0f;
+    float m_renderAlpha = 1.0f;
+    bool m_hasSnapshot = false;
     
     void UpdateViewMatrix();
     void UpdateProjectionMatrix();
@@ -77,6 +83,14 @@ public:
     void SetCameraPadding(float paddingX, float paddingY);
 
     void AddShake(float amplitude, float duration, float frequency = 20.0f);
+
+    // Call at the start of each simulation tick, and SetRenderAlpha() before drawing
+    void SnapshotPosition();
+    void SetRenderAlpha(float alpha);
+
+    // Follow, zoom and shake state; the frustum setup from Init() is not included
+    template <class Archive>
+    void TransferState(Archive& ar);
     
     const Matrix& GetViewMatrix();
     const Matrix& GetProjectionMatrix();
@@ -3,6 +3,7 @@
 #include "CharacterAnimation.h"
 #include "CharacterHitbox.h"
 #include "../GameManager/SoundManager.h"
+#include "../GameManager/Snapshot.h"
 #include "SceneManager.h"
 #include "ResourceManager.h"
 #include "InputManager.h"
@@ -242,9 +243,9 @@ void Character::TriggerOrcFlameBurst() {
     }
 }
 
-void Character::Initialize(std::shared_ptr<AnimationManager> animManager, int objectId) {
+void Character::Initialize(int bodyTextureId, int objectId) {
     if (m_animation) {
-        m_animation->Initialize(animManager, objectId);
+        m_animation->Initialize(bodyTextureId, objectId);
     }
     
     Object* originalObj = SceneManager::GetInstance()->GetObject(objectId);
@@ -271,10 +272,7 @@ void Character::ProcessInput(float deltaTime, InputManager* inputManager) {
         return;
     }
     
-    const bool* keyStates = inputManager->GetKeyStates();
-    if (!keyStates) {
-        return;
-    }
+    const KeyStates& keyStates = inputManager->GetKeyStates();
     
     if (m_movement && m_combat) {
 		bool lock = m_combat->IsKicking();
@@ -450,7 +448,7 @@ void Character::Draw(Camera* camera) {
 
 
 
-void Character::CancelCombosOnOtherAction(const bool* keyStates) {
+void Character::CancelCombosOnOtherAction(const KeyStates& keyStates) {
 }
 
 void Character::SetPosition(float x, float y) {
@@ -461,6 +459,10 @@ Vector3 Character::GetPosition() const {
     return m_movement->GetPosition();
 }
 
+void Character::SaveRenderState() {
+    m_movement->SaveRenderState();
+}
+
 bool Character::IsFacingLeft() const {
     return m_movement->IsFacingLeft();
 }
@@ -566,20 +568,12 @@ bool Character::IsAnimationPlaying() const {
     return m_animation ? m_animation->IsAnimationPlaying() : false;
 }
 
-void Character::GetCurrentFrameUV(float& u0, float& v0, float& u1, float& v1) const {
-    if (m_animation) {
-        m_animation->GetCurrentFrameUV(u0, v0, u1, v1);
-    } else {
-        u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
-    }
+int Character::GetCurrentSheetFrame() const {
+    return m_animation ? m_animation->GetCurrentSheetFrame() : -1;
 }
 
-void Character::GetTopFrameUV(float& u0, float& v0, float& u1, float& v1) const {
-    if (m_animation) {
-        m_animation->GetTopFrameUV(u0, v0, u1, v1);
-    } else {
-        u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
-    }
+int Character::GetTopSheetFrame() const {
+    return m_animation ? m_animation->GetTopSheetFrame() : -1;
 }
 
 int Character::GetHeadTextureId() const {
@@ -905,4 +899,24 @@ void Character::MarkGunShotFired() {
     if (m_animation) {
         m_animation->OnGunShotFired(m_movement.get());
     }
-}
\ No newline at end of file
+}
+
+template <class Archive>
+void Character::TransferState(Archive& ar) {
+    ar(m_health);
+    ar(m_isDead);
+    ar(m_prevHardLandingActive);
+    ar(m_lastDamageTime);
+    ar(m_isHealing);
+    ar(m_stamina);
+    ar(m_prevRolling);
+    ar(m_prevJumpingForStamina);
+    ar(m_weapon);
+    ar(m_suppressNextPunch);
+    if (m_movement) m_movement->TransferState(ar);
+    if (m_combat) m_combat->TransferState(ar);
+    if (m_animation) m_animation->TransferState(ar);
+}
+
+template void Character::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void Character::TransferState<SnapshotReader>(SnapshotReader&);
@@ -7,7 +7,6 @@
 #include "CharacterHitbox.h"
 #include "../../Utilities/Math.h"
 
-class AnimationManager;
 class CharacterAnimation;
 
 class InputManager;
@@ -46,7 +45,7 @@ private:
     bool ShouldBlockInput() const;
 
     // Helper methods
-    void CancelCombosOnOtherAction(const bool* keyStates);
+    void CancelCombosOnOtherAction(const KeyStates& keyStates);
 
     // Inventory/state
     WeaponType m_weapon = WeaponType::None;
@@ -58,7 +57,7 @@ public:
     Character();
     ~Character();
     
-    void Initialize(std::shared_ptr<AnimationManager> animManager, int objectId);
+    void Initialize(int bodyTextureId, int objectId);
     void SetInputConfig(const PlayerInputConfig& config);
     void SetGunMode(bool enabled);
     bool IsGunMode() const;
@@ -96,6 +95,8 @@ public:
     // Movement
     void SetPosition(float x, float y);
     Vector3 GetPosition() const;
+    // Called at the start of every simulation tick
+    void SaveRenderState();
     bool IsFacingLeft() const;
     void SetFacingLeft(bool facingLeft);
     CharState GetState() const;
@@ -150,8 +151,9 @@ public:
     void PlayAnimation(int animIndex, bool loop);
     int GetCurrentAnimation() const;
     bool IsAnimationPlaying() const;
-    void GetCurrentFrameUV(float& u0, float& v0, float& u1, float& v1) const;
-    void GetTopFrameUV(float& u0, float& v0, float& u1, float& v1) const;
+    // Sprite sheet cells of the body and the gun/grenade top layer, -1 when none
+    int GetCurrentSheetFrame() const;
+    int GetTopSheetFrame() const;
     int GetHeadTextureId() const;
     int GetBodyTextureId() const;
     float GetHeadOffsetX() const;
@@ -207,6 +209,10 @@ public:
      CharacterCombat* GetCombat() const { return m_combat.get(); }
      void SetSelfDeathCallback(std::function<void(Character&)> callback) { m_selfDeathCallback = callback; }
 
+     // Health, stamina and inventory plus the movement, combat and animation state
+     template <class Archive>
+     void TransferState(Archive& ar);
+
      // Werewolf action state queries for hurtbox selection
      bool IsWerewolfComboActive() const;
      bool IsWerewolfPounceActive() const;
@@ -3,12 +3,14 @@
 #include "CharacterMovement.h"
 #include "CharacterMovement.h" // ensure PlayerInputConfig is visible
 #include "CharacterCombat.h"
+#include "InputManager.h"
 #include "AnimationManager.h"
 #include "SceneManager.h"
 #include "../GameManager/ResourceManager.h"
 #include "../GameManager/SoundManager.h"
+#include "../GameManager/SimulationClock.h"
+#include "../GameManager/Snapshot.h"
 #include "Object.h"
-#include <SDL.h>
 #include <iostream>
 #include <cmath>
 
@@ -26,8 +28,9 @@ CharacterAnimation::CharacterAnimation()
 CharacterAnimation::~CharacterAnimation() {
 }
 
-void CharacterAnimation::Initialize(std::shared_ptr<AnimationManager> animManager, int objectId) {
-    m_animManager = animManager;
+void CharacterAnimation::Initialize(int bodyTextureId, int objectId) {
+    m_animManager = AnimationManager();
+    m_animManager.SetSheet(bodyTextureId);
     m_objectId = objectId;
     
     m_characterObject = std::make_unique<Object>(objectId);
@@ -43,21 +46,13 @@ void CharacterAnimation::Initialize(std::shared_ptr<AnimationManager> animManage
         m_characterObject->SetScale(originalObj->GetScale());
     }
     
-    if (m_animManager) {
-        m_animManager->Play(0, true);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(0, true);
     }
 
     int headTexId = (m_objectId == 1000) ? 8 : 9;
-    const TextureData* headTex = ResourceManager::GetInstance()->GetTextureData(headTexId);
-    if (headTex && headTex->spriteWidth > 0 && headTex->spriteHeight > 0) {
-        m_topAnimManager = std::make_shared<AnimationManager>();
-        std::vector<AnimationData> topAnims;
-        topAnims.reserve(headTex->animations.size());
-        for (const auto& a : headTex->animations) {
-            topAnims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_topAnimManager->Initialize(headTex->spriteWidth, headTex->spriteHeight, topAnims);
-        m_topAnimManager->Play(0, true);
+    if (m_topAnimManager.SetSheet(headTexId)) {
+        m_topAnimManager.Play(0, true);
 
         m_topObject = std::make_unique<Object>(objectId + 10000); // unique id for overlay
         if (originalObj) {
@@ -70,55 +65,55 @@ void CharacterAnimation::Initialize(std::shared_ptr<AnimationManager> animManage
 }
 
 void CharacterAnimation::Update(float deltaTime, CharacterMovement* movement, CharacterCombat* combat) {
-    if (m_animManager) {
-        m_animManager->Update(deltaTime);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Update(deltaTime);
         UpdateAnimationState(movement, combat);
     }
     if (movement) {
         m_lastFacingLeft = movement->IsFacingLeft();
     }
-    if (m_topAnimManager) {
-        m_topAnimManager->Update(deltaTime);
+    if (m_topAnimManager.HasSheet()) {
+        m_topAnimManager.Update(deltaTime);
     }
-    if (m_orcFireActive && m_orcFireAnim) {
-        m_orcFireAnim->Update(deltaTime);
-        if (!m_orcFireAnim->IsPlaying()) {
+    if (m_orcFireActive && m_orcFireAnim.HasSheet()) {
+        m_orcFireAnim.Update(deltaTime);
+        if (!m_orcFireAnim.IsPlaying()) {
             m_orcFireActive = false;
             if (m_orcFireObject) {
                 m_orcFireObject->SetVisible(false);
             }
         }
     }
-    if (m_orcAppearActive && m_orcAppearAnim) {
-        m_orcAppearAnim->Update(deltaTime);
-        if (!m_orcAppearAnim->IsPlaying()) {
+    if (m_orcAppearActive && m_orcAppearAnim.HasSheet()) {
+        m_orcAppearAnim.Update(deltaTime);
+        if (!m_orcAppearAnim.IsPlaying()) {
             m_orcAppearActive = false;
             if (m_orcAppearObject) {
                 m_orcAppearObject->SetVisible(false);
             }
         }
     }
-    if (m_werewolfAppearActive && m_werewolfAppearAnim) {
-        m_werewolfAppearAnim->Update(deltaTime);
-        if (!m_werewolfAppearAnim->IsPlaying()) {
+    if (m_werewolfAppearActive && m_werewolfAppearAnim.HasSheet()) {
+        m_werewolfAppearAnim.Update(deltaTime);
+        if (!m_werewolfAppearAnim.IsPlaying()) {
             m_werewolfAppearActive = false;
             if (m_werewolfAppearObject) {
                 m_werewolfAppearObject->SetVisible(false);
             }
         }
     }
-    if (m_batAppearActive && m_batAppearAnim) {
-        m_batAppearAnim->Update(deltaTime);
-        if (!m_batAppearAnim->IsPlaying()) {
+    if (m_batAppearActive && m_batAppearAnim.HasSheet()) {
+        m_batAppearAnim.Update(deltaTime);
+        if (!m_batAppearAnim.IsPlaying()) {
             m_batAppearActive = false;
             if (m_batAppearObject) {
                 m_batAppearObject->SetVisible(false);
             }
         }
     }
-    if (m_kitsuneAppearActive && m_kitsuneAppearAnim) {
-        m_kitsuneAppearAnim->Update(deltaTime);
-        if (!m_kitsuneAppearAnim->IsPlaying()) {
+    if (m_kitsuneAppearActive && m_kitsuneAppearAnim.HasSheet()) {
+        m_kitsuneAppearAnim.Update(deltaTime);
+        if (!m_kitsuneAppearAnim.IsPlaying()) {
             m_kitsuneAppearActive = false;
             if (m_kitsuneAppearObject) {
                 m_kitsuneAppearObject->SetVisible(false);
@@ -126,14 +121,14 @@ void CharacterAnimation::Update(float deltaTime, CharacterMovement* movement, Ch
         }
     }
 
-    if (m_batWindActive && m_batWindAnim) {
-        m_batWindAnim->Update(deltaTime);
+    if (m_batWindActive && m_batWindAnim.HasSheet()) {
+        m_batWindAnim.Update(deltaTime);
         if (m_batWindObject) {
             const Vector3& p = m_batWindObject->GetPosition();
             float dx = m_batWindSpeed * m_batWindFaceSign * deltaTime;
             m_batWindObject->SetPosition(p.x + dx, p.y, p.z);
         }
-        if (!m_batWindAnim->IsPlaying()) {
+        if (!m_batWindAnim.IsPlaying()) {
             m_batWindActive = false;
             if (m_batWindObject) {
                 m_batWindObject->SetVisible(false);
@@ -147,15 +142,13 @@ void CharacterAnimation::Update(float deltaTime, CharacterMovement* movement, Ch
     }
     
     if (m_isBatDemon) {
-        static float wingFlapTimer = 0.0f;
-        wingFlapTimer += deltaTime;
-        if (wingFlapTimer >= 2.0f) {
+        m_wingFlapTimer += deltaTime;
+        if (m_wingFlapTimer >= 2.0f) {
             SoundManager::Instance().PlaySFXByID(32, 1);
-            wingFlapTimer = 0.0f;
+            m_wingFlapTimer = 0.0f;
         }
     } else {
-        static float wingFlapTimer = 0.0f;
-        wingFlapTimer = 0.0f;
+        m_wingFlapTimer = 0.0f;
     }
 
     if (m_kitsuneEnergyOrbCooldownTimer > 0.0f) {
@@ -246,7 +239,7 @@ void CharacterAnimation::Update(float deltaTime, CharacterMovement* movement, Ch
 
 void CharacterAnimation::StartHardLanding(CharacterMovement* movement) {
     if (m_hardLandingActive) return;
-    unsigned int nowMs = SDL_GetTicks();
+    unsigned int nowMs = SimulationClock::Instance().GetTimeMs();
     if (m_blockHardLandingUntilMs != 0 && nowMs < m_blockHardLandingUntilMs) {
         return;
     }
@@ -268,41 +261,32 @@ void CharacterAnimation::StartHardLanding(CharacterMovement* movement) {
 }
 
 void CharacterAnimation::Draw(Camera* camera, CharacterMovement* movement) {
-    if (m_characterObject && m_animManager && m_characterObject->GetModelId() >= 0 && m_characterObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_animManager->GetUV(u0, v0, u1, v1);
-        
-        if (movement && movement->IsFacingLeft()) {
-            float temp = u0;
-            u0 = u1;
-            u1 = temp;
-        }
-        
-        m_characterObject->SetCustomUV(u0, v0, u1, v1);
-        Vector3 position = movement ? movement->GetPosition() : Vector3(0, 0, 0);
-        if (m_isWerewolf) {
-            m_characterObject->SetPosition(position.x, position.y + m_werewolfBodyOffsetY, position.z);
-        } else {
-            m_characterObject->SetPosition(position);
-        }
+    const float alpha = SimulationClock::Instance().GetAlpha();
+    if (m_characterObject && m_animManager.HasSheet() && m_characterObject->GetModelId() >= 0 && m_characterObject->GetModelPtr()) {
+        const bool faceLeft = movement && movement->IsFacingLeft();
+        m_characterObject->SetSpriteFrame(m_animManager.GetSheetFrame(), faceLeft ? Object::SPRITE_FLIP_X : 0);
+        Vector3 position = movement ? movement->GetRenderPosition(alpha) : Vector3(0, 0, 0);
+        float bodyOffsetY = m_isWerewolf ? m_werewolfBodyOffsetY : 0.0f;
+        m_characterObject->SetPosition(position.x, position.y + bodyOffsetY, position.z);
         
         if (camera) {
             m_characterObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
+
+        // Form switches spawn effects at this object's position between ticks;
+        // leave it on the simulated position rather than the blended one
+        if (movement) {
+            Vector3 simPos = movement->GetPosition();
+            m_characterObject->SetPosition(simPos.x, simPos.y + bodyOffsetY, simPos.z);
+        }
     }
 
-    if (!m_isBatDemon && !m_isKitsune && !m_isOrc && (m_gunMode || m_recoilActive) && m_topObject && m_topAnimManager && m_topObject->GetModelId() >= 0 && m_topObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_topAnimManager->GetUV(u0, v0, u1, v1);
-        
+    if (!m_isBatDemon && !m_isKitsune && !m_isOrc && (m_gunMode || m_recoilActive) && m_topObject && m_topAnimManager.HasSheet() && m_topObject->GetModelId() >= 0 && m_topObject->GetModelPtr()) {
         bool shouldFlipUV = m_gunMode ? 
                            (movement && movement->IsFacingLeft()) : 
                            (m_recoilFaceSign < 0.0f);
-        if (shouldFlipUV) {
-            std::swap(u0, u1);
-        }
-        m_topObject->SetCustomUV(u0, v0, u1, v1);
-        Vector3 position = movement ? movement->GetPosition() : Vector3(0, 0, 0);
+        m_topObject->SetSpriteFrame(m_topAnimManager.GetSheetFrame(), shouldFlipUV ? Object::SPRITE_FLIP_X : 0);
+        Vector3 position = movement ? movement->GetRenderPosition(alpha) : Vector3(0, 0, 0);
         
         bool isLeftFacing = m_gunMode ? 
                            (movement && movement->IsFacingLeft()) : 
@@ -324,14 +308,10 @@ void CharacterAnimation::Draw(Camera* camera, CharacterMovement* movement) {
         }
     }
 
-    if (!m_isBatDemon && !m_isKitsune && !m_isOrc && m_grenadeMode && m_topObject && m_topAnimManager && m_topObject->GetModelId() >= 0 && m_topObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_topAnimManager->GetUV(u0, v0, u1, v1);
-        if (movement && movement->IsFacingLeft()) {
-            std::swap(u0, u1);
-        }
-        m_topObject->SetCustomUV(u0, v0, u1, v1);
-        Vector3 position = movement ? movement->GetPosition() : Vector3(0, 0, 0);
+    if (!m_isBatDemon && !m_isKitsune && !m_isOrc && m_grenadeMode && m_topObject && m_topAnimManager.HasSheet() && m_topObject->GetModelId() >= 0 && m_topObject->GetModelPtr()) {
+        const bool faceLeft = movement && movement->IsFacingLeft();
+        m_topObject->SetSpriteFrame(m_topAnimManager.GetSheetFrame(), faceLeft ? Object::SPRITE_FLIP_X : 0);
+        Vector3 position = movement ? movement->GetRenderPosition(alpha) : Vector3(0, 0, 0);
         float offsetX = (movement && movement->IsFacingLeft()) ? -m_topOffsetX : m_topOffsetX;
         float bodyY2 = m_isWerewolf ? (position.y + m_werewolfBodyOffsetY) : position.y;
         m_topObject->SetPosition(position.x + offsetX, bodyY2 + m_topOffsetY, position.z);
@@ -343,53 +323,38 @@ void CharacterAnimation::Draw(Camera* camera, CharacterMovement* movement) {
     }
 
     if (m_orcFireActive && m_orcFireObject && m_orcFireObject->GetModelId() >= 0 && m_orcFireObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_orcFireAnim->GetUV(u0, v0, u1, v1);
-        m_orcFireObject->SetCustomUV(u0, v0, u1, v1);
+        m_orcFireObject->SetSpriteFrame(m_orcFireAnim.GetSheetFrame());
         if (camera) {
             m_orcFireObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
     if (m_orcAppearActive && m_orcAppearObject && m_orcAppearObject->GetModelId() >= 0 && m_orcAppearObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_orcAppearAnim->GetUV(u0, v0, u1, v1);
-        m_orcAppearObject->SetCustomUV(u0, v0, u1, v1);
+        m_orcAppearObject->SetSpriteFrame(m_orcAppearAnim.GetSheetFrame());
         if (camera) {
             m_orcAppearObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
     if (m_werewolfAppearActive && m_werewolfAppearObject && m_werewolfAppearObject->GetModelId() >= 0 && m_werewolfAppearObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_werewolfAppearAnim->GetUV(u0, v0, u1, v1);
-        m_werewolfAppearObject->SetCustomUV(u0, v0, u1, v1);
+        m_werewolfAppearObject->SetSpriteFrame(m_werewolfAppearAnim.GetSheetFrame());
         if (camera) {
             m_werewolfAppearObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
     if (m_batAppearActive && m_batAppearObject && m_batAppearObject->GetModelId() >= 0 && m_batAppearObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_batAppearAnim->GetUV(u0, v0, u1, v1);
-        m_batAppearObject->SetCustomUV(u0, v0, u1, v1);
+        m_batAppearObject->SetSpriteFrame(m_batAppearAnim.GetSheetFrame());
         if (camera) {
             m_batAppearObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
     if (m_kitsuneAppearActive && m_kitsuneAppearObject && m_kitsuneAppearObject->GetModelId() >= 0 && m_kitsuneAppearObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_kitsuneAppearAnim->GetUV(u0, v0, u1, v1);
-        m_kitsuneAppearObject->SetCustomUV(u0, v0, u1, v1);
+        m_kitsuneAppearObject->SetSpriteFrame(m_kitsuneAppearAnim.GetSheetFrame());
         if (camera) {
             m_kitsuneAppearObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
     }
 
     if (m_batWindActive && m_batWindObject && m_batWindObject->GetModelId() >= 0 && m_batWindObject->GetModelPtr()) {
-        float u0, v0, u1, v1;
-        m_batWindAnim->GetUV(u0, v0, u1, v1);
-        if (m_batWindFaceSign < 0.0f) {
-            std::swap(u0, u1);
-        }
-        m_batWindObject->SetCustomUV(u0, v0, u1, v1);
+        m_batWindObject->SetSpriteFrame(m_batWindAnim.GetSheetFrame(), m_batWindFaceSign < 0.0f ? Object::SPRITE_FLIP_X : 0);
         if (camera) {
             m_batWindObject->Draw(camera->GetViewMatrix(), camera->GetProjectionMatrix());
         }
@@ -405,254 +370,22 @@ Vector3 CharacterAnimation::GetTopWorldPosition(CharacterMovement* movement) con
 void CharacterAnimation::UpdateAnimationState(CharacterMovement* movement, CharacterCombat* combat) {
     if (!movement) return;
 
-    // BatDemon mode
     if (m_isBatDemon) {
-        if (m_characterObject) {
-            const std::vector<int>& texIds = m_characterObject->GetTextureIds();
-            int currentTex = texIds.empty() ? -1 : texIds[0];
-            if (currentTex != 61) {
-                m_characterObject->SetTexture(61, 0);
-                if (auto texData = ResourceManager::GetInstance()->GetTextureData(61)) {
-                    if (!m_animManager) {
-                        m_animManager = std::make_shared<AnimationManager>();
-                    }
-                    std::vector<AnimationData> anims;
-                    anims.reserve(texData->animations.size());
-                    for (const auto& a : texData->animations) {
-                        anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                    }
-                    m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                    m_lastAnimation = -1;
-                }
-            }
-        }
-        if (m_animManager) {
-            if (m_batSlashActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 1) {
-                    m_animManager->Play(1, false);
-                    m_lastAnimation = 1;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_batSlashActive = false;
-                    m_batSlashCooldownTimer = BAT_SLASH_COOLDOWN;
-                }
-            } else {
-                int cur = GetCurrentAnimation();
-                if (cur != 0) {
-                    m_animManager->Play(0, true);
-                    m_lastAnimation = 0;
-                } else {
-                    m_animManager->Resume();
-                }
-            }
-        }
+        UpdateSpecialForm(AnimationGraph::FORM_BAT_DEMON, movement, combat);
         return;
     }
-
-    // Werewolf mode
     if (m_isWerewolf) {
-        if (m_characterObject) {
-            const std::vector<int>& texIds = m_characterObject->GetTextureIds();
-            int currentTex = texIds.empty() ? -1 : texIds[0];
-            if (currentTex != 60) {
-                m_characterObject->SetTexture(60, 0);
-                if (auto texData = ResourceManager::GetInstance()->GetTextureData(60)) {
-                    if (!m_animManager) {
-                        m_animManager = std::make_shared<AnimationManager>();
-                    }
-                    std::vector<AnimationData> anims;
-                    anims.reserve(texData->animations.size());
-                    for (const auto& a : texData->animations) {
-                        anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                    }
-                    m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                    m_lastAnimation = -1;
-                }
-            }
-        }
-        // Drive werewolf anims by movement state
-        if (movement && m_animManager) {
-            bool physJumping = movement->IsJumping();
-            if (!physJumping) { m_werewolfAirTimer = 0.0f; }
-            bool considerJumping = (m_werewolfAirTimer >= WEREWOLF_AIR_DEBOUNCE);
-
-            // Pounce overrides combo and movement
-            if (m_werewolfPounceActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 3) {
-                    m_animManager->Play(3, false);
-                    m_lastAnimation = 3;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_werewolfPounceActive = false;
-                    m_werewolfPounceCooldownTimer = m_werewolfPounceCooldown;
-                }
-                return;
-            }
-            if (m_werewolfComboActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 1) {
-                    m_animManager->Play(1, false);
-                    m_lastAnimation = 1;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_werewolfComboActive = false;
-                    m_werewolfComboCooldownTimer = m_werewolfComboCooldown;
-                }
-                return;
-            }
-
-            int desired = 0;
-            bool loop = true;
-            if (considerJumping) {
-                desired = 5; loop = false;
-            } else {
-                CharState st = movement->GetState();
-                bool isMoving = (st == CharState::MoveLeft || st == CharState::MoveRight);
-                bool isRunning = movement->IsRunningLeft() || movement->IsRunningRight();
-                if (isMoving && isRunning) { desired = 2; loop = true; }
-                else if (isMoving) { desired = 4; loop = true; }
-                else { desired = 0; loop = true; }
-            }
-            int cur = GetCurrentAnimation();
-            if (cur != desired || (desired == 5 && !m_animManager->IsPlaying())) {
-                m_animManager->Play(desired, loop);
-                m_lastAnimation = desired;
-            } else {
-                m_animManager->Resume();
-            }
-        }
+        // Short hops off ledges do not count as airborne
+        if (!movement->IsJumping()) { m_werewolfAirTimer = 0.0f; }
+        UpdateSpecialForm(AnimationGraph::FORM_WEREWOLF, movement, combat);
         return;
     }
-
-    // Kitsune mode
     if (m_isKitsune) {
-        if (m_characterObject) {
-            const std::vector<int>& texIds = m_characterObject->GetTextureIds();
-            int currentTex = texIds.empty() ? -1 : texIds[0];
-            if (currentTex != 62) {
-                m_characterObject->SetTexture(62, 0);
-                if (auto texData = ResourceManager::GetInstance()->GetTextureData(62)) {
-                    if (!m_animManager) {
-                        m_animManager = std::make_shared<AnimationManager>();
-                    }
-                    std::vector<AnimationData> anims;
-                    anims.reserve(texData->animations.size());
-                    for (const auto& a : texData->animations) {
-                        anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                    }
-                    m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                    m_lastAnimation = -1;
-                }
-            }
-        }
-        if (m_animManager) {
-            if (m_kitsuneEnergyOrbActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 3) {
-                    m_animManager->Play(3, false);
-                    m_lastAnimation = 3;
-                    m_kitsuneEnergyOrbAnimationComplete = false;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_kitsuneEnergyOrbActive = false;
-                    m_kitsuneEnergyOrbCooldownTimer = KITSUNE_ENERGY_ORB_COOLDOWN;
-                    m_kitsuneEnergyOrbAnimationComplete = true;
-                }
-            } else {
-                int desired = 0;
-                if (movement) {
-                    CharState st = movement->GetState();
-                    bool isMoving = (st == CharState::MoveLeft || st == CharState::MoveRight);
-                    bool isRunning = movement->IsRunningLeft() || movement->IsRunningRight();
-                    if (isMoving) { desired = isRunning ? 2 : 1; }
-                }
-                int cur = GetCurrentAnimation();
-                if (cur != desired) {
-                    m_animManager->Play(desired, true);
-                    m_lastAnimation = desired;
-                } else {
-                    m_animManager->Resume();
-                }
-            }
-        }
+        UpdateSpecialForm(AnimationGraph::FORM_KITSUNE, movement, combat);
         return;
     }
-
-    // Orc mode
     if (m_isOrc) {
-        if (m_characterObject) {
-            const std::vector<int>& texIds = m_characterObject->GetTextureIds();
-            int currentTex = texIds.empty() ? -1 : texIds[0];
-            if (currentTex != 63) {
-                m_characterObject->SetTexture(63, 0);
-                if (auto texData = ResourceManager::GetInstance()->GetTextureData(63)) {
-                    if (!m_animManager) {
-                        m_animManager = std::make_shared<AnimationManager>();
-                    }
-                    std::vector<AnimationData> anims;
-                    anims.reserve(texData->animations.size());
-                    for (const auto& a : texData->animations) {
-                        anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                    }
-                    m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                    m_lastAnimation = -1;
-                }
-            }
-        }
-        if (m_animManager) {
-            if (m_orcMeteorStrikeActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 2) {
-                    m_animManager->Play(2, false);
-                    m_lastAnimation = 2;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_orcMeteorStrikeActive = false;
-                    if (movement) {
-                        movement->SetInputLocked(false);
-                    }
-                } else {
-                    if (movement) {
-                        movement->SetInputLocked(true);
-                    }
-                }
-                return;
-            } else if (m_orcFlameBurstActive) {
-                int cur = GetCurrentAnimation();
-                if (cur != 3) {
-                    m_animManager->Play(3, false);
-                    m_lastAnimation = 3;
-                }
-                if (!m_animManager->IsPlaying()) {
-                    m_orcFlameBurstActive = false;
-                    if (movement) {
-                        movement->SetInputLocked(false);
-                    }
-                    m_animManager->Play(0, true);
-                } else {
-                    if (movement) {
-                        movement->SetInputLocked(true);
-                    }
-                }
-                return;
-            }
-            
-            int cur = GetCurrentAnimation();
-            int desired = 0;
-            if (movement && !m_orcMeteorStrikeActive && !m_orcFlameBurstActive) {
-                CharState st = movement->GetState();
-                bool isMoving = (st == CharState::MoveLeft || st == CharState::MoveRight);
-                if (isMoving) { desired = 1; } // Walk
-            }
-            if (cur != desired && !m_orcMeteorStrikeActive && !m_orcFlameBurstActive) {
-                m_animManager->Play(desired, true);
-                m_lastAnimation = desired;
-            } else if (!m_orcMeteorStrikeActive && !m_orcFlameBurstActive) {
-                m_animManager->Resume();
-            }
-        }
+        UpdateSpecialForm(AnimationGraph::FORM_ORC, movement, combat);
         return;
     }
 
@@ -669,21 +402,21 @@ void CharacterAnimation::UpdateAnimationState(CharacterMovement* movement, Chara
         if (m_hardLandingPhase == 0) {
             if (cur != 15) {
                 PlayAnimation(15, false);
-            } else if (!m_animManager->IsPlaying()) {
+            } else if (!m_animManager.IsPlaying()) {
                 m_hardLandingPhase = 1;
                 PlayAnimation(14, false);
             }
         } else {
             if (cur != 14) {
                 PlayAnimation(14, false);
-            } else if (!m_animManager->IsPlaying()) {
+            } else if (!m_animManager.IsPlaying()) {
                 m_hardLandingActive = false;
                 m_hardLandingPhase = 0;
                 if (m_restoreInputAfterHardLanding) {
                     movement->SetInputLocked(false);
                 }
                 PlayAnimation(0, true);
-                unsigned int doneMs = SDL_GetTicks();
+                unsigned int doneMs = SimulationClock::Instance().GetTimeMs();
                 m_blockHardLandingUntilMs = doneMs + 120; // ~0.12s debounce
             }
         }
@@ -697,7 +430,7 @@ void CharacterAnimation::UpdateAnimationState(CharacterMovement* movement, Chara
     if (m_grenadeMode) {
         if (m_isKitsune) { m_grenadeMode = false; return; }
         if (m_isOrc) { m_grenadeMode = false; return; }
-        PlayAnimation(31, true);
+        PlayGraphForm(AnimationGraph::FORM_GRENADE, movement, combat, nullptr);
         PlayTopAnimation(7, true);
         return;
     }
@@ -729,40 +462,40 @@ void CharacterAnimation::UpdateAnimationState(CharacterMovement* movement, Chara
         return;
     }
     
-    if (combat->IsInCombo() && !m_animManager->IsPlaying()) {
+    if (combat->IsInCombo() && !m_animManager.IsPlaying()) {
         if (combat->IsComboCompleted()) {
             combat->CancelAllCombos();
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         } else if (combat->GetComboTimer() <= 0.0f) {
             combat->CancelAllCombos();
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         } else {
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         }
     }
     
-    if (combat->IsInAxeCombo() && !m_animManager->IsPlaying()) {
+    if (combat->IsInAxeCombo() && !m_animManager.IsPlaying()) {
         if (combat->IsAxeComboCompleted()) {
             combat->CancelAllCombos();
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         } else if (combat->GetAxeComboTimer() <= 0.0f) {
             combat->CancelAllCombos();
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         } else {
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         }
     }
     
     if (combat->IsKicking()) {
-        int cur = m_animManager->GetCurrentAnimation();
+        int cur = m_animManager.GetCurrentAnimation();
         bool isKickAnim = (cur == 17 || cur == 19);
-        if (!m_animManager->IsPlaying() || !movement->IsJumping() || !isKickAnim) {
+        if (!m_animManager.IsPlaying() || !movement->IsJumping() || !isKickAnim) {
             combat->CancelAllCombos();
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
         }
     }
     
-    if (!m_animManager->IsPlaying() && 
+    if (!m_animManager.IsPlaying() && 
         !combat->IsInCombo() && 
         !combat->IsInAxeCombo() && 
         !combat->IsKicking() && 
@@ -770,12 +503,12 @@ void CharacterAnimation::UpdateAnimationState(CharacterMovement* movement, Chara
         !movement->IsSitting() && 
         !combat->IsHit() &&
         !movement->IsDying()) {
-        m_animManager->Play(0, true);
+        m_animManager.Play(0, true);
     }
 }
 
-void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, CharacterMovement* movement, CharacterCombat* combat) {
-    if (!keyStates || !movement || !combat) {
+void CharacterAnimation::HandleMovementAnimations(const KeyStates& keyStates, CharacterMovement* movement, CharacterCombat* combat) {
+    if (!movement || !combat) {
         return;
     }
     if (m_hardLandingActive) {
@@ -790,7 +523,6 @@ void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, Charact
     }
     
     const PlayerInputConfig& inputConfig = movement->GetInputConfig();
-    bool isShiftPressed = keyStates[16];
 
     if (m_isBatDemon) { return; }
 
@@ -825,7 +557,7 @@ void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, Charact
         }
 
         HandleGunAim(keyStates, inputConfig);
-        PlayAnimation(31, true);
+        PlayGraphForm(AnimationGraph::FORM_GRENADE, movement, combat, &keyStates);
         PlayTopAnimation(7, true);
         return;
         }
@@ -866,9 +598,9 @@ void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, Charact
             if (m_gunEntering) {
                 PlayTopAnimation(m_gunTopAnimReverse, false);
             }
-            PlayAnimation(29, true);
+            PlayGraphForm(AnimationGraph::FORM_GUN, movement, combat, &keyStates);
             if (m_gunEntering) {
-                unsigned int nowMs = SDL_GetTicks();
+                unsigned int nowMs = SimulationClock::Instance().GetTimeMs();
                 float elapsed = (nowMs - m_gunEnterStartMs) / 1000.0f;
                 if (elapsed >= GUN_ENTER_DURATION) {
                     m_gunEntering = false;
@@ -879,7 +611,7 @@ void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, Charact
 
         HandleGunAim(keyStates, movement->GetInputConfig());
 
-        PlayAnimation(29, true);
+        PlayGraphForm(AnimationGraph::FORM_GUN, movement, combat, &keyStates);
         if (m_reloadActive && m_gunTopAnimReload >= 0) {
             PlayTopAnimation(m_gunTopAnimReload, false);
         } else {
@@ -888,102 +620,195 @@ void CharacterAnimation::HandleMovementAnimations(const bool* keyStates, Charact
         return;
     }
     
-    if (movement->IsDying()) {
-        PlayAnimation(15, false);
+    PlayGraphForm(AnimationGraph::FORM_NORMAL, movement, combat, &keyStates);
+}
+
+uint32_t CharacterAnimation::BuildGraphConditions(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat, const KeyStates* keyStates) const {
+    uint32_t c = 0;
+    if (movement) {
+        CharState st = movement->GetState();
+        if (st == CharState::MoveLeft || st == CharState::MoveRight) c |= AnimationGraph::COND_MOVING;
+        if (movement->IsRunningLeft() || movement->IsRunningRight()) c |= AnimationGraph::COND_RUNNING;
+        bool airborne = (form == AnimationGraph::FORM_WEREWOLF) ? (m_werewolfAirTimer >= WEREWOLF_AIR_DEBOUNCE) : movement->IsJumping();
+        if (airborne) c |= AnimationGraph::COND_AIRBORNE;
+        if (movement->IsRolling()) c |= AnimationGraph::COND_ROLLING;
+        if (movement->IsSitting()) c |= AnimationGraph::COND_SITTING;
+        if (movement->IsDying()) c |= AnimationGraph::COND_DYING;
+        if (movement->IsOnLadder()) c |= AnimationGraph::COND_LADDER;
+        if (keyStates) {
+            const PlayerInputConfig& input = movement->GetInputConfig();
+            if ((*keyStates)[input.moveLeftKey] || (*keyStates)[input.moveRightKey]) c |= AnimationGraph::COND_MOVE_KEY;
+            if ((*keyStates)[16]) c |= AnimationGraph::COND_RUN_KEY;
+            if ((*keyStates)[input.sitKey]) c |= AnimationGraph::COND_SIT_KEY;
+        }
+    }
+    if (combat) {
+        if (combat->IsInCombo()) c |= AnimationGraph::COND_COMBO;
+        if (combat->IsInAxeCombo()) c |= AnimationGraph::COND_AXE_COMBO;
+        if (combat->IsKicking()) c |= AnimationGraph::COND_KICKING;
+        if (combat->IsHit()) c |= AnimationGraph::COND_HIT;
+    }
+    if (!m_animManager.IsPlaying()) c |= AnimationGraph::COND_CLIP_DONE;
+    if (m_batSlashActive) c |= AnimationGraph::COND_BAT_SLASH;
+    if (m_werewolfComboActive) c |= AnimationGraph::COND_WEREWOLF_COMBO;
+    if (m_werewolfPounceActive) c |= AnimationGraph::COND_WEREWOLF_POUNCE;
+    if (m_kitsuneEnergyOrbActive) c |= AnimationGraph::COND_KITSUNE_ORB;
+    if (m_orcMeteorStrikeActive) c |= AnimationGraph::COND_ORC_METEOR;
+    if (m_orcFlameBurstActive) c |= AnimationGraph::COND_ORC_FLAME;
+    return c;
+}
+
+const AnimationGraph::State* CharacterAnimation::StepGraph(AnimationGraph::Form form, uint32_t conditions, bool& restart) {
+    const AnimationGraph& graph = AnimationGraph::Instance();
+    restart = false;
+    if (!graph.IsLoaded()) return nullptr;
+    if (m_graphForm != form) {
+        m_graphForm = form;
+        m_graphState = -1;
+    }
+    const AnimationGraph::Transition* t = graph.Evaluate(form, m_graphState, conditions);
+    if (!t || t->target < 0) return nullptr;
+    m_graphState = t->target;
+    restart = t->restart != 0;
+    return &graph.GetState(form, t->target);
+}
+
+void CharacterAnimation::PlayGraphForm(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat, const KeyStates* keyStates) {
+    bool restart = false;
+    const AnimationGraph::State* state = StepGraph(form, BuildGraphConditions(form, movement, combat, keyStates), restart);
+    if (!state) return;
+    if (state->flags & AnimationGraph::STATE_MANUAL) {
+        if (GetCurrentAnimation() != state->clip) {
+            PlayAnimation(state->clip, true);
+        }
+        if (keyStates) {
+            HandleLadderClimb(*keyStates, movement, state->clip);
+        }
         return;
     }
-    
-    if (!combat->IsInCombo() && !combat->IsInAxeCombo() && !combat->IsKicking() && !combat->IsHit()) {
-        if (movement->IsOnLadder()) {
-            if (GetCurrentAnimation() != 6) {
-                PlayAnimation(6, true);
-            }
+    PlayAnimation(state->clip, (state->flags & AnimationGraph::STATE_LOOP) != 0);
+}
 
-            const PlayerInputConfig& input = movement->GetInputConfig();
-            const bool upHeld = keyStates[input.jumpKey];
-            const bool downHeld = keyStates[input.sitKey];
-            const bool upPressed = upHeld;
-            const bool downPressed = downHeld;
-            const bool upJustPressed = upPressed && !m_prevClimbUpPressed;
-            const bool downJustPressed = downPressed && !m_prevClimbDownPressed;
-
-            if (upJustPressed && !upHeld) {
-                const AnimationData* anim = m_animManager->GetAnimation(6);
-                if (anim) {
-                    int frame = m_animManager->GetCurrentFrame();
-                    frame = (frame + 1) % anim->numFrames;
-                    m_animManager->SetCurrentFrame(frame);
-                }
-            }
-            if (downJustPressed) {
-                const AnimationData* anim = m_animManager->GetAnimation(6);
-                if (anim) {
-                    int frame = m_animManager->GetCurrentFrame();
-                    frame = (frame - 1);
-                    if (frame < 0) frame = anim->numFrames - 1;
-                    m_animManager->SetCurrentFrame(frame);
-                }
+void CharacterAnimation::UpdateSpecialForm(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat) {
+    const int texture = AnimationGraph::Instance().IsLoaded() ? AnimationGraph::Instance().GetTextureId(form) : -1;
+    if (m_characterObject && texture >= 0) {
+        const std::vector<int>& texIds = m_characterObject->GetTextureIds();
+        int currentTex = texIds.empty() ? -1 : texIds[0];
+        if (currentTex != texture) {
+            m_characterObject->SetTexture(texture, 0);
+            if (m_animManager.SetSheet(texture)) {
+                m_lastAnimation = -1;
             }
+        }
+    }
+    if (!m_animManager.HasSheet()) return;
 
-            float now = SDL_GetTicks() / 1000.0f;
-            if (downJustPressed) {
-                m_downPressStartTime = now;
-            }
-            bool isDownHeldLong = false;
-            if (downHeld && m_downPressStartTime >= 0.0f) {
-                isDownHeldLong = (now - m_downPressStartTime) > CLIMB_DOWN_HOLD_THRESHOLD;
-            }
-            if (!downHeld) {
-                m_downPressStartTime = -1.0f;
-            }
+    bool restart = false;
+    const AnimationGraph::State* state = StepGraph(form, BuildGraphConditions(form, movement, combat, nullptr), restart);
+    if (!state) return;
+    const bool loop = (state->flags & AnimationGraph::STATE_LOOP) != 0;
+    if (GetCurrentAnimation() != state->clip || restart) {
+        m_animManager.Play(state->clip, loop);
+        m_lastAnimation = state->clip;
+    } else if (loop) {
+        m_animManager.Resume();
+    }
+    if (state->endAction && !m_animManager.IsPlaying()) {
+        EndGraphAction(state->endAction);
+    }
+    if ((state->flags & AnimationGraph::STATE_LOCK_INPUT) && movement) {
+        movement->SetInputLocked(m_animManager.IsPlaying());
+    }
+}
 
-            bool leftHeld = keyStates[input.moveLeftKey];
-            bool rightHeld = keyStates[input.moveRightKey];
-            if (upHeld || leftHeld || rightHeld) {
-                m_animManager->SetPlaying(true);
-                m_lastClimbDir = 1;
-            } else if (isDownHeldLong) {
-                const AnimationData* anim = m_animManager->GetAnimation(6);
-                if (anim) {
-                    m_animManager->Pause();
-                    m_animManager->SetCurrentFrame(0);
-                }
-                m_lastClimbDir = -1;
-            } else if (!upHeld && !downHeld) {
-                m_animManager->Pause();
-                m_lastClimbDir = 0;
-            }
+void CharacterAnimation::EndGraphAction(uint32_t action) {
+    switch (action) {
+    case AnimationGraph::COND_BAT_SLASH:
+        m_batSlashActive = false;
+        m_batSlashCooldownTimer = BAT_SLASH_COOLDOWN;
+        break;
+    case AnimationGraph::COND_WEREWOLF_COMBO:
+        m_werewolfComboActive = false;
+        m_werewolfComboCooldownTimer = m_werewolfComboCooldown;
+        break;
+    case AnimationGraph::COND_WEREWOLF_POUNCE:
+        m_werewolfPounceActive = false;
+        m_werewolfPounceCooldownTimer = m_werewolfPounceCooldown;
+        break;
+    case AnimationGraph::COND_KITSUNE_ORB:
+        m_kitsuneEnergyOrbActive = false;
+        m_kitsuneEnergyOrbCooldownTimer = KITSUNE_ENERGY_ORB_COOLDOWN;
+        m_kitsuneEnergyOrbAnimationComplete = true;
+        break;
+    case AnimationGraph::COND_ORC_METEOR:
+        m_orcMeteorStrikeActive = false;
+        break;
+    case AnimationGraph::COND_ORC_FLAME:
+        m_orcFlameBurstActive = false;
+        break;
+    default:
+        break;
+    }
+}
 
-            m_prevClimbUpPressed = upPressed;
-            m_prevClimbDownPressed = downPressed;
-            return;
+void CharacterAnimation::HandleLadderClimb(const KeyStates& keyStates, CharacterMovement* movement, int clip) {
+    const PlayerInputConfig& input = movement->GetInputConfig();
+    const bool upHeld = keyStates[input.jumpKey];
+    const bool downHeld = keyStates[input.sitKey];
+    const bool upPressed = upHeld;
+    const bool downPressed = downHeld;
+    const bool upJustPressed = upPressed && !m_prevClimbUpPressed;
+    const bool downJustPressed = downPressed && !m_prevClimbDownPressed;
+    
+    if (upJustPressed && !upHeld) {
+        const AnimationData* anim = m_animManager.GetAnimation(clip);
+        if (anim) {
+            int frame = m_animManager.GetCurrentFrame();
+            frame = (frame + 1) % anim->numFrames;
+            m_animManager.SetCurrentFrame(frame);
         }
-        
-        if (movement->IsJumping()) {
-            if (combat->IsKicking() && GetCurrentAnimation() == 17) {
-            } else {
-                PlayAnimation(16, false);
-            }
-        } else if (movement->IsRolling()) {
-            PlayAnimation(4, true);
-        } else if (keyStates[inputConfig.moveRightKey]) {
-            if (isShiftPressed) {
-                PlayAnimation(2, true);
-            } else {
-                PlayAnimation(1, true);
-            }
-        } else if (keyStates[inputConfig.moveLeftKey]) {
-            if (isShiftPressed) {
-                PlayAnimation(2, true);
-            } else {
-                PlayAnimation(1, true);
-            }
-        } else if (keyStates[inputConfig.sitKey] || movement->IsSitting()) {
-            PlayAnimation(3, true);
-        } else {
-            PlayAnimation(0, true);
+    }
+    if (downJustPressed) {
+        const AnimationData* anim = m_animManager.GetAnimation(clip);
+        if (anim) {
+            int frame = m_animManager.GetCurrentFrame();
+            frame = (frame - 1);
+            if (frame < 0) frame = anim->numFrames - 1;
+            m_animManager.SetCurrentFrame(frame);
         }
     }
+    
+    float now = SimulationClock::Instance().GetTime();
+    if (downJustPressed) {
+        m_downPressStartTime = now;
+    }
+    bool isDownHeldLong = false;
+    if (downHeld && m_downPressStartTime >= 0.0f) {
+        isDownHeldLong = (now - m_downPressStartTime) > CLIMB_DOWN_HOLD_THRESHOLD;
+    }
+    if (!downHeld) {
+        m_downPressStartTime = -1.0f;
+    }
+    
+    bool leftHeld = keyStates[input.moveLeftKey];
+    bool rightHeld = keyStates[input.moveRightKey];
+    if (upHeld || leftHeld || rightHeld) {
+        m_animManager.SetPlaying(true);
+        m_lastClimbDir = 1;
+    } else if (isDownHeldLong) {
+        const AnimationData* anim = m_animManager.GetAnimation(clip);
+        if (anim) {
+            m_animManager.Pause();
+            m_animManager.SetCurrentFrame(0);
+        }
+        m_lastClimbDir = -1;
+    } else if (!upHeld && !downHeld) {
+        m_animManager.Pause();
+        m_lastClimbDir = 0;
+    }
+    
+    m_prevClimbUpPressed = upPressed;
+    m_prevClimbDownPressed = downPressed;
 }
 
 void CharacterAnimation::PlayAnimation(int animIndex, bool loop) {
@@ -992,14 +817,14 @@ void CharacterAnimation::PlayAnimation(int animIndex, bool loop) {
         if (animIndex != required) {
             return;
         }
-        if (m_animManager) {
-            int cur = m_animManager->GetCurrentAnimation();
-            if (cur == required && m_animManager->IsPlaying()) {
+        if (m_animManager.HasSheet()) {
+            int cur = m_animManager.GetCurrentAnimation();
+            if (cur == required && m_animManager.IsPlaying()) {
                 return;
             }
         }
     }
-    if (m_animManager) {
+    if (m_animManager.HasSheet()) {
         bool allowReplay = (animIndex == 19 || animIndex == 17) ||
                           (animIndex >= 10 && animIndex <= 12) ||
                           (animIndex >= 20 && animIndex <= 22) ||
@@ -1007,7 +832,7 @@ void CharacterAnimation::PlayAnimation(int animIndex, bool loop) {
                           (animIndex == 3);
 
         if (m_lastAnimation != animIndex || allowReplay) {
-            m_animManager->Play(animIndex, loop);
+            m_animManager.Play(animIndex, loop);
             m_lastAnimation = animIndex;
         }
     }
@@ -1017,20 +842,20 @@ void CharacterAnimation::PlayTopAnimation(int animIndex, bool loop) {
     if (m_hardLandingActive) {
         return;
     }
-    if (m_topAnimManager) {
+    if (m_topAnimManager.HasSheet()) {
         if (m_lastTopAnimation != animIndex) {
-            m_topAnimManager->Play(animIndex, loop);
+            m_topAnimManager.Play(animIndex, loop);
             m_lastTopAnimation = animIndex;
         }
     }
 }
 
 int CharacterAnimation::GetCurrentAnimation() const {
-    return m_animManager ? m_animManager->GetCurrentAnimation() : -1;
+    return m_animManager.HasSheet() ? m_animManager.GetCurrentAnimation() : -1;
 }
 
 bool CharacterAnimation::IsAnimationPlaying() const {
-    return m_animManager ? m_animManager->IsPlaying() : false;
+    return m_animManager.HasSheet() ? m_animManager.IsPlaying() : false;
 }
 
 bool CharacterAnimation::IsFacingLeft(CharacterMovement* movement) const {
@@ -1042,7 +867,7 @@ void CharacterAnimation::SetGunMode(bool enabled) {
         return;
     }
     if (enabled && !m_gunMode) {
-        unsigned int nowMsEnter = SDL_GetTicks();
+        unsigned int nowMsEnter = SimulationClock::Instance().GetTimeMs();
         bool isSticky = (m_lastShotTickMs != 0 && (nowMsEnter - m_lastShotTickMs) <= STICKY_AIM_WINDOW_MS);
         if (isSticky) {
             m_aimAngleDeg = m_lastShotAimDeg;
@@ -1071,7 +896,7 @@ void CharacterAnimation::SetGrenadeMode(bool enabled) {
     }
     if (enabled && !m_grenadeMode) {
         // Initialize aim like entering gun mode
-        unsigned int nowMsEnter = SDL_GetTicks();
+        unsigned int nowMsEnter = SimulationClock::Instance().GetTimeMs();
         bool isSticky = (m_lastShotTickMs != 0 && (nowMsEnter - m_lastShotTickMs) <= STICKY_AIM_WINDOW_MS);
         if (!isSticky) {
             m_aimAngleDeg = 0.0f;
@@ -1106,18 +931,9 @@ void CharacterAnimation::SetBatDemonMode(bool enabled) {
         if (m_characterObject) {
             m_characterObject->SetTexture(61, 0);
         }
-        if (auto texData = ResourceManager::GetInstance()->GetTextureData(61)) {
-            if (!m_animManager) {
-                m_animManager = std::make_shared<AnimationManager>();
-            }
-            std::vector<AnimationData> anims;
-            anims.reserve(texData->animations.size());
-            for (const auto& a : texData->animations) {
-                anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-            }
-            m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
+        if (m_animManager.SetSheet(61)) {
             // Animation 0: Fly
-            m_animManager->Play(0, true);
+            m_animManager.Play(0, true);
             m_lastAnimation = 0;
         }
         m_batSlashActive = false;
@@ -1132,17 +948,8 @@ void CharacterAnimation::SetBatDemonMode(bool enabled) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(60, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(60)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(60)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else {
@@ -1150,17 +957,8 @@ void CharacterAnimation::SetBatDemonMode(bool enabled) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(bodyTexId, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(bodyTexId)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(bodyTexId)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         }
@@ -1170,9 +968,6 @@ void CharacterAnimation::SetBatDemonMode(bool enabled) {
 }
 
 void CharacterAnimation::TriggerBatAppearEffectAt(float x, float y) {
-    if (!m_batAppearAnim) {
-        m_batAppearAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_batAppearObject) {
         m_batAppearObject = std::make_unique<Object>(m_objectId + 23000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1181,14 +976,8 @@ void CharacterAnimation::TriggerBatAppearEffectAt(float x, float y) {
             m_batAppearObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(72)) { // BatDemon_Appear.tga
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_batAppearAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_batAppearAnim->Play(0, false);
+    if (m_batAppearAnim.SetSheet(72)) { // BatDemon_Appear.tga
+        m_batAppearAnim.Play(0, false);
         m_batAppearActive = true;
         if (m_batAppearObject) {
             m_batAppearObject->SetTexture(72, 0);
@@ -1207,15 +996,12 @@ void CharacterAnimation::TriggerBatDemonSlash() {
     SoundManager::Instance().PlaySFXByID(30, 0);
     SoundManager::Instance().PlayMusicByID(34, 0);
     
-    if (m_animManager) {
-        m_animManager->Play(1, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(1, false);
         m_lastAnimation = 1;
         m_batSlashActive = true;
     }
 
-    if (!m_batWindAnim) {
-        m_batWindAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_batWindObject) {
         m_batWindObject = std::make_unique<Object>(m_objectId + 25000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1224,14 +1010,8 @@ void CharacterAnimation::TriggerBatDemonSlash() {
             m_batWindObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(68)) {
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_batWindAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_batWindAnim->Play(0, false);
+    if (m_batWindAnim.SetSheet(68)) {
+        m_batWindAnim.Play(0, false);
         m_batWindActive = true;
         m_batWindHasDealtDamage = false;
         if (m_batWindObject && m_characterObject) {
@@ -1261,20 +1041,12 @@ void CharacterAnimation::GetBatWindAabb(float& left, float& right, float& bottom
     }
 }
 
-void CharacterAnimation::GetCurrentFrameUV(float& u0, float& v0, float& u1, float& v1) const {
-    if (m_animManager) {
-        m_animManager->GetUV(u0, v0, u1, v1);
-    } else {
-        u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
-    }
+int CharacterAnimation::GetCurrentSheetFrame() const {
+    return m_animManager.HasSheet() ? m_animManager.GetSheetFrame() : -1;
 }
 
-void CharacterAnimation::GetTopFrameUV(float& u0, float& v0, float& u1, float& v1) const {
-    if (m_topAnimManager) {
-        m_topAnimManager->GetUV(u0, v0, u1, v1);
-    } else {
-        u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
-    }
+int CharacterAnimation::GetTopSheetFrame() const {
+    return m_topAnimManager.HasSheet() ? m_topAnimManager.GetSheetFrame() : -1;
 }
 
 void CharacterAnimation::StartTurn(bool toLeft, bool initialLeft) {
@@ -1285,12 +1057,11 @@ void CharacterAnimation::StartTurn(bool toLeft, bool initialLeft) {
     PlayTopAnimation(0, false);
 }
 
-void CharacterAnimation::HandleGunAim(const bool* keyStates, const PlayerInputConfig& inputConfig) {
-    if (!keyStates) return;
+void CharacterAnimation::HandleGunAim(const KeyStates& keyStates, const PlayerInputConfig& inputConfig) {
     const int aimUpKey = inputConfig.jumpKey;
     const int aimDownKey = inputConfig.sitKey;
 
-    unsigned int nowMs = SDL_GetTicks();
+    unsigned int nowMs = SimulationClock::Instance().GetTimeMs();
     float dt = 0.0f;
     if (m_lastAimTickMs == 0) {
         dt = 0.0f;
@@ -1355,7 +1126,7 @@ void CharacterAnimation::HandleGunAim(const bool* keyStates, const PlayerInputCo
 
 void CharacterAnimation::OnGunShotFired(CharacterMovement* movement) {
     m_lastShotAimDeg = m_aimAngleDeg;
-    m_lastShotTickMs = SDL_GetTicks();
+    m_lastShotTickMs = SimulationClock::Instance().GetTimeMs();
     
     m_recoilActive = true;
     m_recoilTimer = 0.0f;
@@ -1437,17 +1208,8 @@ void CharacterAnimation::SetWerewolfMode(bool enabled) {
         if (m_characterObject) {
             m_characterObject->SetTexture(60, 0);
         }
-        if (auto texData = ResourceManager::GetInstance()->GetTextureData(60)) {
-            if (!m_animManager) {
-                m_animManager = std::make_shared<AnimationManager>();
-            }
-            std::vector<AnimationData> anims;
-            anims.reserve(texData->animations.size());
-            for (const auto& a : texData->animations) {
-                anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-            }
-            m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-            m_animManager->Play(0, true);
+        if (m_animManager.SetSheet(60)) {
+            m_animManager.Play(0, true);
             m_lastAnimation = 0;
         }
         if (m_characterObject) {
@@ -1465,26 +1227,14 @@ void CharacterAnimation::SetWerewolfMode(bool enabled) {
         if (m_characterObject) {
             m_characterObject->SetTexture(bodyTexId, 0);
         }
-        if (auto texData = ResourceManager::GetInstance()->GetTextureData(bodyTexId)) {
-            if (!m_animManager) {
-                m_animManager = std::make_shared<AnimationManager>();
-            }
-            std::vector<AnimationData> anims;
-            anims.reserve(texData->animations.size());
-            for (const auto& a : texData->animations) {
-                anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-            }
-            m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-            m_animManager->Play(0, true);
+        if (m_animManager.SetSheet(bodyTexId)) {
+            m_animManager.Play(0, true);
             m_lastAnimation = 0;
         }
     }
 }
 
 void CharacterAnimation::TriggerWerewolfAppearEffectAt(float x, float y) {
-    if (!m_werewolfAppearAnim) {
-        m_werewolfAppearAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_werewolfAppearObject) {
         m_werewolfAppearObject = std::make_unique<Object>(m_objectId + 22000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1493,14 +1243,8 @@ void CharacterAnimation::TriggerWerewolfAppearEffectAt(float x, float y) {
             m_werewolfAppearObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(71)) { // Werewolf_Appear.tga
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_werewolfAppearAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_werewolfAppearAnim->Play(0, false);
+    if (m_werewolfAppearAnim.SetSheet(71)) { // Werewolf_Appear.tga
+        m_werewolfAppearAnim.Play(0, false);
         m_werewolfAppearActive = true;
         if (m_werewolfAppearObject) {
             m_werewolfAppearObject->SetTexture(71, 0);
@@ -1522,17 +1266,8 @@ void CharacterAnimation::SetKitsuneMode(bool enabled) {
         if (m_characterObject) {
             m_characterObject->SetTexture(62, 0);
         }
-        if (auto texData = ResourceManager::GetInstance()->GetTextureData(62)) {
-            if (!m_animManager) {
-                m_animManager = std::make_shared<AnimationManager>();
-            }
-            std::vector<AnimationData> anims;
-            anims.reserve(texData->animations.size());
-            for (const auto& a : texData->animations) {
-                anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-            }
-            m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-            m_animManager->Play(0, true);
+        if (m_animManager.SetSheet(62)) {
+            m_animManager.Play(0, true);
             m_lastAnimation = 0;
         }
         if (m_characterObject) {
@@ -1545,34 +1280,16 @@ void CharacterAnimation::SetKitsuneMode(bool enabled) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(60, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(60)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(60)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else if (m_isBatDemon) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(61, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(61)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(61)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else {
@@ -1580,17 +1297,8 @@ void CharacterAnimation::SetKitsuneMode(bool enabled) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(bodyTexId, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(bodyTexId)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(bodyTexId)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         }
@@ -1598,9 +1306,6 @@ void CharacterAnimation::SetKitsuneMode(bool enabled) {
 }
 
 void CharacterAnimation::TriggerKitsuneAppearEffectAt(float x, float y) {
-    if (!m_kitsuneAppearAnim) {
-        m_kitsuneAppearAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_kitsuneAppearObject) {
         m_kitsuneAppearObject = std::make_unique<Object>(m_objectId + 24000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1609,14 +1314,8 @@ void CharacterAnimation::TriggerKitsuneAppearEffectAt(float x, float y) {
             m_kitsuneAppearObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(73)) { // Kitsune_Appear.tga (ID 73)
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_kitsuneAppearAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_kitsuneAppearAnim->Play(0, false);
+    if (m_kitsuneAppearAnim.SetSheet(73)) { // Kitsune_Appear.tga (ID 73)
+        m_kitsuneAppearAnim.Play(0, false);
         m_kitsuneAppearActive = true;
         if (m_kitsuneAppearObject) {
             m_kitsuneAppearObject->SetTexture(73, 0);
@@ -1637,90 +1336,54 @@ void CharacterAnimation::SetOrcMode(bool enabled) {
         m_isKitsune = false;
         m_orcMeteorStrikeActive = false;
         m_orcFlameBurstActive = false;
-        m_topAnimManager.reset();
+        m_topAnimManager = AnimationManager();
         m_topObject.reset();
         m_orcFireActive = false;
-        m_orcFireAnim.reset();
+        m_orcFireAnim = AnimationManager();
         m_orcFireObject.reset();
         m_orcAppearActive = false;
-        m_orcAppearAnim.reset();
+        m_orcAppearAnim = AnimationManager();
         m_orcAppearObject.reset();
         m_orcActionCooldownTimer = 0.0f;
         if (m_characterObject) {
             m_characterObject->SetTexture(63, 0);
         }
-        if (auto texData = ResourceManager::GetInstance()->GetTextureData(63)) {
-            if (!m_animManager) {
-                m_animManager = std::make_shared<AnimationManager>();
-            }
-            std::vector<AnimationData> anims;
-            anims.reserve(texData->animations.size());
-            for (const auto& a : texData->animations) {
-                anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-            }
-            m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-            m_animManager->Play(0, true); // Idle
+        if (m_animManager.SetSheet(63)) {
+            m_animManager.Play(0, true); // Idle
             m_lastAnimation = 0;
         }
     } else {
         m_orcMeteorStrikeActive = false;
         m_orcFlameBurstActive = false;
         m_orcFireActive = false;
-        m_orcFireAnim.reset();
+        m_orcFireAnim = AnimationManager();
         m_orcFireObject.reset();
         m_orcAppearActive = false;
-        m_orcAppearAnim.reset();
+        m_orcAppearAnim = AnimationManager();
         m_orcAppearObject.reset();
         m_orcActionCooldownTimer = 0.0f;
         if (m_isWerewolf) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(60, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(60)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(60)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else if (m_isBatDemon) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(61, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(61)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(61)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else if (m_isKitsune) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(62, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(62)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(62)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
         } else {
@@ -1728,32 +1391,15 @@ void CharacterAnimation::SetOrcMode(bool enabled) {
             if (m_characterObject) {
                 m_characterObject->SetTexture(bodyTexId, 0);
             }
-            if (auto texData = ResourceManager::GetInstance()->GetTextureData(bodyTexId)) {
-                if (!m_animManager) {
-                    m_animManager = std::make_shared<AnimationManager>();
-                }
-                std::vector<AnimationData> anims;
-                anims.reserve(texData->animations.size());
-                for (const auto& a : texData->animations) {
-                    anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                }
-                m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-                m_animManager->Play(0, true);
+            if (m_animManager.SetSheet(bodyTexId)) {
+                m_animManager.Play(0, true);
                 m_lastAnimation = 0;
             }
             int headTexId = (m_objectId == 1000) ? 8 : 9;
-            const TextureData* headTex = ResourceManager::GetInstance()->GetTextureData(headTexId);
-            if (headTex && headTex->spriteWidth > 0 && headTex->spriteHeight > 0) {
-                if (!m_topAnimManager) {
-                    m_topAnimManager = std::make_shared<AnimationManager>();
-                    std::vector<AnimationData> topAnims;
-                    topAnims.reserve(headTex->animations.size());
-                    for (const auto& a : headTex->animations) {
-                        topAnims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-                    }
-                    m_topAnimManager->Initialize(headTex->spriteWidth, headTex->spriteHeight, topAnims);
-                    m_topAnimManager->Play(0, true);
-                }
+            if (!m_topAnimManager.HasSheet() && m_topAnimManager.SetSheet(headTexId)) {
+                m_topAnimManager.Play(0, true);
+            }
+            if (m_topAnimManager.HasSheet()) {
                 if (!m_topObject) {
                     m_topObject = std::make_unique<Object>(m_objectId + 10000);
                     if (m_characterObject) {
@@ -1776,8 +1422,8 @@ void CharacterAnimation::TriggerWerewolfCombo() {
     
     m_werewolfComboActive = true;
     m_werewolfComboHitWindowTimer = m_werewolfComboHitWindow;
-    if (m_animManager) {
-        m_animManager->Play(1, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(1, false);
         m_lastAnimation = 1;
     }
 }
@@ -1791,8 +1437,8 @@ void CharacterAnimation::TriggerWerewolfPounce() {
     m_werewolfComboActive = false;
     m_werewolfPounceActive = true;
     m_werewolfPounceHitWindowTimer = m_werewolfPounceHitWindow;
-    if (m_animManager) {
-        m_animManager->Play(3, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(3, false);
         m_lastAnimation = 3;
     }
 }
@@ -1801,8 +1447,8 @@ void CharacterAnimation::TriggerKitsuneEnergyOrb() {
     if (!m_isKitsune) return;
     if (m_kitsuneEnergyOrbActive) return;
     if (m_kitsuneEnergyOrbCooldownTimer > 0.0f) return;
-    if (m_animManager) {
-        m_animManager->Play(3, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(3, false);
         m_lastAnimation = 3;
         m_kitsuneEnergyOrbActive = true;
         m_kitsuneEnergyOrbAnimationComplete = false;
@@ -1813,8 +1459,8 @@ void CharacterAnimation::TriggerOrcMeteorStrike() {
     if (!m_isOrc) return;
     if (m_orcMeteorStrikeActive) return;
     if (m_orcActionCooldownTimer > 0.0f) return;
-    if (m_animManager) {
-        m_animManager->Play(2, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(2, false);
         m_lastAnimation = 2;
         m_orcMeteorStrikeActive = true;
         m_orcActionCooldownTimer = ORC_ACTION_COOLDOWN;
@@ -1828,16 +1474,13 @@ void CharacterAnimation::TriggerOrcFlameBurst() {
     
     SoundManager::Instance().PlaySFXByID(28, 0);
     
-    if (m_animManager) {
-        m_animManager->Play(3, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(3, false);
         m_lastAnimation = 3;
         m_orcFlameBurstActive = true;
         m_orcActionCooldownTimer = ORC_ACTION_COOLDOWN;
     }
 
-    if (!m_orcFireAnim) {
-        m_orcFireAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_orcFireObject) {
         m_orcFireObject = std::make_unique<Object>(m_objectId + 20000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1846,14 +1489,8 @@ void CharacterAnimation::TriggerOrcFlameBurst() {
             m_orcFireObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(67)) {
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_orcFireAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_orcFireAnim->Play(0, false);
+    if (m_orcFireAnim.SetSheet(67)) {
+        m_orcFireAnim.Play(0, false);
         m_orcFireActive = true;
         if (m_orcFireObject) {
             m_orcFireObject->SetTexture(67, 0);
@@ -1880,9 +1517,6 @@ void CharacterAnimation::GetOrcFireAabb(float& left, float& right, float& bottom
 }
 
 void CharacterAnimation::TriggerOrcAppearEffectAt(float x, float y) {
-    if (!m_orcAppearAnim) {
-        m_orcAppearAnim = std::make_shared<AnimationManager>();
-    }
     if (!m_orcAppearObject) {
         m_orcAppearObject = std::make_unique<Object>(m_objectId + 21000);
         if (Object* originalObj = SceneManager::GetInstance()->GetObject(m_objectId)) {
@@ -1891,14 +1525,8 @@ void CharacterAnimation::TriggerOrcAppearEffectAt(float x, float y) {
             m_orcAppearObject->SetScale(originalObj->GetScale());
         }
     }
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(74)) {
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_orcAppearAnim->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
-        m_orcAppearAnim->Play(0, false);
+    if (m_orcAppearAnim.SetSheet(74)) {
+        m_orcAppearAnim.Play(0, false);
         m_orcAppearActive = true;
         if (m_orcAppearObject) {
             m_orcAppearObject->SetTexture(74, 0);
@@ -1907,4 +1535,63 @@ void CharacterAnimation::TriggerOrcAppearEffectAt(float x, float y) {
             m_orcAppearObject->SetScale(0.8f, 0.8f, 0.0f);
         }
     }
-}
\ No newline at end of file
+}
+
+// Effect overlays are created lazily; a snapshot taken after one was created
+// brings it back on restore, and one the snapshot predates is left in place
+// with its active flag cleared by the fields above
+template <class Archive>
+static void TransferOverlay(Archive& ar, std::unique_ptr<Object>& object, int objectId) {
+    bool present = object != nullptr;
+    ar(present);
+    if (!present) return;
+    if (!object) object = std::make_unique<Object>(objectId);
+    object->TransferState(ar);
+}
+
+template <class Archive>
+void CharacterAnimation::TransferState(Archive& ar) {
+    ar(m_lastAnimation); ar(m_lastTopAnimation); ar(m_gunMode); ar(m_gunEntering);
+    ar(m_gunEnterStartMs); ar(m_syncFacingOnEnter); ar(m_topOffsetX); ar(m_topOffsetY);
+    ar(m_gunTopAnimReverse); ar(m_gunTopAnimHold); ar(m_gunTopAnimReload); ar(m_climbHoldTimer);
+    ar(m_lastClimbDir); ar(m_prevClimbUpPressed); ar(m_prevClimbDownPressed); ar(m_downPressStartTime);
+    ar(m_isTurning); ar(m_turnTargetLeft); ar(m_turnTimer); ar(m_turnInitialLeft);
+    ar(m_prevFacingLeft); ar(m_lastFacingLeft); ar(m_aimAngleDeg); ar(m_prevAimUp);
+    ar(m_prevAimDown); ar(m_aimHoldTimerUp); ar(m_aimHoldTimerDown); ar(m_aimSincePressUp);
+    ar(m_aimSincePressDown); ar(m_lastAimTickMs); ar(m_aimHoldBlockUntilMs); ar(m_lastShotAimDeg);
+    ar(m_lastShotTickMs); ar(m_recoilActive); ar(m_recoilTimer); ar(m_recoilOffsetX);
+    ar(m_recoilOffsetY); ar(m_recoilFaceSign); ar(m_recoilStrengthMul); ar(m_reloadActive);
+    ar(m_reloadTimer); ar(m_grenadeMode); ar(m_isBatDemon); ar(m_isWerewolf);
+    ar(m_isKitsune); ar(m_isOrc); ar(m_batSlashActive); ar(m_batSlashCooldownTimer);
+    ar(m_wingFlapTimer); ar(m_kitsuneEnergyOrbActive); ar(m_kitsuneEnergyOrbCooldownTimer); ar(m_kitsuneEnergyOrbAnimationComplete);
+    ar(m_orcMeteorStrikeActive); ar(m_orcFlameBurstActive); ar(m_orcFireActive); ar(m_orcActionCooldownTimer);
+    ar(m_orcAppearActive); ar(m_werewolfAppearActive); ar(m_batAppearActive); ar(m_kitsuneAppearActive);
+    ar(m_batWindActive); ar(m_batWindSpeed); ar(m_batWindFaceSign); ar(m_batWindHasDealtDamage);
+    ar(m_werewolfComboActive); ar(m_werewolfPounceActive); ar(m_werewolfBodyOffsetY); ar(m_werewolfAirTimer);
+    ar(m_werewolfPounceSpeed); ar(m_werewolfPounceCooldownTimer); ar(m_werewolfPounceCooldown); ar(m_werewolfPounceHitWindowTimer);
+    ar(m_werewolfPounceHitWindow); ar(m_werewolfComboCooldownTimer); ar(m_werewolfComboCooldown); ar(m_werewolfComboHitWindowTimer);
+    ar(m_werewolfComboHitWindow); ar(m_hardLandingActive); ar(m_hardLandingPhase); ar(m_restoreInputAfterHardLanding);
+    ar(m_blockHardLandingUntilMs);
+    ar(m_graphForm); ar(m_graphState);
+
+    // The body sheet and texture follow the special form, so both travel whole
+    m_animManager.TransferState(ar);
+    TransferOverlay(ar, m_characterObject, m_objectId);
+    m_topAnimManager.TransferState(ar);
+    TransferOverlay(ar, m_topObject, m_objectId + 10000);
+    m_orcFireAnim.TransferState(ar);
+    TransferOverlay(ar, m_orcFireObject, m_objectId + 20000);
+    m_orcAppearAnim.TransferState(ar);
+    TransferOverlay(ar, m_orcAppearObject, m_objectId + 21000);
+    m_werewolfAppearAnim.TransferState(ar);
+    TransferOverlay(ar, m_werewolfAppearObject, m_objectId + 22000);
+    m_batAppearAnim.TransferState(ar);
+    TransferOverlay(ar, m_batAppearObject, m_objectId + 23000);
+    m_kitsuneAppearAnim.TransferState(ar);
+    TransferOverlay(ar, m_kitsuneAppearObject, m_objectId + 24000);
+    m_batWindAnim.TransferState(ar);
+    TransferOverlay(ar, m_batWindObject, m_objectId + 25000);
+}
+
+template void CharacterAnimation::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void CharacterAnimation::TransferState<SnapshotReader>(SnapshotReader&);
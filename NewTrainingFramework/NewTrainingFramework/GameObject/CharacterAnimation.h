@@ -1,23 +1,24 @@
 #pragma once
 #include <memory>
 #include "../../Utilities/Math.h"
-
-class AnimationManager;
+#include "AnimationManager.h"
+#include "AnimationGraph.h"
 
 class Camera;
 class Object;
 class CharacterMovement;
 struct PlayerInputConfig;
 class CharacterCombat;
+class KeyStates;
 
 class CharacterAnimation {
 private:
-    std::shared_ptr<AnimationManager> m_animManager;
+    AnimationManager m_animManager;
     std::unique_ptr<class Object> m_characterObject;
     int m_lastAnimation;
     int m_objectId;
 
-    std::shared_ptr<AnimationManager> m_topAnimManager;
+    AnimationManager m_topAnimManager;
     std::unique_ptr<class Object> m_topObject;
     int m_lastTopAnimation = -1;
     bool m_gunMode = false;
@@ -86,6 +87,7 @@ private:
     bool m_isOrc = false;
     bool m_batSlashActive = false;
     float m_batSlashCooldownTimer = 0.0f;
+    float m_wingFlapTimer = 0.0f;
     static constexpr float BAT_SLASH_COOLDOWN = 10.0f;
     bool m_kitsuneEnergyOrbActive = false;
     float m_kitsuneEnergyOrbCooldownTimer = 0.0f;
@@ -96,27 +98,27 @@ private:
     bool m_orcFireActive = false;
     float m_orcActionCooldownTimer = 0.0f;
     static constexpr float ORC_ACTION_COOLDOWN = 10.0f;
-    std::shared_ptr<AnimationManager> m_orcFireAnim;
+    AnimationManager m_orcFireAnim;
     std::unique_ptr<class Object> m_orcFireObject;
     bool m_orcAppearActive = false;
-    std::shared_ptr<AnimationManager> m_orcAppearAnim;
+    AnimationManager m_orcAppearAnim;
     std::unique_ptr<class Object> m_orcAppearObject;
     static constexpr float ORC_APPEAR_Y_OFFSET = 0.19f;
     bool m_werewolfAppearActive = false;
-    std::shared_ptr<AnimationManager> m_werewolfAppearAnim;
+    AnimationManager m_werewolfAppearAnim;
     std::unique_ptr<class Object> m_werewolfAppearObject;
     static constexpr float WEREWOLF_APPEAR_Y_OFFSET = 0.05f;
     bool m_batAppearActive = false;
-    std::shared_ptr<AnimationManager> m_batAppearAnim;
+    AnimationManager m_batAppearAnim;
     std::unique_ptr<class Object> m_batAppearObject;
     static constexpr float BAT_APPEAR_Y_OFFSET = 0.05f;
     bool m_kitsuneAppearActive = false;
-    std::shared_ptr<AnimationManager> m_kitsuneAppearAnim;
+    AnimationManager m_kitsuneAppearAnim;
     std::unique_ptr<class Object> m_kitsuneAppearObject;
     static constexpr float KITSUNE_APPEAR_Y_OFFSET = 0.19f;
 
     bool m_batWindActive = false;
-    std::shared_ptr<AnimationManager> m_batWindAnim;
+    AnimationManager m_batWindAnim;
     std::unique_ptr<class Object> m_batWindObject;
     float m_batWindSpeed = 0.8f;
     float m_batWindFaceSign = 1.0f;
@@ -142,6 +144,19 @@ private:
     // Helper methods
     void UpdateAnimationState(CharacterMovement* movement, CharacterCombat* combat);
 
+    // Body state in AnimationGraph; the state index is reset whenever the form changes
+    int m_graphForm = -1;
+    int m_graphState = -1;
+    uint32_t BuildGraphConditions(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat, const KeyStates* keyStates) const;
+    // Next state of the form's graph; nullptr when playback should be left alone
+    const AnimationGraph::State* StepGraph(AnimationGraph::Form form, uint32_t conditions, bool& restart);
+    // Normal, gun and grenade bodies go through PlayAnimation() and its replay rules
+    void PlayGraphForm(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat, const KeyStates* keyStates);
+    // Special forms: swap to the form's sheet, play the state's clip and finish its action
+    void UpdateSpecialForm(AnimationGraph::Form form, CharacterMovement* movement, CharacterCombat* combat);
+    void EndGraphAction(uint32_t action);
+    void HandleLadderClimb(const KeyStates& keyStates, CharacterMovement* movement, int clip);
+
     bool m_hardLandingActive = false;
     int  m_hardLandingPhase = 0; // 0 = Lie, 1 = Land
     bool m_restoreInputAfterHardLanding = false;
@@ -149,12 +164,12 @@ private:
 
 public:
     // Movement animation handling
-    void HandleMovementAnimations(const bool* keyStates, CharacterMovement* movement, CharacterCombat* combat);
+    void HandleMovementAnimations(const KeyStates& keyStates, CharacterMovement* movement, CharacterCombat* combat);
     CharacterAnimation();
     ~CharacterAnimation();
     
     // Initialization
-    void Initialize(std::shared_ptr<AnimationManager> animManager, int objectId);
+    void Initialize(int bodyTextureId, int objectId);
     
     // Core update
     void Update(float deltaTime, CharacterMovement* movement, CharacterCombat* combat);
@@ -170,7 +185,7 @@ public:
     void PlayTopAnimation(int animIndex, bool loop);
     int GetCurrentAnimation() const;
     bool IsAnimationPlaying() const;
-    void GetCurrentFrameUV(float& u0, float& v0, float& u1, float& v1) const;
+    int GetCurrentSheetFrame() const;
     // Gun helpers
     Vector3 GetTopWorldPosition(CharacterMovement* movement) const;
     float GetAimAngleDeg() const { return m_aimAngleDeg; }
@@ -212,7 +227,7 @@ public:
     bool IsWerewolfComboHitWindowActive() const { return m_werewolfComboHitWindowTimer > 0.0f; }
     bool IsWerewolfPounceHitWindowActive() const { return m_werewolfPounceHitWindowTimer > 0.0f; }
 
-    void GetTopFrameUV(float& u0, float& v0, float& u1, float& v1) const;
+    int GetTopSheetFrame() const;
     int GetHeadTextureId() const { return (m_objectId == 1000) ? 8 : 9; }
     int GetBodyTextureId() const { return m_isBatDemon ? 61 : (m_isWerewolf ? 60 : (m_isKitsune ? 62 : (m_isOrc ? 63 : ((m_objectId == 1000) ? 10 : 11)))); }
     float GetTopOffsetX() const { return m_topOffsetX; }
@@ -249,7 +264,12 @@ public:
     void TriggerBatAppearEffectAt(float x, float y);
     void TriggerKitsuneAppearEffectAt(float x, float y);
 
+    // Mode flags, timers and every animation manager and overlay object; the
+    // special form is restored by value rather than by replaying Set*Mode()
+    template <class Archive>
+    void TransferState(Archive& ar);
+
 private:
     void StartTurn(bool toLeft, bool initialLeft);
-    void HandleGunAim(const bool* keyStates, const PlayerInputConfig& inputConfig);
+    void HandleGunAim(const KeyStates& keyStates, const PlayerInputConfig& inputConfig);
 }; 
\ No newline at end of file
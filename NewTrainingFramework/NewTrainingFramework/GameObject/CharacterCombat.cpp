@@ -5,6 +5,7 @@
 #include "CharacterMovement.h"
 #include "AnimationManager.h"
 #include "../GameManager/SoundManager.h"
+#include "../GameManager/Snapshot.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -414,4 +415,19 @@ void CharacterCombat::TriggerGetHit(CharacterAnimation* animation, const Charact
             target->TriggerDieFromAttack(attacker);
         }
     }
-} 
\ No newline at end of file
+} 
+
+template <class Archive>
+void CharacterCombat::TransferState(Archive& ar) {
+    ar(m_comboCount); ar(m_comboTimer); ar(m_isInCombo); ar(m_comboCompleted);
+    ar(m_axeComboCount); ar(m_axeComboTimer); ar(m_isInAxeCombo); ar(m_axeComboCompleted);
+    ar(m_isKicking); ar(m_isHit); ar(m_hitTimer); ar(m_showHitbox);
+    ar(m_hitboxTimer); ar(m_hitboxWidth); ar(m_hitboxHeight); ar(m_hitboxOffsetX);
+    ar(m_hitboxOffsetY); ar(m_nextGetHitAnimation); ar(m_weaponComboCooldown); ar(m_weaponComboQueued);
+    ar(m_punchComboCooldown); ar(m_punchComboQueued); ar(m_currentWeaponAnim1); ar(m_currentWeaponAnim2);
+    ar(m_currentWeaponAnim3); ar(m_attackPressed); ar(m_isLunging); ar(m_lungeRemainingDistance);
+    ar(m_lungeSpeed); ar(m_lungeDirection); ar(m_lungeDeltaThisFrame);
+}
+
+template void CharacterCombat::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void CharacterCombat::TransferState<SnapshotReader>(SnapshotReader&);
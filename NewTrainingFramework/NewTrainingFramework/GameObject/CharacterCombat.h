@@ -101,6 +101,9 @@ public:
     float GetHitboxOffsetX() const { return m_hitboxOffsetX; }
     float GetHitboxOffsetY() const { return m_hitboxOffsetY; }
 
+    template <class Archive>
+    void TransferState(Archive& ar);
+
     void StartLunge(bool facingLeft, float distance, float duration) {
         if (distance <= 0.0f || duration <= 0.0f) return;
         m_isLunging = true;
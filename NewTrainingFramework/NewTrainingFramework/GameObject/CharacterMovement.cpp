@@ -1,13 +1,14 @@
 #include "stdafx.h"
 #include "CharacterMovement.h"
+#include "InputManager.h"
 #include "WallCollision.h"
 #include "PlatformCollision.h"
 #include <iostream>
-#include <SDL.h>
 #include "SceneManager.h"
 #include "Object.h"
 #include "LadderCollision.h"
 #include "TeleportCollision.h"
+#include "../GameManager/Snapshot.h"
 
 const float CharacterMovement::JUMP_FORCE = 0.9f;
 const float CharacterMovement::GRAVITY = 2.5f;
@@ -52,6 +53,8 @@ CharacterMovement::~CharacterMovement() {
 void CharacterMovement::Initialize(float startX, float startY, float groundY) {
     m_posX = startX;
     m_posY = startY;
+    m_prevPosX = startX;
+    m_prevPosY = startY;
     m_groundY = groundY;
     m_state = CharState::Idle;
     m_facingLeft = false;
@@ -73,10 +76,7 @@ void CharacterMovement::Initialize(float startX, float startY, float groundY) {
     m_pendingFallDamage = 0.0f;
 }
 
-void CharacterMovement::Update(float deltaTime, const bool* keyStates) {
-    if (!keyStates) {
-        return;
-    }
+void CharacterMovement::Update(float deltaTime, const KeyStates& keyStates) {
     
     m_wasJumping = m_isJumping;
     
@@ -94,10 +94,7 @@ void CharacterMovement::Update(float deltaTime, const bool* keyStates) {
     }
 }
 
-void CharacterMovement::HandleMovement(float deltaTime, const bool* keyStates) {
-    if (!keyStates) {
-        return;
-    }
+void CharacterMovement::HandleMovement(float deltaTime, const KeyStates& keyStates) {
     
     if (m_inputLocked) {
         if (!m_isJumping) {
@@ -133,13 +130,13 @@ void CharacterMovement::HandleMovement(float deltaTime, const bool* keyStates) {
     
     bool isOtherAction = keyStates[m_inputConfig.jumpKey];
     
-    float currentTime = SDL_GetTicks() / 1000.0f;
-
+    // Taps are timed by when the key went down, not by the tick that saw it
     if (keyStates[m_inputConfig.moveLeftKey] && !m_prevLeftKey) {
-        if (currentTime - m_lastLeftPressTime < DOUBLE_TAP_THRESHOLD) {
+        const float pressTime = (float)keyStates.GetPressTime(m_inputConfig.moveLeftKey);
+        if (pressTime - m_lastLeftPressTime < DOUBLE_TAP_THRESHOLD) {
             m_isRunningLeft = m_allowRun;
         }
-        m_lastLeftPressTime = currentTime;
+        m_lastLeftPressTime = pressTime;
     }
     if (!keyStates[m_inputConfig.moveLeftKey]) {
         m_isRunningLeft = false;
@@ -147,10 +144,11 @@ void CharacterMovement::HandleMovement(float deltaTime, const bool* keyStates) {
     m_prevLeftKey = keyStates[m_inputConfig.moveLeftKey];
 
     if (keyStates[m_inputConfig.moveRightKey] && !m_prevRightKey) {
-        if (currentTime - m_lastRightPressTime < DOUBLE_TAP_THRESHOLD) {
+        const float pressTime = (float)keyStates.GetPressTime(m_inputConfig.moveRightKey);
+        if (pressTime - m_lastRightPressTime < DOUBLE_TAP_THRESHOLD) {
             m_isRunningRight = m_allowRun;
         }
-        m_lastRightPressTime = currentTime;
+        m_lastRightPressTime = pressTime;
     }
     if (!keyStates[m_inputConfig.moveRightKey]) {
         m_isRunningRight = false;
@@ -208,10 +206,7 @@ void CharacterMovement::HandleMovement(float deltaTime, const bool* keyStates) {
     }
 }
 
-void CharacterMovement::HandleJump(float deltaTime, const bool* keyStates) {
-    if (!keyStates) {
-        return;
-    }
+void CharacterMovement::HandleJump(float deltaTime, const KeyStates& keyStates) {
     if (m_inputLocked) {
         return;
     }
@@ -318,6 +313,16 @@ void CharacterMovement::SetPosition(float x, float y) {
     m_posY = y;
 }
 
+Vector3 CharacterMovement::GetRenderPosition(float alpha) const {
+    const float SNAP_DISTANCE = 0.25f;
+    float dx = m_posX - m_prevPosX;
+    float dy = m_posY - m_prevPosY;
+    if (dx * dx + dy * dy > SNAP_DISTANCE * SNAP_DISTANCE) {
+        return GetPosition();
+    }
+    return Vector3(m_prevPosX + dx * alpha, m_prevPosY + dy * alpha, 0.0f);
+}
+
 void CharacterMovement::TriggerDie(bool attackerFacingLeft) {
     if (!m_isDying && !m_isDead) {
         m_isDying = true;
@@ -353,10 +358,7 @@ void CharacterMovement::ResetDieState() {
     m_state = CharState::Idle;
 }
 
-void CharacterMovement::HandleLanding(const bool* keyStates) {
-    if (!keyStates) {
-        return;
-    }
+void CharacterMovement::HandleLanding(const KeyStates& keyStates) {
     
     if (keyStates[m_inputConfig.moveLeftKey]) {
         m_state = CharState::MoveLeft;
@@ -416,8 +418,7 @@ bool CharacterMovement::CheckPlatformCollisionWithHurtbox(float& newY, float hur
     return collided;
 }
 
-void CharacterMovement::UpdateWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough) {
-    if (!keyStates) return;
+void CharacterMovement::UpdateWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough) {
     
     if (m_isDying || m_isDead) {
         HandleDie(deltaTime);
@@ -506,8 +507,7 @@ void CharacterMovement::UpdateWithHurtbox(float deltaTime, const bool* keyStates
     }
 }
 
-void CharacterMovement::UpdateNoClip(float deltaTime, const bool* keyStates) {
-    if (!keyStates) return;
+void CharacterMovement::UpdateNoClip(float deltaTime, const KeyStates& keyStates) {
     const PlayerInputConfig& ic = GetInputConfig();
     float speed = MOVE_SPEED * 2.0f * m_moveSpeedMultiplier;
     if (keyStates[ic.moveLeftKey])  { m_posX -= speed * deltaTime; m_facingLeft = true;  m_state = CharState::MoveLeft; }
@@ -517,7 +517,7 @@ void CharacterMovement::UpdateNoClip(float deltaTime, const bool* keyStates) {
     m_isJumping = false;
     m_isOnPlatform = false;
 }
-bool CharacterMovement::HandleLadderWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY) {
+bool CharacterMovement::HandleLadderWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY) {
     if (m_inputLocked) {
         return false;
     }
@@ -544,11 +544,11 @@ bool CharacterMovement::HandleLadderWithHurtbox(float deltaTime, const bool* key
             bool downKey = keyStates[input.sitKey];
 
             bool canEnter = false;
-            float now = SDL_GetTicks() / 1000.0f;
 
             if (requireDoubleTap) {
                 if (m_allowLadderDoubleTap) {
                     if (upKey && !m_prevUpKey) {
+                        const float now = (float)keyStates.GetPressTime(input.jumpKey);
                         if (now - m_lastUpTapTimeForLadder < DOUBLE_TAP_THRESHOLD) {
                             m_upTapCountForLadder++;
                         } else {
@@ -557,6 +557,7 @@ bool CharacterMovement::HandleLadderWithHurtbox(float deltaTime, const bool* key
                         m_lastUpTapTimeForLadder = now;
                     }
                     if (downKey && !m_prevDownKeyForLadder) {
+                        const float now = (float)keyStates.GetPressTime(input.sitKey);
                         if (now - m_lastDownTapTimeForLadder < DOUBLE_TAP_THRESHOLD) {
                             m_downTapCountForLadder++;
                         } else {
@@ -663,7 +664,7 @@ bool CharacterMovement::HandleLadderWithHurtbox(float deltaTime, const bool* key
 }
 
 
-void CharacterMovement::HandleJumpWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough) {
+void CharacterMovement::HandleJumpWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough) {
     const PlayerInputConfig& inputConfig = GetInputConfig();
     
     bool onGround = (m_posY <= m_groundY + 0.01f);
@@ -675,12 +676,12 @@ void CharacterMovement::HandleJumpWithHurtbox(float deltaTime, const bool* keySt
                                                           hurtboxOffsetX, hurtboxOffsetY);
     }
     
-    float currentTime = SDL_GetTicks() / 1000.0f;
     int downKey = inputConfig.sitKey;
     bool isDownPressed = keyStates[downKey];
     
     if (isDownPressed && !m_prevDownKey) {
-        if (currentTime - m_lastDownPressTime < DOUBLE_TAP_THRESHOLD) {
+        const float pressTime = (float)keyStates.GetPressTime(downKey);
+        if (pressTime - m_lastDownPressTime < DOUBLE_TAP_THRESHOLD) {
             if (m_isOnPlatform && !m_isJumping && allowPlatformFallThrough) {
                 m_isOnPlatform = false;
                 m_isJumping = true;
@@ -689,7 +690,7 @@ void CharacterMovement::HandleJumpWithHurtbox(float deltaTime, const bool* keySt
                 m_fallThroughTimer = 0.0f;
             }
         }
-        m_lastDownPressTime = currentTime;
+        m_lastDownPressTime = pressTime;
     }
     m_prevDownKey = isDownPressed;
     
@@ -769,7 +770,7 @@ void CharacterMovement::HandleJumpWithHurtbox(float deltaTime, const bool* keySt
     }
 }
 
-void CharacterMovement::HandleLandingWithHurtbox(const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY) {
+void CharacterMovement::HandleLandingWithHurtbox(const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY) {
     if (!m_isJumping) {
         float newY = m_posY;
         bool onPlatform = !m_isFallingThroughPlatform && CheckPlatformCollisionWithHurtbox(newY, hurtboxWidth, hurtboxHeight, hurtboxOffsetX, hurtboxOffsetY);
@@ -839,4 +840,28 @@ void CharacterMovement::InitializeTeleportCollision() {
         m_teleportLockTimer = 0.0f;
         m_lastTeleportFromId = -1;
     }
-}
\ No newline at end of file
+}
+
+template <class Archive>
+void CharacterMovement::TransferState(Archive& ar) {
+    ar(m_posX); ar(m_posY); ar(m_prevPosX); ar(m_prevPosY);
+    ar(m_groundY); ar(m_facingLeft); ar(m_state); ar(m_isJumping);
+    ar(m_jumpVelocity); ar(m_jumpStartY); ar(m_wasJumping); ar(m_isSitting);
+    ar(m_isRolling); ar(m_isDying); ar(m_isDead); ar(m_dieTimer);
+    ar(m_knockdownTimer); ar(m_knockdownComplete); ar(m_attackerFacingLeft); ar(m_dieBaseY);
+    ar(m_dieLanded); ar(m_dieVerticalVelocity); ar(m_lastLeftPressTime); ar(m_lastRightPressTime);
+    ar(m_isRunningLeft); ar(m_isRunningRight); ar(m_prevLeftKey); ar(m_prevRightKey);
+    ar(m_lastDownPressTime); ar(m_prevDownKey); ar(m_prevUpKey); ar(m_isFallingThroughPlatform);
+    ar(m_fallThroughTimer); ar(m_lastUpTapTimeForLadder); ar(m_lastDownTapTimeForLadder); ar(m_prevDownKeyForLadder);
+    ar(m_upTapCountForLadder); ar(m_downTapCountForLadder); ar(m_characterWidth); ar(m_characterHeight);
+    ar(m_isOnPlatform); ar(m_currentPlatformY); ar(m_currentMovingPlatformId); ar(m_isOnLadder);
+    ar(m_ladderCenterX); ar(m_ladderTop); ar(m_ladderBottom); ar(m_teleportLockTimer);
+    ar(m_lastTeleportFromId); ar(m_invertHorizontal); ar(m_inputLocked); ar(m_justStartedUpwardJump);
+    ar(m_highestYInAir); ar(m_hardLandingRequested); ar(m_rollCadenceActive); ar(m_rollPhaseIsRoll);
+    ar(m_rollPhaseTimer); ar(m_hasPendingFallDamage); ar(m_pendingFallDamage); ar(m_noClipNoGravity);
+    ar(m_allowLadderDoubleTap); ar(m_ladderEnabled); ar(m_moveSpeedMultiplier); ar(m_runSpeedMultiplier);
+    ar(m_jumpForceMultiplier); ar(m_allowRun);
+}
+
+template void CharacterMovement::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void CharacterMovement::TransferState<SnapshotReader>(SnapshotReader&);
@@ -6,6 +6,8 @@
 #include "LadderCollision.h"
 #include "TeleportCollision.h"
 
+class KeyStates;
+
 enum class CharState {
     Idle,
     MoveLeft,
@@ -43,6 +45,8 @@ struct PlayerInputConfig {
 class CharacterMovement {
 private:
     float m_posX, m_posY;
+    // Position at the start of the current simulation tick, for render interpolation
+    float m_prevPosX = 0.0f, m_prevPosY = 0.0f;
     float m_groundY;
     bool m_facingLeft;
     CharState m_state;
@@ -139,7 +143,7 @@ private:
     void QueueFallDamageFromDrop(float dropDistance);
 
     bool m_noClipNoGravity = false;
-    void UpdateNoClip(float deltaTime, const bool* keyStates);
+    void UpdateNoClip(float deltaTime, const KeyStates& keyStates);
 
     bool m_allowLadderDoubleTap = true;
     bool m_ladderEnabled = true;
@@ -175,21 +179,24 @@ public:
     void SetLadderDoubleTapEnabled(bool enabled) { m_allowLadderDoubleTap = enabled; }
     void SetLadderEnabled(bool enabled) { m_ladderEnabled = enabled; if (!enabled) m_isOnLadder = false; }
     
-    void Update(float deltaTime, const bool* keyStates);
-    void UpdateWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough = true);
-    bool HandleLadderWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY);
+    void Update(float deltaTime, const KeyStates& keyStates);
+    void UpdateWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough = true);
+    bool HandleLadderWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY);
     
-    void HandleMovement(float deltaTime, const bool* keyStates);
-    void HandleJump(float deltaTime, const bool* keyStates);
-    void HandleJumpWithHurtbox(float deltaTime, const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough = true);
-    void HandleLanding(const bool* keyStates);
-    void HandleLandingWithHurtbox(const bool* keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY);
+    void HandleMovement(float deltaTime, const KeyStates& keyStates);
+    void HandleJump(float deltaTime, const KeyStates& keyStates);
+    void HandleJumpWithHurtbox(float deltaTime, const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY, bool allowPlatformFallThrough = true);
+    void HandleLanding(const KeyStates& keyStates);
+    void HandleLandingWithHurtbox(const KeyStates& keyStates, float hurtboxWidth, float hurtboxHeight, float hurtboxOffsetX, float hurtboxOffsetY);
     void HandleDie(float deltaTime);
     
     void SetPosition(float x, float y);
     void TriggerDie(bool attackerFacingLeft = false);
     void ResetDieState();
     Vector3 GetPosition() const { return Vector3(m_posX, m_posY, 0.0f); }
+    void SaveRenderState() { m_prevPosX = m_posX; m_prevPosY = m_posY; }
+    // Blend between the previous and current tick; jumps larger than a tick of movement snap
+    Vector3 GetRenderPosition(float alpha) const;
     float GetPosX() const { return m_posX; }
     float GetPosY() const { return m_posY; }
     bool IsFacingLeft() const { return m_facingLeft; }
@@ -251,6 +258,10 @@ public:
         return d;
     }
 
+    // Everything Update() mutates; collision shapes and the input config are set up once per match
+    template <class Archive>
+    void TransferState(Archive& ar);
+
     // Static input configurations
     static const PlayerInputConfig PLAYER1_INPUT;
     static const PlayerInputConfig PLAYER2_INPUT;
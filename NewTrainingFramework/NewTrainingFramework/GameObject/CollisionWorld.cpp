@@ -0,0 +1,71 @@
+#include "stdafx.h"
+#include "CollisionWorld.h"
+#include <algorithm>
+
+void CollisionWorld::Clear() {
+    m_boxes.Clear();
+    m_colliders.clear();
+}
+
+void CollisionWorld::Reserve(int count) {
+    m_boxes.Reserve(count);
+    m_colliders.reserve(count);
+}
+
+int CollisionWorld::Add(uint8_t layer, uint8_t mask, float left, float right, float bottom, float top,
+                        uint8_t kind, int source, uint8_t owner) {
+    m_boxes.Add(left, right, bottom, top);
+    m_colliders.push_back({ layer, mask, kind, owner, source });
+    return Size() - 1;
+}
+
+void CollisionWorld::GeneratePairs(std::vector<Pair>& outPairs) {
+    outPairs.clear();
+    const int n = Size();
+    if (n == 0) return;
+
+    uint8_t wanted = 0;
+    for (const Collider& c : m_colliders) wanted |= c.mask;
+
+    for (int bit = 0; bit < 8; ++bit) {
+        const uint8_t layer = (uint8_t)(1u << bit);
+        if (!(wanted & layer)) continue;
+
+        m_targetIds.clear();
+        bool anyQuery = false;
+        for (int i = 0; i < n; ++i) {
+            const Collider& c = m_colliders[i];
+            if (c.layer == layer) m_targetIds.push_back(i);
+            if (c.mask & layer) anyQuery = true;
+        }
+        if (m_targetIds.empty() || !anyQuery) continue;
+
+        // Every packed box is tested in place; results for colliders that do not
+        // want this layer are skipped, which is cheaper than copying the queries out
+        m_masks.resize(n);
+        for (size_t base = 0; base < m_targetIds.size(); base += AabbSet::MAX_TARGETS) {
+            const size_t end = std::min(m_targetIds.size(), base + (size_t)AabbSet::MAX_TARGETS);
+            m_targets.Clear();
+            for (size_t t = base; t < end; ++t) {
+                const int id = m_targetIds[t];
+                m_targets.Add(m_boxes.GetLeft(id), m_boxes.GetRight(id), m_boxes.GetBottom(id), m_boxes.GetTop(id));
+            }
+            m_targets.Query(m_boxes, AabbSet::OVERLAP_INCLUSIVE, m_masks.data());
+            for (int i = 0; i < n; ++i) {
+                uint32_t mask = m_masks[i];
+                if (!mask || !(m_colliders[i].mask & layer)) continue;
+                while (mask) {
+                    int j = 0;
+                    while (!(mask & (1u << j))) ++j;
+                    mask &= ~(1u << j);
+                    const int other = m_targetIds[base + j];
+                    if (other != i) outPairs.push_back({ i, other });
+                }
+            }
+        }
+    }
+
+    std::sort(outPairs.begin(), outPairs.end(), [](const Pair& a, const Pair& b) {
+        return a.collider != b.collider ? a.collider < b.collider : a.other < b.other;
+    });
+}
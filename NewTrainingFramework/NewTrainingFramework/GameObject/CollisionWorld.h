@@ -0,0 +1,58 @@
+#pragma once
+#include "AabbSet.h"
+#include <vector>
+#include <cstdint>
+
+// Per-tick collision broadphase over typed layers. Every collider belongs to one
+// layer and carries a mask of the layers it wants to be tested against; the
+// world is rebuilt each tick and GeneratePairs() reports every overlap as
+// (collider, other) sorted by collider index, then by other index, so the
+// order in which colliders are added defines the order of the resulting events.
+class CollisionWorld {
+public:
+    enum Layer : uint8_t {
+        LAYER_PROJECTILE = 1 << 0,
+        LAYER_HAZARD     = 1 << 1,
+        LAYER_HURTBOX    = 1 << 2,
+        LAYER_HITBOX     = 1 << 3,
+        LAYER_PICKUP     = 1 << 4,
+    };
+
+    struct Collider {
+        uint8_t layer;
+        uint8_t mask;
+        uint8_t kind;    // game-defined source type
+        uint8_t owner;   // game-defined owner id, 0 when none
+        int source;      // index into the owning system
+    };
+
+    struct Pair {
+        int collider;
+        int other;
+    };
+
+    void Clear();
+    void Reserve(int count);
+    int Add(uint8_t layer, uint8_t mask, float left, float right, float bottom, float top,
+            uint8_t kind, int source, uint8_t owner = 0);
+
+    // Inclusive overlap test: touching edges count
+    void GeneratePairs(std::vector<Pair>& outPairs);
+
+    int Size() const { return (int)m_colliders.size(); }
+    const Collider& Get(int i) const { return m_colliders[i]; }
+    const AabbSet& GetBoxes() const { return m_boxes; }
+    float GetCenterX(int i) const { return (m_boxes.GetLeft(i) + m_boxes.GetRight(i)) * 0.5f; }
+    float GetCenterY(int i) const { return (m_boxes.GetBottom(i) + m_boxes.GetTop(i)) * 0.5f; }
+    float GetHalfWidth(int i) const { return (m_boxes.GetRight(i) - m_boxes.GetLeft(i)) * 0.5f; }
+    float GetHalfHeight(int i) const { return (m_boxes.GetTop(i) - m_boxes.GetBottom(i)) * 0.5f; }
+
+private:
+    AabbSet m_boxes;
+    std::vector<Collider> m_colliders;
+
+    // Scratch buffers reused across ticks
+    AabbSet m_targets;
+    std::vector<int> m_targetIds;
+    std::vector<uint32_t> m_masks;
+};
@@ -4,6 +4,7 @@
 #include "../GameManager/ResourceManager.h"
 #include "../GameManager/SceneManager.h"
 #include "WallCollision.h"
+#include "../GameManager/Snapshot.h"
 
 EnergyOrbProjectile::EnergyOrbProjectile()
     : m_isActive(false)
@@ -39,14 +40,7 @@ void EnergyOrbProjectile::Initialize() {
         m_object->MakeModelInstanceCopy();
     }
     
-    if (auto texData = ResourceManager::GetInstance()->GetTextureData(65)) {
-        m_animManager = std::make_shared<AnimationManager>();
-        std::vector<AnimationData> anims;
-        anims.reserve(texData->animations.size());
-        for (const auto& a : texData->animations) {
-            anims.push_back({a.startFrame, a.numFrames, a.duration, 0.0f});
-        }
-        m_animManager->Initialize(texData->spriteWidth, texData->spriteHeight, anims);
+    if (m_animManager.SetSheet(65)) {
     }
 }
 
@@ -63,20 +57,15 @@ void EnergyOrbProjectile::Spawn(const Vector3& position, const Vector3& directio
     m_animationLoop = true;
     m_ownerId = ownerId;
     
-    if (m_animManager) {
-        m_animManager->Play(0, true);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(0, true);
     }
     
     if (m_object) {
         m_object->SetPosition(m_position);
         
-        if (m_animManager) {
-            float u0, v0, u1, v1;
-            m_animManager->GetUV(u0, v0, u1, v1);
-            if (m_velocity.x < 0.0f) {
-                float tmp = u0; u0 = u1; u1 = tmp;
-            }
-            m_object->SetCustomUV(u0, v0, u1, v1);
+        if (m_animManager.HasSheet()) {
+            m_object->SetSpriteFrame(m_animManager.GetSheetFrame(), m_velocity.x < 0.0f ? Object::SPRITE_FLIP_X : 0);
         }
     }
 }
@@ -98,15 +87,13 @@ void EnergyOrbProjectile::Update(float deltaTime) {
             return;
         }
         
-        if (m_animManager && m_currentAnimation != 1) {
-            m_animManager->Play(1, false);
+        if (m_animManager.HasSheet() && m_currentAnimation != 1) {
+            m_animManager.Play(1, false);
             m_currentAnimation = 1;
             m_animationLoop = false;
             
             if (m_object) {
-                float u0, v0, u1, v1;
-                m_animManager->GetUV(u0, v0, u1, v1);
-                m_object->SetCustomUV(u0, v0, u1, v1);
+                m_object->SetSpriteFrame(m_animManager.GetSheetFrame());
             }
         }
     } else {
@@ -121,17 +108,12 @@ void EnergyOrbProjectile::Update(float deltaTime) {
         
     }
     
-    if (m_animManager) {
-        m_animManager->Update(deltaTime);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Update(deltaTime);
     }
     
-    if (m_animManager && m_object) {
-        float u0, v0, u1, v1;
-        m_animManager->GetUV(u0, v0, u1, v1);
-        if (m_velocity.x < 0.0f) {
-            float tmp = u0; u0 = u1; u1 = tmp;
-        }
-        m_object->SetCustomUV(u0, v0, u1, v1);
+    if (m_animManager.HasSheet() && m_object) {
+        m_object->SetSpriteFrame(m_animManager.GetSheetFrame(), m_velocity.x < 0.0f ? Object::SPRITE_FLIP_X : 0);
     }
 }
 
@@ -153,15 +135,13 @@ void EnergyOrbProjectile::TriggerExplosion() {
         m_explosionCallback(m_position.x);
     }
     
-    if (m_animManager) {
-        m_animManager->Play(1, false);
+    if (m_animManager.HasSheet()) {
+        m_animManager.Play(1, false);
         m_currentAnimation = 1;
         m_animationLoop = false;
         
         if (m_object) {
-            float u0, v0, u1, v1;
-            m_animManager->GetUV(u0, v0, u1, v1);
-            m_object->SetCustomUV(u0, v0, u1, v1);
+            m_object->SetSpriteFrame(m_animManager.GetSheetFrame());
         }
     }
 }
@@ -192,3 +172,18 @@ bool EnergyOrbProjectile::CheckWallCollision() const {
         0.0f, 0.0f                
     );
 }
+
+template <class Archive>
+void EnergyOrbProjectile::TransferState(Archive& ar) {
+    ar(m_isActive);
+    ar(m_position); ar(m_velocity);
+    ar(m_speed); ar(m_lifetime); ar(m_maxLifetime);
+    ar(m_isExploding); ar(m_explosionTimer); ar(m_explosionDuration);
+    ar(m_currentAnimation); ar(m_animationLoop);
+    ar(m_ownerId);
+    if (m_animManager.HasSheet()) m_animManager.TransferState(ar);
+    if (m_object) m_object->TransferState(ar);
+}
+
+template void EnergyOrbProjectile::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void EnergyOrbProjectile::TransferState<SnapshotReader>(SnapshotReader&);
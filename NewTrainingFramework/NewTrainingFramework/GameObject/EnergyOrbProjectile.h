@@ -11,7 +11,7 @@ class Camera;
 class EnergyOrbProjectile {
 private:
     std::unique_ptr<Object> m_object;
-    std::shared_ptr<AnimationManager> m_animManager;
+    AnimationManager m_animManager;
     
     bool m_isActive;
     Vector3 m_position;
@@ -56,6 +56,10 @@ public:
     
     void TriggerExplosion();
     bool IsExploding() const { return m_isExploding; }
+
+    // Flight and explosion state; Initialize() must already have run on both sides
+    template <class Archive>
+    void TransferState(Archive& ar);
     
 private:
     void HandleCollision();
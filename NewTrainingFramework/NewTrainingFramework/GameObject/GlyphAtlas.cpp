@@ -0,0 +1,126 @@
+#include "stdafx.h"
+#include "GlyphAtlas.h"
+#include "Texture2D.h"
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char* HUD_FONT_PATH = "../Resources/Font/PressStart2P-Regular.ttf";
+    const int ATLAS_WIDTH = 1024;
+    const int GLYPH_PADDING = 1;
+
+    const SDL_Color COLORS[GlyphAtlas::COLOR_COUNT] = {
+        { 255, 255, 255, 255 },
+        { 255, 0, 0, 255 },
+    };
+}
+
+std::map<int, std::shared_ptr<GlyphAtlas>> GlyphAtlas::s_atlases;
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::Get(int pointSize) {
+    if (esIsHeadless()) return nullptr;
+    auto it = s_atlases.find(pointSize);
+    if (it != s_atlases.end()) return it->second;
+
+    std::shared_ptr<GlyphAtlas> atlas = std::make_shared<GlyphAtlas>();
+    if (!atlas->Build(pointSize)) {
+        atlas.reset();
+    }
+    // Failures are cached too, so a missing font is reported once
+    s_atlases[pointSize] = atlas;
+    return atlas;
+}
+
+void GlyphAtlas::ReleaseAll() {
+    s_atlases.clear();
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::Find(char c, Color color) const {
+    if (c < FIRST_CHAR || c > LAST_CHAR || color < 0 || color >= COLOR_COUNT) return nullptr;
+    return &m_glyphs[color][c - FIRST_CHAR];
+}
+
+bool GlyphAtlas::Build(int pointSize) {
+    if (TTF_WasInit() == 0) {
+        TTF_Init();
+    }
+    TTF_Font* font = TTF_OpenFont(HUD_FONT_PATH, pointSize);
+    if (!font) {
+        std::cout << "Failed to load HUD font: " << TTF_GetError() << std::endl;
+        return false;
+    }
+    TTF_SetFontHinting(font, TTF_HINTING_NONE);
+    TTF_SetFontStyle(font, TTF_STYLE_NORMAL);
+
+    // Each glyph is rendered as a one-character string so its cell matches the
+    // texture TTF_RenderUTF8_Blended would produce for that character alone
+    const int glyphCount = LAST_CHAR - FIRST_CHAR + 1;
+    SDL_Surface* surfaces[COLOR_COUNT][glyphCount];
+    memset(surfaces, 0, sizeof(surfaces));
+    int x = GLYPH_PADDING, y = GLYPH_PADDING, rowHeight = 0;
+    int placeX[COLOR_COUNT][glyphCount], placeY[COLOR_COUNT][glyphCount];
+    for (int color = 0; color < COLOR_COUNT; ++color) {
+        for (int i = 0; i < glyphCount; ++i) {
+            const char text[2] = { (char)(FIRST_CHAR + i), '\0' };
+            SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, COLORS[color]);
+            surfaces[color][i] = surf;
+            if (!surf) continue;
+            if (x + surf->w + GLYPH_PADDING > ATLAS_WIDTH) {
+                x = GLYPH_PADDING;
+                y += rowHeight + GLYPH_PADDING;
+                rowHeight = 0;
+            }
+            placeX[color][i] = x;
+            placeY[color][i] = y;
+            x += surf->w + GLYPH_PADDING;
+            rowHeight = std::max(rowHeight, surf->h);
+        }
+    }
+    TTF_CloseFont(font);
+
+    int height = 1;
+    while (height < y + rowHeight + GLYPH_PADDING) height <<= 1;
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 0, 0, 0, 0));
+    }
+
+    memset(m_glyphs, 0, sizeof(m_glyphs));
+    for (int color = 0; color < COLOR_COUNT; ++color) {
+        for (int i = 0; i < glyphCount; ++i) {
+            SDL_Surface* surf = surfaces[color][i];
+            if (!surf) continue;
+            if (atlas) {
+                // Copy alpha as-is instead of blending onto the transparent atlas
+                SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE);
+                SDL_Rect dst = { placeX[color][i], placeY[color][i], surf->w, surf->h };
+                SDL_BlitSurface(surf, nullptr, atlas, &dst);
+            }
+            Glyph& glyph = m_glyphs[color][i];
+            glyph.width = surf->w;
+            glyph.height = surf->h;
+            glyph.u0 = (float)placeX[color][i] / ATLAS_WIDTH;
+            glyph.v0 = (float)placeY[color][i] / height;
+            glyph.u1 = (float)(placeX[color][i] + surf->w) / ATLAS_WIDTH;
+            glyph.v1 = (float)(placeY[color][i] + surf->h) / height;
+            SDL_FreeSurface(surf);
+        }
+    }
+    if (!atlas) {
+        std::cout << "Failed to create glyph atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    m_texture = std::make_shared<Texture2D>();
+    const bool loaded = m_texture->LoadFromSDLSurface(atlas);
+    SDL_FreeSurface(atlas);
+    if (!loaded) {
+        m_texture.reset();
+        return false;
+    }
+    m_texture->SetSharpFiltering();
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <map>
+#include <memory>
+
+class Texture2D;
+
+// Every printable ASCII glyph of the HUD font, rasterized once per point size
+// and per colour into a single texture. Text is drawn by pointing quads at a
+// glyph's UVs, so changing a number on screen never touches the font or GL.
+class GlyphAtlas {
+public:
+    enum Color {
+        WHITE,
+        RED,
+        COLOR_COUNT,
+    };
+
+    struct Glyph {
+        // Atlas UVs with v growing downwards, as in Sprite2D
+        float u0, v0, u1, v1;
+        int width, height;
+    };
+
+    static const char FIRST_CHAR = 32;
+    static const char LAST_CHAR = 126;
+
+    // Built on first use and shared afterwards; nullptr when headless or the font is missing
+    static std::shared_ptr<GlyphAtlas> Get(int pointSize);
+    // Drops every atlas; call while the GL context is still current
+    static void ReleaseAll();
+
+    // nullptr for characters outside FIRST_CHAR..LAST_CHAR
+    const Glyph* Find(char c, Color color = WHITE) const;
+    const std::shared_ptr<Texture2D>& GetTexture() const { return m_texture; }
+
+private:
+    bool Build(int pointSize);
+
+    static std::map<int, std::shared_ptr<GlyphAtlas>> s_atlases;
+
+    Glyph m_glyphs[COLOR_COUNT][LAST_CHAR - FIRST_CHAR + 1];
+    std::shared_ptr<Texture2D> m_texture;
+};
@@ -1,88 +1,86 @@
 #include "stdafx.h"
 #include "InputManager.h"
+#include "../GameManager/MatchContext.h"
 #include <iostream>
 
-InputManager* InputManager::s_instance = nullptr;
-
 InputManager* InputManager::GetInstance() {
-    if (!s_instance) {
-        s_instance = new InputManager();
+    InputManager*& instance = MatchContext::Current().m_inputManager;
+    if (!instance) {
+        instance = new InputManager();
     }
-    return s_instance;
+    return instance;
 }
 
 void InputManager::DestroyInstance() {
-    if (s_instance) {
-        delete s_instance;
-        s_instance = nullptr;
+    InputManager*& instance = MatchContext::Current().m_inputManager;
+    if (instance) {
+        delete instance;
+        instance = nullptr;
     }
 }
 
-InputManager::InputManager() {
-    for (int i = 0; i < 512; i++) {
-        m_keyStates[i] = false;
-        m_keyPressed[i] = false;
+KeyStates::KeyStates() {
+    for (int i = 0; i < KEY_COUNT; i++) {
+        m_pressTime[i] = -1.0;
     }
 }
 
-InputManager::~InputManager() {
+InputManager::InputManager() : m_queueHead(0), m_queueTail(0) {
 }
 
-void InputManager::UpdateKeyState(unsigned char key, bool pressed) {
-    if (pressed && !m_keyStates[key]) {
-        m_keyPressed[key] = true;
-    }
-    m_keyStates[key] = pressed;
+InputManager::~InputManager() {
 }
 
-void InputManager::UpdateKeyState(int key, bool pressed) {
-    if (key >= 0 && key < 512) {
-        if (pressed && !m_keyStates[key]) {
-            m_keyPressed[key] = true;
+void InputManager::ApplyEvent(const InputEvent& e) {
+    if (e.pressed) {
+        if (!m_keys.m_down[e.key]) {
+            m_justPressed[e.key] = true;
+            m_keys.m_pressTime[e.key] = e.time;
         }
-        m_keyStates[key] = pressed;
+        m_keys.m_down[e.key] = true;
+    } else {
+        m_keys.m_down[e.key] = false;
     }
 }
 
-bool InputManager::IsKeyPressed(unsigned char key) const {
-    return m_keyStates[key];
-}
+void InputManager::QueueKeyEvent(int key, bool pressed, double time) {
+    if (key < 0 || key >= KeyStates::KEY_COUNT) return;
 
-bool InputManager::IsKeyPressed(int key) const {
-    if (key >= 0 && key < 512) {
-        return m_keyStates[key];
+    if (m_queueTail - m_queueHead == (uint32_t)QUEUE_CAPACITY) {
+        // Full: the oldest event can no longer wait for its tick
+        ApplyEvent(m_queue[m_queueHead & (QUEUE_CAPACITY - 1)]);
+        ++m_queueHead;
     }
-    return false;
-}
-
-bool InputManager::IsKeyJustPressed(unsigned char key) const {
-    return m_keyPressed[key];
+    InputEvent& e = m_queue[m_queueTail & (QUEUE_CAPACITY - 1)];
+    e.time = time;
+    e.key = (uint8_t)key;
+    e.pressed = pressed;
+    ++m_queueTail;
 }
 
-bool InputManager::IsKeyJustPressed(int key) const {
-    if (key >= 0 && key < 512) {
-        return m_keyPressed[key];
+void InputManager::BeginTick(double deadline) {
+    m_justPressed.reset();
+    while (m_queueHead != m_queueTail) {
+        const InputEvent& e = m_queue[m_queueHead & (QUEUE_CAPACITY - 1)];
+        if (e.time > deadline) break;
+        if (!e.pressed && m_justPressed[e.key]) break;
+        ApplyEvent(e);
+        ++m_queueHead;
     }
-    return false;
 }
 
-bool InputManager::IsKeyReleased(unsigned char key) const {
-    return !m_keyStates[key];
+void InputManager::ClearQueue() {
+    m_queueHead = m_queueTail;
 }
 
-bool InputManager::IsKeyReleased(int key) const {
-    if (key >= 0 && key < 512) {
-        return !m_keyStates[key];
-    }
-    return true;
+bool InputManager::IsKeyPressed(int key) const {
+    return m_keys[key];
 }
 
-const bool* InputManager::GetKeyStates() const {
-    return m_keyStates;
+bool InputManager::IsKeyJustPressed(int key) const {
+    return key >= 0 && key < KeyStates::KEY_COUNT && m_justPressed[key];
 }
 
-void InputManager::Update() {
-    for (int i = 0; i < 512; i++) {
-        m_keyPressed[i] = false;
-    }
-} 
\ No newline at end of file
+bool InputManager::IsKeyReleased(int key) const {
+    return !m_keys[key];
+}
@@ -1,31 +1,72 @@
 #pragma once
 #include <vector>
+#include <bitset>
+#include <cstdint>
 
 class Character;
 
+// Held-key snapshot for one simulation tick, indexable like the old bool array
+class KeyStates {
+public:
+    static const int KEY_COUNT = 256;
+
+    KeyStates();
+
+    bool operator[](int key) const { return key >= 0 && key < KEY_COUNT && m_down[key]; }
+    // Simulation time (seconds) of the key's most recent press
+    double GetPressTime(int key) const { return (key >= 0 && key < KEY_COUNT) ? m_pressTime[key] : -1.0; }
+
+private:
+    friend class InputManager;
+
+    std::bitset<KEY_COUNT> m_down;
+    double m_pressTime[KEY_COUNT];
+};
+
+struct InputEvent {
+    double time;      // simulation time the event happened at
+    uint8_t key;
+    bool pressed;
+};
+
+// Key events are queued with their timestamp as the platform delivers them and
+// applied in order by BeginTick(), so each tick sees exactly the input that
+// happened up to its own time and a press/release inside one frame is not lost.
 class InputManager {
 private:
-    static InputManager* s_instance;
-    bool m_keyStates[512];
-    bool m_keyPressed[512];
+    static const int QUEUE_CAPACITY = 256;   // power of two
+
+    KeyStates m_keys;
+    std::bitset<KeyStates::KEY_COUNT> m_justPressed;
+
+    InputEvent m_queue[QUEUE_CAPACITY];
+    uint32_t m_queueHead;   // next event to consume
+    uint32_t m_queueTail;   // next free slot
 
     InputManager();
 
+    void ApplyEvent(const InputEvent& e);
+
 public:
     static InputManager* GetInstance();
     static void DestroyInstance();
     ~InputManager();
 
-    void UpdateKeyState(unsigned char key, bool pressed);
-    void UpdateKeyState(int key, bool pressed);
-    
-    bool IsKeyPressed(unsigned char key) const;
+    void QueueKeyEvent(int key, bool pressed, double time);
+    // Applies queued events stamped at or before deadline. A key released in the
+    // same tick it was pressed keeps its release queued for the next tick, so a
+    // tap always reaches the game for at least one tick.
+    void BeginTick(double deadline);
+    void ClearQueue();
+
     bool IsKeyPressed(int key) const;
-    bool IsKeyJustPressed(unsigned char key) const;
     bool IsKeyJustPressed(int key) const;
-    bool IsKeyReleased(unsigned char key) const;
     bool IsKeyReleased(int key) const;
-    
-    const bool* GetKeyStates() const;
-    void Update();
-}; 
\ No newline at end of file
+
+    const KeyStates& GetKeyStates() const { return m_keys; }
+    int GetQueuedCount() const { return (int)(m_queueTail - m_queueHead); }
+    // Running totals of events queued and applied; recordings use them to tell
+    // which tick consumed each event
+    uint32_t GetQueuedTotal() const { return m_queueTail; }
+    uint32_t GetAppliedTotal() const { return m_queueHead; }
+};
@@ -3,8 +3,10 @@
 #include "../../Utilities/TGA.h"
 #include <fstream>
 #include <sstream>
+#include <cstring>
 
 Model::Model() : vboId(0), iboId(0), textureId(0), vertexCount(0), indexCount(0) {
+    memset(uploadedUV, 0, sizeof(uploadedUV));
 }
 
 Model::~Model() {
@@ -77,6 +79,9 @@ bool Model::LoadFromNFG(const char* filename) {
 
 bool Model::LoadTexture(const char* filename) {
     int width, height, bpp;
+    if (esIsHeadless()) {
+        return LoadTGAInfo(filename, &width, &height, &bpp);
+    }
     char* textureData = LoadTGA(filename, &width, &height, &bpp);
 
     if (!textureData) {
@@ -106,7 +111,11 @@ void Model::CreateBuffers() {
 
     vertexCount = (int)vertices.size();
     indexCount = (int)indices.size();
+    if (esIsHeadless()) {
+        return;
+    }
 
+    GetQuadUV(uploadedUV);
     glGenBuffers(1, &vboId);
     glBindBuffer(GL_ARRAY_BUFFER, vboId);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
@@ -118,7 +127,43 @@ void Model::CreateBuffers() {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-void Model::Draw() {
+bool Model::GetQuadUV(float* outUV) const {
+    if (vertices.size() < 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+        outUV[i * 2] = vertices[i].uv.x;
+        outUV[i * 2 + 1] = vertices[i].uv.y;
+    }
+    return true;
+}
+
+void Model::Draw(const float* quadUV) {
+    if (esIsHeadless()) {
+        return;
+    }
+    if (!vboId) {
+        CreateBuffers();
+    }
+    // The UVs come from the draw command rather than from vertices, which the
+    // simulation thread may be rewriting while a render thread draws
+    if (quadUV && vboId && memcmp(quadUV, uploadedUV, sizeof(uploadedUV)) != 0) {
+        Vertex quad[4];
+        for (int i = 0; i < 4; ++i) {
+            quad[i].pos.x = vertices[i].pos.x;
+            quad[i].pos.y = vertices[i].pos.y;
+            quad[i].pos.z = vertices[i].pos.z;
+            quad[i].color.x = vertices[i].color.x;
+            quad[i].color.y = vertices[i].color.y;
+            quad[i].color.z = vertices[i].color.z;
+            quad[i].uv.x = quadUV[i * 2];
+            quad[i].uv.y = quadUV[i * 2 + 1];
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, vboId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(quad), quad);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        memcpy(uploadedUV, quadUV, sizeof(uploadedUV));
+    }
     if (textureId) {
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, textureId);
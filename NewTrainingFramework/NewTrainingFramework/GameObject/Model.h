@@ -15,6 +15,7 @@ public:
     GLuint textureId;
     int vertexCount;
     int indexCount;
+    float uploadedUV[8];  // UVs of the first four vertices as last written to the VBO
     
     Model();
     ~Model();
@@ -22,6 +23,9 @@ public:
     bool LoadFromNFG(const char* filename);
     bool LoadTexture(const char* filename);
     void CreateBuffers();
-    void Draw();
+    // Copies the first four vertex UVs; false for models with fewer vertices
+    bool GetQuadUV(float* outUV) const;
+    // quadUV, when given, is uploaded over the first four vertices if it changed
+    void Draw(const float* quadUV = nullptr);
     void Cleanup();
 }; 
\ No newline at end of file
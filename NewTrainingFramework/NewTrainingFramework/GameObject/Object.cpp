@@ -4,31 +4,27 @@
 #include "Model.h"
 #include "Texture2D.h"
 #include "Shaders.h"
+#include "RenderPacket.h"
+#include "../GameManager/SimulationClock.h"
+#include "../GameManager/Snapshot.h"
 #include <SDL.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include <cstring>
 
 Object::Object() 
     : m_position(0.0f, 0.0f, 0.0f)
     , m_rotation(0.0f, 0.0f, 0.0f)
     , m_scale(1.0f, 1.0f, 1.0f)
     , m_matrixNeedsUpdate(true)
+    , m_prevX(0.0f), m_prevY(0.0f), m_prevZ(0.0f)
+    , m_interpolate(false)
     , m_modelId(-1)
     , m_shaderId(-1)
     , m_id(-1)
-    , m_autoRotate(false)
-    , m_rotationSpeed(30.0f)
-    , m_isLiftPlatform(false)
-    , m_liftStartPos(0.0f, 0.0f, 0.0f)
-    , m_liftEndPos(0.0f, 0.0f, 0.0f)
-    , m_liftSpeed(1.0f)
-    , m_liftProgress(0.0f)
-    , m_liftGoingUp(true)
-    , m_liftPauseTime(1.0f)
-    , m_liftPauseTimer(0.0f)
-    , m_visible(true) {
+    , m_visible(true)
+    , m_spriteMode(false)
+    , m_spriteFrame(-1)
+    , m_spriteFlags(0)
+    , m_revision(0) {
     m_worldMatrix.SetIdentity();
 }
 
@@ -37,20 +33,16 @@ Object::Object(int id)
     , m_rotation(0.0f, 0.0f, 0.0f)
     , m_scale(1.0f, 1.0f, 1.0f)
     , m_matrixNeedsUpdate(true)
+    , m_prevX(0.0f), m_prevY(0.0f), m_prevZ(0.0f)
+    , m_interpolate(false)
     , m_modelId(-1)
     , m_shaderId(-1)
     , m_id(id)
-    , m_autoRotate(false)
-    , m_rotationSpeed(30.0f)
-    , m_isLiftPlatform(false)
-    , m_liftStartPos(0.0f, 0.0f, 0.0f)
-    , m_liftEndPos(0.0f, 0.0f, 0.0f)
-    , m_liftSpeed(1.0f)
-    , m_liftProgress(0.0f)
-    , m_liftGoingUp(true)
-    , m_liftPauseTime(1.0f)
-    , m_liftPauseTimer(0.0f)
-    , m_visible(true) {
+    , m_visible(true)
+    , m_spriteMode(false)
+    , m_spriteFrame(-1)
+    , m_spriteFlags(0)
+    , m_revision(0) {
     m_worldMatrix.SetIdentity();
 }
 
@@ -58,24 +50,30 @@ Object::~Object() {
 }
 
 void Object::SetPosition(const Vector3& position) {
+    if (m_position.x == position.x && m_position.y == position.y && m_position.z == position.z) return;
     m_position.x = position.x;
     m_position.y = position.y;
     m_position.z = position.z;
     m_matrixNeedsUpdate = true;
+    ++m_revision;
 }
 
 void Object::SetRotation(const Vector3& rotation) {
+    if (m_rotation.x == rotation.x && m_rotation.y == rotation.y && m_rotation.z == rotation.z) return;
     m_rotation.x = rotation.x;
     m_rotation.y = rotation.y;
     m_rotation.z = rotation.z;
     m_matrixNeedsUpdate = true;
+    ++m_revision;
 }
 
 void Object::SetScale(const Vector3& scale) {
+    if (m_scale.x == scale.x && m_scale.y == scale.y && m_scale.z == scale.z) return;
     m_scale.x = scale.x;
     m_scale.y = scale.y;
     m_scale.z = scale.z;
     m_matrixNeedsUpdate = true;
+    ++m_revision;
 }
 
 void Object::SetPosition(float x, float y, float z) {
@@ -101,6 +99,50 @@ const Matrix& Object::GetWorldMatrix() {
     return m_worldMatrix;
 }
 
+void Object::SnapshotTransform() {
+    m_prevX = m_position.x;
+    m_prevY = m_position.y;
+    m_prevZ = m_position.z;
+    m_interpolate = true;
+}
+
+template <class Archive>
+void Object::TransferState(Archive& ar) {
+    ar(m_position);
+    ar(m_rotation);
+    ar(m_scale);
+    ar(m_prevX); ar(m_prevY); ar(m_prevZ);
+    ar(m_interpolate);
+    ar(m_visible);
+    ar(m_spriteMode);
+    ar(m_spriteFrame);
+    ar(m_spriteFlags);
+
+    // Resources are only re-cached when they differ from what the object already uses
+    int modelId = m_modelId;
+    int shaderId = m_shaderId;
+    ar(modelId);
+    ar(shaderId);
+    uint32_t textureCount = (uint32_t)m_textureIds.size();
+    ar(textureCount);
+    for (uint32_t i = 0; i < textureCount && ar.Ok(); ++i) {
+        int textureId = i < m_textureIds.size() ? m_textureIds[i] : -1;
+        ar(textureId);
+        if (Archive::IS_LOADING && (i >= m_textureIds.size() || m_textureIds[i] != textureId)) {
+            SetTexture(textureId, (int)i);
+        }
+    }
+    if (Archive::IS_LOADING) {
+        if (modelId != m_modelId) SetModel(modelId);
+        if (shaderId != m_shaderId) SetShader(shaderId);
+        m_matrixNeedsUpdate = true;
+        ++m_revision;
+    }
+}
+
+template void Object::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void Object::TransferState<SnapshotReader>(SnapshotReader&);
+
 void Object::UpdateWorldMatrix() {
     // Build world matrix: World = Translation × RotationZ × RotationY × RotationX × Scale
     Matrix translation, rotationX, rotationY, rotationZ, scale;
@@ -122,6 +164,7 @@ void Object::UpdateWorldMatrix() {
 void Object::SetModel(int modelId) {
     m_modelId = modelId;
     m_model = ResourceManager::GetInstance()->GetModel(modelId);
+    ++m_revision;
 }
 
 void Object::SetTexture(int textureId, int index) {
@@ -131,20 +174,23 @@ void Object::SetTexture(int textureId, int index) {
         m_textures.resize(index + 1, nullptr);
     }
     
+    if (m_textureIds[index] == textureId && m_textures[index]) return;
     m_textureIds[index] = textureId;
     auto texture = ResourceManager::GetInstance()->GetTexture(textureId);
     m_textures[index] = texture;
-    
+    ++m_revision;
 }
 
 void Object::AddTexture(int textureId) {
     m_textureIds.push_back(textureId);
     m_textures.push_back(ResourceManager::GetInstance()->GetTexture(textureId));
+    ++m_revision;
 }
 
 void Object::SetShader(int shaderId) {
     m_shaderId = shaderId;
     m_shader = ResourceManager::GetInstance()->GetShader(shaderId);
+    ++m_revision;
 }
 
 void Object::CacheResources() {
@@ -173,23 +219,28 @@ void Object::CacheResources() {
 
 void Object::RefreshResources() {
     CacheResources();
+    ++m_revision;
 }
 
 void Object::Draw(const Matrix& viewMatrix, const Matrix& projectionMatrix) {
     if (!m_visible) {
         return;
     }
-    if (!m_model || !m_shader) {
+    if (!m_model || !m_shader || esIsHeadless()) {
         return;
     }
-        
-    // Use shader
-    glUseProgram(m_shader->program);
     
     // Calculate MVP matrix step by step to avoid const reference issues
     const Matrix& worldMatrixRef = GetWorldMatrix();
     Matrix worldMatrix;
     worldMatrix = const_cast<Matrix&>(worldMatrixRef);
+    if (m_interpolate) {
+        // Translation is the last factor of the world matrix, so it sits alone in row 3
+        const float alpha = SimulationClock::Instance().GetAlpha();
+        worldMatrix.m[3][0] = m_prevX + (m_position.x - m_prevX) * alpha;
+        worldMatrix.m[3][1] = m_prevY + (m_position.y - m_prevY) * alpha;
+        worldMatrix.m[3][2] = m_prevZ + (m_position.z - m_prevZ) * alpha;
+    }
     Matrix viewMatrixCopy;
     viewMatrixCopy = const_cast<Matrix&>(viewMatrix);
     Matrix projMatrixCopy;
@@ -197,148 +248,70 @@ void Object::Draw(const Matrix& viewMatrix, const Matrix& projectionMatrix) {
     
     Matrix wvMatrix = worldMatrix * viewMatrixCopy;
     Matrix mvpMatrix = wvMatrix * projMatrixCopy;
-    
-    // Set MVP uniform
-    GLint mvpLocation = glGetUniformLocation(m_shader->program, "u_mvpMatrix");
-    if (mvpLocation != -1) {
-        glUniformMatrix4fv(mvpLocation, 1, GL_FALSE, &mvpMatrix.m[0][0]);
-    }
-    // Optional uniforms for glint shader
-    GLint timeLoc = glGetUniformLocation(m_shader->program, "u_time");
-    if (timeLoc != -1) {
-        float t = SDL_GetTicks() / 1000.0f;
-        glUniform1f(timeLoc, t);
-    }
-    GLint dirLoc = glGetUniformLocation(m_shader->program, "u_glintDir");
-    if (dirLoc != -1) {
-        glUniform2f(dirLoc, 0.7071f, -0.7071f);
-    }
-    GLint widthLoc = glGetUniformLocation(m_shader->program, "u_glintWidth");
-    if (widthLoc != -1) {
-        glUniform1f(widthLoc, 0.16f);
-    }
-    GLint speedLoc = glGetUniformLocation(m_shader->program, "u_glintSpeed");
-    if (speedLoc != -1) {
-        glUniform1f(speedLoc, 0.9f);
-    }
-    GLint intensityLoc = glGetUniformLocation(m_shader->program, "u_glintIntensity");
-    if (intensityLoc != -1) {
-        glUniform1f(intensityLoc, 1.0f);
-    }
-    
-    // Bind textures
-    bool hasValidTexture = false;
-    for (int i = 0; i < (int)m_textures.size(); ++i) {
-        if (m_textures[i]) {
-            m_textures[i]->Bind(i);
-            
-            // Set texture uniform (assume u_texture for first texture)
-            if (i == 0) {
-                GLint textureLocation = glGetUniformLocation(m_shader->program, "u_texture");
-                if (textureLocation != -1) {
-                    glUniform1i(textureLocation, i);
-                }
-                hasValidTexture = true;
-            }
-        }
+
+    RenderPacket::DrawCommand command;
+    command.model = m_model;
+    command.shader = m_shader;
+    command.textureCount = std::min((int)m_textures.size(), (int)RenderPacket::MAX_TEXTURES);
+    for (int i = 0; i < command.textureCount; ++i) {
+        command.textures[i] = m_textures[i];
     }
-    
-    // Removed fallback binding to texture ID 0 to avoid masking missing textures
-    // if (!hasValidTexture) {
-    //     auto fallbackTexture = ResourceManager::GetInstance()->GetTexture(0);
-    //     if (fallbackTexture) {
-    //         fallbackTexture->Bind(0);
-    //         GLint textureLocation = glGetUniformLocation(m_shader->program, "u_texture");
-    //         if (textureLocation != -1) {
-    //             glUniform1i(textureLocation, 0);
-    //         }
-    //     }
-    // }
-    
-    // Draw model
-    m_model->Draw();
-    
-    // Unbind textures
-    for (int i = 0; i < (int)m_textures.size(); ++i) {
-        if (m_textures[i]) {
-            glActiveTexture(GL_TEXTURE0 + i);
-            glBindTexture(GL_TEXTURE_2D, 0);
-        }
+    memcpy(command.mvp, &mvpMatrix.m[0][0], sizeof(command.mvp));
+    if (command.textureCount > 0 && m_textures[0]) {
+        command.alphaClass = m_textures[0]->GetAlphaClass();
     }
-}
-
-void Object::Update(float deltaTime) {
-    // Auto-rotation logic
-    if (m_autoRotate) {
-        float radiansPerSecond = m_rotationSpeed * (float)M_PI / 180.0f;
-        
-        // Rotate around Y axis (vertical rotation)
-        m_rotation.y += radiansPerSecond * deltaTime;
-        
-        // Keep rotation in [0, 2π] range
-        if (m_rotation.y > 2.0f * (float)M_PI) {
-            m_rotation.y -= 2.0f * (float)M_PI;
-        }
-        
-        m_matrixNeedsUpdate = true;
+    if (command.textureCount > 0 && m_textures[0] && m_textures[0]->IsPacked()) {
+        command.layer = m_textures[0]->GetLayer();
+        memcpy(command.packedRect, m_textures[0]->GetPackedRect(), sizeof(command.packedRect));
     }
-    
-    // Lift platform logic
-    if (m_isLiftPlatform) {
-        // Check if we're in pause state
-        if (m_liftPauseTimer > 0.0f) {
-            m_liftPauseTimer -= deltaTime;
-            return; // Don't move during pause
+    if (m_spriteMode) {
+        const Texture2D* sheet = m_textures.empty() ? nullptr : m_textures[0].get();
+        int columns = 1, rows = 1, frame = 0;
+        if (m_spriteFrame >= 0 && sheet && sheet->GetSheetColumns() > 0 && sheet->GetSheetRows() > 0) {
+            columns = sheet->GetSheetColumns();
+            rows = sheet->GetSheetRows();
+            frame = std::min(m_spriteFrame, columns * rows - 1);
         }
-        
-        // Calculate movement
-        float distance = m_liftSpeed * deltaTime;
-        float totalDistance = Vector3::Distance(m_liftStartPos, m_liftEndPos);
-        
-        if (m_liftGoingUp) {
-            m_liftProgress += distance / totalDistance;
-            if (m_liftProgress >= 1.0f) {
-                m_liftProgress = 1.0f;
-                m_liftGoingUp = false;
-                m_liftPauseTimer = m_liftPauseTime; // Start pause at top
-            }
-        } else {
-            m_liftProgress -= distance / totalDistance;
-            if (m_liftProgress <= 0.0f) {
-                m_liftProgress = 0.0f;
-                m_liftGoingUp = true;
-                m_liftPauseTimer = m_liftPauseTime; // Start pause at bottom
+        command.sheet[0] = columns;
+        command.sheet[1] = rows;
+        command.sheet[2] = frame;
+        command.sheet[3] = m_spriteFlags;
+        if (const float* trim = (m_spriteFrame >= 0 && sheet) ? sheet->GetFrameTrim(frame) : nullptr) {
+            if (trim[2] <= trim[0] || trim[3] <= trim[1]) {
+                return;     // nothing visible in this frame
             }
+            memcpy(command.frameTrim, trim, sizeof(command.frameTrim));
         }
-        
-        // Interpolate position
-        m_position = Vector3::Lerp(m_liftStartPos, m_liftEndPos, m_liftProgress);
-        m_matrixNeedsUpdate = true;
+        command.hasQuadUV = false;
+    } else {
+        command.hasQuadUV = m_model->GetQuadUV(command.uv);
     }
-}
+    command.time = SDL_GetTicks() / 1000.0f;
 
-// Auto-rotation methods
-void Object::ToggleAutoRotation() {
-    m_autoRotate = !m_autoRotate;
+    RenderPacket::Issue(std::move(command));
 }
 
-void Object::SetAutoRotation(bool enabled, float speed) {
-    m_autoRotate = enabled;
-    m_rotationSpeed = speed;
-} 
-
 // Thêm hàm cập nhật UV động cho Sprite2D
 void Object::SetCustomUV(float u0, float v0, float u1, float v1) {
-    if (!m_model || m_model->vboId == 0) return;
+    if (!m_model || esIsHeadless()) return;
     if (m_model->vertices.size() < 4) return;
+    if (m_model->vertices[0].uv.x == u0 && m_model->vertices[0].uv.y == v0 &&
+        m_model->vertices[2].uv.x == u1 && m_model->vertices[2].uv.y == v1) return;
     // Đúng thứ tự đỉnh Sprite2D.nfg
     m_model->vertices[0].uv = Vector2(u0, v0); // bottom-left
     m_model->vertices[1].uv = Vector2(u0, v1); // top-left
     m_model->vertices[2].uv = Vector2(u1, v1); // top-right
     m_model->vertices[3].uv = Vector2(u1, v0); // bottom-right
-    glBindBuffer(GL_ARRAY_BUFFER, m_model->vboId);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * sizeof(Vertex), m_model->vertices.data());
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ++m_revision;
+    // No GL here: Draw records these UVs with the draw and Model::Draw uploads them
+}
+
+void Object::SetSpriteFrame(int frame, int flags) {
+    if (m_spriteMode && m_spriteFrame == frame && m_spriteFlags == flags) return;
+    m_spriteMode = true;
+    m_spriteFrame = frame;
+    m_spriteFlags = flags;
+    ++m_revision;
 }
 
 void Object::MakeModelInstanceCopy() {
@@ -348,30 +321,6 @@ void Object::MakeModelInstanceCopy() {
     cloned->indices = m_model->indices;
     cloned->vertexCount = m_model->vertexCount;
     cloned->indexCount = m_model->indexCount;
-    cloned->CreateBuffers();
+    // GPU buffers are created on first Draw, so pools may grow off the GL thread
     m_model = cloned;
 }
-
-// Lift platform methods
-void Object::SetLiftPlatform(bool enabled, const Vector3& startPos, const Vector3& endPos, 
-                            float speed, float pauseTime) {
-    m_isLiftPlatform = enabled;
-    if (enabled) {
-        m_liftStartPos = startPos;
-        m_liftEndPos = endPos;
-        m_liftSpeed = speed;
-        m_liftPauseTime = pauseTime;
-        m_liftProgress = 0.0f;
-        m_liftGoingUp = true;
-        m_liftPauseTimer = 0.0f;
-        
-        m_position = startPos;
-        m_matrixNeedsUpdate = true;
-
-    }
-}
-
-void Object::SetLiftPlatform(bool enabled, float startX, float startY, float startZ,
-                            float endX, float endY, float endZ, float speed, float pauseTime) {
-    SetLiftPlatform(enabled, Vector3(startX, startY, startZ), Vector3(endX, endY, endZ), speed, pauseTime);
-}
\ No newline at end of file
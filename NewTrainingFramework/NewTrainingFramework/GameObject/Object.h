@@ -2,6 +2,7 @@
 #include "../../Utilities/Math.h"
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 // Forward declarations
 class Model;
@@ -17,6 +18,10 @@ private:
     Vector3 m_scale;
     Matrix m_worldMatrix;
     bool m_matrixNeedsUpdate;
+
+    // Position at the start of the simulation tick; only used once SnapshotTransform() is called
+    float m_prevX, m_prevY, m_prevZ;
+    bool m_interpolate;
     
     // Resource references (IDs from ResourceManager)
     int m_modelId;
@@ -31,20 +36,14 @@ private:
     // Object ID for identification
     int m_id;
     bool m_visible;
-    
-    // Auto-rotation
-    bool m_autoRotate;
-    float m_rotationSpeed;  // degrees per second
-    
-    // Lift platform properties
-    bool m_isLiftPlatform;
-    Vector3 m_liftStartPos;
-    Vector3 m_liftEndPos;
-    float m_liftSpeed;      // units per second
-    float m_liftProgress;   // 0.0 to 1.0
-    bool m_liftGoingUp;     // true = going up, false = going down
-    float m_liftPauseTime;  // pause time at each end
-    float m_liftPauseTimer; // current pause timer
+
+    // Sprite sheet frame picked by the vertex shader (see SetSpriteFrame)
+    bool m_spriteMode;
+    int m_spriteFrame;
+    int m_spriteFlags;
+
+    // Bumped whenever something that affects how the object draws actually changes
+    uint32_t m_revision;
     
     void UpdateWorldMatrix();
     void CacheResources();
@@ -71,6 +70,15 @@ public:
     const Vector3& GetRotation() const { return m_rotation; }
     const Vector3& GetScale() const { return m_scale; }
     const Matrix& GetWorldMatrix();
+
+    // For objects moved by the simulation: call before moving them each tick,
+    // and again after a teleport. Draw() then blends from the snapshot by the
+    // simulation clock alpha.
+    void SnapshotTransform();
+
+    // Transform, visibility and resource ids for match snapshots (see Snapshot.h)
+    template <class Archive>
+    void TransferState(Archive& ar);
     
     // Resource assignment
     void SetModel(int modelId);
@@ -88,25 +96,15 @@ public:
     
     // Rendering
     void Draw(const Matrix& viewMatrix, const Matrix& projectionMatrix);
-    void Update(float deltaTime);
     
     // Visibility control
-    void SetVisible(bool visible) { m_visible = visible; }
+    void SetVisible(bool visible) {
+        if (m_visible != visible) { m_visible = visible; ++m_revision; }
+    }
     bool IsVisible() const { return m_visible; }
-    
-    // Auto-rotation
-    void ToggleAutoRotation();
-    void SetAutoRotation(bool enabled, float speed = 30.0f); // 30 degrees/sec default
-    bool IsAutoRotating() const { return m_autoRotate; }
-    
-    // Lift platform methods
-    void SetLiftPlatform(bool enabled, const Vector3& startPos, const Vector3& endPos, 
-                        float speed = 1.0f, float pauseTime = 1.0f);
-    void SetLiftPlatform(bool enabled, float startX, float startY, float startZ,
-                        float endX, float endY, float endZ, float speed = 1.0f, float pauseTime = 1.0f);
-    bool IsLiftPlatform() const { return m_isLiftPlatform; }
-    void SetLiftSpeed(float speed) { m_liftSpeed = speed; }
-    void SetLiftPauseTime(float pauseTime) { m_liftPauseTime = pauseTime; }
+
+    // Lets cached renderings (the HUD layer) tell whether the object changed since they drew it
+    uint32_t GetRevision() const { return m_revision; }
     
     // Resource management
     void RefreshResources();
@@ -118,11 +116,22 @@ public:
 
     // Thêm hàm public để gán texture động (dùng cho text)
     void SetDynamicTexture(std::shared_ptr<Texture2D> tex) {
+        if (m_textureIds.empty() && m_textures.size() == 1 && m_textures[0] == tex) return;
         m_textureIds.clear();
         m_textures.clear();
         m_textures.push_back(tex);
+        ++m_revision;
     }
 
     // Thêm hàm cập nhật UV động cho Sprite2D
     void SetCustomUV(float u0, float v0, float u1, float v1);
+
+    enum SpriteFlags {
+        SPRITE_FLIP_X = 1 << 0,
+        SPRITE_FLIP_Y = 1 << 1,
+    };
+    // Draws one cell of texture 0's sheet grid; the shader derives the UVs, so
+    // nothing is computed or uploaded per frame. A negative frame, or a texture
+    // without a grid, draws the whole texture.
+    void SetSpriteFrame(int frame, int flags = 0);
 }; 
\ No newline at end of file
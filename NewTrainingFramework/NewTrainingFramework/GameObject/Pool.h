@@ -0,0 +1,171 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <functional>
+#include <new>
+#include <cstdint>
+
+// Fixed-slot object pool. Slots live in contiguous chunks that never move, so
+// pointers returned by Get() stay valid until the pool is destroyed.
+// The initializer runs once when a slot is first constructed; acquire/release
+// hooks run on every reuse and should stay cheap (e.g. toggle visibility).
+template <typename T>
+class Pool {
+public:
+    typedef std::function<void(T&, int)> InitFunc;
+    typedef std::function<void(T&)> HookFunc;
+
+    explicit Pool(int chunkSize = 64)
+        : m_chunkSize(chunkSize > 0 ? chunkSize : 64)
+        , m_size(0)
+        , m_inUse(0)
+        , m_highWater(0) {
+    }
+
+    ~Pool() {
+        Destroy();
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    void SetInitializer(InitFunc init) { m_init = init; }
+    void SetAcquireHook(HookFunc hook) { m_onAcquire = hook; }
+    void SetReleaseHook(HookFunc hook) { m_onRelease = hook; }
+
+    // Constructs and initializes slots until at least capacity exist
+    void Prewarm(int capacity) {
+        while (m_size < capacity) {
+            int slot = Construct();
+            m_free.push_back(slot);
+        }
+    }
+
+    int Acquire() {
+        int slot;
+        if (!m_free.empty()) {
+            slot = m_free.back();
+            m_free.pop_back();
+        } else {
+            slot = Construct();
+        }
+        m_live[slot] = 1;
+        ++m_inUse;
+        if (m_inUse > m_highWater) m_highWater = m_inUse;
+        if (m_onAcquire) m_onAcquire(*Slot(slot));
+        return slot;
+    }
+
+    void Release(int slot) {
+        if (!IsInUse(slot)) return;
+        m_live[slot] = 0;
+        --m_inUse;
+        if (m_onRelease) m_onRelease(*Slot(slot));
+        m_free.push_back(slot);
+    }
+
+    void ReleaseAll() {
+        for (int i = 0; i < m_size; ++i) {
+            Release(i);
+        }
+    }
+
+    // Destroys every slot; the next Acquire/Prewarm re-runs the initializer
+    void Destroy() {
+        for (int i = 0; i < m_size; ++i) {
+            Slot(i)->~T();
+        }
+        m_chunks.clear();
+        m_live.clear();
+        m_free.clear();
+        m_size = 0;
+        m_inUse = 0;
+    }
+
+    T* Get(int slot) { return IsValid(slot) ? Slot(slot) : nullptr; }
+    const T* Get(int slot) const { return IsValid(slot) ? Slot(slot) : nullptr; }
+
+    bool IsValid(int slot) const { return slot >= 0 && slot < m_size; }
+    bool IsInUse(int slot) const { return IsValid(slot) && m_live[slot] != 0; }
+
+    // Snapshot support (see Snapshot.h): live flags, free list order and the
+    // state of every live slot through transferSlot(T&). Restoring into a pool
+    // that has grown since keeps the extra slots, free, in the order Construct()
+    // would have handed them out; slots whose live flag changes get the acquire
+    // or release hook. A live-flag count that does not match fails the archive.
+    template <class Archive, class SlotFunc>
+    void TransferState(Archive& ar, SlotFunc transferSlot) {
+        int size = m_size;
+        ar(size);
+        if (Archive::IS_LOADING) {
+            while (m_size < size) {
+                Construct();
+            }
+            m_scratchLive = m_live;
+            ar(m_live);
+            if ((int)m_live.size() != size) {
+                // Keep the pool as it was; the failed archive leaves the reads below untouched
+                m_live = m_scratchLive;
+                ar.Fail();
+            }
+            m_live.resize(m_size, 0);
+            for (int i = 0; i < m_size; ++i) {
+                if (m_scratchLive[i] && !m_live[i] && m_onRelease) m_onRelease(*Slot(i));
+                if (!m_scratchLive[i] && m_live[i] && m_onAcquire) m_onAcquire(*Slot(i));
+            }
+            ar(m_free);
+            if (ar.Ok()) {
+                m_free.insert(m_free.begin(), m_size - size, 0);
+                for (int i = 0; i < m_size - size; ++i) {
+                    m_free[i] = m_size - 1 - i;
+                }
+            }
+        } else {
+            ar(m_live);
+            ar(m_free);
+        }
+        ar(m_inUse);
+        ar(m_highWater);
+        for (int i = 0; i < size && i < m_size; ++i) {
+            if (m_live[i]) transferSlot(*Slot(i));
+        }
+    }
+
+    int Size() const { return m_size; }
+    int InUse() const { return m_inUse; }
+    int FreeCount() const { return (int)m_free.size(); }
+    int HighWaterMark() const { return m_highWater; }
+    void ResetHighWaterMark() { m_highWater = m_inUse; }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+    T* Slot(int slot) const {
+        Storage* chunk = m_chunks[slot / m_chunkSize].get();
+        return reinterpret_cast<T*>(&chunk[slot % m_chunkSize]);
+    }
+
+    int Construct() {
+        if (m_size == (int)m_chunks.size() * m_chunkSize) {
+            m_chunks.emplace_back(new Storage[m_chunkSize]);
+        }
+        int slot = m_size++;
+        T* obj = new (Slot(slot)) T();
+        m_live.push_back(0);
+        if (m_init) m_init(*obj, slot);
+        return slot;
+    }
+
+    int m_chunkSize;
+    std::vector<std::unique_ptr<Storage[]>> m_chunks;
+    std::vector<uint8_t> m_live;
+    std::vector<int> m_free;
+    std::vector<uint8_t> m_scratchLive;  // restore only: live flags before the restore
+    int m_size;
+    int m_inUse;
+    int m_highWater;
+
+    InitFunc m_init;
+    HookFunc m_onAcquire;
+    HookFunc m_onRelease;
+};
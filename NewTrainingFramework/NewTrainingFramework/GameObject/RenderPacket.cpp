@@ -0,0 +1,277 @@
+#include "stdafx.h"
+#include "RenderPacket.h"
+#include "Model.h"
+#include "Texture2D.h"
+#include "Shaders.h"
+#include "RenderTarget.h"
+#include <atomic>
+#include <iostream>
+
+namespace {
+    thread_local RenderPacket* t_recording = nullptr;
+    std::atomic<bool> s_depthPasses(true);
+    std::atomic<bool> s_overdrawView(false);
+
+    // Each fragment adds this much in the overdraw view: 8 of 255 per layer
+    const float OVERDRAW_STEP = 1.0f / 32.0f;
+    const int OVERDRAW_REPORT_FRAMES = 120;
+    const float CUTOUT_THRESHOLD = 0.5f;
+
+    bool IsTranslucent(const RenderPacket::DrawCommand& command) {
+        return command.premultiplied || command.alphaClass == Texture2D::ALPHA_TRANSLUCENT;
+    }
+}
+
+RenderPacket::RenderPacket() {
+    m_viewport[0] = m_viewport[1] = m_viewport[2] = m_viewport[3] = 0;
+    m_clearColor[0] = m_clearColor[1] = m_clearColor[2] = 0.0f;
+    m_clearColor[3] = 1.0f;
+}
+
+void RenderPacket::SetViewport(int x, int y, int width, int height) {
+    m_viewport[0] = x;
+    m_viewport[1] = y;
+    m_viewport[2] = width;
+    m_viewport[3] = height;
+}
+
+void RenderPacket::SetClearColor(float r, float g, float b, float a) {
+    m_clearColor[0] = r;
+    m_clearColor[1] = g;
+    m_clearColor[2] = b;
+    m_clearColor[3] = a;
+}
+
+void RenderPacket::Submit() const {
+    const bool depthPasses = s_depthPasses.load(std::memory_order_relaxed);
+    const bool overdraw = s_overdrawView.load(std::memory_order_relaxed);
+
+    glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]);
+    if (overdraw) {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    } else {
+        glClearColor(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]);
+    }
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Render targets go first, in recorded order: they have no depth buffer,
+    // and their textures are then ready for the screen draws that sample them
+    m_screenDraws.clear();
+    int targetDepth = 0;
+    for (const DrawCommand& command : m_commands) {
+        if (command.kind == BEGIN_TARGET) ++targetDepth;
+        if (targetDepth > 0) {
+            Execute(command);
+        } else {
+            m_screenDraws.push_back(&command);
+        }
+        if (command.kind == END_TARGET) --targetDepth;
+    }
+
+    const int count = (int)m_screenDraws.size();
+    if (overdraw) {
+        glBlendFunc(GL_ONE, GL_ONE);
+    }
+    if (!depthPasses) {
+        for (const DrawCommand* command : m_screenDraws) {
+            Execute(*command, 0.0f, 0.0f, overdraw);
+        }
+    } else {
+        // Later draws sit nearer, spread evenly inside the clip range
+        const float depthStep = 2.0f / (count + 1);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+
+        glDepthMask(GL_TRUE);
+        if (!overdraw) {
+            glDisable(GL_BLEND);
+        }
+        for (int i = count - 1; i >= 0; --i) {
+            const DrawCommand& command = *m_screenDraws[i];
+            if (IsTranslucent(command)) continue;
+            const float cutoff = command.alphaClass == Texture2D::ALPHA_CUTOUT ? CUTOUT_THRESHOLD : 0.0f;
+            Execute(command, 1.0f - (i + 1) * depthStep, cutoff, overdraw);
+        }
+
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        for (int i = 0; i < count; ++i) {
+            const DrawCommand& command = *m_screenDraws[i];
+            if (!IsTranslucent(command)) continue;
+            Execute(command, 1.0f - (i + 1) * depthStep, 0.0f, overdraw);
+        }
+
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+    }
+    if (overdraw) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        ReportOverdraw();
+    }
+}
+
+void RenderPacket::ReportOverdraw() const {
+    static int s_frames = 0;
+    if (++s_frames < OVERDRAW_REPORT_FRAMES) return;
+    s_frames = 0;
+
+    const int width = m_viewport[2], height = m_viewport[3];
+    if (width <= 0 || height <= 0) return;
+    std::vector<unsigned char> pixels((size_t)width * height * 4);
+    glReadPixels(m_viewport[0], m_viewport[1], width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    double layers = 0.0;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        layers += pixels[i] / (255.0 * OVERDRAW_STEP);
+    }
+    std::cout << "[Overdraw] " << layers / ((double)width * height) << " fragments per pixel, depth passes "
+              << (s_depthPasses.load() ? "on" : "off") << std::endl;
+}
+
+void RenderPacket::Execute(const DrawCommand& command, float depth, float alphaCutoff, bool overdraw) {
+    if (command.kind == BEGIN_TARGET) {
+        command.target->Begin();
+        return;
+    }
+    if (command.kind == END_TARGET) {
+        command.target->End();
+        return;
+    }
+
+    const GLuint program = command.shader->program;
+    glUseProgram(program);
+
+    GLint mvpLocation = glGetUniformLocation(program, "u_mvpMatrix");
+    if (mvpLocation != -1) {
+        glUniformMatrix4fv(mvpLocation, 1, GL_FALSE, command.mvp);
+    }
+    GLint sheetLoc = glGetUniformLocation(program, "u_sheet");
+    if (sheetLoc != -1) {
+        glUniform4iv(sheetLoc, 1, command.sheet);
+    }
+    GLint depthLoc = glGetUniformLocation(program, "u_depth");
+    if (depthLoc != -1) {
+        glUniform1f(depthLoc, depth);
+    }
+    GLint cutoffLoc = glGetUniformLocation(program, "u_alphaCutoff");
+    if (cutoffLoc != -1) {
+        glUniform1f(cutoffLoc, alphaCutoff);
+    }
+    GLint overdrawLoc = glGetUniformLocation(program, "u_overdraw");
+    if (overdrawLoc != -1) {
+        glUniform1f(overdrawLoc, overdraw ? OVERDRAW_STEP : 0.0f);
+    }
+    GLint trimLoc = glGetUniformLocation(program, "u_frameTrim");
+    if (trimLoc != -1) {
+        glUniform4fv(trimLoc, 1, command.frameTrim);
+    }
+    GLint layerLoc = glGetUniformLocation(program, "u_layer");
+    if (layerLoc != -1) {
+        glUniform1i(layerLoc, command.layer);
+    }
+    GLint packedRectLoc = glGetUniformLocation(program, "u_packedRect");
+    if (packedRectLoc != -1) {
+        glUniform4fv(packedRectLoc, 1, command.packedRect);
+    }
+    GLint arrayLoc = glGetUniformLocation(program, "u_textureArray");
+    if (arrayLoc != -1) {
+        glUniform1i(arrayLoc, ARRAY_TEXTURE_UNIT);
+    }
+    // Optional uniforms for glint shader
+    GLint timeLoc = glGetUniformLocation(program, "u_time");
+    if (timeLoc != -1) {
+        glUniform1f(timeLoc, command.time);
+    }
+    GLint dirLoc = glGetUniformLocation(program, "u_glintDir");
+    if (dirLoc != -1) {
+        glUniform2f(dirLoc, 0.7071f, -0.7071f);
+    }
+    GLint widthLoc = glGetUniformLocation(program, "u_glintWidth");
+    if (widthLoc != -1) {
+        glUniform1f(widthLoc, 0.16f);
+    }
+    GLint speedLoc = glGetUniformLocation(program, "u_glintSpeed");
+    if (speedLoc != -1) {
+        glUniform1f(speedLoc, 0.9f);
+    }
+    GLint intensityLoc = glGetUniformLocation(program, "u_glintIntensity");
+    if (intensityLoc != -1) {
+        glUniform1f(intensityLoc, 1.0f);
+    }
+
+    for (int i = 0; i < command.textureCount; ++i) {
+        if (command.textures[i]) {
+            const bool layered = i == 0 && command.layer >= 0;
+            command.textures[i]->Bind(layered ? ARRAY_TEXTURE_UNIT : i);
+            if (i == 0 && !layered) {
+                GLint textureLocation = glGetUniformLocation(program, "u_texture");
+                if (textureLocation != -1) {
+                    glUniform1i(textureLocation, i);
+                }
+            }
+        }
+    }
+
+    const bool premultiplied = command.premultiplied && !overdraw;
+    if (premultiplied) {
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    command.model->Draw(command.hasQuadUV ? command.uv : nullptr);
+    if (premultiplied) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    for (int i = 0; i < command.textureCount; ++i) {
+        if (command.textures[i]) {
+            const bool layered = i == 0 && command.layer >= 0;
+            glActiveTexture(GL_TEXTURE0 + (layered ? ARRAY_TEXTURE_UNIT : i));
+            glBindTexture(command.textures[i]->GetTarget(), 0);
+        }
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void RenderPacket::Issue(DrawCommand&& command) {
+    if (RenderPacket* packet = Recording()) {
+        packet->Add(std::move(command));
+    } else {
+        Execute(command);
+    }
+}
+
+void RenderPacket::BeginTarget(const std::shared_ptr<RenderTarget>& target) {
+    DrawCommand command;
+    command.kind = BEGIN_TARGET;
+    command.target = target;
+    Issue(std::move(command));
+}
+
+void RenderPacket::EndTarget(const std::shared_ptr<RenderTarget>& target) {
+    DrawCommand command;
+    command.kind = END_TARGET;
+    command.target = target;
+    Issue(std::move(command));
+}
+
+RenderPacket* RenderPacket::Recording() {
+    return t_recording;
+}
+
+void RenderPacket::SetRecording(RenderPacket* packet) {
+    t_recording = packet;
+}
+
+void RenderPacket::SetDepthPasses(bool enabled) {
+    s_depthPasses.store(enabled);
+}
+
+bool RenderPacket::GetDepthPasses() {
+    return s_depthPasses.load();
+}
+
+void RenderPacket::SetOverdrawView(bool enabled) {
+    s_overdrawView.store(enabled);
+}
+
+bool RenderPacket::GetOverdrawView() {
+    return s_overdrawView.load();
+}
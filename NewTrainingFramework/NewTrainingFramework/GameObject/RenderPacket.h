@@ -0,0 +1,90 @@
+#pragma once
+#include "Texture2D.h"
+#include <memory>
+#include <vector>
+
+class Model;
+class Shaders;
+class RenderTarget;
+
+// One frame of draw calls captured on the simulation thread. While a packet is
+// recording on the calling thread, Object::Draw appends a command instead of
+// touching GL; Submit() later replays the commands in order on the thread that
+// owns the GL context. Commands hold shared references, so every model, shader
+// and texture they draw (HUD text included) stays alive until the packet is cleared.
+//
+// Screen draws are submitted in two passes: opaque and cutout commands nearest
+// first with depth writes and blending off, then translucent ones in recorded
+// order over that depth. Depth comes from the recorded order, so the picture
+// matches drawing everything back to front.
+class RenderPacket {
+public:
+    static const int MAX_TEXTURES = 4;
+    // u_textureArray samples this unit, so it never shares one with a sampler2D
+    static const int ARRAY_TEXTURE_UNIT = MAX_TEXTURES;
+
+    enum CommandKind {
+        DRAW,
+        BEGIN_TARGET,   // following draws go into target until END_TARGET
+        END_TARGET,
+    };
+
+    struct DrawCommand {
+        CommandKind kind = DRAW;
+        std::shared_ptr<RenderTarget> target;   // BEGIN_TARGET / END_TARGET only
+        std::shared_ptr<Model> model;
+        std::shared_ptr<Shaders> shader;
+        std::shared_ptr<Texture2D> textures[MAX_TEXTURES];
+        int textureCount;
+        float mvp[16];
+        float uv[8];      // first four vertex UVs at record time
+        bool hasQuadUV;
+        int sheet[4] = { 1, 1, -1, 0 };   // u_sheet: columns, rows, frame (-1: model UVs), flip bits
+        float frameTrim[4] = { 0.0f, 0.0f, 1.0f, 1.0f };   // u_frameTrim: visible part of the sheet cell
+        int layer = -1;   // u_layer: array layer of texture 0, -1 when it is a plain texture
+        float packedRect[4] = { 0.0f, 0.0f, 1.0f, 1.0f };   // u_packedRect: texture 0's offset and scale inside its page or layer
+        float time;       // u_time for animated shaders
+        bool premultiplied = false;   // texture colour is already multiplied by alpha
+        Texture2D::AlphaClass alphaClass = Texture2D::ALPHA_TRANSLUCENT;   // texture 0's; picks the pass
+    };
+
+    RenderPacket();
+
+    void SetViewport(int x, int y, int width, int height);
+    void SetClearColor(float r, float g, float b, float a);
+    void Add(DrawCommand&& command) { m_commands.push_back(std::move(command)); }
+    // Drops the commands and the resource references they hold
+    void Clear() { m_commands.clear(); }
+    int Size() const { return (int)m_commands.size(); }
+
+    // Clears the viewport and issues every command
+    void Submit() const;
+    // Issues a single draw on the current GL context. depth is the NDC depth
+    // the screen passes assign; fragments below alphaCutoff are discarded;
+    // overdraw writes the overdraw view's constant instead of the texture.
+    static void Execute(const DrawCommand& command, float depth = 0.0f, float alphaCutoff = 0.0f, bool overdraw = false);
+    // Records into the packet recording on this thread, or executes right away
+    static void Issue(DrawCommand&& command);
+    static void BeginTarget(const std::shared_ptr<RenderTarget>& target);
+    static void EndTarget(const std::shared_ptr<RenderTarget>& target);
+
+    // Packet that Object::Draw records into on this thread, nullptr to draw immediately
+    static RenderPacket* Recording();
+    static void SetRecording(RenderPacket* packet);
+
+    // Debug switches read by Submit(), safe to flip from the simulation thread.
+    // With depth passes off everything blends back to front as before; the
+    // overdraw view shows how many fragments each pixel received and logs the average.
+    static void SetDepthPasses(bool enabled);
+    static bool GetDepthPasses();
+    static void SetOverdrawView(bool enabled);
+    static bool GetOverdrawView();
+
+private:
+    void ReportOverdraw() const;
+
+    std::vector<DrawCommand> m_commands;
+    mutable std::vector<const DrawCommand*> m_screenDraws;   // Submit() scratch
+    int m_viewport[4];
+    float m_clearColor[4];
+};
@@ -0,0 +1,59 @@
+#include "stdafx.h"
+#include "RenderTarget.h"
+#include "Texture2D.h"
+#include <iostream>
+
+RenderTarget::RenderTarget()
+    : m_width(0), m_height(0), m_framebuffer(0), m_attachedTexture(0), m_active(false) {
+    m_savedViewport[0] = m_savedViewport[1] = m_savedViewport[2] = m_savedViewport[3] = 0;
+    m_savedClearColor[0] = m_savedClearColor[1] = m_savedClearColor[2] = m_savedClearColor[3] = 0.0f;
+}
+
+RenderTarget::~RenderTarget() {
+    if (m_framebuffer) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+}
+
+bool RenderTarget::Resize(int width, int height) {
+    if (m_texture && width == m_width && height == m_height) return false;
+    std::shared_ptr<Texture2D> texture = std::make_shared<Texture2D>();
+    if (!texture->CreateRenderTexture(width, height)) return false;
+    m_texture = texture;
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void RenderTarget::Begin() {
+    if (!m_texture || !m_texture->GetTextureId()) return;
+    if (!m_framebuffer) {
+        glGenFramebuffers(1, &m_framebuffer);
+    }
+    glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, m_savedClearColor);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    if (m_attachedTexture != m_texture->GetTextureId()) {
+        m_attachedTexture = m_texture->GetTextureId();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_attachedTexture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cout << "[RenderTarget] framebuffer incomplete at " << m_width << "x" << m_height << std::endl;
+        }
+    }
+    glViewport(0, 0, m_width, m_height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    // Keeps colour premultiplied and accumulates coverage in alpha
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    m_active = true;
+}
+
+void RenderTarget::End() {
+    if (!m_active) return;
+    m_active = false;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+    glClearColor(m_savedClearColor[0], m_savedClearColor[1], m_savedClearColor[2], m_savedClearColor[3]);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
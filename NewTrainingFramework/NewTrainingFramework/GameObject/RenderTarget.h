@@ -0,0 +1,41 @@
+#pragma once
+#include "../../Utilities/utilities.h"
+#include <memory>
+
+class Texture2D;
+
+// Offscreen colour buffer that drawing can be redirected into and that is later
+// sampled as an ordinary texture. The texture is created by Resize() on any
+// context sharing objects with the renderer; the framebuffer, which contexts do
+// not share, is created by Begin() on the thread that submits GL. Contents are
+// premultiplied by alpha, so composite them with DrawCommand::premultiplied.
+class RenderTarget {
+public:
+    RenderTarget();
+    ~RenderTarget();
+
+    // Swaps in a new texture of the given size; the old one stays valid for
+    // packets that still sample it. False when the size did not change.
+    bool Resize(int width, int height);
+    const std::shared_ptr<Texture2D>& GetTexture() const { return m_texture; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    // Redirects drawing into the target and clears it to transparent
+    void Begin();
+    // Back to the default framebuffer, viewport, clear colour and blend function
+    void End();
+
+private:
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    std::shared_ptr<Texture2D> m_texture;
+    int m_width;
+    int m_height;
+    GLuint m_framebuffer;
+    GLuint m_attachedTexture;
+    GLint m_savedViewport[4];
+    GLfloat m_savedClearColor[4];
+    bool m_active;
+};
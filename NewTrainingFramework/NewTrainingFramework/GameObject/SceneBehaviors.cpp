@@ -0,0 +1,192 @@
+#include "stdafx.h"
+#include "SceneBehaviors.h"
+#include "Object.h"
+#include "../GameManager/Snapshot.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+void SceneBehaviors::AddLift(Object* obj, float startX, float startY, float startZ,
+                             float endX, float endY, float endZ, float speed, float pauseTime) {
+    if (!obj) return;
+    float dx = endX - startX, dy = endY - startY, dz = endZ - startZ;
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+    Lift lift;
+    lift.obj = obj;
+    lift.startX = startX; lift.startY = startY; lift.startZ = startZ;
+    lift.endX = endX; lift.endY = endY; lift.endZ = endZ;
+    lift.step = (distance > 0.0f) ? speed / distance : 0.0f;
+    lift.progress = 0.0f;
+    lift.pauseTime = pauseTime;
+    lift.pauseTimer = 0.0f;
+    lift.goingUp = true;
+    m_lifts.push_back(lift);
+
+    obj->SetPosition(startX, startY, startZ);
+}
+
+void SceneBehaviors::AddRotation(Object* obj, Axis axis, float speed, float period) {
+    if (!obj) return;
+    m_rotations.push_back({ obj, (int)axis, speed, period });
+}
+
+int SceneBehaviors::AddScrollGroup(float speed, float leftBoundary, float spacing) {
+    ScrollGroup group;
+    group.speed = speed;
+    group.leftBoundary = leftBoundary;
+    group.spacing = spacing;
+    m_scrollGroups.push_back(group);
+    return (int)m_scrollGroups.size() - 1;
+}
+
+void SceneBehaviors::AddToScrollGroup(int group, Object* obj) {
+    if (!obj || group < 0 || group >= (int)m_scrollGroups.size()) return;
+    m_scrollGroups[group].members.push_back(obj);
+}
+
+void SceneBehaviors::AddOscillation(Object* obj, float ampX, float ampY, float ampZ, float frequency, float phase) {
+    if (!obj) return;
+    const Vector3& pos = obj->GetPosition();
+    Oscillation osc;
+    osc.obj = obj;
+    osc.baseX = pos.x; osc.baseY = pos.y; osc.baseZ = pos.z;
+    osc.ampX = ampX; osc.ampY = ampY; osc.ampZ = ampZ;
+    osc.omega = 2.0f * (float)M_PI * frequency;
+    osc.phase = phase;
+    osc.time = 0.0f;
+    m_oscillations.push_back(osc);
+}
+
+void SceneBehaviors::Remove(const Object* obj) {
+    auto byObject = [obj](const auto& entry) { return entry.obj == obj; };
+    m_lifts.erase(std::remove_if(m_lifts.begin(), m_lifts.end(), byObject), m_lifts.end());
+    m_rotations.erase(std::remove_if(m_rotations.begin(), m_rotations.end(), byObject), m_rotations.end());
+    m_oscillations.erase(std::remove_if(m_oscillations.begin(), m_oscillations.end(), byObject), m_oscillations.end());
+    for (ScrollGroup& group : m_scrollGroups) {
+        group.members.erase(std::remove(group.members.begin(), group.members.end(), obj), group.members.end());
+    }
+}
+
+void SceneBehaviors::Clear() {
+    m_lifts.clear();
+    m_rotations.clear();
+    m_scrollGroups.clear();
+    m_oscillations.clear();
+}
+
+void SceneBehaviors::Update(float deltaTime) {
+    UpdateLifts(deltaTime);
+    UpdateRotations(deltaTime);
+    UpdateScrollGroups(deltaTime);
+    UpdateOscillations(deltaTime);
+}
+
+int SceneBehaviors::GetCount() const {
+    int count = (int)(m_lifts.size() + m_rotations.size() + m_oscillations.size());
+    for (const ScrollGroup& group : m_scrollGroups) {
+        count += (int)group.members.size();
+    }
+    return count;
+}
+
+template <class Archive>
+void SceneBehaviors::TransferState(Archive& ar) {
+    uint32_t liftCount = (uint32_t)m_lifts.size();
+    ar(liftCount);
+    for (uint32_t i = 0; i < liftCount && ar.Ok(); ++i) {
+        Lift unused = {};
+        Lift& lift = i < m_lifts.size() ? m_lifts[i] : unused;
+        ar(lift.progress);
+        ar(lift.pauseTimer);
+        ar(lift.goingUp);
+    }
+    uint32_t oscillationCount = (uint32_t)m_oscillations.size();
+    ar(oscillationCount);
+    for (uint32_t i = 0; i < oscillationCount && ar.Ok(); ++i) {
+        float unused = 0.0f;
+        ar(i < m_oscillations.size() ? m_oscillations[i].time : unused);
+    }
+}
+
+template void SceneBehaviors::TransferState<SnapshotWriter>(SnapshotWriter&);
+template void SceneBehaviors::TransferState<SnapshotReader>(SnapshotReader&);
+
+void SceneBehaviors::UpdateLifts(float deltaTime) {
+    for (Lift& lift : m_lifts) {
+        if (lift.pauseTimer > 0.0f) {
+            lift.obj->SnapshotTransform();
+            lift.pauseTimer -= deltaTime;
+            continue;
+        }
+
+        if (lift.goingUp) {
+            lift.progress += lift.step * deltaTime;
+            if (lift.progress >= 1.0f) {
+                lift.progress = 1.0f;
+                lift.goingUp = false;
+                lift.pauseTimer = lift.pauseTime;
+            }
+        } else {
+            lift.progress -= lift.step * deltaTime;
+            if (lift.progress <= 0.0f) {
+                lift.progress = 0.0f;
+                lift.goingUp = true;
+                lift.pauseTimer = lift.pauseTime;
+            }
+        }
+
+        float t = lift.progress;
+        lift.obj->SnapshotTransform();
+        lift.obj->SetPosition(lift.startX + (lift.endX - lift.startX) * t,
+                              lift.startY + (lift.endY - lift.startY) * t,
+                              lift.startZ + (lift.endZ - lift.startZ) * t);
+    }
+}
+
+void SceneBehaviors::UpdateRotations(float deltaTime) {
+    for (Rotation& rot : m_rotations) {
+        const Vector3& current = rot.obj->GetRotation();
+        float r[3] = { current.x, current.y, current.z };
+        r[rot.axis] += rot.speed * deltaTime;
+        if (rot.period > 0.0f && r[rot.axis] >= rot.period) {
+            r[rot.axis] -= rot.period;
+        }
+        rot.obj->SetRotation(r[0], r[1], r[2]);
+    }
+}
+
+void SceneBehaviors::UpdateScrollGroups(float deltaTime) {
+    for (ScrollGroup& group : m_scrollGroups) {
+        for (Object* obj : group.members) {
+            const Vector3& pos = obj->GetPosition();
+            obj->SnapshotTransform();
+            obj->SetPosition(pos.x - group.speed * deltaTime, pos.y, pos.z);
+        }
+
+        for (Object* obj : group.members) {
+            const Vector3& pos = obj->GetPosition();
+            if (pos.x > group.leftBoundary) continue;
+            float rightmostX = -1000.0f;
+            for (const Object* other : group.members) {
+                if (other->GetPosition().x > rightmostX) {
+                    rightmostX = other->GetPosition().x;
+                }
+            }
+            obj->SetPosition(rightmostX + group.spacing, pos.y, pos.z);
+            obj->SnapshotTransform();
+        }
+    }
+}
+
+void SceneBehaviors::UpdateOscillations(float deltaTime) {
+    for (Oscillation& osc : m_oscillations) {
+        osc.time += deltaTime;
+        float s = sinf(osc.omega * osc.time + osc.phase);
+        osc.obj->SnapshotTransform();
+        osc.obj->SetPosition(osc.baseX + osc.ampX * s, osc.baseY + osc.ampY * s, osc.baseZ + osc.ampZ * s);
+    }
+}
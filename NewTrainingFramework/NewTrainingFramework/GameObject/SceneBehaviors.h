@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+
+class Object;
+
+// Per-frame behaviors attached to scene objects. Each behavior kind is kept in
+// its own contiguous array and Update() only walks registered entries, so the
+// static majority of the scene costs nothing per tick.
+// Entries hold raw Object pointers; SceneManager calls Remove()/Clear() when
+// objects go away.
+class SceneBehaviors {
+public:
+    enum Axis {
+        AXIS_X,
+        AXIS_Y,
+        AXIS_Z,
+    };
+
+    // Moves between two points at speed units/sec, pausing pauseTime at each end
+    void AddLift(Object* obj, float startX, float startY, float startZ,
+                 float endX, float endY, float endZ, float speed, float pauseTime);
+    // Adds speed * dt to one rotation component and wraps it back by period
+    void AddRotation(Object* obj, Axis axis, float speed, float period);
+    // Members scroll along X; one that passes leftBoundary re-enters spacing behind the rightmost member
+    int AddScrollGroup(float speed, float leftBoundary, float spacing);
+    void AddToScrollGroup(int group, Object* obj);
+    // Sine offset of the given amplitude around the position at registration time
+    void AddOscillation(Object* obj, float ampX, float ampY, float ampZ, float frequency, float phase = 0.0f);
+
+    void Remove(const Object* obj);
+    void Clear();
+    void Update(float deltaTime);
+
+    int GetCount() const;
+
+    // Lift and oscillation progress; entries are matched by registration order
+    template <class Archive>
+    void TransferState(Archive& ar);
+
+private:
+    struct Lift {
+        Object* obj;
+        float startX, startY, startZ;
+        float endX, endY, endZ;
+        float step;          // progress per second
+        float progress;      // 0 at start, 1 at end
+        float pauseTime;
+        float pauseTimer;
+        bool goingUp;
+    };
+
+    struct Rotation {
+        Object* obj;
+        int axis;
+        float speed;
+        float period;
+    };
+
+    struct ScrollGroup {
+        float speed;
+        float leftBoundary;
+        float spacing;
+        std::vector<Object*> members;
+    };
+
+    struct Oscillation {
+        Object* obj;
+        float baseX, baseY, baseZ;
+        float ampX, ampY, ampZ;
+        float omega;
+        float phase;
+        float time;
+    };
+
+    void UpdateLifts(float deltaTime);
+    void UpdateRotations(float deltaTime);
+    void UpdateScrollGroups(float deltaTime);
+    void UpdateOscillations(float deltaTime);
+
+    std::vector<Lift> m_lifts;
+    std::vector<Rotation> m_rotations;
+    std::vector<ScrollGroup> m_scrollGroups;
+    std::vector<Oscillation> m_oscillations;
+};
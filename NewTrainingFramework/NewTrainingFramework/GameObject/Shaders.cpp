@@ -3,6 +3,12 @@
 
 int Shaders::Init(char * fileVertexShader, char * fileFragmentShader)
 {
+	if ( esIsHeadless() )
+	{
+		program = vertexShader = fragmentShader = 0;
+		return 0;
+	}
+
 	vertexShader = esLoadShader(GL_VERTEX_SHADER, fileVertexShader);
 
 	if ( vertexShader == 0 )
@@ -26,6 +32,8 @@ int Shaders::Init(char * fileVertexShader, char * fileFragmentShader)
 
 Shaders::~Shaders()
 {
+	if ( esIsHeadless() )
+		return;
 	glDeleteProgram(program);
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
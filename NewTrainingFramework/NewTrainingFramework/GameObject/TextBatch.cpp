@@ -0,0 +1,110 @@
+#include "stdafx.h"
+#include "TextBatch.h"
+#include "Model.h"
+#include "Texture2D.h"
+#include "RenderPacket.h"
+#include "../GameManager/ResourceManager.h"
+#include <SDL.h>
+#include <cstring>
+
+namespace {
+    // Same shader as the Sprite2D objects the HUD text used to be
+    const int TEXT_SHADER_ID = 0;
+}
+
+TextBatch::TextBatch() : m_dirty(true), m_revision(0) {
+}
+
+void TextBatch::SetAtlas(std::shared_ptr<GlyphAtlas> atlas) {
+    m_atlas = atlas;
+    m_dirty = true;
+    ++m_revision;
+}
+
+void TextBatch::Clear() {
+    m_cells.clear();
+    m_mesh.reset();
+    m_dirty = true;
+    ++m_revision;
+}
+
+int TextBatch::AddCell(float x, float y, float width, float height) {
+    Cell cell = { x, y, width, height, '\0', GlyphAtlas::WHITE };
+    m_cells.push_back(cell);
+    m_dirty = true;
+    ++m_revision;
+    return (int)m_cells.size() - 1;
+}
+
+void TextBatch::SetGlyph(int cell, char c, GlyphAtlas::Color color) {
+    if (cell < 0 || cell >= (int)m_cells.size()) return;
+    Cell& target = m_cells[cell];
+    if (target.c == c && target.color == color) return;
+    target.c = c;
+    target.color = color;
+    m_dirty = true;
+    ++m_revision;
+}
+
+void TextBatch::SetText(int firstCell, const char* text, GlyphAtlas::Color color) {
+    for (int i = 0; text[i] != '\0'; ++i) {
+        SetGlyph(firstCell + i, text[i], color);
+    }
+}
+
+void TextBatch::RebuildMesh() {
+    m_dirty = false;
+    m_mesh.reset();
+    if (!m_atlas) return;
+
+    std::shared_ptr<Model> mesh = std::make_shared<Model>();
+    for (const Cell& cell : m_cells) {
+        const GlyphAtlas::Glyph* glyph = m_atlas->Find(cell.c, cell.color);
+        if (!glyph || cell.c == ' ' || glyph->width == 0) continue;
+        const float left = cell.x - cell.width * 0.5f, right = cell.x + cell.width * 0.5f;
+        const float bottom = cell.y - cell.height * 0.5f, top = cell.y + cell.height * 0.5f;
+        // Sprite2D vertex order: bottom-left, top-left, top-right, bottom-right
+        const GLushort base = (GLushort)mesh->vertices.size();
+        mesh->vertices.push_back(Vertex(left, bottom, 0.0f, 1.0f, 1.0f, 1.0f, glyph->u0, glyph->v1));
+        mesh->vertices.push_back(Vertex(left, top, 0.0f, 1.0f, 1.0f, 1.0f, glyph->u0, glyph->v0));
+        mesh->vertices.push_back(Vertex(right, top, 0.0f, 1.0f, 1.0f, 1.0f, glyph->u1, glyph->v0));
+        mesh->vertices.push_back(Vertex(right, bottom, 0.0f, 1.0f, 1.0f, 1.0f, glyph->u1, glyph->v1));
+        const GLushort quad[6] = { base, (GLushort)(base + 1), (GLushort)(base + 2),
+                                   base, (GLushort)(base + 2), (GLushort)(base + 3) };
+        mesh->indices.insert(mesh->indices.end(), quad, quad + 6);
+    }
+    if (mesh->indices.empty()) return;
+    // Buffers are created on first Draw, on whichever thread submits GL
+    mesh->vertexCount = (int)mesh->vertices.size();
+    mesh->indexCount = (int)mesh->indices.size();
+    m_mesh = mesh;
+}
+
+void TextBatch::Draw(const Matrix& viewMatrix, const Matrix& projectionMatrix) {
+    if (esIsHeadless() || !m_atlas || !m_atlas->GetTexture()) return;
+    if (m_dirty) {
+        RebuildMesh();
+    }
+    if (!m_mesh) return;
+    if (!m_shader) {
+        m_shader = ResourceManager::GetInstance()->GetShader(TEXT_SHADER_ID);
+        if (!m_shader) return;
+    }
+
+    Matrix viewMatrixCopy;
+    viewMatrixCopy = const_cast<Matrix&>(viewMatrix);
+    Matrix projMatrixCopy;
+    projMatrixCopy = const_cast<Matrix&>(projectionMatrix);
+    Matrix mvpMatrix = viewMatrixCopy * projMatrixCopy;
+
+    RenderPacket::DrawCommand command;
+    command.model = m_mesh;
+    command.shader = m_shader;
+    command.textureCount = 1;
+    command.textures[0] = m_atlas->GetTexture();
+    memcpy(command.mvp, &mvpMatrix.m[0][0], sizeof(command.mvp));
+    command.hasQuadUV = false;
+    command.time = SDL_GetTicks() / 1000.0f;
+
+    RenderPacket::Issue(std::move(command));
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "GlyphAtlas.h"
+#include "../../Utilities/Math.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Model;
+class Shaders;
+
+// Fixed screen cells that each show one glyph of a GlyphAtlas, drawn together
+// as a single mesh in one draw call. The mesh is only rebuilt after a cell's
+// glyph changes; the old one stays with any render packet still using it.
+class TextBatch {
+public:
+    TextBatch();
+
+    void SetAtlas(std::shared_ptr<GlyphAtlas> atlas);
+    void Clear();
+
+    // Cell centred at (x, y) with the given size; starts out blank
+    int AddCell(float x, float y, float width, float height);
+    // '\0' or ' ' leaves the cell blank
+    void SetGlyph(int cell, char c, GlyphAtlas::Color color = GlyphAtlas::WHITE);
+    // Fills consecutive cells starting at firstCell, one character each
+    void SetText(int firstCell, const char* text, GlyphAtlas::Color color = GlyphAtlas::WHITE);
+    int GetCellCount() const { return (int)m_cells.size(); }
+    // Changes whenever the batch would draw something different
+    uint32_t GetRevision() const { return m_revision; }
+
+    void Draw(const Matrix& viewMatrix, const Matrix& projectionMatrix);
+
+private:
+    struct Cell {
+        float x, y, width, height;
+        char c;
+        GlyphAtlas::Color color;
+    };
+
+    void RebuildMesh();
+
+    std::vector<Cell> m_cells;
+    std::shared_ptr<GlyphAtlas> m_atlas;
+    std::shared_ptr<Model> m_mesh;
+    std::shared_ptr<Shaders> m_shader;
+    bool m_dirty;
+    uint32_t m_revision;
+};
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Texture2D.h"
 #include "../../Utilities/TGA.h"
+#include "../GameManager/MatchRecording.h"
 #include <iostream>
 #include <SDL_surface.h>
 
@@ -9,20 +10,75 @@
 #endif
 
 Texture2D::Texture2D() 
-    : m_textureId(0), m_width(0), m_height(0), m_channels(0) {
+    : m_textureId(0), m_width(0), m_height(0), m_channels(0), m_sheetColumns(0), m_sheetRows(0),
+      m_alphaClass(ALPHA_TRANSLUCENT), m_contentHash(0), m_target(GL_TEXTURE_2D), m_layer(-1) {
+    m_packedRect[0] = m_packedRect[1] = 0.0f;
+    m_packedRect[2] = m_packedRect[3] = 1.0f;
 }
 
 Texture2D::~Texture2D() {
     Cleanup();
 }
 
+Texture2D::AlphaClass Texture2D::ClassifyAlpha(const unsigned char* pixels, int width, int height, int bitsPerPixel) {
+    if (bitsPerPixel != 32) {
+        return ALPHA_OPAQUE;
+    }
+    AlphaClass result = ALPHA_OPAQUE;
+    const size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char alpha = pixels[i * 4 + 3];
+        if (alpha == 255) continue;
+        if (alpha != 0) return ALPHA_TRANSLUCENT;
+        result = ALPHA_CUTOUT;
+    }
+    return result;
+}
+
+const char* Texture2D::GetAlphaClassName(AlphaClass alphaClass) {
+    switch (alphaClass) {
+        case ALPHA_OPAQUE: return "opaque";
+        case ALPHA_CUTOUT: return "cutout";
+        default:           return "translucent";
+    }
+}
+
+bool Texture2D::ParseAlphaClass(const std::string& name, AlphaClass& outClass) {
+    for (int i = ALPHA_OPAQUE; i <= ALPHA_TRANSLUCENT; ++i) {
+        if (name == GetAlphaClassName((AlphaClass)i)) {
+            outClass = (AlphaClass)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t Texture2D::HashPixels(const unsigned char* pixels, int width, int height, int bitsPerPixel) {
+    StateHash hash;
+    hash.Add(width);
+    hash.Add(height);
+    hash.Add(bitsPerPixel);
+    hash.Add(pixels, (size_t)width * height * (bitsPerPixel / 8));
+    return hash.Get();
+}
+
 bool Texture2D::LoadFromFile(const std::string& filepath, const std::string& tiling) {
     Cleanup();
+
+    if (esIsHeadless()) {
+        if (!LoadTGAInfo(filepath.c_str(), &m_width, &m_height, &m_channels)) {
+            return false;
+        }
+        m_filepath = filepath;
+        return true;
+    }
     
     char* textureData = LoadTGA(filepath.c_str(), &m_width, &m_height, &m_channels);
     if (!textureData) {
         return false;
     }
+    m_alphaClass = ClassifyAlpha((const unsigned char*)textureData, m_width, m_height, m_channels);
+    m_contentHash = HashPixels((const unsigned char*)textureData, m_width, m_height, m_channels);
     
     glGenTextures(1, &m_textureId);
     glBindTexture(GL_TEXTURE_2D, m_textureId);
@@ -53,14 +109,16 @@ bool Texture2D::LoadFromFile(const std::string& filepath, const std::string& til
 }
 
 void Texture2D::Bind(int textureUnit) const {
-    if (m_textureId) {
+    if (m_page) {
+        m_page->Bind(textureUnit);
+    } else if (m_textureId) {
         glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, m_textureId);
+        glBindTexture(m_target, m_textureId);
     }
 }
 
 void Texture2D::Unbind() const {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GetTarget(), 0);
 }
 
 void Texture2D::Cleanup() {
@@ -70,12 +128,103 @@ void Texture2D::Cleanup() {
     }
     m_width = m_height = m_channels = 0;
     m_filepath.clear();
-} 
+    m_alphaClass = ALPHA_TRANSLUCENT;
+    m_contentHash = 0;
+    m_target = GL_TEXTURE_2D;
+    m_page.reset();
+    m_layer = -1;
+    m_packedRect[0] = m_packedRect[1] = 0.0f;
+    m_packedRect[2] = m_packedRect[3] = 1.0f;
+}
+
+bool Texture2D::CreateArray(int width, int height, int layers) {
+    Cleanup();
+    if (width <= 0 || height <= 0 || layers <= 0) {
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_channels = 32;
+    m_target = GL_TEXTURE_2D_ARRAY;
+    if (esIsHeadless()) {
+        return true;
+    }
+
+    glGenTextures(1, &m_textureId);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureId);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    // Space between packed sheets must read as transparent
+    std::vector<unsigned char> clear((size_t)width * height * 4, 0);
+    for (int layer = 0; layer < layers; ++layer) {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, clear.data());
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    return true;
+}
+
+bool Texture2D::PackInto(const std::shared_ptr<Texture2D>& array, int layer, int x, int y) {
+    if (!array || array->m_target != GL_TEXTURE_2D_ARRAY || m_channels != 32 ||
+        x + m_width > array->m_width || y + m_height > array->m_height) {
+        return false;
+    }
+
+    if (!esIsHeadless()) {
+        int width, height, bpp;
+        char* textureData = LoadTGA(m_filepath.c_str(), &width, &height, &bpp);
+        if (!textureData) {
+            return false;
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array->m_textureId);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, textureData);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        delete[] textureData;
+
+        if (m_textureId) {
+            glDeleteTextures(1, &m_textureId);
+            m_textureId = 0;
+        }
+    }
+
+    m_page = array;
+    m_layer = layer;
+    m_packedRect[0] = (float)x / array->m_width;
+    m_packedRect[1] = (float)y / array->m_height;
+    m_packedRect[2] = (float)m_width / array->m_width;
+    m_packedRect[3] = (float)m_height / array->m_height;
+    return true;
+}
+
+void Texture2D::SetAtlasRegion(const std::shared_ptr<Texture2D>& page, int x, int y, int width, int height,
+                               const std::string& filepath, AlphaClass alphaClass) {
+    Cleanup();
+    m_width = width;
+    m_height = height;
+    m_channels = 32;
+    m_filepath = filepath;
+    m_alphaClass = alphaClass;
+    m_page = page;
+    m_packedRect[0] = (float)x / page->m_width;
+    m_packedRect[1] = (float)y / page->m_height;
+    m_packedRect[2] = (float)width / page->m_width;
+    m_packedRect[3] = (float)height / page->m_height;
+}
 
 bool Texture2D::LoadFromSDLSurface(void* surfacePtr) {
     Cleanup();
     if (!surfacePtr) return false;
     SDL_Surface* surface = (SDL_Surface*)surfacePtr;
+    if (esIsHeadless()) {
+        m_width = surface->w;
+        m_height = surface->h;
+        m_channels = 4;
+        return true;
+    }
 
     SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
     if (!converted) return false;
@@ -103,6 +252,7 @@ bool Texture2D::CreateColorTexture(int width, int height, unsigned char r, unsig
     m_width = width;
     m_height = height;
     m_channels = 4;
+    m_alphaClass = a == 255 ? ALPHA_OPAQUE : ALPHA_TRANSLUCENT;
     
     std::vector<unsigned char> textureData(width * height * 4);
     for (int i = 0; i < width * height; ++i) {
@@ -111,6 +261,9 @@ bool Texture2D::CreateColorTexture(int width, int height, unsigned char r, unsig
         textureData[i * 4 + 2] = b;
         textureData[i * 4 + 3] = a;
     }
+    if (esIsHeadless()) {
+        return true;
+    }
     
     glGenTextures(1, &m_textureId);
     glBindTexture(GL_TEXTURE_2D, m_textureId);
@@ -128,12 +281,34 @@ bool Texture2D::CreateColorTexture(int width, int height, unsigned char r, unsig
     return true;
 }
 
+bool Texture2D::CreateRenderTexture(int width, int height) {
+    Cleanup();
+
+    m_width = width;
+    m_height = height;
+    m_channels = 4;
+    if (esIsHeadless()) {
+        return true;
+    }
+
+    glGenTextures(1, &m_textureId);
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return true;
+}
+
 void Texture2D::SetFiltering(GLenum minFilter, GLenum magFilter) {
     if (m_textureId) {
-        glBindTexture(GL_TEXTURE_2D, m_textureId);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(m_target, m_textureId);
+        glTexParameteri(m_target, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(m_target, GL_TEXTURE_MAG_FILTER, magFilter);
+        glBindTexture(m_target, 0);
     }
 }
 
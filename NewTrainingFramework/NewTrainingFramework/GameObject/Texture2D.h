@@ -1,14 +1,49 @@
 #pragma once
 #include "../../Utilities/utilities.h"
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 class Texture2D {
+public:
+    // Decides how RenderPacket draws the texture. Opaque and cutout draws go
+    // front to back with depth writes and no blending, cutout discarding its
+    // transparent texels; translucent draws blend back to front.
+    enum AlphaClass {
+        ALPHA_OPAQUE,       // alpha is 255 everywhere
+        ALPHA_CUTOUT,       // alpha is 0 or 255
+        ALPHA_TRANSLUCENT,  // anything in between, and textures never classified
+    };
+
+    static AlphaClass ClassifyAlpha(const unsigned char* pixels, int width, int height, int bitsPerPixel);
+    static const char* GetAlphaClassName(AlphaClass alphaClass);
+    static bool ParseAlphaClass(const std::string& name, AlphaClass& outClass);
+    // FNV-1a over LoadTGA's pixels; lets a manifest tell an edited source image
+    static uint64_t HashPixels(const unsigned char* pixels, int width, int height, int bitsPerPixel);
+
 private:
     GLuint m_textureId;
     int m_width;
     int m_height;
     int m_channels;
     std::string m_filepath;
+    // Frame grid from the SIZE line in RM.txt; 0 for plain textures
+    int m_sheetColumns;
+    int m_sheetRows;
+    // Four floats per frame, see GetFrameTrim
+    std::vector<float> m_frameTrims;
+    AlphaClass m_alphaClass;
+    // HashPixels of the file this was loaded from; 0 when the pixels were never read
+    uint64_t m_contentHash;
+    // GL_TEXTURE_2D_ARRAY for a texture made by CreateArray()
+    GLenum m_target;
+    // Set for a texture that lives inside another one, an array layer
+    // (PackInto) or an atlas page (SetAtlasRegion): draws bind m_page and
+    // sample m_packedRect of it
+    std::shared_ptr<Texture2D> m_page;
+    int m_layer;
+    float m_packedRect[4];
     
 public:
     Texture2D();
@@ -19,17 +54,47 @@ public:
     void Bind(int textureUnit = 0) const;
     void Unbind() const;
 
-    GLuint GetTextureId() const { return m_textureId; }
+    GLuint GetTextureId() const { return m_page ? m_page->m_textureId : m_textureId; }
+    GLenum GetTarget() const { return m_page ? m_page->m_target : m_target; }
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
     int GetChannels() const { return m_channels; }
     const std::string& GetFilepath() const { return m_filepath; }
+    AlphaClass GetAlphaClass() const { return m_alphaClass; }
+    uint64_t GetContentHash() const { return m_contentHash; }
+
+    void SetSheetGrid(int columns, int rows) { m_sheetColumns = columns; m_sheetRows = rows; }
+    int GetSheetColumns() const { return m_sheetColumns; }
+    int GetSheetRows() const { return m_sheetRows; }
+    // Bounds of the frame's visible texels from SpriteTrim.txt as u0, v0, u1, v1
+    // inside its cell, all zero for an empty frame; nullptr when the sheet has none
+    void SetFrameTrims(const std::vector<float>& trims) { m_frameTrims = trims; }
+    const float* GetFrameTrim(int frame) const {
+        return frame >= 0 && (size_t)frame * 4 < m_frameTrims.size() ? &m_frameTrims[frame * 4] : nullptr;
+    }
+
+    // Sprite sheets grouped under one ARRAY name in RM.txt share a texture
+    // array; small textures listed in the atlas manifest share an atlas page.
+    // Either way the texture keeps its own size and frame grid.
+    bool CreateArray(int width, int height, int layers);
+    // Copies this 32-bit TGA into array at (x, y) of layer and frees its own storage
+    bool PackInto(const std::shared_ptr<Texture2D>& array, int layer, int x, int y);
+    // Stands for filepath, already copied to (x, y) of page by the atlas packer
+    void SetAtlasRegion(const std::shared_ptr<Texture2D>& page, int x, int y, int width, int height,
+                        const std::string& filepath, AlphaClass alphaClass);
+    bool IsPacked() const { return m_page != nullptr; }
+    // Array layer; -1 on an atlas page
+    int GetLayer() const { return m_layer; }
+    // u offset, v offset, u scale, v scale inside the page or layer
+    const float* GetPackedRect() const { return m_packedRect; }
 
     void Cleanup();
 
     bool LoadFromSDLSurface(void* surface);
     
     bool CreateColorTexture(int width, int height, unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255);
+    // Uninitialised RGBA storage for a RenderTarget to draw into
+    bool CreateRenderTexture(int width, int height);
     
     void SetFiltering(GLenum minFilter, GLenum magFilter);
     void SetSharpFiltering();
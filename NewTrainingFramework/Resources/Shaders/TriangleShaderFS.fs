@@ -2,14 +2,29 @@
 precision mediump float;
 
 in mediump vec3 v_color;
-in mediump vec2 v_uv;  // UV coordinates từ vertex shader
+in highp vec2 v_uv;  // UV coordinates từ vertex shader
 
 uniform sampler2D u_texture;
+// Packed sprite sheets: u_layer >= 0 samples that layer of u_textureArray instead
+uniform int u_layer;
+uniform mediump sampler2DArray u_textureArray;
+// Cutout textures drawn in the opaque pass drop texels below this alpha
+uniform float u_alphaCutoff;
+// Overdraw view: > 0 writes this flat amount per fragment for additive blending
+uniform float u_overdraw;
 
 layout(location = 0) out mediump vec4 o_color;
 
 void main()
 {
-	vec4 texColor = texture(u_texture, v_uv);
-	o_color = texColor;
+	vec4 texColor;
+	if (u_layer >= 0) {
+		texColor = texture(u_textureArray, vec3(v_uv, float(u_layer)));
+	} else {
+		texColor = texture(u_texture, v_uv);
+	}
+	if (texColor.a < u_alphaCutoff) {
+		discard;
+	}
+	o_color = u_overdraw > 0.0 ? vec4(vec3(u_overdraw), 1.0) : texColor;
 }
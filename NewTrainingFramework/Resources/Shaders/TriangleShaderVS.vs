@@ -8,6 +8,25 @@ layout(location = 2) in highp vec2 a_uv;
 // Uniform MVP matrix  
 uniform highp mat4 u_mvpMatrix;
 
+// Sprite sheet: columns, rows, frame index, flip bits (1 = x, 2 = y).
+// A negative frame index draws the model's own UVs.
+uniform ivec4 u_sheet;
+
+// Part of the frame's cell that has visible texels: u0, v0, u1, v1 in cell
+// units, (0, 0, 1, 1) for the whole cell. The quad shrinks to it so the
+// transparent margin is never rasterised.
+uniform highp vec4 u_frameTrim;
+
+// Where the texture sits in its atlas page or texture array layer: u, v offset
+// and u, v scale. (0, 0, 1, 1) for a plain texture.
+uniform highp vec4 u_packedRect;
+
+// Clip-space depth picked by RenderPacket from draw order; later draws are nearer
+uniform highp float u_depth;
+
+// Sprite2D.nfg corners in vertex order, as offsets inside one sheet cell
+const vec2 c_cellCorner[4] = vec2[4](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
+
 // Output to fragment shader
 out highp vec3 v_color;
 out highp vec2 v_uv;
@@ -23,6 +42,25 @@ void main()
     
     // Pass attributes to fragment shader
     v_color = a_color;
-    v_uv = a_uv;
+    if (u_sheet.z < 0) {
+        v_uv = a_uv;
+    } else {
+        vec2 quadCorner = c_cellCorner[gl_VertexID & 3];
+        vec2 corner = quadCorner;
+        if ((u_sheet.w & 1) != 0) corner.x = 1.0 - corner.x;
+        if ((u_sheet.w & 2) != 0) corner.y = 1.0 - corner.y;
+        corner = mix(u_frameTrim.xy, u_frameTrim.zw, corner);
+        // Back to quad space through the same flips; Sprite2D is a unit quad
+        vec2 trimmedCorner = corner;
+        if ((u_sheet.w & 1) != 0) trimmedCorner.x = 1.0 - trimmedCorner.x;
+        if ((u_sheet.w & 2) != 0) trimmedCorner.y = 1.0 - trimmedCorner.y;
+        gl_Position = u_mvpMatrix * vec4(a_posL.xy + trimmedCorner - quadCorner, a_posL.z, 1.0);
+        // Frames run left to right from the top row; texture rows count up from the bottom
+        int column = u_sheet.z % u_sheet.x;
+        int row = u_sheet.y - 1 - u_sheet.z / u_sheet.x;
+        v_uv = (vec2(float(column), float(row)) + corner) / vec2(u_sheet.xy);
+    }
+    v_uv = u_packedRect.xy + v_uv * u_packedRect.zw;
+    gl_Position.z = u_depth * gl_Position.w;
 }
    
\ No newline at end of file
@@ -1,22 +1,34 @@
 #version 300 es
 precision mediump float;
 
-in mediump vec2 v_uv;
+in highp vec2 v_uv;
 
 uniform sampler2D u_texture;
+// Atlas placement from the vertex shader; the band runs across the weapon's own UVs
+uniform highp vec4 u_packedRect;
 uniform float u_time;
 uniform vec2 u_glintDir;
 uniform float u_glintWidth;
 uniform float u_glintSpeed;
 uniform float u_glintIntensity;
+uniform float u_alphaCutoff;
+uniform float u_overdraw;
 
 layout(location = 0) out mediump vec4 o_color;
 
 void main() {
     vec4 base = texture(u_texture, v_uv);
+    if (base.a < u_alphaCutoff) {
+        discard;
+    }
+    if (u_overdraw > 0.0) {
+        o_color = vec4(vec3(u_overdraw), 1.0);
+        return;
+    }
 
     vec2 dir = normalize(u_glintDir);
-    float s = dot(v_uv, dir) + u_glintSpeed * u_time;
+    vec2 localUV = (v_uv - u_packedRect.xy) / u_packedRect.zw;
+    float s = dot(localUV, dir) + u_glintSpeed * u_time;
     s = fract(s);
 
     float d = abs(s - 0.5);
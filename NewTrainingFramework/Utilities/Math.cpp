@@ -5,7 +5,7 @@
 
 //Vector2
 
-GLfloat Vector2::Length()
+GLfloat Vector2::Length() const
 {
 	return (GLfloat)sqrt(x*x + y*y);
 }
@@ -19,12 +19,12 @@ Vector2 & Vector2::Normalize()
 	return *this;
 }
 
-Vector2 Vector2::operator + (Vector2 & vector)
+Vector2 Vector2::operator + (const Vector2 & vector) const
 {
 	return Vector2(x + vector.x, y + vector.y);
 }
 
-Vector2 & Vector2::operator += (Vector2 & vector)
+Vector2 & Vector2::operator += (const Vector2 & vector)
 {
 	x += vector.x;
 	y += vector.y;
@@ -32,17 +32,17 @@ Vector2 & Vector2::operator += (Vector2 & vector)
 	return *this;
 }
 
-Vector2 Vector2::operator - ()
+Vector2 Vector2::operator - () const
 {
 	return Vector2(-x, -y);
 }
 
-Vector2 Vector2::operator - (Vector2 & vector)
+Vector2 Vector2::operator - (const Vector2 & vector) const
 {
 	return Vector2(x - vector.x, y - vector.y);
 }
 
-Vector2 & Vector2::operator -= (Vector2 & vector)
+Vector2 & Vector2::operator -= (const Vector2 & vector)
 {
 	x -= vector.x;
 	y -= vector.y;
@@ -50,7 +50,7 @@ Vector2 & Vector2::operator -= (Vector2 & vector)
 	return *this;
 }
 
-Vector2 Vector2::operator * (GLfloat k)
+Vector2 Vector2::operator * (GLfloat k) const
 {
 	return Vector2(x * k, y * k);
 }
@@ -63,7 +63,7 @@ Vector2 & Vector2::operator *= (GLfloat k)
 	return *this;
 }
 
-Vector2 Vector2::operator / (GLfloat k)
+Vector2 Vector2::operator / (GLfloat k) const
 {
 	GLfloat kInv = 1.0f / k;
 	return Vector2(x * kInv, y * kInv);
@@ -74,7 +74,7 @@ Vector2 & Vector2::operator /= (GLfloat k)
 	return operator *= (1.0f / k);
 }
 
-Vector2 & Vector2::operator = (Vector2 & vector)
+Vector2 & Vector2::operator = (const Vector2 & vector)
 {
 	x = vector.x;
 	y = vector.y;
@@ -82,24 +82,24 @@ Vector2 & Vector2::operator = (Vector2 & vector)
 	return *this;
 }
 
-GLfloat Vector2::operator [] (unsigned int idx)
+GLfloat Vector2::operator [] (unsigned int idx) const
 {
 	return (&x)[idx];
 }
 
-Vector2 Vector2::Modulate(Vector2 & vector)
+Vector2 Vector2::Modulate(const Vector2 & vector) const
 {
 	return Vector2(x * vector.x, y * vector.y);
 }
 
-GLfloat Vector2::Dot(Vector2 & vector)
+GLfloat Vector2::Dot(const Vector2 & vector) const
 {
 	return x * vector.x + y * vector.y;
 }
 
 //Vector3
 
-GLfloat Vector3::Length()
+GLfloat Vector3::Length() const
 {
 	return (GLfloat)sqrt(x*x + y*y + z*z);
 }
@@ -114,12 +114,12 @@ Vector3 & Vector3::Normalize()
 	return *this;
 }
 
-Vector3 Vector3::operator + (Vector3 & vector)
+Vector3 Vector3::operator + (const Vector3 & vector) const
 {
 	return Vector3(x + vector.x, y + vector.y, z + vector.z);
 }
 
-Vector3 & Vector3::operator += (Vector3 & vector)
+Vector3 & Vector3::operator += (const Vector3 & vector)
 {
 	x += vector.x;
 	y += vector.y;
@@ -128,17 +128,17 @@ Vector3 & Vector3::operator += (Vector3 & vector)
 	return *this;
 }
 
-Vector3 Vector3::operator - ()
+Vector3 Vector3::operator - () const
 {
 	return Vector3(-x, -y, -z);
 }
 
-Vector3 Vector3::operator - (Vector3 & vector)
+Vector3 Vector3::operator - (const Vector3 & vector) const
 {
 	return Vector3(x - vector.x, y - vector.y, z - vector.z);
 }
 
-Vector3 & Vector3::operator -= (Vector3 & vector)
+Vector3 & Vector3::operator -= (const Vector3 & vector)
 {
 	x -= vector.x;
 	y -= vector.y;
@@ -147,7 +147,7 @@ Vector3 & Vector3::operator -= (Vector3 & vector)
 	return *this;
 }
 
-Vector3 Vector3::operator * (GLfloat k)
+Vector3 Vector3::operator * (GLfloat k) const
 {
 	return Vector3(x * k, y * k, z * k);
 }
@@ -161,7 +161,7 @@ Vector3 & Vector3::operator *= (GLfloat k)
 	return *this;
 }
 
-Vector3 Vector3::operator / (GLfloat k)
+Vector3 Vector3::operator / (GLfloat k) const
 {
 	GLfloat kInv = 1.0f / k;
 	return Vector3(x * kInv, y * kInv, z * kInv);
@@ -172,15 +172,6 @@ Vector3 & Vector3::operator /= (GLfloat k)
 	return operator *= (1.0f / k);
 }
 
-Vector3 & Vector3::operator = (Vector3 & vector)
-{
-	x = vector.x;
-	y = vector.y;
-	z = vector.z;
-	
-	return *this;
-}
-
 Vector3 & Vector3::operator = (const Vector3 & vector)
 {
 	x = vector.x;
@@ -190,22 +181,22 @@ Vector3 & Vector3::operator = (const Vector3 & vector)
 	return *this;
 }
 
-GLfloat Vector3::operator [] (unsigned int idx)
+GLfloat Vector3::operator [] (unsigned int idx) const
 {
 	return (&x)[idx];
 }
 
-Vector3 Vector3::Modulate(Vector3 & vector)
+Vector3 Vector3::Modulate(const Vector3 & vector) const
 {
 	return Vector3(x * vector.x, y * vector.y, z * vector.z);
 }
 
-GLfloat Vector3::Dot(Vector3 & vector)
+GLfloat Vector3::Dot(const Vector3 & vector) const
 {
 	return x * vector.x + y * vector.y + z * vector.z;
 }
 
-Vector3 Vector3::Cross(Vector3 & vector)
+Vector3 Vector3::Cross(const Vector3 & vector) const
 {
 	return Vector3(y * vector.z -  z * vector.y, z * vector.x - x * vector.z, x * vector.y - y * vector.x);
 }
@@ -224,7 +215,7 @@ GLfloat Vector3::Distance(const Vector3& a, const Vector3& b) {
 
 //Vector4
 
-GLfloat Vector4::Length()
+GLfloat Vector4::Length() const
 {
 	return (GLfloat)sqrt(x*x + y*y + z*z + w*w);
 }
@@ -240,12 +231,12 @@ Vector4 & Vector4::Normalize()
 	return *this;
 }
 
-Vector4 Vector4::operator + (Vector4 & vector)
+Vector4 Vector4::operator + (const Vector4 & vector) const
 {
 	return Vector4(x + vector.x, y + vector.y, z + vector.z, w + vector.w);
 }
 
-Vector4 & Vector4::operator += (Vector4 & vector)
+Vector4 & Vector4::operator += (const Vector4 & vector)
 {
 	x += vector.x;
 	y += vector.y;
@@ -255,17 +246,17 @@ Vector4 & Vector4::operator += (Vector4 & vector)
 	return *this;
 }
 
-Vector4 Vector4::operator - ()
+Vector4 Vector4::operator - () const
 {
 	return Vector4(-x, -y, -z, -w);
 }
 
-Vector4 Vector4::operator - (Vector4 & vector)
+Vector4 Vector4::operator - (const Vector4 & vector) const
 {
 	return Vector4(x - vector.x, y - vector.y, z - vector.z, w - vector.w);
 }
 
-Vector4 & Vector4::operator -= (Vector4 & vector)
+Vector4 & Vector4::operator -= (const Vector4 & vector)
 {
 	x -= vector.x;
 	y -= vector.y;
@@ -275,7 +266,7 @@ Vector4 & Vector4::operator -= (Vector4 & vector)
 	return *this;
 }
 
-Vector4 Vector4::operator * (GLfloat k)
+Vector4 Vector4::operator * (GLfloat k) const
 {
 	return Vector4(x * k, y * k, z * k, w * k);
 }
@@ -290,7 +281,7 @@ Vector4 & Vector4::operator *= (GLfloat k)
 	return *this;
 }
 
-Vector4 Vector4::operator / (GLfloat k)
+Vector4 Vector4::operator / (GLfloat k) const
 {
 	GLfloat kInv = 1.0f / k;
 	return Vector4(x * kInv, y * kInv, z * kInv, w * kInv);
@@ -301,7 +292,7 @@ Vector4 & Vector4::operator /= (GLfloat k)
 	return operator *= (1.0f / k);
 }
 
-Vector4 & Vector4::operator = (Vector4 & vector)
+Vector4 & Vector4::operator = (const Vector4 & vector)
 {
 	x = vector.x;
 	y = vector.y;
@@ -310,23 +301,23 @@ Vector4 & Vector4::operator = (Vector4 & vector)
 	return *this;
 }
 
-GLfloat Vector4::operator [] (unsigned int idx)
+GLfloat Vector4::operator [] (unsigned int idx) const
 {
 	return (&x)[idx];
 }
 
-Vector4 Vector4::Modulate(Vector4 & vector)
+Vector4 Vector4::Modulate(const Vector4 & vector) const
 {
 	return Vector4(x * vector.x, y * vector.y, z * vector.z, w * vector.w);
 }
 
-GLfloat Vector4::Dot(Vector4 & vector)
+GLfloat Vector4::Dot(const Vector4 & vector) const
 {
 	return x * vector.x + y * vector.y + z * vector.z + w * vector.w;
 }
 
 
-Vector4 Vector4::operator * ( Matrix & m )
+Vector4 Vector4::operator * ( const Matrix & m ) const
 {
 	Vector4 res;
 	res.x = x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0] + w * m.m[3][0];
@@ -348,7 +339,7 @@ Matrix::Matrix(GLfloat val)
 	m[3][0] = val; m[3][1] = val; m[3][2] = val; m[3][3] = val;
 }
 
-Matrix::Matrix(Matrix & mat)
+Matrix::Matrix(const Matrix & mat)
 {
 	m[0][0] = mat.m[0][0]; m[0][1] = mat.m[0][1]; m[0][2] = mat.m[0][2]; m[0][3] = mat.m[0][3];
 	m[1][0] = mat.m[1][0]; m[1][1] = mat.m[1][1]; m[1][2] = mat.m[1][2]; m[1][3] = mat.m[1][3];
@@ -492,7 +483,7 @@ Matrix & Matrix::SetScale(GLfloat * pScale)
 	return *this;
 }
 
-Matrix & Matrix::SetScale(Vector3 & scaleVec)
+Matrix & Matrix::SetScale(const Vector3 & scaleVec)
 {
 	m[0][0] = scaleVec.x; m[0][1] = 0.0f;       m[0][2] = 0.0f;       m[0][3] = 0.0f;
 	m[1][0] = 0.0f;       m[1][1] = scaleVec.y; m[1][2] = 0.0f;       m[1][3] = 0.0f;
@@ -522,7 +513,7 @@ Matrix & Matrix::SetTranslation( GLfloat *pTrans)
 	return *this;
 }
 
-Matrix & Matrix::SetTranslation( Vector3 &vec )
+Matrix & Matrix::SetTranslation( const Vector3 &vec )
 {
 	m[0][0] =  1.0f; m[0][1] =  0.0f; m[0][2] =  0.0f; m[0][3] = 0.0f;
 	m[1][0] =  0.0f; m[1][1] =  1.0f; m[1][2] =  0.0f; m[1][3] = 0.0f;
@@ -563,7 +554,7 @@ Matrix & Matrix::SetOrthographic(GLfloat left, GLfloat right, GLfloat bottom, GL
 	return *this;
 }
 
-Matrix & Matrix::SetLookAt(Vector3 &eye, Vector3 &target, Vector3 &up)
+Matrix & Matrix::SetLookAt(const Vector3 &eye, const Vector3 &target, const Vector3 &up)
 {
 	// Tính các vector cho camera coordinate system
 	Vector3 forward = target - eye;
@@ -603,14 +594,14 @@ Matrix Matrix::Transpose()
 	return res;
 }
 
-Matrix Matrix::operator + (Matrix & mat)
+Matrix Matrix::operator + (const Matrix & mat) const
 {
 	Matrix res( *this );
 	res += mat;
 	return res;
 }
 
-Matrix & Matrix::operator += (Matrix & mat)
+Matrix & Matrix::operator += (const Matrix & mat)
 {
 	m[0][0] += mat.m[0][0]; m[0][1] += mat.m[0][1]; m[0][2] += mat.m[0][2]; m[0][3] += mat.m[0][3];
 	m[1][0] += mat.m[1][0]; m[1][1] += mat.m[1][1]; m[1][2] += mat.m[1][2]; m[1][3] += mat.m[1][3];
@@ -620,14 +611,14 @@ Matrix & Matrix::operator += (Matrix & mat)
 	return *this;
 }
 
-Matrix Matrix::operator - (Matrix & mat)
+Matrix Matrix::operator - (const Matrix & mat) const
 {
 	Matrix res( *this );
 	res -= mat;
 	return res;
 }
 
-Matrix & Matrix::operator -= (Matrix & mat)
+Matrix & Matrix::operator -= (const Matrix & mat)
 {
 	m[0][0] -= mat.m[0][0]; m[0][1] -= mat.m[0][1]; m[0][2] -= mat.m[0][2]; m[0][3] -= mat.m[0][3];
 	m[1][0] -= mat.m[1][0]; m[1][1] -= mat.m[1][1]; m[1][2] -= mat.m[1][2]; m[1][3] -= mat.m[1][3];
@@ -637,7 +628,7 @@ Matrix & Matrix::operator -= (Matrix & mat)
 	return *this;
 }
 
-Matrix Matrix::operator * (Matrix & mat)
+Matrix Matrix::operator * (const Matrix & mat) const
 {
 	Matrix res;
 	res.m[0][0] = m[0][0] * mat.m[0][0] + m[0][1] * mat.m[1][0] + m[0][2] * mat.m[2][0] + m[0][3] * mat.m[3][0];
@@ -663,7 +654,7 @@ Matrix Matrix::operator * (Matrix & mat)
 	return res;
 }
 
-Matrix Matrix::operator * (GLfloat k)
+Matrix Matrix::operator * (GLfloat k) const
 {
 	Matrix mat( *this );
 	mat *= k;
@@ -681,7 +672,7 @@ Matrix & Matrix::operator *= (GLfloat k)
 }
 
 
-Vector4 Matrix::operator * (Vector4 & vec)
+Vector4 Matrix::operator * (const Vector4 & vec) const
 {
 	Vector4 res;
 	res.x = vec.x * m[0][0] + vec.y * m[0][1] + vec.z * m[0][2] + vec.w * m[0][3];
@@ -692,7 +683,7 @@ Vector4 Matrix::operator * (Vector4 & vec)
 	return res;
 }
 
-Matrix & Matrix::operator = (Matrix & mat)
+Matrix & Matrix::operator = (const Matrix & mat)
 {
 	m[0][0] = mat.m[0][0]; m[0][1] = mat.m[0][1]; m[0][2] = mat.m[0][2]; m[0][3] = mat.m[0][3];
 	m[1][0] = mat.m[1][0]; m[1][1] = mat.m[1][1]; m[1][2] = mat.m[1][2]; m[1][3] = mat.m[1][3];
@@ -11,26 +11,26 @@ public:
 	Vector2() : x(0.0f), y(0.0f){}
 	Vector2(GLfloat _x, GLfloat _y) : x(_x), y(_y) {}
 	Vector2(GLfloat * pArg) : x(pArg[0]), y(pArg[1]) {}
-	Vector2(Vector2 & vector) : x(vector.x), y(vector.y) {}
+	Vector2(const Vector2 & vector) : x(vector.x), y(vector.y) {}
 
 	//Vector's operations
-	GLfloat Length();
+	GLfloat Length() const;
 	Vector2 & Normalize();
-	Vector2 operator + (Vector2 & vector);
-	Vector2 & operator += (Vector2 & vector);
-	Vector2 operator - ();
-	Vector2 operator - (Vector2 & vector);
-	Vector2 & operator -= (Vector2 & vector);
-	Vector2 operator * (GLfloat k);
+	Vector2 operator + (const Vector2 & vector) const;
+	Vector2 & operator += (const Vector2 & vector);
+	Vector2 operator - () const;
+	Vector2 operator - (const Vector2 & vector) const;
+	Vector2 & operator -= (const Vector2 & vector);
+	Vector2 operator * (GLfloat k) const;
 	Vector2 & operator *= (GLfloat k);
-	Vector2 operator / (GLfloat k);
+	Vector2 operator / (GLfloat k) const;
 	Vector2 & operator /= (GLfloat k);
-	Vector2 & operator = (Vector2 & vector);
-	Vector2 Modulate(Vector2 & vector);
-	GLfloat Dot(Vector2 & vector);
+	Vector2 & operator = (const Vector2 & vector);
+	Vector2 Modulate(const Vector2 & vector) const;
+	GLfloat Dot(const Vector2 & vector) const;
 
 	//access to elements
-	GLfloat operator [] (unsigned int idx);
+	GLfloat operator [] (unsigned int idx) const;
 
 	//data members
 	GLfloat x;
@@ -46,32 +46,31 @@ public:
 	Vector3() : x(0.0f), y(0.0f), z(0.0f) {}
 	Vector3(GLfloat _x, GLfloat _y, GLfloat _z) : x(_x), y(_y), z(_z) {}
 	Vector3(GLfloat * pArg) : x(pArg[0]), y(pArg[1]), z(pArg[2]) {}
-	Vector3(Vector3 & vector) : x(vector.x), y(vector.y), z(vector.z) {}
+	Vector3(const Vector3 & vector) : x(vector.x), y(vector.y), z(vector.z) {}
 	
 	//Vector's operations
-	GLfloat Length();
+	GLfloat Length() const;
 	Vector3 & Normalize();
-	Vector3 operator + (Vector3 & vector);
-	Vector3 & operator += (Vector3 & vector);
-	Vector3 operator - ();
-	Vector3 operator - (Vector3 & vector);
-	Vector3 & operator -= (Vector3 & vector);
-	Vector3 operator * (GLfloat k);
+	Vector3 operator + (const Vector3 & vector) const;
+	Vector3 & operator += (const Vector3 & vector);
+	Vector3 operator - () const;
+	Vector3 operator - (const Vector3 & vector) const;
+	Vector3 & operator -= (const Vector3 & vector);
+	Vector3 operator * (GLfloat k) const;
 	Vector3 & operator *= (GLfloat k);
-	Vector3 operator / (GLfloat k);
+	Vector3 operator / (GLfloat k) const;
 	Vector3 & operator /= (GLfloat k);
-	Vector3 & operator = (Vector3 & vector);
 	Vector3 & operator = (const Vector3 & vector);
-	Vector3 Modulate(Vector3 & vector);
-	GLfloat Dot(Vector3 & vector);
-	Vector3 Cross(Vector3 & vector);
+	Vector3 Modulate(const Vector3 & vector) const;
+	GLfloat Dot(const Vector3 & vector) const;
+	Vector3 Cross(const Vector3 & vector) const;
 
 	// Utility functions
 	static Vector3 Lerp(const Vector3& a, const Vector3& b, float t);
 	static GLfloat Distance(const Vector3& a, const Vector3& b);
 
 	//access to elements
-	GLfloat operator [] (unsigned int idx);
+	GLfloat operator [] (unsigned int idx) const;
 
 	// data members
 	GLfloat x;
@@ -91,31 +90,31 @@ public:
 	Vector4(GLfloat _x, GLfloat _y, GLfloat _z) : x(_x), y(_y), z(_z), w(1.0f) {}
 	Vector4(GLfloat _x, GLfloat _y, GLfloat _z, GLfloat _w) : x(_x), y(_y), z(_z), w(_w) {}
 	Vector4(GLfloat * pArg) : x(pArg[0]), y(pArg[1]), z(pArg[2]), w(pArg[3]) {}
-	Vector4(Vector3 & vector) : x(vector.x), y(vector.y), z(vector.z), w(1.0f){}
-	Vector4(Vector3 & vector, GLfloat _w) : x(vector.x), y(vector.y), z(vector.z), w(_w) {}
-	Vector4(Vector4 & vector) : x(vector.x), y(vector.y), z(vector.z), w(vector.w) {}
+	Vector4(const Vector3 & vector) : x(vector.x), y(vector.y), z(vector.z), w(1.0f){}
+	Vector4(const Vector3 & vector, GLfloat _w) : x(vector.x), y(vector.y), z(vector.z), w(_w) {}
+	Vector4(const Vector4 & vector) : x(vector.x), y(vector.y), z(vector.z), w(vector.w) {}
 
 	//Vector's operations
-	GLfloat Length();
+	GLfloat Length() const;
 	Vector4 & Normalize();
-	Vector4 operator + (Vector4 & vector);
-	Vector4 & operator += (Vector4 & vector);
-	Vector4 operator - ();
-	Vector4 operator - (Vector4 & vector);
-	Vector4 & operator -= (Vector4 & vector);
-	Vector4 operator * (GLfloat k);
+	Vector4 operator + (const Vector4 & vector) const;
+	Vector4 & operator += (const Vector4 & vector);
+	Vector4 operator - () const;
+	Vector4 operator - (const Vector4 & vector) const;
+	Vector4 & operator -= (const Vector4 & vector);
+	Vector4 operator * (GLfloat k) const;
 	Vector4 & operator *= (GLfloat k);
-	Vector4 operator / (GLfloat k);
+	Vector4 operator / (GLfloat k) const;
 	Vector4 & operator /= (GLfloat k);
-	Vector4 & operator = (Vector4 & vector);
-	Vector4 Modulate(Vector4 & vector);
-	GLfloat Dot(Vector4 & vector);
+	Vector4 & operator = (const Vector4 & vector);
+	Vector4 Modulate(const Vector4 & vector) const;
+	GLfloat Dot(const Vector4 & vector) const;
 
 	//matrix multiplication
-	Vector4 operator * ( Matrix & m );
+	Vector4 operator * ( const Matrix & m ) const;
 
 	//access to elements
-	GLfloat operator [] (unsigned int idx);
+	GLfloat operator [] (unsigned int idx) const;
 
 	//data members
 	GLfloat x;
@@ -133,7 +132,7 @@ public:
 	//constructors
 	Matrix() {}
 	Matrix(GLfloat val);
-	Matrix(Matrix & mat);
+	Matrix(const Matrix & mat);
 
 	// Matrix operations
 	Matrix & SetZero();
@@ -147,30 +146,30 @@ public:
 	Matrix & SetScale(GLfloat scale);
 	Matrix & SetScale(GLfloat scaleX, GLfloat scaleY, GLfloat scaleZ);
 	Matrix & SetScale(GLfloat * pScale);
-	Matrix & SetScale(Vector3 &scaleVec);
+	Matrix & SetScale(const Vector3 &scaleVec);
 
 	Matrix & SetTranslation(GLfloat x, GLfloat y, GLfloat z);
 	Matrix & SetTranslation(GLfloat *pTrans);
-	Matrix & SetTranslation(Vector3 &vec);
+	Matrix & SetTranslation(const Vector3 &vec);
 
 	// Removed SetPerspective - 2D engine uses orthographic only
 	Matrix & SetOrthographic(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat nearPlane, GLfloat farPlane);
-	Matrix & SetLookAt(Vector3 &eye, Vector3 &target, Vector3 &up);
+	Matrix & SetLookAt(const Vector3 &eye, const Vector3 &target, const Vector3 &up);
 
 	Matrix Transpose();
 
-	Matrix operator + (Matrix & mat);
-	Matrix & operator += (Matrix & mat);
-	Matrix operator - (Matrix & mat);
-	Matrix &operator -= (Matrix & mat);
+	Matrix operator + (const Matrix & mat) const;
+	Matrix & operator += (const Matrix & mat);
+	Matrix operator - (const Matrix & mat) const;
+	Matrix &operator -= (const Matrix & mat);
 
-	Matrix operator * (Matrix & mat);
-	Matrix operator * (GLfloat k);
+	Matrix operator * (const Matrix & mat) const;
+	Matrix operator * (GLfloat k) const;
 	Matrix & operator *= (GLfloat k);
 
-	Vector4 operator * (Vector4 & vec);
+	Vector4 operator * (const Vector4 & vec) const;
 
-	Matrix & operator = (Matrix & mat);
+	Matrix & operator = (const Matrix & mat);
 
 	//data members
 	GLfloat m[4][4];
@@ -2,7 +2,10 @@
 #include "MemoryManager.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 const unsigned long CHECK_CODE = 0X12345678;
 
@@ -20,8 +23,9 @@ MemoryManager::~MemoryManager()
 
 void * MemoryManager::Alloc(unsigned int noBytes, char * fileName, unsigned int line)
 {
+	std::lock_guard<std::mutex> lock(m_lock);
 	#ifdef _DEBUG
-		SanityCheck();
+		CheckBuffers(false);
 	#endif
 
     if (m_noBuffers >= MAX_ALLOC) {
@@ -43,9 +47,10 @@ void * MemoryManager::Alloc(unsigned int noBytes, char * fileName, unsigned int
 
 void MemoryManager::Free(void * pAddress)
 {
+	std::lock_guard<std::mutex> lock(m_lock);
 	#ifdef _DEBUG
 	//memory overrun checking
-		SanityCheck();
+		CheckBuffers(false);
 	// deletion of Null pointer
 		if(pAddress == NULL)
 		{
@@ -77,6 +82,7 @@ void MemoryManager::Free(void * pAddress)
 
 void MemoryManager::Dump()
 {
+	std::lock_guard<std::mutex> lock(m_lock);
 	unsigned long noTotalBytes = 0;
 
 	esLogMessage("Starting memory dump\n");
@@ -92,6 +98,12 @@ void MemoryManager::Dump()
 }
 
 void MemoryManager::SanityCheck(bool bShowStats)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	CheckBuffers(bShowStats);
+}
+
+void MemoryManager::CheckBuffers(bool bShowStats)
 {
 	if (bShowStats)
 		esLogMessage("Sanity check start...\n");
@@ -124,6 +136,7 @@ void MemoryManager::SanityCheck(bool bShowStats)
 void MemoryManager::Error(char * szMessage)
 {
 	esLogMessage(szMessage);
+#ifdef _WIN32
 	switch (MessageBoxA(NULL,szMessage,"Memory Error", MB_ABORTRETRYIGNORE | MB_ICONERROR))
 	{
 	case IDABORT:
@@ -132,4 +145,7 @@ void MemoryManager::Error(char * szMessage)
 		return;
 	}
 	throw;
+#else
+	exit(-1);
+#endif
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 
 const int MAX_ALLOC = 20000;
 
@@ -20,6 +21,10 @@ private:
 	static MemoryManager ms_Instance;
 	AllocBuffers m_dataBuffers[MAX_ALLOC];
 	unsigned int m_noBuffers;
+	// new/delete come from the job, render and match threads too
+	std::mutex m_lock;
+
+	void CheckBuffers(bool bShowStats);
 
 public:
 	static MemoryManager * GetInstance() {return &ms_Instance;}
@@ -166,3 +166,77 @@ char * LoadTGA( const char * szFileName, int * width, int * height, int * bpp )
 
     return pOutBuffer;
 }
+
+bool LoadTGAInfo( const char * szFileName, int * width, int * height, int * bpp )
+{
+    FILE * f;
+
+    if (fopen_s(&f, szFileName, "rb" ) != 0)
+        return false;
+
+    TGA_HEADER header;
+    size_t read = fread( &header, sizeof(header), 1, f );
+    fclose( f );
+
+    if ( read != 1 )
+        return false;
+    if ( header.imagetype != IT_COMPRESSED && header.imagetype != IT_UNCOMPRESSED )
+        return false;
+    if ( header.bits != 24 && header.bits != 32 )
+        return false;
+
+    *width = header.width;
+    *height = header.height;
+    *bpp = header.bits;
+    return true;
+}
+
+bool SaveTGA( const char * szFileName, int width, int height, const char * pRGBA )
+{
+    FILE * f;
+
+    if (fopen_s(&f, szFileName, "wb" ) != 0)
+        return false;
+
+    TGA_HEADER header = {};
+    header.imagetype = IT_COMPRESSED;
+    header.width = (short)width;
+    header.height = (short)height;
+    header.bits = 32;
+    header.descriptor = 8;                  // 8 alpha bits, bottom-left origin
+    fwrite( &header, sizeof(header), 1, f );
+
+    // Packets stay inside one row: runs of equal pixels, or up to 128 literals
+    const unsigned int * pixels = (const unsigned int *)pRGBA;
+    for ( int y = 0; y < height; y ++ )
+    {
+        const unsigned int * row = pixels + y * width;
+        int x = 0;
+        while ( x < width )
+        {
+            int run = 1;
+            while ( x + run < width && run < 128 && row[x + run] == row[x] )
+                run ++;
+            int count = run;
+            if ( run == 1 )
+            {
+                while ( x + count < width && count < 128 &&
+                        ( x + count + 1 >= width || row[x + count + 1] != row[x + count] ) )
+                    count ++;
+            }
+            unsigned char packet = (unsigned char)( run > 1 ? 127 + run : count - 1 );
+            fputc( packet, f );
+            for ( int i = 0; i < ( run > 1 ? 1 : count ); i ++ )
+            {
+                const unsigned char * p = (const unsigned char *)( row + x + i );
+                unsigned char bgra[4] = { p[2], p[1], p[0], p[3] };
+                fwrite( bgra, 1, 4, f );
+            }
+            x += count;
+        }
+    }
+
+    bool ok = ferror( f ) == 0;
+    fclose( f );
+    return ok;
+}
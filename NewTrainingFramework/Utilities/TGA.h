@@ -1,3 +1,7 @@
 #pragma once
 
 char * LoadTGA( const char * szFileName, int * width, int * height, int * bpp );
+// Reads only the header; same validation as LoadTGA, no pixel data
+bool LoadTGAInfo( const char * szFileName, int * width, int * height, int * bpp );
+// Writes 32-bit RGBA pixels, bottom row first as LoadTGA returns them, RLE compressed
+bool SaveTGA( const char * szFileName, int width, int height, const char * pRGBA );
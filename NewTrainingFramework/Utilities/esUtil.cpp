@@ -1,11 +1,17 @@
 #include "stdafx.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
 #include <GLES3/gl3.h>
 #include <EGL/egl.h>
+#ifdef _WIN32
 #include "esUtil_win.h"
+#endif
 
 
+#ifdef _WIN32
+
 // CreateEGLContext()
 //Creates an EGL rendering context and all associated elements
 
@@ -73,6 +79,8 @@ EGLBoolean CreateEGLContext ( EGLNativeWindowType hWnd, EGLDisplay* eglDisplay,
    return EGL_TRUE;
 } 
 
+#endif // _WIN32
+
 //  esInitContext()
 //
 //      Initialize ES utility context.  This must be called before calling any other
@@ -87,6 +95,8 @@ void ESUTIL_API esInitContext ( ESContext *esContext )
 }
 
 
+#ifdef _WIN32
+
 //  esCreateWindow()
 //
 //      title - name for title bar of window
@@ -106,7 +116,7 @@ GLboolean ESUTIL_API esCreateWindow ( ESContext *esContext, const char* title, G
        EGL_GREEN_SIZE,     6,
        EGL_BLUE_SIZE,      5,
        EGL_ALPHA_SIZE,     (flags & ES_WINDOW_ALPHA) ? 8 : EGL_DONT_CARE,
-       EGL_DEPTH_SIZE,     (flags & ES_WINDOW_DEPTH) ? 8 : EGL_DONT_CARE,
+       EGL_DEPTH_SIZE,     (flags & ES_WINDOW_DEPTH) ? 16 : EGL_DONT_CARE,
        EGL_STENCIL_SIZE,   (flags & ES_WINDOW_STENCIL) ? 8 : EGL_DONT_CARE,
        EGL_SAMPLE_BUFFERS, (flags & ES_WINDOW_MULTISAMPLE) ? 1 : 0,
        EGL_NONE
@@ -148,6 +158,71 @@ void ESUTIL_API esMainLoop ( ESContext *esContext )
 }
 
 
+//  esGetTime()
+//
+//    High-resolution monotonic time in seconds
+
+double ESUTIL_API esGetTime ( void )
+{
+   return WinGetTime ();
+}
+
+
+//  esGetEventTime()
+
+double ESUTIL_API esGetEventTime ( void )
+{
+   return WinGetEventTime ();
+}
+
+
+//  esQuit()
+
+void ESUTIL_API esQuit ( void )
+{
+   WinQuit ();
+}
+
+#endif // _WIN32
+
+
+//  esSetHeadless()
+//
+//    Process-wide; set once before Init so no GL object is ever created
+
+static GLboolean s_headless = GL_FALSE;
+
+void ESUTIL_API esSetHeadless ( GLboolean headless )
+{
+   s_headless = headless;
+}
+
+GLboolean ESUTIL_API esIsHeadless ( void )
+{
+   return s_headless;
+}
+
+
+//  esSetFrameRate()
+
+void ESUTIL_API esSetFrameRate ( ESContext *esContext, float targetFps, float idleFps )
+{
+   esContext->targetFrameRate = targetFps > 0.0f ? targetFps : 0.0f;
+   esContext->idleFrameRate = idleFps > 0.0f ? idleFps : 0.0f;
+}
+
+
+//  esSetSwapInterval()
+
+void ESUTIL_API esSetSwapInterval ( ESContext *esContext, EGLint interval )
+{
+   if ( esContext->eglDisplay != EGL_NO_DISPLAY && eglSwapInterval ( esContext->eglDisplay, interval ) )
+   {
+      esContext->swapInterval = interval;
+   }
+}
+
+
 
 //  esRegisterDrawFunc()
 
@@ -188,6 +263,30 @@ void ESUTIL_API esRegisterMouseMoveFunc ( ESContext *esContext,
    esContext->mouseMoveFunc = mouseMoveFunc;
 }
 
+//  esRegisterResizeFunc()
+
+void ESUTIL_API esRegisterResizeFunc ( ESContext *esContext,
+                                       void (ESCALLBACK *resizeFunc) (ESContext*, int, int ) )
+{
+   esContext->resizeFunc = resizeFunc;
+}
+
+//  esRegisterIdleFunc()
+
+void ESUTIL_API esRegisterIdleFunc ( ESContext *esContext,
+                                     bool (ESCALLBACK *idleFunc) (ESContext* ) )
+{
+   esContext->idleFunc = idleFunc;
+}
+
+//  esRegisterShutdownFunc()
+
+void ESUTIL_API esRegisterShutdownFunc ( ESContext *esContext,
+                                         void (ESCALLBACK *shutdownFunc) (ESContext* ) )
+{
+   esContext->shutdownFunc = shutdownFunc;
+}
+
 
 // esLogMessage()
 //    Log an error message to the debug output for the platform
@@ -198,10 +297,12 @@ void ESUTIL_API esLogMessage ( const char *formatStr, ... )
     char buf[2048];
 
     va_start ( params, formatStr );
-    vsprintf_s ( buf, sizeof(buf),  formatStr, params );
+    vsnprintf ( buf, sizeof(buf),  formatStr, params );
     
     printf ( "%s", buf );
+#ifdef _WIN32
 	OutputDebugString(buf);
+#endif
     
     va_end ( params );
 }
@@ -4,8 +4,13 @@
 
 //  Macros
 
+#ifdef _WIN32
 #define ESUTIL_API  __cdecl
 #define ESCALLBACK  __cdecl
+#else
+#define ESUTIL_API
+#define ESCALLBACK
+#endif
 
 
 /// esCreateWindow flag - RGB color buffer
@@ -26,10 +31,10 @@
 class ESContext
 {
 public:
-   /// Window width
+   /// Drawable width, kept current by the platform layer on resize
    GLint       width;
 
-   /// Window height
+   /// Drawable height, kept current by the platform layer on resize
    GLint       height;
 
    /// Window handle
@@ -44,12 +49,22 @@ public:
    /// EGL surface
    EGLSurface  eglSurface;
 
+   /// Frame pacing; 0 leaves the loop uncapped
+   float       targetFrameRate;
+   float       idleFrameRate;
+
+   /// Swap interval passed to eglSwapInterval, 0 = vsync off
+   EGLint      swapInterval;
+
    /// Callbacks
    void (ESCALLBACK *drawFunc) ( ESContext * );
    void (ESCALLBACK *keyFunc) ( ESContext *, unsigned char, bool );
    void (ESCALLBACK *updateFunc) ( ESContext *, float deltaTime );
    void (ESCALLBACK *mouseFunc) ( ESContext *, int, int, bool );
    void (ESCALLBACK *mouseMoveFunc) ( ESContext *, int, int );
+   bool (ESCALLBACK *idleFunc) ( ESContext * );
+   void (ESCALLBACK *resizeFunc) ( ESContext *, int, int );
+   void (ESCALLBACK *shutdownFunc) ( ESContext * );
 };
 
 
@@ -82,6 +97,47 @@ GLboolean ESUTIL_API esCreateWindow ( ESContext *esContext, const char *title, G
 //
 void ESUTIL_API esMainLoop ( ESContext *esContext );
 
+//
+/// \brief Set the frame rate limits used by the main loop
+/// \param esContext Application context
+/// \param targetFps Frames per second while the application is active, 0 for uncapped
+/// \param idleFps Frames per second while the idle callback reports true, 0 to use targetFps
+//
+void ESUTIL_API esSetFrameRate ( ESContext *esContext, float targetFps, float idleFps );
+
+//
+/// \brief Set the number of vertical blanks to wait for on each buffer swap
+/// \param esContext Application context
+/// \param interval 0 disables vsync, 1 syncs to every refresh
+//
+void ESUTIL_API esSetSwapInterval ( ESContext *esContext, EGLint interval );
+
+//
+/// \brief Read the high-resolution monotonic timer
+/// \return Seconds since an arbitrary origin; only differences are meaningful
+//
+double ESUTIL_API esGetTime ( void );
+
+//
+/// \brief Timestamp of the input event being dispatched to a callback
+/// \return esGetTime() seconds at which the platform received the event; the
+///         current time when called outside an input callback
+//
+double ESUTIL_API esGetEventTime ( void );
+
+//
+/// \brief Ask the main loop to exit after the current frame
+//
+void ESUTIL_API esQuit ( void );
+
+//
+/// \brief Select the null backend: no window or GL context exists, resource loaders
+///        keep only metadata (sizes, sprite layout) and every GL call is skipped
+/// \param headless GL_TRUE before any resource is loaded to run without a GPU
+//
+void ESUTIL_API esSetHeadless ( GLboolean headless );
+GLboolean ESUTIL_API esIsHeadless ( void );
+
 //
 /// \brief Register a draw callback function to be used to render each frame
 /// \param esContext Application context
@@ -120,6 +176,31 @@ void ESUTIL_API esRegisterMouseFunc ( ESContext *esContext,
 void ESUTIL_API esRegisterMouseMoveFunc ( ESContext *esContext, 
                                           void (ESCALLBACK *mouseMoveFunc) ( ESContext*, int, int ) );
 
+//
+/// \brief Register a callback for drawable size changes
+/// \param esContext Application context
+/// \param resizeFunc Receives the new drawable width and height in pixels
+//
+void ESUTIL_API esRegisterResizeFunc ( ESContext *esContext, 
+                                       void (ESCALLBACK *resizeFunc) ( ESContext*, int, int ) );
+
+//
+/// \brief Register a callback run when the main loop exits, before the platform
+///        layer releases the window and its GL context
+/// \param esContext Application context
+/// \param shutdownFunc Shutdown callback function
+//
+void ESUTIL_API esRegisterShutdownFunc ( ESContext *esContext,
+                                         void (ESCALLBACK *shutdownFunc) ( ESContext* ) );
+
+//
+/// \brief Register a callback that reports whether nothing is animating
+/// \param esContext Application context
+/// \param idleFunc Returns true to let the main loop drop to the idle frame rate
+//
+void ESUTIL_API esRegisterIdleFunc ( ESContext *esContext, 
+                                     bool (ESCALLBACK *idleFunc) ( ESContext* ) );
+
 //
 /// \brief Log a message to the debug output for the platform
 /// \param formatStr Format string for error log.  
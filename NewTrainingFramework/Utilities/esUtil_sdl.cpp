@@ -0,0 +1,404 @@
+#include "stdafx.h"
+// SDL2 platform layer for non-Windows builds. Implements the same
+// esCreateWindow/esMainLoop contract as esUtil_win.cpp:
+// - windowed: SDL creates a GLES 3 context through EGL and the EGL handles
+//   are published in ESContext, so callers keep using eglSwapBuffers
+// - SDL_VIDEODRIVER=offscreen: same path, SDL renders into an EGL pbuffer
+// - SDL_VIDEODRIVER=dummy: no SDL window; an EGL pbuffer on the default
+//   display is created here so GL calls still work on headless servers
+#ifndef _WIN32
+
+#include <SDL.h>
+#include <string.h>
+#include <EGL/egl.h>
+#include "esUtil.h"
+
+#ifndef EGL_OPENGL_ES3_BIT
+#define EGL_OPENGL_ES3_BIT 0x00000040
+#endif
+
+static SDL_Window* s_window = NULL;
+static SDL_GLContext s_glContext = NULL;
+static bool s_headless = false;
+// Time of the key event being dispatched, negative outside a dispatch
+static double s_eventTime = -1.0;
+
+
+//      GLES 3 pbuffer context on the default EGL display
+static GLboolean SdlCreatePbufferContext ( ESContext *esContext, GLuint flags )
+{
+   EGLint configAttribs[] =
+   {
+       EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+       EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+       EGL_RED_SIZE,        8,
+       EGL_GREEN_SIZE,      8,
+       EGL_BLUE_SIZE,       8,
+       EGL_ALPHA_SIZE,      (flags & ES_WINDOW_ALPHA) ? 8 : 0,
+       EGL_DEPTH_SIZE,      (flags & ES_WINDOW_DEPTH) ? 16 : 0,
+       EGL_STENCIL_SIZE,    (flags & ES_WINDOW_STENCIL) ? 8 : 0,
+       EGL_NONE
+   };
+   EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+   EGLint numConfigs = 0;
+   EGLConfig config;
+
+   EGLDisplay display = eglGetDisplay ( EGL_DEFAULT_DISPLAY );
+   if ( display == EGL_NO_DISPLAY || !eglInitialize ( display, NULL, NULL ) )
+      return GL_FALSE;
+
+   eglBindAPI ( EGL_OPENGL_ES_API );
+   if ( !eglChooseConfig ( display, configAttribs, &config, 1, &numConfigs ) || numConfigs < 1 )
+      return GL_FALSE;
+
+   EGLint surfaceAttribs[] = { EGL_WIDTH, esContext->width, EGL_HEIGHT, esContext->height, EGL_NONE };
+   EGLSurface surface = eglCreatePbufferSurface ( display, config, surfaceAttribs );
+   if ( surface == EGL_NO_SURFACE )
+      return GL_FALSE;
+
+   EGLContext context = eglCreateContext ( display, config, EGL_NO_CONTEXT, contextAttribs );
+   if ( context == EGL_NO_CONTEXT )
+      return GL_FALSE;
+
+   if ( !eglMakeCurrent ( display, surface, surface, context ) )
+      return GL_FALSE;
+
+   esContext->eglDisplay = display;
+   esContext->eglSurface = surface;
+   esContext->eglContext = context;
+   return GL_TRUE;
+}
+
+//      SDL window with a GLES 3 context created through EGL
+static GLboolean SdlCreateWindowContext ( ESContext *esContext, const char *title, GLuint flags )
+{
+   SDL_GL_SetAttribute ( SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES );
+   SDL_GL_SetAttribute ( SDL_GL_CONTEXT_MAJOR_VERSION, 3 );
+   SDL_GL_SetAttribute ( SDL_GL_CONTEXT_MINOR_VERSION, 0 );
+   SDL_GL_SetAttribute ( SDL_GL_RED_SIZE, 8 );
+   SDL_GL_SetAttribute ( SDL_GL_GREEN_SIZE, 8 );
+   SDL_GL_SetAttribute ( SDL_GL_BLUE_SIZE, 8 );
+   SDL_GL_SetAttribute ( SDL_GL_ALPHA_SIZE, (flags & ES_WINDOW_ALPHA) ? 8 : 0 );
+   SDL_GL_SetAttribute ( SDL_GL_DEPTH_SIZE, (flags & ES_WINDOW_DEPTH) ? 16 : 0 );
+   SDL_GL_SetAttribute ( SDL_GL_STENCIL_SIZE, (flags & ES_WINDOW_STENCIL) ? 8 : 0 );
+   SDL_GL_SetAttribute ( SDL_GL_MULTISAMPLEBUFFERS, (flags & ES_WINDOW_MULTISAMPLE) ? 1 : 0 );
+
+   Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+   size_t titleLen = strlen ( title );
+   if ( titleLen >= 4 && strcmp ( title + (titleLen - 4), "[FS]" ) == 0 )
+      windowFlags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+
+   s_window = SDL_CreateWindow ( title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                 esContext->width, esContext->height, windowFlags );
+   if ( s_window == NULL )
+      return GL_FALSE;
+
+   s_glContext = SDL_GL_CreateContext ( s_window );
+   if ( s_glContext == NULL || SDL_GL_MakeCurrent ( s_window, s_glContext ) != 0 )
+      return GL_FALSE;
+
+   // Callers present with eglSwapBuffers, so the context must be EGL-backed
+   esContext->eglDisplay = eglGetCurrentDisplay ();
+   esContext->eglSurface = eglGetCurrentSurface ( EGL_DRAW );
+   esContext->eglContext = eglGetCurrentContext ();
+   if ( esContext->eglDisplay == EGL_NO_DISPLAY || esContext->eglSurface == EGL_NO_SURFACE )
+   {
+      esLogMessage ( "SDL did not create an EGL context (video driver %s)\n", SDL_GetCurrentVideoDriver () );
+      return GL_FALSE;
+   }
+
+   int drawableW = 0, drawableH = 0;
+   SDL_GL_GetDrawableSize ( s_window, &drawableW, &drawableH );
+   esContext->width = drawableW;
+   esContext->height = drawableH;
+   return GL_TRUE;
+}
+
+
+//  esCreateWindow()
+
+GLboolean ESUTIL_API esCreateWindow ( ESContext *esContext, const char* title, GLint width, GLint height, GLuint flags )
+{
+   if ( esContext == NULL )
+      return GL_FALSE;
+
+   esContext->width = width;
+   esContext->height = height;
+   esContext->eglDisplay = EGL_NO_DISPLAY;
+   esContext->eglSurface = EGL_NO_SURFACE;
+   esContext->eglContext = EGL_NO_CONTEXT;
+
+   SDL_SetHint ( SDL_HINT_VIDEO_X11_FORCE_EGL, "1" );
+   SDL_SetHint ( SDL_HINT_OPENGL_ES_DRIVER, "1" );
+   if ( SDL_InitSubSystem ( SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER ) != 0 )
+   {
+      esLogMessage ( "SDL_Init failed: %s\n", SDL_GetError () );
+      return GL_FALSE;
+   }
+
+   const char* driver = SDL_GetCurrentVideoDriver ();
+   s_headless = driver != NULL && strcmp ( driver, "dummy" ) == 0;
+
+   GLboolean ok = s_headless ? SdlCreatePbufferContext ( esContext, flags )
+                             : SdlCreateWindowContext ( esContext, title, flags );
+   if ( !ok )
+      esLogMessage ( "Could not create a GLES 3 context on video driver %s\n", driver ? driver : "(none)" );
+   return ok;
+}
+
+
+//  esGetTime()
+
+double ESUTIL_API esGetTime ( void )
+{
+   static const double period = 1.0 / (double)SDL_GetPerformanceFrequency ();
+   return (double)SDL_GetPerformanceCounter () * period;
+}
+
+
+//  esGetEventTime()
+
+double ESUTIL_API esGetEventTime ( void )
+{
+   return s_eventTime >= 0.0 ? s_eventTime : esGetTime ();
+}
+
+
+//  esQuit()
+
+void ESUTIL_API esQuit ( void )
+{
+   SDL_Event quit;
+   memset ( &quit, 0, sizeof ( quit ) );
+   quit.type = SDL_QUIT;
+   SDL_PushEvent ( &quit );
+}
+
+
+//      Map SDL keys onto the Win32 virtual-key codes the game is written against
+static int SdlKeyToVirtualKey ( SDL_Keycode key )
+{
+   if ( key >= SDLK_a && key <= SDLK_z )
+      return 'A' + ( key - SDLK_a );
+   if ( key >= SDLK_0 && key <= SDLK_9 )
+      return '0' + ( key - SDLK_0 );
+   if ( key >= SDLK_KP_1 && key <= SDLK_KP_9 )
+      return 0x61 + ( key - SDLK_KP_1 );
+   if ( key >= SDLK_F1 && key <= SDLK_F12 )
+      return 0x70 + ( key - SDLK_F1 );
+
+   switch ( key )
+   {
+      case SDLK_KP_0:       return 0x60;
+      case SDLK_BACKSPACE:  return 0x08;
+      case SDLK_TAB:        return 0x09;
+      case SDLK_RETURN:
+      case SDLK_KP_ENTER:   return 0x0D;
+      case SDLK_LSHIFT:
+      case SDLK_RSHIFT:     return 0x10;
+      case SDLK_LCTRL:
+      case SDLK_RCTRL:      return 0x11;
+      case SDLK_LALT:
+      case SDLK_RALT:       return 0x12;
+      case SDLK_ESCAPE:     return 0x1B;
+      case SDLK_SPACE:      return 0x20;
+      case SDLK_LEFT:       return 0x25;
+      case SDLK_UP:         return 0x26;
+      case SDLK_RIGHT:      return 0x27;
+      case SDLK_DOWN:       return 0x28;
+      case SDLK_DELETE:     return 0x2E;
+      case SDLK_SEMICOLON:  return 0xBA;
+      case SDLK_EQUALS:     return 0xBB;
+      case SDLK_COMMA:      return 0xBC;
+      case SDLK_MINUS:      return 0xBD;
+      case SDLK_PERIOD:     return 0xBE;
+      case SDLK_SLASH:      return 0xBF;
+      case SDLK_BACKQUOTE:  return 0xC0;
+      case SDLK_LEFTBRACKET:  return 0xDB;
+      case SDLK_BACKSLASH:    return 0xDC;
+      case SDLK_RIGHTBRACKET: return 0xDD;
+      case SDLK_QUOTE:        return 0xDE;
+      default:              return 0;
+   }
+}
+
+//      Mouse events arrive in window coordinates; callers work in drawable pixels
+static void SdlWindowToDrawable ( ESContext *esContext, int* x, int* y )
+{
+   int windowW = 0, windowH = 0;
+   SDL_GetWindowSize ( s_window, &windowW, &windowH );
+   if ( windowW > 0 && windowH > 0 )
+   {
+      *x = *x * esContext->width / windowW;
+      *y = *y * esContext->height / windowH;
+   }
+}
+
+//      Dispatch one SDL event to the registered callbacks; returns false on quit
+static bool SdlDispatchEvent ( ESContext *esContext, const SDL_Event& event )
+{
+   switch ( event.type )
+   {
+      case SDL_QUIT:
+         return false;
+
+      case SDL_WINDOWEVENT:
+         if ( event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED && s_window )
+         {
+            SDL_GL_GetDrawableSize ( s_window, &esContext->width, &esContext->height );
+            if ( esContext->resizeFunc )
+               esContext->resizeFunc ( esContext, esContext->width, esContext->height );
+         }
+         else if ( event.window.event == SDL_WINDOWEVENT_EXPOSED && esContext->drawFunc )
+         {
+            esContext->drawFunc ( esContext );
+         }
+         break;
+
+      case SDL_KEYDOWN:
+      case SDL_KEYUP:
+         {
+            int vk = SdlKeyToVirtualKey ( event.key.keysym.sym );
+            if ( vk != 0 && esContext->keyFunc )
+            {
+               // Event timestamps are SDL_GetTicks milliseconds; rebase onto esGetTime
+               Uint32 ageMs = SDL_GetTicks () - event.key.timestamp;
+               s_eventTime = esGetTime () - ( ageMs < 0x80000000u ? ageMs : 0u ) / 1000.0;
+               esContext->keyFunc ( esContext, (unsigned char)vk, event.type == SDL_KEYDOWN );
+               s_eventTime = -1.0;
+            }
+         }
+         break;
+
+      case SDL_MOUSEBUTTONDOWN:
+      case SDL_MOUSEBUTTONUP:
+         if ( event.button.button == SDL_BUTTON_LEFT && esContext->mouseFunc )
+         {
+            int x = event.button.x, y = event.button.y;
+            SdlWindowToDrawable ( esContext, &x, &y );
+            esContext->mouseFunc ( esContext, x, y, event.type == SDL_MOUSEBUTTONDOWN );
+         }
+         break;
+
+      case SDL_MOUSEMOTION:
+         if ( esContext->mouseMoveFunc )
+         {
+            int x = event.motion.x, y = event.motion.y;
+            SdlWindowToDrawable ( esContext, &x, &y );
+            esContext->mouseMoveFunc ( esContext, x, y );
+         }
+         break;
+   }
+   return true;
+}
+
+//      Wait until deadline (esGetTime seconds) or until an event is queued.
+//      Sleeps in the event queue, then yields for the last couple of milliseconds.
+static void SdlWaitUntil ( double deadline )
+{
+   const double spinWindow = 0.002;
+   double remaining = deadline - esGetTime ();
+   if ( remaining > spinWindow )
+   {
+      if ( SDL_WaitEventTimeout ( NULL, (int)( ( remaining - spinWindow ) * 1000.0 ) ) )
+         return;
+   }
+   while ( esGetTime () < deadline )
+   {
+      SDL_PumpEvents ();
+      if ( SDL_HasEvents ( SDL_FIRSTEVENT, SDL_LASTEVENT ) )
+         return;
+      SDL_Delay ( 0 );
+   }
+}
+
+//      Refresh rate of the window's display, 0 if unknown or headless
+static int SdlGetRefreshRate ( void )
+{
+   SDL_DisplayMode mode;
+   if ( s_window == NULL )
+      return 0;
+   int display = SDL_GetWindowDisplayIndex ( s_window );
+   if ( display < 0 || SDL_GetCurrentDisplayMode ( display, &mode ) != 0 )
+      return 0;
+   return mode.refresh_rate;
+}
+
+
+//  esMainLoop()
+//
+//    Same pacing rules as WinLoop: drain events, update, draw, then wait for
+//    the next frame slot at the active or idle rate.
+
+void ESUTIL_API esMainLoop ( ESContext *esContext )
+{
+   SDL_Event event;
+   bool done = false;
+   bool idle = false;
+   const int refreshRate = SdlGetRefreshRate ();
+
+   double lastTime = esGetTime ();
+   double nextFrame = lastTime;
+
+   while ( !done )
+   {
+      bool gotEvent = false;
+      while ( !done && SDL_PollEvent ( &event ) )
+      {
+         done = !SdlDispatchEvent ( esContext, event );
+         gotEvent = true;
+      }
+      if ( done )
+         break;
+
+      double curTime = esGetTime ();
+      if ( idle && gotEvent )
+         nextFrame = curTime;
+      if ( curTime < nextFrame )
+      {
+         SdlWaitUntil ( nextFrame );
+         continue;
+      }
+
+      float deltaTime = (float)( curTime - lastTime );
+      lastTime = curTime;
+
+      if ( esContext->updateFunc != NULL )
+         esContext->updateFunc ( esContext, deltaTime );
+
+      if ( esContext->drawFunc != NULL )
+         esContext->drawFunc ( esContext );
+
+      idle = esContext->idleFunc != NULL && esContext->idleFunc ( esContext );
+      float fps = ( idle && esContext->idleFrameRate > 0.0f ) ? esContext->idleFrameRate : esContext->targetFrameRate;
+
+      bool swapPaced = !idle && !s_headless && esContext->swapInterval > 0 && refreshRate > 0 &&
+                       fps >= (float)refreshRate / (float)esContext->swapInterval - 1.0f;
+
+      if ( fps <= 0.0f || swapPaced )
+      {
+         nextFrame = curTime;
+      }
+      else
+      {
+         double period = 1.0 / fps;
+         if ( nextFrame < curTime - period )
+            nextFrame = curTime;
+         nextFrame += period;
+      }
+   }
+
+   if ( esContext->shutdownFunc != NULL )
+      esContext->shutdownFunc ( esContext );
+
+   if ( esContext->eglDisplay != EGL_NO_DISPLAY )
+      eglMakeCurrent ( esContext->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+   if ( s_glContext )
+      SDL_GL_DeleteContext ( s_glContext );
+   if ( s_window )
+      SDL_DestroyWindow ( s_window );
+   s_glContext = NULL;
+   s_window = NULL;
+}
+
+#endif // !_WIN32
@@ -1,9 +1,27 @@
 #include "stdafx.h"
 #include <windows.h>
+#include <mmsystem.h>
 #include <cstring>
 #include "esUtil.h"
+#include "esUtil_win.h"
 
 
+// Time of the key message being dispatched, negative outside a dispatch
+static double s_eventTime = -1.0;
+
+//      Forwards a key message, stamped with the time it was posted
+static void WinDispatchKey ( HWND hWnd, WPARAM wParam, bool pressed )
+{
+   ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
+   if ( esContext && esContext->keyFunc )
+   {
+      // GetMessageTime is in GetTickCount milliseconds; rebase it onto WinGetTime
+      LONG ageMs = (LONG)( GetTickCount () - (DWORD)GetMessageTime () );
+      s_eventTime = WinGetTime () - ( ageMs > 0 ? ageMs : 0 ) / 1000.0;
+      esContext->keyFunc ( esContext, (unsigned char) wParam, pressed );
+      s_eventTime = -1.0;
+   }
+}
 
 // Main window procedure
 LRESULT WINAPI ESWindowProc ( HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam ) 
@@ -32,39 +50,19 @@ LRESULT WINAPI ESWindowProc ( HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam
          break; 
       
 	  case WM_KEYDOWN:
-		  {
-			  ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
-
-			  if ( esContext && esContext->keyFunc )
-				  esContext->keyFunc ( esContext, (unsigned char) wParam, true );
-		  }
+		  WinDispatchKey ( hWnd, wParam, true );
 		  break;
 
 	  case WM_KEYUP:
-		  {
-			  ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
-
-			  if ( esContext && esContext->keyFunc )
-				  esContext->keyFunc ( esContext, (unsigned char) wParam, false );
-		  }
+		  WinDispatchKey ( hWnd, wParam, false );
 		  break;
 
 	  case WM_SYSKEYDOWN:
-		  {
-			  ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
-
-			  if ( esContext && esContext->keyFunc )
-				  esContext->keyFunc ( esContext, (unsigned char) wParam, true );
-		  }
+		  WinDispatchKey ( hWnd, wParam, true );
 		  break;
 
 	  case WM_SYSKEYUP:
-		  {
-			  ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
-
-			  if ( esContext && esContext->keyFunc )
-				  esContext->keyFunc ( esContext, (unsigned char) wParam, false );
-		  }
+		  WinDispatchKey ( hWnd, wParam, false );
 		  break;
 
       case WM_LBUTTONDOWN:
@@ -103,6 +101,19 @@ LRESULT WINAPI ESWindowProc ( HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam
          }
          break;
 
+      case WM_SIZE:
+         {
+            ESContext *esContext = (ESContext*)(LONG_PTR) GetWindowLongPtr ( hWnd, GWL_USERDATA );
+            if ( esContext )
+            {
+               esContext->width = (GLint)LOWORD(lParam);
+               esContext->height = (GLint)HIWORD(lParam);
+               if ( esContext->resizeFunc )
+                  esContext->resizeFunc ( esContext, esContext->width, esContext->height );
+            }
+         }
+         break;
+
       case WM_MOVE:
          {
             WDpoint.x = (int)LOWORD(lParam); // horizontal position
@@ -196,37 +207,139 @@ GLboolean WinCreate ( ESContext *esContext, const char *title )
 
 
 
+//      Seconds from the performance counter
+double WinGetTime ( void )
+{
+   static LARGE_INTEGER frequency = { 0 };
+   LARGE_INTEGER counter;
+   if ( frequency.QuadPart == 0 )
+      QueryPerformanceFrequency ( &frequency );
+   QueryPerformanceCounter ( &counter );
+   return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+//      Time of the key message being dispatched, or now outside a dispatch
+double WinGetEventTime ( void )
+{
+   return s_eventTime >= 0.0 ? s_eventTime : WinGetTime ();
+}
+
+//      Wait until deadline (WinGetTime seconds) or until a window message
+//      arrives. The bulk of the wait sleeps in the message queue; the last
+//      couple of milliseconds yield in a loop so wake-up lands on time.
+static void WinWaitUntil ( double deadline )
+{
+   const double spinWindow = 0.002;
+   double remaining = deadline - WinGetTime();
+   if ( remaining > spinWindow )
+   {
+      DWORD ms = (DWORD)( ( remaining - spinWindow ) * 1000.0 );
+      if ( MsgWaitForMultipleObjects ( 0, NULL, FALSE, ms, QS_ALLINPUT ) != WAIT_TIMEOUT )
+         return;
+   }
+   while ( WinGetTime() < deadline )
+   {
+      if ( HIWORD ( GetQueueStatus ( QS_ALLINPUT ) ) != 0 )
+         return;
+      SwitchToThread();
+   }
+}
+
+//      Refresh rate of the primary display, 0 if the driver does not report one
+static int WinGetRefreshRate ( void )
+{
+   DEVMODE mode;
+   memset ( &mode, 0, sizeof ( mode ) );
+   mode.dmSize = sizeof ( mode );
+   if ( EnumDisplaySettings ( NULL, ENUM_CURRENT_SETTINGS, &mode ) && mode.dmDisplayFrequency > 1 )
+      return (int)mode.dmDisplayFrequency;
+   return 0;
+}
+
+//      Close the active window, which ends WinLoop
+void WinQuit ( void )
+{
+   HWND hWnd = GetActiveWindow();
+   if ( hWnd )
+      PostMessage ( hWnd, WM_CLOSE, 0, 0 );
+   else
+      PostQuitMessage ( 0 );
+}
+
 //      Start main windows loop
 void WinLoop ( ESContext *esContext )
 {
    MSG msg = { 0 };
    int done = 0;
-   DWORD lastTime = GetTickCount();
+   bool idle = false;
+   const int refreshRate = WinGetRefreshRate();
+
+   // 1 ms scheduler granularity so the timed waits below are not rounded up to 15.6 ms
+   timeBeginPeriod ( 1 );
+
+   double lastTime = WinGetTime();
+   double nextFrame = lastTime;
    
    while (!done)
    {
-      int gotMsg = (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE) != 0);
-      DWORD curTime = GetTickCount();
-      float deltaTime = (float)( curTime - lastTime ) / 1000.0f;
-      lastTime = curTime;
-
-      if ( gotMsg )
+      bool gotMsg = false;
+      while ( PeekMessage(&msg, NULL, 0, 0, PM_REMOVE) )
       {
          if (msg.message==WM_QUIT)
          {
              done=1; 
+             break;
          }
-         else
-         {
-             TranslateMessage(&msg); 
-             DispatchMessage(&msg); 
-         }
+         TranslateMessage(&msg); 
+         DispatchMessage(&msg); 
+         gotMsg = true;
       }
-      else
-         SendMessage( esContext->hWnd, WM_PAINT, 0, 0 );
+      if ( done )
+         break;
+
+      double curTime = WinGetTime();
+      // Input wakes an idle loop right away instead of at its next slow frame
+      if ( idle && gotMsg )
+         nextFrame = curTime;
+      if ( curTime < nextFrame )
+      {
+         WinWaitUntil ( nextFrame );
+         continue;
+      }
+
+      float deltaTime = (float)( curTime - lastTime );
+      lastTime = curTime;
 
       // Call update function if registered
       if ( esContext->updateFunc != NULL )
          esContext->updateFunc ( esContext, deltaTime );
+
+      SendMessage( esContext->hWnd, WM_PAINT, 0, 0 );
+
+      idle = esContext->idleFunc != NULL && esContext->idleFunc ( esContext );
+      float fps = ( idle && esContext->idleFrameRate > 0.0f ) ? esContext->idleFrameRate : esContext->targetFrameRate;
+
+      // With vsync on, eglSwapBuffers already blocks at the display rate; only
+      // sleep when the requested rate is below what the swap would give
+      bool swapPaced = !idle && esContext->swapInterval > 0 && refreshRate > 0 &&
+                       fps >= (float)refreshRate / (float)esContext->swapInterval - 1.0f;
+
+      if ( fps <= 0.0f || swapPaced )
+      {
+         nextFrame = curTime;
+      }
+      else
+      {
+         double period = 1.0 / fps;
+         // A frame that overran by more than a period resets the schedule rather than bursting
+         if ( nextFrame < curTime - period )
+            nextFrame = curTime;
+         nextFrame += period;
+      }
    }
+
+   if ( esContext->shutdownFunc != NULL )
+      esContext->shutdownFunc ( esContext );
+
+   timeEndPeriod ( 1 );
 }
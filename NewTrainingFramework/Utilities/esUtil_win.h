@@ -9,3 +9,12 @@ GLboolean WinCreate ( ESContext *esContext, const char *title );
 // Start main windows loop
 void WinLoop ( ESContext *esContext );
 
+// Seconds since an arbitrary origin, from the high-resolution performance counter
+double WinGetTime ( void );
+
+// WinGetTime() at which the key message being dispatched was posted
+double WinGetEventTime ( void );
+
+// Close the active window, which ends WinLoop
+void WinQuit ( void );
+
@@ -12,5 +12,16 @@
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
 #endif
 
+#ifndef _WIN32
+#include <stdio.h>
+#include <errno.h>
+// MSVC secure CRT names used by the loaders
+inline int fopen_s(FILE** file, const char* fileName, const char* mode)
+{
+	*file = fopen(fileName, mode);
+	return *file ? 0 : errno;
+}
+#endif
+
 
 // TODO: reference additional headers your program requires here
@@ -2,7 +2,9 @@
 #pragma once
 
 #include "esUtil.h"
+#ifdef _WIN32
 #include "esUtil_win.h"
+#endif
 #include "Math.h"
 #include "TGA.h"
 #include "MemoryOperators.h"